@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cstring>
+#include <boost/interprocess/ipc/message_queue.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include "InterprocessChannel.h"
+
+namespace
+{
+    using boost::interprocess::message_queue;
+
+    boost::posix_time::ptime getDeadline(int timeout)
+    {
+        return boost::posix_time::microsec_clock::universal_time() + boost::posix_time::milliseconds(timeout);
+    }
+}
+
+struct InterprocessChannel::Impl
+{
+    Impl(string const& name, int maxChunkSize, int capacity)
+        : queue(boost::interprocess::open_or_create, name.c_str(), capacity, maxChunkSize)
+        , chunk(maxChunkSize)
+    {
+    }
+
+    message_queue queue;
+    vector<char> chunk;
+};
+
+InterprocessChannel::InterprocessChannel(string const& name, int maxChunkSize, int capacity)
+    : _impl(new Impl(name, maxChunkSize, capacity))
+{
+    CHECK(maxChunkSize >= static_cast<int>(sizeof(uint64_t)));
+}
+
+InterprocessChannel::~InterprocessChannel()
+{
+    delete _impl;
+}
+
+void InterprocessChannel::remove(string const& name)
+{
+    message_queue::remove(name.c_str());
+}
+
+void InterprocessChannel::send(string const& message)
+{
+    sendChunks(message, boost::none);
+}
+
+bool InterprocessChannel::send(string const& message, int timeout)
+{
+    return sendChunks(message, timeout);
+}
+
+//the first chunk contains the message size followed by the beginning of the message
+bool InterprocessChannel::sendChunks(string const& message, optional<int> timeout)
+{
+    auto& chunk = _impl->chunk;
+    auto const messageSize = static_cast<uint64_t>(message.size());
+    std::memcpy(chunk.data(), &messageSize, sizeof(uint64_t));
+
+    size_t chunkSize = sizeof(uint64_t);
+    size_t pos = 0;
+    do {
+        auto const numBytes = std::min(chunk.size() - chunkSize, message.size() - pos);
+        std::memcpy(chunk.data() + chunkSize, message.data() + pos, numBytes);
+        if (timeout) {
+            if (!_impl->queue.timed_send(chunk.data(), chunkSize + numBytes, 0, getDeadline(*timeout))) {
+                return false;
+            }
+        }
+        else {
+            _impl->queue.send(chunk.data(), chunkSize + numBytes, 0);
+        }
+        pos += numBytes;
+        chunkSize = 0;
+    } while (pos < message.size());
+    return true;
+}
+
+optional<string> InterprocessChannel::receive(int timeout)
+{
+    auto& chunk = _impl->chunk;
+    message_queue::size_type chunkSize = 0;
+    unsigned int priority = 0;
+    if (!_impl->queue.timed_receive(chunk.data(), chunk.size(), chunkSize, priority, getDeadline(timeout))) {
+        return boost::none;
+    }
+    CHECK(chunkSize >= sizeof(uint64_t));
+    uint64_t messageSize = 0;
+    std::memcpy(&messageSize, chunk.data(), sizeof(uint64_t));
+
+    string result(chunk.data() + sizeof(uint64_t), chunk.data() + chunkSize);
+    result.reserve(messageSize);
+    while (result.size() < messageSize) {
+        //the remaining chunks are sent immediately after the first one unless the sender has given up or stopped
+        if (!_impl->queue.timed_receive(chunk.data(), chunk.size(), chunkSize, priority, getDeadline(timeout))) {
+            return boost::none;
+        }
+        result.append(chunk.data(), chunkSize);
+    }
+    CHECK(result.size() == messageSize);
+    return result;
+}
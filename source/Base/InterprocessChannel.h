@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * One-directional message channel between processes on the same machine based on a named message queue in shared
+ * memory. Both sides open the channel with the same name; the queue is created by whichever side comes first.
+ * Messages of arbitrary size are transferred in chunks of at most maxChunkSize bytes.
+ */
+class BASE_EXPORT InterprocessChannel
+{
+public:
+    InterprocessChannel(string const& name, int maxChunkSize = 64 * 1024, int capacity = 64);
+    ~InterprocessChannel();
+
+    //removes the shared memory of a channel, e.g. remainders of a crashed run
+    static void remove(string const& name);
+
+    void send(string const& message);
+
+    //returns false if the queue has not accepted the message within the timeout in ms (e.g. receiver has stopped)
+    bool send(string const& message, int timeout);
+
+    //returns none if no message or only a part of it has arrived within the timeout in ms, in the latter case the
+    //channel is out of step and should not be used any further
+    optional<string> receive(int timeout);
+
+private:
+    bool sendChunks(string const& message, optional<int> timeout);
+
+    struct Impl;
+    Impl* _impl = nullptr;
+};
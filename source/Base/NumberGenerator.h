@@ -10,7 +10,8 @@ public:
 	NumberGenerator(QObject* parent = nullptr) : QObject(parent) {}
 	virtual ~NumberGenerator() = default;
 
-	virtual void init(uint32_t arraySize = 1323781, uint16_t threadId = 0) = 0;
+	//threadId selects an independent random stream and is stored in the upper bits of the ids
+	virtual void init(uint32_t seed = 1323781, uint16_t threadId = 0) = 0;
 
 	virtual uint32_t getRandomInt() = 0;
 	virtual uint32_t getRandomInt(uint32_t range) = 0;
@@ -20,4 +21,5 @@ public:
 	virtual QByteArray getRandomArray(int length) = 0;
 
 	virtual uint64_t getId() = 0;
+	virtual uint64_t getIds(uint64_t count) = 0;	//reserves count consecutive ids and returns the first one
 };
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __CUDACC__
+#define RANDOM_FUNCTION __host__ __device__ __inline__
+#else
+#define RANDOM_FUNCTION inline
+#endif
+
+/**
+ * Counter-based random number generator (Philox4x32-10).
+ * A number is a pure function of seed, stream id and position. Hence independent streams can be created per thread
+ * or per entity without any synchronization, and host and device produce identical sequences for the same seed.
+ * Header-only so that it can be compiled by nvcc as well.
+ */
+class RandomStream
+{
+public:
+    RANDOM_FUNCTION RandomStream(uint64_t seed, uint64_t streamId, uint64_t position = 0)
+        : _seed(seed), _streamId(streamId), _position(position)
+    {}
+
+    RANDOM_FUNCTION uint64_t getPosition() const { return _position; }
+    RANDOM_FUNCTION void setPosition(uint64_t position) { _position = position; }
+
+    RANDOM_FUNCTION uint32_t getUInt()
+    {
+        auto const blockIndex = _position / 4;
+        if (!_blockValid || blockIndex != _blockIndex) {
+            generateBlock(_seed, _streamId, blockIndex, _block);
+            _blockIndex = blockIndex;
+            _blockValid = true;
+        }
+        return _block[_position++ % 4];
+    }
+
+    //uniform in [0, range)
+    RANDOM_FUNCTION uint32_t getUInt(uint32_t range) { return toRange(getUInt(), range); }
+
+    //uniform in [0, 1)
+    RANDOM_FUNCTION float getFloat() { return toFloat(getUInt()); }
+    RANDOM_FUNCTION double getDouble() { return toDouble(getUInt()); }
+
+    RANDOM_FUNCTION static uint32_t toRange(uint32_t value, uint32_t range)
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(value) * range) >> 32);
+    }
+
+    RANDOM_FUNCTION static float toFloat(uint32_t value) { return static_cast<float>(value >> 8) * (1.0f / 16777216.0f); }
+
+    RANDOM_FUNCTION static double toDouble(uint32_t value) { return static_cast<double>(value) * (1.0 / 4294967296.0); }
+
+    RANDOM_FUNCTION static uint32_t generateNumber(uint64_t seed, uint64_t streamId, uint64_t position)
+    {
+        uint32_t block[4];
+        generateBlock(seed, streamId, position / 4, block);
+        return block[position % 4];
+    }
+
+    //block i of a stream contains the numbers at positions 4i, ..., 4i+3
+    RANDOM_FUNCTION static void generateBlock(uint64_t seed, uint64_t streamId, uint64_t blockIndex, uint32_t* result)
+    {
+        uint32_t counter[4] = {static_cast<uint32_t>(blockIndex),
+                               static_cast<uint32_t>(blockIndex >> 32),
+                               static_cast<uint32_t>(streamId),
+                               static_cast<uint32_t>(streamId >> 32)};
+        uint32_t key[2] = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+        philox4x32_10(counter, key, result);
+    }
+
+    //position-addressable, hence large ranges can be split among threads
+    static void fill(uint64_t seed, uint64_t streamId, uint64_t position, uint32_t* target, size_t count)
+    {
+        size_t index = 0;
+        while (index < count && position % 4 != 0) {
+            target[index++] = generateNumber(seed, streamId, position++);
+        }
+        auto blockIndex = position / 4;
+        for (; index + 4 <= count; index += 4, ++blockIndex) {
+            generateBlock(seed, streamId, blockIndex, target + index);
+        }
+        if (index < count) {
+            uint32_t block[4];
+            generateBlock(seed, streamId, blockIndex, block);
+            for (int i = 0; index < count; ++i) {
+                target[index++] = block[i];
+            }
+        }
+    }
+
+    RANDOM_FUNCTION static void philox4x32_10(uint32_t const* counter, uint32_t const* key, uint32_t* result)
+    {
+        uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < 10; ++round) {
+            if (round > 0) {
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+            auto const product0 = static_cast<uint64_t>(0xD2511F53) * c0;
+            auto const product1 = static_cast<uint64_t>(0xCD9E8D57) * c2;
+            auto const hi0 = static_cast<uint32_t>(product0 >> 32);
+            auto const lo0 = static_cast<uint32_t>(product0);
+            auto const hi1 = static_cast<uint32_t>(product1 >> 32);
+            auto const lo1 = static_cast<uint32_t>(product1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+        }
+        result[0] = c0;
+        result[1] = c1;
+        result[2] = c2;
+        result[3] = c3;
+    }
+
+private:
+    uint64_t _seed;
+    uint64_t _streamId;
+    uint64_t _position;
+
+    uint64_t _blockIndex = 0;
+    bool _blockValid = false;
+    uint32_t _block[4];
+};
@@ -0,0 +1,311 @@
+#include <chrono>
+
+#include "TraceRecorder.h"
+#include "TaskScheduler.h"
+
+namespace
+{
+    //scheduler and queue of the current worker thread
+    thread_local TaskScheduler const* currentScheduler = nullptr;
+    thread_local int currentQueueIndex = -1;
+}
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler, CancellationToken const* cancellation)
+    : _scheduler(scheduler)
+    , _cancellation(cancellation)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    waitIntern();
+}
+
+void TaskGroup::run(std::function<void()> const& task, char const* name)
+{
+    ++_numPendingTasks;
+    _scheduler.submit(TaskScheduler::Task{task, name, this});
+}
+
+void TaskGroup::wait()
+{
+    waitIntern();
+    if (_exception) {
+        auto const exception = _exception;
+        _exception = nullptr;
+        _failed = false;
+        std::rethrow_exception(exception);
+    }
+}
+
+bool TaskGroup::isCancelled() const
+{
+    return _failed.load(std::memory_order_relaxed) || (_cancellation && _cancellation->isCancelled());
+}
+
+void TaskGroup::waitIntern()
+{
+    while (_numPendingTasks.load() > 0) {
+        if (!_scheduler.tryExecuteTask()) {
+            //the remaining tasks are executed by other threads but may spawn further tasks
+            std::unique_lock<std::mutex> lock(_mutex);
+            _finished.wait_for(lock, std::chrono::microseconds(100), [this] { return _numPendingTasks.load() == 0; });
+        }
+    }
+
+    //the last finishing task may still hold the mutex
+    std::lock_guard<std::mutex> lock(_mutex);
+}
+
+void TaskGroup::finishTask(std::exception_ptr const& exception)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (exception) {
+        if (!_exception) {
+            _exception = exception;
+        }
+        _failed = true;
+    }
+    if (--_numPendingTasks == 0) {
+        _finished.notify_all();
+    }
+}
+
+TaskScheduler& TaskScheduler::getInstance()
+{
+    //not destroyed since joining threads while a library is unloaded can block
+    static TaskScheduler* instance = new TaskScheduler();
+    return *instance;
+}
+
+TaskScheduler::TaskScheduler(int numThreads)
+{
+    startWorkers(numThreads);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    stopWorkers();
+}
+
+void TaskScheduler::setNumThreads(int numThreads)
+{
+    stopWorkers();
+    startWorkers(numThreads);
+}
+
+int TaskScheduler::getNumThreads() const
+{
+    return _numThreads;
+}
+
+void TaskScheduler::parallelFor(
+    int begin,
+    int end,
+    std::function<void(int)> const& func,
+    int grainSize,
+    CancellationToken const* cancellation,
+    char const* name)
+{
+    if (end <= begin) {
+        return;
+    }
+    auto const chunkSize = calcGrainSize(end - begin, grainSize);
+    TaskGroup group(*this, cancellation);
+    for (int chunkBegin = begin; chunkBegin < end; chunkBegin += std::min(chunkSize, end - chunkBegin)) {
+        auto const chunkEnd = chunkBegin + std::min(chunkSize, end - chunkBegin);
+        group.run(
+            [&func, chunkBegin, chunkEnd] {
+                for (int index = chunkBegin; index < chunkEnd; ++index) {
+                    func(index);
+                }
+            },
+            name);
+    }
+    group.wait();
+}
+
+void TaskScheduler::submit(Task&& task)
+{
+    auto const queueIndex = currentScheduler == this ? currentQueueIndex : static_cast<int>(_queues.size()) - 1;
+    {
+        auto& queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.emplace_back(std::move(task));
+    }
+    ++_numQueuedTasks;
+
+    //a worker which is about to sleep has either seen the new task or is already waiting
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    _wakeUp.notify_one();
+}
+
+bool TaskScheduler::tryExecuteTask()
+{
+    Task task;
+    if (!tryPopTask(task)) {
+        return false;
+    }
+    execute(task);
+    return true;
+}
+
+//a worker takes its newest task, other tasks are taken (stolen) in the order of their submission
+bool TaskScheduler::tryPopTask(Task& task)
+{
+    if (0 == _numQueuedTasks.load()) {
+        return false;
+    }
+    auto const numQueues = static_cast<int>(_queues.size());
+    auto const ownQueueIndex = currentScheduler == this ? currentQueueIndex : numQueues - 1;
+    for (int offset = 0; offset < numQueues; ++offset) {
+        auto const queueIndex = (ownQueueIndex + offset) % numQueues;
+        auto& queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        auto const isOwnWorkerQueue = 0 == offset && queueIndex != numQueues - 1;
+        if (isOwnWorkerQueue) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --_numQueuedTasks;
+        return true;
+    }
+    return false;
+}
+
+void TaskScheduler::execute(Task& task)
+{
+    std::exception_ptr exception;
+    if (!task.group->isCancelled()) {
+        try {
+#ifndef ALIEN_NO_TRACING
+            if (task.name) {
+                TraceScope scope(task.name);
+                task.func();
+            }
+            else {
+                task.func();
+            }
+#else
+            task.func();
+#endif
+        }
+        catch (...) {
+            exception = std::current_exception();
+        }
+    }
+    task.group->finishTask(exception);
+}
+
+void TaskScheduler::startWorkers(int numThreads)
+{
+    _numThreads = numThreads > 0 ? numThreads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    _stopping = false;
+    _queues.clear();
+    for (int index = 0; index < _numThreads; ++index) {
+        _queues.emplace_back(new TaskQueue());
+    }
+    for (int index = 0; index < _numThreads - 1; ++index) {
+        _workers.emplace_back(&TaskScheduler::runWorker, this, index);
+    }
+}
+
+void TaskScheduler::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+    }
+    _wakeUp.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void TaskScheduler::runWorker(int queueIndex)
+{
+    currentScheduler = this;
+    currentQueueIndex = queueIndex;
+    TRACE_THREAD_NAME("TaskScheduler worker");
+
+    while (true) {
+        if (tryExecuteTask()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _wakeUp.wait(lock, [this] { return _stopping || _numQueuedTasks.load() > 0; });
+        if (_stopping) {
+            return;
+        }
+    }
+}
+
+int TaskScheduler::calcGrainSize(int numIndices, int grainSize) const
+{
+    if (grainSize > 0) {
+        return grainSize;
+    }
+    return std::max(1, numIndices / (4 * _numThreads));
+}
+
+//enough chunks for load balancing on common machines
+int TaskScheduler::calcReductionGrainSize(int numIndices, int grainSize)
+{
+    if (grainSize > 0) {
+        return grainSize;
+    }
+    return std::max(1, numIndices / 256);
+}
+
+int TaskGraph::addTask(std::function<void()> const& task, vector<int> const& dependencies, char const* name)
+{
+    auto const id = static_cast<int>(_nodes.size());
+    Node node;
+    node.task = task;
+    node.name = name;
+    node.numDependencies = static_cast<int>(dependencies.size());
+    _nodes.emplace_back(node);
+    for (int dependency : dependencies) {
+        CHECK(dependency >= 0 && dependency < id);
+        _nodes[dependency].successors.emplace_back(id);
+    }
+    return id;
+}
+
+void TaskGraph::run(TaskScheduler& scheduler, CancellationToken const* cancellation) const
+{
+    vector<std::atomic<int>> numRemainingDependencies(_nodes.size());
+    for (int index = 0; index < static_cast<int>(_nodes.size()); ++index) {
+        numRemainingDependencies[index] = _nodes[index].numDependencies;
+    }
+
+    TaskGroup group(scheduler, cancellation);
+    std::function<void(int)> runNode = [&](int index) {
+        group.run(
+            [&, index] {
+                _nodes[index].task();
+                for (int successor : _nodes[index].successors) {
+                    if (0 == --numRemainingDependencies[successor]) {
+                        runNode(successor);
+                    }
+                }
+            },
+            _nodes[index].name);
+    };
+    for (int index = 0; index < static_cast<int>(_nodes.size()); ++index) {
+        if (0 == _nodes[index].numDependencies) {
+            runNode(index);
+        }
+    }
+    group.wait();
+}
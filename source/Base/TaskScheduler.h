@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Definitions.h"
+
+class TaskScheduler;
+
+class BASE_EXPORT CancellationToken
+{
+public:
+    void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return _cancelled.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> _cancelled{false};
+};
+
+/**
+ * Tasks which are waited for together. Tasks which have not started yet are skipped after the group has been
+ * cancelled via its token or after a task has thrown an exception. Tasks may run further tasks in their own group.
+ */
+class BASE_EXPORT TaskGroup
+{
+public:
+    TaskGroup(TaskScheduler& scheduler, CancellationToken const* cancellation = nullptr);
+    ~TaskGroup();   //waits for the tasks but discards their exceptions
+
+    TaskGroup(TaskGroup const&) = delete;
+    void operator=(TaskGroup const&) = delete;
+
+    //name has to be a string literal, tasks with a name are recorded by the TraceRecorder
+    void run(std::function<void()> const& task, char const* name = nullptr);
+
+    //executes pending tasks of the scheduler while waiting and rethrows the first exception of the tasks
+    void wait();
+
+    bool isCancelled() const;
+
+private:
+    friend class TaskScheduler;
+    void waitIntern();
+    void finishTask(std::exception_ptr const& exception);
+
+    TaskScheduler& _scheduler;
+    CancellationToken const* _cancellation = nullptr;
+    std::atomic<bool> _failed{false};
+    std::atomic<int> _numPendingTasks{0};
+    std::mutex _mutex;
+    std::condition_variable _finished;
+    std::exception_ptr _exception;
+};
+
+/**
+ * Work-stealing thread pool for the host code. Each worker thread has its own task queue; it executes its newest tasks
+ * first and steals the oldest tasks of other workers when its queue is empty. Threads which wait for a task group help
+ * executing tasks, hence parallel loops can be nested.
+ * The application shares the instance returned by getInstance(). It is the single place where the number of host
+ * threads is configured.
+ */
+class BASE_EXPORT TaskScheduler
+{
+public:
+    static TaskScheduler& getInstance();
+
+    TaskScheduler(int numThreads = 0);  //0 = number of hardware threads, the waiting thread counts as one
+    ~TaskScheduler();
+
+    TaskScheduler(TaskScheduler const&) = delete;
+    void operator=(TaskScheduler const&) = delete;
+
+    //must not be called while tasks are running
+    void setNumThreads(int numThreads);
+    int getNumThreads() const;
+
+    //calls func for each index of [begin, end) in chunks of grainSize indices (0 = automatic)
+    void parallelFor(
+        int begin,
+        int end,
+        std::function<void(int)> const& func,
+        int grainSize = 0,
+        CancellationToken const* cancellation = nullptr,
+        char const* name = nullptr);
+
+    //func(T& partialResult, int index) accumulates into the partial result of a chunk, the partial results are
+    //combined in the order of their chunks so that the result does not depend on the number of threads
+    //(the automatic grain size only depends on the number of indices for this reason)
+    template <typename T, typename Func, typename CombineFunc>
+    T parallelReduce(
+        int begin,
+        int end,
+        T const& identity,
+        Func const& func,
+        CombineFunc const& combine,
+        int grainSize = 0,
+        char const* name = nullptr);
+
+private:
+    friend class TaskGroup;
+
+    struct Task
+    {
+        std::function<void()> func;
+        char const* name = nullptr;
+        TaskGroup* group = nullptr;
+    };
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void submit(Task&& task);
+    bool tryExecuteTask();
+    bool tryPopTask(Task& task);
+    void execute(Task& task);
+
+    void startWorkers(int numThreads);
+    void stopWorkers();
+    void runWorker(int queueIndex);
+
+    int calcGrainSize(int numIndices, int grainSize) const;
+    static int calcReductionGrainSize(int numIndices, int grainSize);
+
+    int _numThreads = 1;
+    vector<std::unique_ptr<TaskQueue>> _queues;     //last queue is used by threads outside the pool
+    vector<std::thread> _workers;
+    std::atomic<int> _numQueuedTasks{0};
+
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeUp;
+    bool _stopping = false;
+};
+
+/**
+ * Tasks with dependencies which are executed by a scheduler as soon as all their dependencies have finished.
+ */
+class BASE_EXPORT TaskGraph
+{
+public:
+    //dependencies are ids of previously added tasks, returns the id of the new task
+    int addTask(std::function<void()> const& task, vector<int> const& dependencies = {}, char const* name = nullptr);
+
+    //rethrows the first exception of the tasks, the tasks depending on a failed task are not executed
+    void run(TaskScheduler& scheduler, CancellationToken const* cancellation = nullptr) const;
+
+private:
+    struct Node
+    {
+        std::function<void()> task;
+        char const* name = nullptr;
+        int numDependencies = 0;
+        vector<int> successors;
+    };
+    vector<Node> _nodes;
+};
+
+template <typename T, typename Func, typename CombineFunc>
+T TaskScheduler::parallelReduce(
+    int begin,
+    int end,
+    T const& identity,
+    Func const& func,
+    CombineFunc const& combine,
+    int grainSize,
+    char const* name)
+{
+    if (end <= begin) {
+        return identity;
+    }
+    auto const chunkSize = calcReductionGrainSize(end - begin, grainSize);
+    auto const numChunks = (end - begin + chunkSize - 1) / chunkSize;
+    vector<T> partialResults(numChunks, identity);
+    parallelFor(
+        0,
+        numChunks,
+        [&](int chunkIndex) {
+            auto const chunkEnd = std::min(end, begin + (chunkIndex + 1) * chunkSize);
+            for (int index = begin + chunkIndex * chunkSize; index < chunkEnd; ++index) {
+                func(partialResults[chunkIndex], index);
+            }
+        },
+        1,
+        nullptr,
+        name);
+
+    auto result = identity;
+    for (auto const& partialResult : partialResults) {
+        result = combine(result, partialResult);
+    }
+    return result;
+}
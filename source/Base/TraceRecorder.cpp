@@ -0,0 +1,179 @@
+#include <fstream>
+#include <sstream>
+
+#include "TraceRecorder.h"
+
+namespace
+{
+    void writeEscaped(std::ostream& stream, char const* text)
+    {
+        stream << '"';
+        for (; *text; ++text) {
+            auto const c = *text;
+            if ('"' == c || '\\' == c) {
+                stream << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+                stream << ' ';
+            }
+            else {
+                stream << c;
+            }
+        }
+        stream << '"';
+    }
+}
+
+TraceRecorder& TraceRecorder::getInstance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::TraceRecorder()
+    : _enabled(false)
+    , _startTime(std::chrono::steady_clock::now())
+{
+}
+
+void TraceRecorder::setEnabled(bool enabled)
+{
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void TraceRecorder::setThreadName(char const* name)
+{
+    auto& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.threadName = name;
+}
+
+void TraceRecorder::beginEvent(char const* name)
+{
+    record(EventType::Begin, name, 0);
+}
+
+void TraceRecorder::endEvent()
+{
+    record(EventType::End, nullptr, 0);
+}
+
+void TraceRecorder::counterEvent(char const* name, double value)
+{
+    record(EventType::Counter, name, value);
+}
+
+string TraceRecorder::exportToJson() const
+{
+    std::stringstream stream;
+    stream.precision(15);
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool firstEvent = true;
+    auto separate = [&] {
+        if (!firstEvent) {
+            stream << ",\n";
+        }
+        firstEvent = false;
+    };
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto const& buffer : _threadBuffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        //threads without events (e.g. idle pool threads) are omitted
+        if (0 == buffer->numRecordedEvents) {
+            continue;
+        }
+        if (buffer->threadName) {
+            separate();
+            stream << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadId
+                   << ",\"args\":{\"name\":";
+            writeEscaped(stream, buffer->threadName);
+            stream << "}}";
+        }
+
+        auto const numEvents = std::min<uint64_t>(buffer->numRecordedEvents, EventsPerThread);
+        auto const firstIndex = buffer->numRecordedEvents - numEvents;
+        int depth = 0;
+        for (auto index = firstIndex; index < buffer->numRecordedEvents; ++index) {
+            auto const& event = buffer->events[index % EventsPerThread];
+
+            //end events whose begin events have been overwritten are omitted
+            if (EventType::End == event.type) {
+                if (0 == depth) {
+                    continue;
+                }
+                --depth;
+            }
+            if (EventType::Begin == event.type) {
+                ++depth;
+            }
+
+            separate();
+            stream << "{\"pid\":1,\"tid\":" << buffer->threadId
+                   << ",\"ts\":" << static_cast<double>(event.timestamp) / 1000;
+            switch (event.type) {
+            case EventType::Begin:
+                stream << ",\"ph\":\"B\",\"name\":";
+                writeEscaped(stream, event.name);
+                break;
+            case EventType::End:
+                stream << ",\"ph\":\"E\"";
+                break;
+            case EventType::Counter:
+                stream << ",\"ph\":\"C\",\"name\":";
+                writeEscaped(stream, event.name);
+                stream << ",\"args\":{\"value\":" << event.value << "}";
+                break;
+            }
+            stream << "}";
+        }
+    }
+    stream << "]}";
+    return stream.str();
+}
+
+bool TraceRecorder::exportToFile(string const& filename) const
+{
+    std::ofstream file(filename, std::ios::out | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    file << exportToJson();
+    return static_cast<bool>(file);
+}
+
+void TraceRecorder::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto const& buffer : _threadBuffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->numRecordedEvents = 0;
+    }
+}
+
+TraceRecorder::ThreadBuffer& TraceRecorder::getThreadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> threadBuffer;
+    if (!threadBuffer) {
+        threadBuffer = std::make_shared<ThreadBuffer>();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        threadBuffer->threadId = static_cast<int>(_threadBuffers.size()) + 1;
+        _threadBuffers.emplace_back(threadBuffer);
+    }
+    return *threadBuffer;
+}
+
+void TraceRecorder::record(EventType type, char const* name, double value)
+{
+    auto const timestamp =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _startTime).count();
+
+    auto& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.empty()) {
+        buffer.events.resize(EventsPerThread);  //allocated on demand since many threads are only named
+    }
+    buffer.events[buffer.numRecordedEvents % EventsPerThread] = {type, name, timestamp, value};
+    ++buffer.numRecordedEvents;
+}
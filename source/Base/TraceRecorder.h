@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include "Definitions.h"
+
+/**
+ * Timeline of begin/end and counter events of all threads which can be exported in the Chrome trace-event format
+ * (viewable in chrome://tracing or Perfetto). Each thread records into its own ring buffer of EventsPerThread
+ * events, i.e. the oldest events are overwritten. Recording is switched on at runtime by setEnabled(); when it is
+ * switched off, an event costs a single atomic load. Defining ALIEN_NO_TRACING removes all instrumentation at
+ * compile time.
+ *
+ * Use the macros below instead of calling the recorder directly. Names have to be string literals since only the
+ * pointers are stored.
+ */
+class BASE_EXPORT TraceRecorder
+{
+public:
+    static TraceRecorder& getInstance();
+
+    TraceRecorder(TraceRecorder const&) = delete;
+    void operator=(TraceRecorder const&) = delete;
+
+    static int const EventsPerThread = 1 << 16;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    void setThreadName(char const* name);
+    void beginEvent(char const* name);
+    void endEvent();
+    void counterEvent(char const* name, double value);
+
+    string exportToJson() const;
+    bool exportToFile(string const& filename) const;
+    void clear();
+
+private:
+    TraceRecorder();
+    ~TraceRecorder() = default;
+
+    enum class EventType
+    {
+        Begin,
+        End,
+        Counter
+    };
+    struct Event
+    {
+        EventType type;
+        char const* name;
+        int64_t timestamp;  //in nanoseconds since the construction of the recorder
+        double value;
+    };
+    struct ThreadBuffer
+    {
+        int threadId = 0;
+        char const* threadName = nullptr;
+        vector<Event> events;
+        uint64_t numRecordedEvents = 0;
+        std::mutex mutex;   //only contended during export and clear
+    };
+
+    ThreadBuffer& getThreadBuffer();
+    void record(EventType type, char const* name, double value);
+
+    std::atomic<bool> _enabled;
+    std::chrono::steady_clock::time_point _startTime;
+
+    mutable std::mutex _mutex;
+    vector<std::shared_ptr<ThreadBuffer>> _threadBuffers;   //buffers are kept after their threads have finished
+};
+
+class TraceScope
+{
+public:
+    TraceScope(char const* name)
+        : _recording(TraceRecorder::getInstance().isEnabled())
+    {
+        if (_recording) {
+            TraceRecorder::getInstance().beginEvent(name);
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (_recording) {
+            TraceRecorder::getInstance().endEvent();
+        }
+    }
+
+    TraceScope(TraceScope const&) = delete;
+    void operator=(TraceScope const&) = delete;
+
+private:
+    bool _recording;
+};
+
+#ifdef ALIEN_NO_TRACING
+
+#define TRACE_SCOPE(name)
+#define TRACE_COUNTER(name, value)
+#define TRACE_THREAD_NAME(name)
+
+#else
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_COUNTER(name, value) \
+    do { \
+        if (TraceRecorder::getInstance().isEnabled()) { \
+            TraceRecorder::getInstance().counterEvent(name, static_cast<double>(value)); \
+        } \
+    } while (false)
+#define TRACE_THREAD_NAME(name) TraceRecorder::getInstance().setThreadName(name)
+
+#endif
@@ -1,41 +1,49 @@
 #include <sstream>
 #include <thread>
+
+#include "Base/RandomStream.h"
+
 #include "NumberGeneratorImpl.h"
 
+namespace
+{
+	int const BufferSize = 1024;
+}
+
 NumberGeneratorImpl::NumberGeneratorImpl(QObject * parent)
 	: NumberGenerator(parent)
 {
 }
 
-void NumberGeneratorImpl::init(uint32_t arraySize, uint16_t threadId)
+void NumberGeneratorImpl::init(uint32_t seed, uint16_t threadId)
 {
 	_threadId = static_cast<uint64_t>(threadId) << 48;
-	_arrayOfRandomNumbers.clear();
 	_runningNumber = 0;
-	for (uint32_t i = 0; i < arraySize; ++i) {
-		_arrayOfRandomNumbers.push_back(qrand());
-	}
+	_seed = seed;
+	_position = 0;
+	_buffer.resize(BufferSize);
+	_index = BufferSize;
 }
 
 uint32_t NumberGeneratorImpl::getRandomInt()
 {
-	return getNumberFromArray();
+	return getNumberFromBuffer();
 }
 
 uint32_t NumberGeneratorImpl::getRandomInt(uint32_t range)
 {
-	return getNumberFromArray() % range;
+	return getNumberFromBuffer() % range;
 }
 
 uint32_t NumberGeneratorImpl::getRandomInt(uint32_t min, uint32_t max)
 {
     auto delta = max - min + 1;
-    return min + (getNumberFromArray() % delta);
+    return min + (getNumberFromBuffer() % delta);
 }
 
 uint32_t NumberGeneratorImpl::getLargeRandomInt(uint32_t range)
 {
-	return static_cast<uint32_t>((static_cast<double>(range) * static_cast<double>(getNumberFromArray()) / RAND_MAX));
+	return RandomStream::toRange(getNumberFromBuffer(), range);
 }
 
 double NumberGeneratorImpl::getRandomReal(double min, double max)
@@ -45,7 +53,7 @@ double NumberGeneratorImpl::getRandomReal(double min, double max)
 
 double NumberGeneratorImpl::getRandomReal()
 {
-	return static_cast<double>(getNumberFromArray()) / RAND_MAX;
+	return RandomStream::toDouble(getNumberFromBuffer());
 }
 
 QByteArray NumberGeneratorImpl::getRandomArray(int length)
@@ -63,8 +71,19 @@ uint64_t NumberGeneratorImpl::getId()
 	return _threadId | ++_runningNumber;
 }
 
-uint32_t NumberGeneratorImpl::getNumberFromArray()
+uint64_t NumberGeneratorImpl::getIds(uint64_t count)
 {
-	_index = (_index + 1) % _arrayOfRandomNumbers.size();
-	return _arrayOfRandomNumbers[_index];
+	auto const result = _threadId | (_runningNumber + 1);
+	_runningNumber += count;
+	return result;
+}
+
+uint32_t NumberGeneratorImpl::getNumberFromBuffer()
+{
+	if (_index == static_cast<int>(_buffer.size())) {
+		RandomStream::fill(_seed, _threadId >> 48, _position, _buffer.data(), _buffer.size());
+		_position += _buffer.size();
+		_index = 0;
+	}
+	return _buffer[_index++];
 }
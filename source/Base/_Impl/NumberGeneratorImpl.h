@@ -9,7 +9,7 @@ public:
 	NumberGeneratorImpl(QObject* parent = nullptr);
 	virtual ~NumberGeneratorImpl() = default;
 
-	virtual void init(uint32_t arraySize, uint16_t threadId) override;
+	virtual void init(uint32_t seed, uint16_t threadId) override;
 
 	virtual uint32_t getRandomInt() override;
 	virtual uint32_t getRandomInt(uint32_t range) override;
@@ -19,13 +19,16 @@ public:
 	virtual QByteArray getRandomArray(int length) override;
 
 	virtual uint64_t getId() override;
+	virtual uint64_t getIds(uint64_t count) override;
 
 private:
     uint32_t getLargeRandomInt(uint32_t range);
-    quint32 getNumberFromArray();
+    quint32 getNumberFromBuffer();
 
+	uint32_t _seed = 0;
+	uint64_t _position = 0;
 	int _index = 0;
-	vector<uint32_t> _arrayOfRandomNumbers;
+	vector<uint32_t> _buffer;
 	uint64_t _runningNumber = 0;
 	uint64_t _threadId = 0;
 };
@@ -133,6 +133,8 @@ void ActionController::init(
 	connect(actions->actionGridMultiplier, &QAction::triggered, this, &ActionController::onGridMultiplier);
 
     connect(actions->actionMostFrequentCluster, &QAction::triggered, this, &ActionController::onMostFrequentCluster);
+    connect(actions->actionRecordTrace, &QAction::toggled, this, &ActionController::onToggleTraceRecording);
+    connect(actions->actionExportTrace, &QAction::triggered, this, &ActionController::onExportTrace);
 
 	connect(actions->actionAbout, &QAction::triggered, this, &ActionController::onShowAbout);
 	connect(actions->actionDocumentation, &QAction::triggered, this, &ActionController::onShowDocumentation);
@@ -450,74 +452,29 @@ void ActionController::onDeleteCollection()
 	}, UpdateDescription::All);
 }
 
-namespace
-{
-	void modifyDescription(DataDescription& data, QVector2D const& posDelta, optional<double> const& velocityXDelta
-		, optional<double> const& velocityYDelta, optional<double> const& angularVelocityDelta)
-	{
-		if (data.clusters) {
-			for (auto& cluster : data.clusters.get()) {
-				*cluster.pos += posDelta;
-				if (velocityXDelta) {
-					cluster.vel->setX(cluster.vel->x() + *velocityXDelta);
-				}
-				if (velocityYDelta) {
-					cluster.vel->setY(cluster.vel->y() + *velocityYDelta);
-				}
-				if (angularVelocityDelta) {
-					*cluster.angularVel += *angularVelocityDelta;
-				}
-				if (cluster.cells) {
-					for (auto& cell : cluster.cells.get()) {
-						*cell.pos += posDelta;
-					}
-				}
-			}
-		}
-		if (data.particles) {
-			for (auto& particle : data.particles.get()) {
-				*particle.pos += posDelta;
-				if (velocityXDelta) {
-					particle.vel->setX(particle.vel->x() + *velocityXDelta);
-				}
-				if (velocityYDelta) {
-					particle.vel->setY(particle.vel->y() + *velocityYDelta);
-				}
-			}
-		}
-	}
-}
-
 void ActionController::onRandomMultiplier()
 {
 	RandomMultiplierDialog dialog;
 	if (dialog.exec()) {
 		DataDescription data = _repository->getExtendedSelection();
 		IntVector2D universeSize = _mainController->getSimulationConfig()->universeSize;
-		vector<DataRepository::DataAndAngle> addedData;
-		for (int i = 0; i < dialog.getNumberOfCopies(); ++i) {
-			DataDescription dataCopied = data;
-			QVector2D posDelta(_numberGenerator->getRandomReal(0.0, universeSize.x), _numberGenerator->getRandomReal(0.0, universeSize.y));
-			optional<double> velocityX;
-			optional<double> velocityY;
-			optional<double> angle;
-			optional<double> angularVelocity;
+		vector<DescriptionReplicator::Transform> transforms(dialog.getNumberOfCopies());
+		for (auto& transform : transforms) {
+			transform.posDelta = QVector2D(_numberGenerator->getRandomReal(0.0, universeSize.x), _numberGenerator->getRandomReal(0.0, universeSize.y));
 			if (dialog.isChangeVelX()) {
-				velocityX = _numberGenerator->getRandomReal(dialog.getVelXMin(), dialog.getVelXMax());
+				transform.velDelta.setX(_numberGenerator->getRandomReal(dialog.getVelXMin(), dialog.getVelXMax()));
 			}
 			if (dialog.isChangeVelY()) {
-				velocityY = _numberGenerator->getRandomReal(dialog.getVelYMin(), dialog.getVelYMax());
+				transform.velDelta.setY(_numberGenerator->getRandomReal(dialog.getVelYMin(), dialog.getVelYMax()));
 			}
 			if (dialog.isChangeAngle()) {
-				angle = _numberGenerator->getRandomReal(dialog.getAngleMin(), dialog.getAngleMax());
+				transform.angle = _numberGenerator->getRandomReal(dialog.getAngleMin(), dialog.getAngleMax());
 			}
 			if (dialog.isChangeAngVel()) {
-				angularVelocity = _numberGenerator->getRandomReal(dialog.getAngVelMin(), dialog.getAngVelMax());
+				transform.angularVelDelta = _numberGenerator->getRandomReal(dialog.getAngVelMin(), dialog.getAngVelMax());
 			}
-			modifyDescription(dataCopied, posDelta, velocityX, velocityY, angularVelocity);
-			addedData.emplace_back(DataRepository::DataAndAngle{ dataCopied, angle });
 		}
-		_repository->addDataAtFixedPosition(addedData);
+		_repository->addReplicas(data, transforms);
 		Q_EMIT _notifier->notifyDataRepositoryChanged({
 			Receiver::DataEditor,
 			Receiver::Simulation,
@@ -535,38 +492,31 @@ void ActionController::onGridMultiplier()
 	if (dialog.exec()) {
 		QVector2D initialDelta(dialog.getInitialPosX(), dialog.getInitialPosY());
 		initialDelta -= center;
-		vector<DataRepository::DataAndAngle> addedData;
+		vector<DescriptionReplicator::Transform> transforms;
+		transforms.reserve(dialog.getHorizontalNumber() * dialog.getVerticalNumber());
 		for (int i = 0; i < dialog.getHorizontalNumber(); ++i) {
 			for (int j = 0; j < dialog.getVerticalNumber(); ++j) {
 				if (i == 0 && j == 0 && initialDelta.lengthSquared() < FLOATINGPOINT_MEDIUM_PRECISION) {
 					continue;
 				}
-				DataDescription dataCopied = data;
-				optional<double> velocityX;
-				optional<double> velocityY;
-				optional<double> angle;
-				optional<double> angularVelocity;
+				DescriptionReplicator::Transform transform;
 				if (dialog.isChangeAngle()) {
-					angle = dialog.getInitialAngle() + i*dialog.getHorizontalAngleIncrement() + j*dialog.getVerticalAngleIncrement();
+					transform.angle = dialog.getInitialAngle() + i*dialog.getHorizontalAngleIncrement() + j*dialog.getVerticalAngleIncrement();
 				}
 				if (dialog.isChangeVelocityX()) {
-					velocityX = dialog.getInitialVelX() + i*dialog.getHorizontalVelocityXIncrement() + j*dialog.getVerticalVelocityXIncrement();
+					transform.velDelta.setX(dialog.getInitialVelX() + i*dialog.getHorizontalVelocityXIncrement() + j*dialog.getVerticalVelocityXIncrement());
 				}
 				if (dialog.isChangeVelocityY()) {
-					velocityY = dialog.getInitialVelY() + j*dialog.getHorizontalVelocityYIncrement() + j*dialog.getVerticalVelocityYIncrement();
+					transform.velDelta.setY(dialog.getInitialVelY() + j*dialog.getHorizontalVelocityYIncrement() + j*dialog.getVerticalVelocityYIncrement());
 				}
 				if (dialog.isChangeAngularVelocity()) {
-					angularVelocity = dialog.getInitialAngVel() + i*dialog.getHorizontalAngularVelocityIncrement() + j*dialog.getVerticalAngularVelocityIncrement();
+					transform.angularVelDelta = dialog.getInitialAngVel() + i*dialog.getHorizontalAngularVelocityIncrement() + j*dialog.getVerticalAngularVelocityIncrement();
 				}
-
-				QVector2D posDelta(i*dialog.getHorizontalInterval(), j*dialog.getVerticalInterval());
-				posDelta += initialDelta;
-
-				modifyDescription(dataCopied, posDelta, velocityX, velocityY, angularVelocity);
-				addedData.emplace_back(DataRepository::DataAndAngle{ dataCopied, angle });
+				transform.posDelta = QVector2D(i*dialog.getHorizontalInterval(), j*dialog.getVerticalInterval()) + initialDelta;
+				transforms.emplace_back(transform);
 			}
 		}
-		_repository->addDataAtFixedPosition(addedData);
+		_repository->addReplicas(data, transforms);
 		Q_EMIT _notifier->notifyDataRepositoryChanged({
 			Receiver::DataEditor,
 			Receiver::Simulation,
@@ -581,6 +531,22 @@ void ActionController::onMostFrequentCluster()
     _mainController->onAddMostFrequentClusterToSimulation();
 }
 
+void ActionController::onToggleTraceRecording(bool toggled)
+{
+    _mainController->onToggleTraceRecording(toggled);
+}
+
+void ActionController::onExportTrace()
+{
+    QString filename = QFileDialog::getSaveFileName(_mainView, "Export Trace", "", "Chrome Trace (*.json)");
+    if (!filename.isEmpty()) {
+        if (!_mainController->onExportTrace(filename.toStdString())) {
+            QMessageBox msgBox(QMessageBox::Critical, "Error", "An error occurred. The trace could not be exported.");
+            msgBox.exec();
+        }
+    }
+}
+
 void ActionController::onDeleteEntity()
 {
 	onDeleteSelection();
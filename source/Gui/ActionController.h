@@ -68,6 +68,8 @@ private:
 	Q_SLOT void onGridMultiplier();
 
     Q_SLOT void onMostFrequentCluster();
+    Q_SLOT void onToggleTraceRecording(bool toggled);
+    Q_SLOT void onExportTrace();
 
 	Q_SLOT void onShowAbout();
 	Q_SLOT void onShowDocumentation(bool show);
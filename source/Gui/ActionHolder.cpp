@@ -256,6 +256,12 @@ ActionHolder::ActionHolder(QObject* parent) : QObject(parent)
 
     actionMostFrequentCluster = new QAction("Most frequent active cluster", this);
     actionMostFrequentCluster->setEnabled(true);
+    actionRecordTrace = new QAction("Record trace", this);
+    actionRecordTrace->setEnabled(true);
+    actionRecordTrace->setCheckable(true);
+    actionRecordTrace->setChecked(false);
+    actionExportTrace = new QAction("Export trace", this);
+    actionExportTrace->setEnabled(true);
 
 	actionAbout = new QAction("About artificial life environment (alien)", this);
 	actionAbout->setEnabled(true);
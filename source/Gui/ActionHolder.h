@@ -64,6 +64,8 @@ public:
 	QAction* actionGridMultiplier = nullptr;
 
     QAction* actionMostFrequentCluster = nullptr;
+    QAction* actionRecordTrace = nullptr;
+    QAction* actionExportTrace = nullptr;
 
 	QAction* actionAbout = nullptr;
 	QAction* actionDocumentation = nullptr;
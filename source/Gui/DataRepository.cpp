@@ -1,6 +1,7 @@
 #include <QMatrix4x4>
 
 #include "Base/NumberGenerator.h"
+#include "Base/TraceRecorder.h"
 
 #include "ModelBasic/SimulationAccess.h"
 #include "ModelBasic/SimulationContext.h"
@@ -201,37 +202,23 @@ namespace
 	}
 }
 
-void DataRepository::addDataAtFixedPosition(vector<DataAndAngle> dataAndAngles)
-{
-	for (auto & dataAndAngle : dataAndAngles) {
-		auto & data = dataAndAngle.data;
-		auto & rotationAngel = dataAndAngle.angle;
-		if (rotationAngel) {
-			int numClusters = data.clusters.is_initialized() ? data.clusters->size() : 0;
-			int numParticle = data.particles.is_initialized() ? data.particles->size() : 0;
-			auto clusterResolver = [&data](int index) -> ClusterDescription& {
-				return data.clusters->at(index);
-			};
-			auto particleResolver = [&data](int index) -> ParticleDescription& {
-				return data.particles->at(index);
-			};
-			rotate(*dataAndAngle.angle, numClusters, numParticle, clusterResolver, particleResolver);
-		}
-
-		if (data.clusters) {
-			for (auto& cluster : *data.clusters) {
-				cluster.id = 0;
-				_descHelper->makeValid(cluster);
-				_data.addCluster(cluster);
-			}
+void DataRepository::addReplicas(DataDescription const& templateData
+	, vector<DescriptionReplicator::Transform> const& transforms)
+{
+	auto replicas = DescriptionReplicator(_numberGenerator).replicate(templateData, transforms);
+	if (replicas.clusters) {
+		if (!_data.clusters) {
+			_data.clusters = vector<ClusterDescription>();
 		}
-		if (data.particles) {
-			for (auto& particle : *data.particles) {
-				particle.id = 0;
-				_descHelper->makeValid(particle);
-				_data.addParticle(particle);
-			}
+		_data.clusters->insert(_data.clusters->end()
+			, std::make_move_iterator(replicas.clusters->begin()), std::make_move_iterator(replicas.clusters->end()));
+	}
+	if (replicas.particles) {
+		if (!_data.particles) {
+			_data.particles = vector<ParticleDescription>();
 		}
+		_data.particles->insert(_data.particles->end()
+			, std::make_move_iterator(replicas.particles->begin()), std::make_move_iterator(replicas.particles->end()));
 	}
 	_navi.update(_data);
 }
@@ -250,7 +237,7 @@ void DataRepository::addRandomParticles(double totalEnergy, double maxEnergyPerP
 		remainingEnergy -= particleEnergy;
 	}
 
-	addDataAtFixedPosition({ { data, optional<double>() } });
+	addReplicas(data, { DescriptionReplicator::Transform() });
 }
 
 namespace
@@ -387,6 +374,7 @@ bool DataRepository::isParticlePresent(uint64_t particleId)
 
 void DataRepository::dataFromSimulationAvailable()
 {
+	TRACE_SCOPE("DataRepository::dataFromSimulationAvailable");
 	updateInternals(_access->retrieveData());
 
 	Q_EMIT _notifier->notifyDataRepositoryChanged({ Receiver::DataEditor, Receiver::VisualEditor, Receiver::ActionController }, UpdateDescription::All);
@@ -397,6 +385,7 @@ void DataRepository::sendDataChangesToSimulation(set<Receiver> const& targets)
 	if (targets.find(Receiver::Simulation) == targets.end()) {
 		return;
 	}
+	TRACE_SCOPE("DataRepository::sendDataChangesToSimulation");
 	DataChangeDescription delta(_unchangedData, _data);
 	_access->updateData(delta);
 	_unchangedData = _data;
@@ -615,6 +604,7 @@ void DataRepository::updateAfterCellReconnections()
 
 void DataRepository::updateInternals(DataDescription const &data)
 {
+	TRACE_SCOPE("DataRepository::updateInternals");
 	_data = data;
 	_unchangedData = _data;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ModelBasic/Descriptions.h"
+#include "ModelBasic/DescriptionReplicator.h"
 
 #include "Gui/Definitions.h"
 
@@ -28,11 +29,7 @@ public:
 	virtual void addAndSelectCell(QVector2D const& posDelta);
 	virtual void addAndSelectParticle(QVector2D const& posDelta);
 	virtual void addAndSelectData(DataDescription data, QVector2D const& posDelta);
-	struct DataAndAngle {
-		DataDescription data;
-		optional<double> angle;
-	};
-	virtual void addDataAtFixedPosition(vector<DataAndAngle> dataAndAngles);
+	virtual void addReplicas(DataDescription const& templateData, vector<DescriptionReplicator::Transform> const& transforms);
 	virtual void addRandomParticles(double totalEnergy, double maxEnergyPerParticle);
 	virtual void deleteSelection();
 	virtual void deleteExtendedSelection();
@@ -17,18 +17,35 @@ ImageSectionItem::~ImageSectionItem()
 
 QImagePtr ImageSectionItem::getImageOfVisibleRect()
 {
+    auto const viewportRect = _viewport->getRect();
+    IntVector2D upperLeft{ std::max(0, static_cast<int>(viewportRect.x())), std::max(0, static_cast<int>(viewportRect.y())) };
+    IntVector2D lowerRight{
+        std::min(static_cast<int>(_boundingRect.width()), static_cast<int>(viewportRect.x() + viewportRect.width())) - 1,
+        std::min(static_cast<int>(_boundingRect.height()), static_cast<int>(viewportRect.y() + viewportRect.height())) - 1 };
+    lowerRight.x = std::max(upperLeft.x, lowerRight.x);
+    lowerRight.y = std::max(upperLeft.y, lowerRight.y);
+    _rectOfImage = { upperLeft, lowerRight };
+
+    //zoomed-out views are rendered with the resolution of the screen
+    auto const scale = std::min(1.0, static_cast<double>(_viewport->getZoomFactor()));
+    IntVector2D imageSize{
+        std::max(1, static_cast<int>((lowerRight.x - upperLeft.x + 1) * scale)),
+        std::max(1, static_cast<int>((lowerRight.y - upperLeft.y + 1) * scale)) };
+
     //resize image?
-    IntVector2D viewportSize{ static_cast<int>(_viewport->getRect().width()), static_cast<int>(_viewport->getRect().height()) };
-    viewportSize.x = std::min(static_cast<int>(_boundingRect.width()), viewportSize.x);
-    viewportSize.y = std::min(static_cast<int>(_boundingRect.height()), viewportSize.y);
-    if (_imageOfVisibleRect->width() != viewportSize.x || _imageOfVisibleRect->height() != viewportSize.y) {
-        _imageOfVisibleRect = boost::make_shared<QImage>(viewportSize.x, viewportSize.y, QImage::Format_ARGB32);
+    if (_imageOfVisibleRect->width() != imageSize.x || _imageOfVisibleRect->height() != imageSize.y) {
+        _imageOfVisibleRect = boost::make_shared<QImage>(imageSize.x, imageSize.y, QImage::Format_ARGB32);
         _imageOfVisibleRect->fill(QColor(0, 0, 0));
     }
 
     return _imageOfVisibleRect;
 }
 
+IntRect ImageSectionItem::getRectOfImage() const
+{
+    return _rectOfImage;
+}
+
 QRectF ImageSectionItem::boundingRect() const
 {
     return _boundingRect;
@@ -36,13 +53,13 @@ QRectF ImageSectionItem::boundingRect() const
 
 void ImageSectionItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget /*= Q_NULLPTR*/)
 {
-    auto const viewportRect = _viewport->getRect();
-
     std::lock_guard<std::mutex> lock(_mutex);
 
-    painter->drawImage(
-        std::max(0.0f, static_cast<float>(viewportRect.x())),
-        std::max(0.0f, static_cast<float>(viewportRect.y())),
-        *_imageOfVisibleRect);
+    QRectF const target(
+        _rectOfImage.p1.x,
+        _rectOfImage.p1.y,
+        _rectOfImage.p2.x - _rectOfImage.p1.x + 1,
+        _rectOfImage.p2.y - _rectOfImage.p1.y + 1);
+    painter->drawImage(target, *_imageOfVisibleRect);
 }
 
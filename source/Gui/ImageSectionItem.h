@@ -12,11 +12,13 @@ public:
     ~ImageSectionItem();
 
     QImagePtr getImageOfVisibleRect();
+    IntRect getRectOfImage() const;     //universe rect rendered into the image of the visible rect
     QRectF boundingRect() const override;
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = Q_NULLPTR) override;
 
 private:
     QImagePtr _imageOfVisibleRect = nullptr;
+    IntRect _rectOfImage;
     ViewportInterface* _viewport = nullptr;
     QRectF _boundingRect;
     std::mutex& _mutex;
@@ -1,5 +1,7 @@
 #include <QGraphicsScene>
 
+#include "Base/TraceRecorder.h"
+
 #include "ModelBasic/ChangeDescriptions.h"
 #include "Gui/Settings.h"
 #include "Gui/DataRepository.h"
@@ -158,6 +160,7 @@ void ItemManager::updateConnections(DataRepository* repository)
 
 void ItemManager::update(DataRepository* repository)
 {
+	TRACE_SCOPE("ItemManager::update");
 	_viewport->setModeToNoUpdate();
 
 	updateCells(repository);
@@ -13,11 +13,19 @@
 #include "ModelBasic/ModelBasicServices.h"
 
 #include "ModelGpu/ModelGpuServices.h"
+#include "ModelGpu/SubdomainProcess.h"
 
 #include "Gui/MainController.h"
 
 int main(int argc, char *argv[])
 {
+	if (SubdomainProcess::isRequested(argc, argv)) {
+		QCoreApplication a(argc, argv);
+		ModelBasicServices modelBasicServices;
+		ModelGpuServices modelGpuServices;
+		return SubdomainProcess::run(argc, argv);
+	}
+
 	QApplication a(argc, argv);
 	QCoreApplication::setOrganizationName("alien");
 	QCoreApplication::setApplicationName("alien");
@@ -9,6 +9,7 @@
 
 #include "Base/GlobalFactory.h"
 #include "Base/ServiceLocator.h"
+#include "Base/TraceRecorder.h"
 
 #include "ModelBasic/ModelBasicBuilderFacade.h"
 #include "ModelBasic/SimulationController.h"
@@ -19,6 +20,7 @@
 #include "ModelBasic/Serializer.h"
 #include "ModelBasic/DescriptionHelper.h"
 #include "ModelBasic/SimulationMonitor.h"
+#include "ModelBasic/MonitorHistory.h"
 #include "ModelBasic/SerializationHelper.h"
 #include "ModelBasic/SimulationChanger.h"
 
@@ -45,6 +47,9 @@ namespace Const
 {
     std::string const AutoSaveFilename = "autosave.sim";
     std::string const AutoSaveForLoadingFilename = "autosave_load.sim";
+    std::string const AutoSaveMonitorHistoryFilename = "autosave.monitor";
+
+    int const MonitorHistorySamplingInterval = 100;
 }
 
 MainController::MainController(QObject * parent)
@@ -55,12 +60,15 @@ MainController::MainController(QObject * parent)
 MainController::~MainController()
 {
     delete _view;
+    delete _monitorHistory;
 }
 
 void MainController::init()
 {
+    TRACE_THREAD_NAME("GUI");
     _model = new MainModel(this);
     _view = new MainView();
+    _monitorHistory = new MonitorHistory();
 
     _controllerBuildFunc = [](int typeId, IntVector2D const& universeSize, SymbolTable* symbols,
         SimulationParameters const& parameters, map<string, int> const& typeSpecificData, uint timestepAtBeginning) -> SimulationController*
@@ -116,7 +124,10 @@ void MainController::init()
     _view->init(_model, this, _serializer, _repository, _simMonitor, _notifier);
     _worker->init(_serializer);
 
-    if (!onLoadSimulation(getPathToApp() + Const::AutoSaveFilename, LoadOption::Non)) {
+    if (onLoadSimulation(getPathToApp() + Const::AutoSaveFilename, LoadOption::Non)) {
+        _monitorHistory->loadFromFile(getPathToApp() + Const::AutoSaveMonitorHistoryFilename);
+    }
+    else {
 
         //default simulation
         auto const modelGpuFacade = ServiceLocator::getInstance().getService<ModelGpuBuilderFacade>();
@@ -147,6 +158,7 @@ void MainController::autoSave()
 {
     auto progress = MessageHelper::createProgressDialog("Autosaving...", _view);
     autoSaveIntern(getPathToApp() + Const::AutoSaveFilename);
+    saveMonitorHistoryIntern(getPathToApp() + Const::AutoSaveMonitorHistoryFilename);
     delete progress;
 }
 
@@ -178,10 +190,18 @@ void MainController::autoSaveIntern(std::string const& filename)
 
 void MainController::saveSimulationIntern(string const & filename)
 {
+    TRACE_SCOPE("MainController::saveSimulation");
     serializeSimulationAndWaitUntilFinished();
     SerializationHelper::saveToFile(filename, [&]() { return _serializer->retrieveSerializedSimulation(); });
 }
 
+void MainController::saveMonitorHistoryIntern(string const& filename) const
+{
+    if (!_monitorHistory->saveToFile(filename)) {
+        std::cerr << "Could not save monitor history to " << filename << "." << std::endl;
+    }
+}
+
 string MainController::getPathToApp() const
 {
     auto result = qApp->applicationDirPath();
@@ -243,6 +263,7 @@ void MainController::onSimulationChanger(bool toggled)
 
 void MainController::initSimulation(SymbolTable* symbolTable, SimulationParameters const& parameters)
 {
+    TRACE_SCOPE("MainController::initSimulation");
     auto const modelBasicFacade = ServiceLocator::getInstance().getService<ModelBasicBuilderFacade>();
 
 	_model->setSimulationParameters(parameters);
@@ -263,6 +284,7 @@ void MainController::initSimulation(SymbolTable* symbolTable, SimulationParamete
 
 	auto simMonitor = _monitorBuildFunc(_simController);
 	SET_CHILD(_simMonitor, simMonitor);
+    connectMonitorHistory();
 
     auto simChanger = modelBasicFacade->buildSimulationChanger(simMonitor, context->getNumberGenerator());
     for (auto const& connection : _simChangerConnections) {
@@ -329,6 +351,7 @@ void MainController::onSaveSimulation(string const& filename)
 
 bool MainController::onLoadSimulation(string const & filename, LoadOption option)
 {
+    TRACE_SCOPE("MainController::loadSimulation");
     auto progress = MessageHelper::createProgressDialog("Loading...", _view);
 
     if (LoadOption::SaveOldSim == option) {
@@ -405,6 +428,19 @@ void MainController::onAddMostFrequentClusterToSimulation()
     _dataAnalyzer->addMostFrequenceClusterRepresentantToSimulation();
 }
 
+void MainController::onToggleTraceRecording(bool toggled)
+{
+    if (toggled) {
+        TraceRecorder::getInstance().clear();
+    }
+    TraceRecorder::getInstance().setEnabled(toggled);
+}
+
+bool MainController::onExportTrace(string const& filename) const
+{
+    return TraceRecorder::getInstance().exportToFile(filename);
+}
+
 int MainController::getTimestep() const
 {
     if (_simController) {
@@ -436,6 +472,11 @@ SimulationMonitor * MainController::getSimulationMonitor() const
 	return _simMonitor;
 }
 
+MonitorHistory* MainController::getMonitorHistory() const
+{
+    return _monitorHistory;
+}
+
 void MainController::connectSimController() const
 {
 	connect(_simController, &SimulationController::nextTimestepCalculated, [this]() {
@@ -443,6 +484,29 @@ void MainController::connectSimController() const
 	});
 }
 
+void MainController::connectMonitorHistory()
+{
+    //a new simulation starts a new time series
+    _monitorHistory->clear();
+    _monitorHistoryLastRequestedTimestep = getTimestep();
+    _monitorHistoryDataRequired = false;
+
+    connect(_simController, &SimulationController::nextTimestepCalculated, this, [this]() {
+        auto const timestep = getTimestep();
+        if (timestep - _monitorHistoryLastRequestedTimestep >= Const::MonitorHistorySamplingInterval) {
+            _monitorHistoryLastRequestedTimestep = timestep;
+            _monitorHistoryDataRequired = true;
+            _simMonitor->requireData();
+        }
+    });
+    connect(_simMonitor, &SimulationMonitor::dataReadyToRetrieve, this, [this]() {
+        if (_monitorHistoryDataRequired) {
+            _monitorHistoryDataRequired = false;
+            _monitorHistory->add(_monitorHistoryLastRequestedTimestep, _simMonitor->retrieveData());
+        }
+    });
+}
+
 void MainController::addRandomEnergy(double amount)
 {
 	double maxEnergyPerCell = _simController->getContext()->getSimulationParameters().cellMinEnergy;
@@ -34,20 +34,25 @@ public:
     void onUpdateExecutionParameters(ExecutionParameters const& parameters);
     void onRestrictTPS(optional<int> const& tps);
     void onAddMostFrequentClusterToSimulation();
+    void onToggleTraceRecording(bool toggled);
+    bool onExportTrace(string const& filename) const;
 
 	int getTimestep() const;
 	SimulationConfig getSimulationConfig() const;
 	SimulationMonitor* getSimulationMonitor() const;
+    MonitorHistory* getMonitorHistory() const;
 
 private:
 	void initSimulation(SymbolTable* symbolTable, SimulationParameters const& parameters);
 	void recreateSimulation(string const& serializedSimulation);
 	void connectSimController() const;
+    void connectMonitorHistory();
 	void addRandomEnergy(double amount);
 
     void serializeSimulationAndWaitUntilFinished();
     void autoSaveIntern(std::string const& filename);
     void saveSimulationIntern(string const& filename);
+    void saveMonitorHistoryIntern(string const& filename) const;
 
     string getPathToApp() const;
 
@@ -60,6 +65,10 @@ private:
 	SimulationController* _simController = nullptr;
 	SimulationMonitor* _simMonitor = nullptr;
 
+    MonitorHistory* _monitorHistory = nullptr;
+    int _monitorHistoryLastRequestedTimestep = 0;
+    bool _monitorHistoryDataRequired = false;
+
     SimulationChanger* _simChanger = nullptr;
     list<QMetaObject::Connection> _simChangerConnections;
 
@@ -187,6 +187,9 @@ void MainView::setupMenu()
 
     ui->menuTools->addAction(actions->actionMostFrequentCluster);
     ui->menuTools->addAction(actions->actionSimulationChanger);
+    ui->menuTools->addSeparator();
+    ui->menuTools->addAction(actions->actionRecordTrace);
+    ui->menuTools->addAction(actions->actionExportTrace);
 
 	ui->menuHelp->addAction(actions->actionAbout);
 	ui->menuEntity->addSeparator();
@@ -64,10 +64,7 @@ void PixelUniverseView::activate()
 	_connections.push_back(connect(_repository, &DataRepository::imageReady, this, &PixelUniverseView::imageReady, Qt::QueuedConnection));
 	_connections.push_back(connect(_viewport, &ViewportInterface::scrolled, this, &PixelUniverseView::scrolled));
 
-	IntVector2D size = _controller->getContext()->getSpaceProperties()->getSize();
-    auto image = _imageSectionItem->getImageOfVisibleRect();
-    _repository->requireImageFromSimulation(
-        {{0, 0}, {image->width(), image->height()}}, _imageSectionItem->getImageOfVisibleRect());
+	requestImage();
 }
 
 void PixelUniverseView::deactivate()
@@ -112,8 +109,8 @@ void PixelUniverseView::receivedNotifications(set<Receiver> const & targets)
 
 void PixelUniverseView::requestImage()
 {
-	IntRect rect = _viewport->getRect();
-	_repository->requireImageFromSimulation(rect, _imageSectionItem->getImageOfVisibleRect());
+	auto const image = _imageSectionItem->getImageOfVisibleRect();
+	_repository->requireImageFromSimulation(_imageSectionItem->getRectOfImage(), image);
 }
 
 void PixelUniverseView::imageReady()
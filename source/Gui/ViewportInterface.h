@@ -15,6 +15,7 @@ public:
 
 	virtual QRectF getRect() const = 0;
 	virtual QVector2D getCenter() const = 0;
+	virtual qreal getZoomFactor() const = 0;
 
 	virtual void scrollToPos(QVector2D pos, NotifyScrollChanged notify) = 0;
 
@@ -0,0 +1,220 @@
+#include <QMatrix4x4>
+
+#include "SimdSupport.h"
+#include "BatchPhysics.h"
+
+namespace
+{
+#ifdef ALIEN_SIMD_AVAILABLE
+    ALIEN_AVX2_FUNCTION __m256d load4(double const* values)
+    {
+        return _mm256_loadu_pd(values);
+    }
+
+    ALIEN_AVX2_FUNCTION __m256d load4(float const* values)
+    {
+        return _mm256_cvtps_pd(_mm_loadu_ps(values));
+    }
+
+    ALIEN_AVX2_FUNCTION void store4(double* target, __m256d values)
+    {
+        _mm256_storeu_pd(target, values);
+    }
+
+    ALIEN_AVX2_FUNCTION void store4(float* target, __m256d values)
+    {
+        _mm_storeu_ps(target, _mm256_cvtpd_ps(values));
+    }
+
+    ALIEN_AVX2_FUNCTION double sumLanes(__m256d values)
+    {
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, values);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+
+    template <typename T>
+    ALIEN_AVX2_FUNCTION int calcSumsAvx2(Vector2DSpan<T const> positions, double& sumX, double& sumY, double& sumLengthSquared)
+    {
+        auto accX = _mm256_setzero_pd();
+        auto accY = _mm256_setzero_pd();
+        auto accLengthSquared = _mm256_setzero_pd();
+        int index = 0;
+        for (; index + 4 <= positions.size; index += 4) {
+            auto const x = load4(positions.x + index);
+            auto const y = load4(positions.y + index);
+            accX = _mm256_add_pd(accX, x);
+            accY = _mm256_add_pd(accY, y);
+            accLengthSquared = _mm256_add_pd(accLengthSquared, _mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)));
+        }
+        sumX = sumLanes(accX);
+        sumY = sumLanes(accY);
+        sumLengthSquared = sumLanes(accLengthSquared);
+        return index;
+    }
+
+    ALIEN_AVX2_FUNCTION int translateAvx2(Vector2DSpan<float> positions, QVector2D const& delta)
+    {
+        auto const deltaX = _mm256_set1_ps(delta.x());
+        auto const deltaY = _mm256_set1_ps(delta.y());
+        int index = 0;
+        for (; index + 8 <= positions.size; index += 8) {
+            _mm256_storeu_ps(positions.x + index, _mm256_add_ps(_mm256_loadu_ps(positions.x + index), deltaX));
+            _mm256_storeu_ps(positions.y + index, _mm256_add_ps(_mm256_loadu_ps(positions.y + index), deltaY));
+        }
+        return index;
+    }
+
+    ALIEN_AVX2_FUNCTION int translateAvx2(Vector2DSpan<double> positions, QVector2D const& delta)
+    {
+        auto const deltaX = _mm256_set1_pd(delta.x());
+        auto const deltaY = _mm256_set1_pd(delta.y());
+        int index = 0;
+        for (; index + 4 <= positions.size; index += 4) {
+            _mm256_storeu_pd(positions.x + index, _mm256_add_pd(_mm256_loadu_pd(positions.x + index), deltaX));
+            _mm256_storeu_pd(positions.y + index, _mm256_add_pd(_mm256_loadu_pd(positions.y + index), deltaY));
+        }
+        return index;
+    }
+#endif
+}
+
+BatchPhysics::BatchPhysics(bool useSimd)
+    : _useSimd(useSimd && isAvx2Supported())
+{
+}
+
+QVector2D BatchPhysics::calcCenter(Vector2DSpan<float const> positions) const
+{
+    CHECK(positions.size > 0);
+    if (_useSimd) {
+        auto const sums = calcSums(positions);
+        return QVector2D(sums.x / positions.size, sums.y / positions.size);
+    }
+    QVector2D result;
+    for (int index = 0; index < positions.size; ++index) {
+        result += QVector2D(positions.x[index], positions.y[index]);
+    }
+    return result / positions.size;
+}
+
+QVector2D BatchPhysics::calcCenter(Vector2DSpan<double const> positions) const
+{
+    CHECK(positions.size > 0);
+    auto const sums = calcSums(positions);
+    return QVector2D(sums.x / positions.size, sums.y / positions.size);
+}
+
+double BatchPhysics::calcAngularMass(Vector2DSpan<float const> relPositionOfMasses) const
+{
+    if (_useSimd) {
+        return calcSums(relPositionOfMasses).lengthSquared;
+    }
+    auto result = 0.0;
+    for (int index = 0; index < relPositionOfMasses.size; ++index) {
+        result += QVector2D(relPositionOfMasses.x[index], relPositionOfMasses.y[index]).lengthSquared();
+    }
+    return result;
+}
+
+double BatchPhysics::calcAngularMass(Vector2DSpan<double const> relPositionOfMasses) const
+{
+    return calcSums(relPositionOfMasses).lengthSquared;
+}
+
+/**
+ * Same QVector2D operations in the same order as Physics::velocitiesOfCenter, which also determines the barycentric
+ * angular mass from the float center.
+ */
+Physics::Velocities BatchPhysics::calcVelocitiesOfCenter(
+    Physics::Velocities const& velocities,
+    Vector2DSpan<float const> relPositionOfMasses) const
+{
+    CHECK(relPositionOfMasses.size > 0);
+    auto const numMasses = relPositionOfMasses.size;
+    Physics::Velocities result;
+    result.angular = 0.0;
+    QVector2D center;
+    for (int index = 0; index < numMasses; ++index) {
+        QVector2D const relPositionOfMass(relPositionOfMasses.x[index], relPositionOfMasses.y[index]);
+        result.linear += Physics::tangentialVelocity(relPositionOfMass, velocities);
+        center += relPositionOfMass;
+    }
+    result.linear /= numMasses;
+    if (1 == numMasses) {
+        return result;
+    }
+    center /= numMasses;
+
+    auto angularMomentum = 0.0;
+    auto angularMass = 0.0;
+    for (int index = 0; index < numMasses; ++index) {
+        QVector2D const relPositionOfMass(relPositionOfMasses.x[index], relPositionOfMasses.y[index]);
+        angularMass += (relPositionOfMass - center).lengthSquared();
+        auto const relVel = Physics::tangentialVelocity(relPositionOfMass, velocities) - result.linear;
+        angularMomentum += Physics::angularMomentum(relPositionOfMass, relVel);
+    }
+    result.angular = Physics::angularVelocity(angularMomentum, angularMass);
+    return result;
+}
+
+void BatchPhysics::translate(Vector2DSpan<float> positions, QVector2D const& delta) const
+{
+    int index = 0;
+#ifdef ALIEN_SIMD_AVAILABLE
+    if (_useSimd) {
+        index = translateAvx2(positions, delta);
+    }
+#endif
+    for (; index < positions.size; ++index) {
+        positions.x[index] += delta.x();
+        positions.y[index] += delta.y();
+    }
+}
+
+void BatchPhysics::translate(Vector2DSpan<double> positions, QVector2D const& delta) const
+{
+    int index = 0;
+#ifdef ALIEN_SIMD_AVAILABLE
+    if (_useSimd) {
+        index = translateAvx2(positions, delta);
+    }
+#endif
+    for (; index < positions.size; ++index) {
+        positions.x[index] += delta.x();
+        positions.y[index] += delta.y();
+    }
+}
+
+void BatchPhysics::rotateClockwise(Vector2DSpan<float> positions, QVector2D const& center, double angle) const
+{
+    //the matrix of Physics::rotateClockwise is only set up once
+    QMatrix4x4 transform;
+    transform.rotate(angle, 0.0, 0.0, 1.0);
+    for (int index = 0; index < positions.size; ++index) {
+        auto const relPos = QVector2D(positions.x[index], positions.y[index]) - center;
+        auto const pos = center + transform.map(QVector3D(relPos)).toVector2D();
+        positions.x[index] = pos.x();
+        positions.y[index] = pos.y();
+    }
+}
+
+template <typename T>
+auto BatchPhysics::calcSums(Vector2DSpan<T const> positions) const -> Sums
+{
+    Sums result;
+    int index = 0;
+#ifdef ALIEN_SIMD_AVAILABLE
+    if (_useSimd) {
+        index = calcSumsAvx2(positions, result.x, result.y, result.lengthSquared);
+    }
+#endif
+    for (; index < positions.size; ++index) {
+        auto const x = static_cast<double>(positions.x[index]);
+        auto const y = static_cast<double>(positions.y[index]);
+        result.x += x;
+        result.y += y;
+        result.lengthSquared += x * x + y * y;
+    }
+    return result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Definitions.h"
+#include "Physics.h"
+#include "Vector2DArrays.h"
+
+/**
+ * Batch counterparts of Physics functions on structure-of-arrays positions. Element-wise functions give identical
+ * results with and without SIMD. Reductions are summed in a different order on the AVX2 path and therefore agree
+ * with the scalar functions only up to rounding. The scalar path of calcCenter and calcAngularMass reproduces the
+ * QVector2D arithmetic of the corresponding loops exactly. calcVelocitiesOfCenter and rotateClockwise have no SIMD
+ * path and give the same results as Physics.
+ */
+class MODELBASIC_EXPORT BatchPhysics
+{
+public:
+    BatchPhysics(bool useSimd = true);
+
+    QVector2D calcCenter(Vector2DSpan<float const> positions) const;
+    QVector2D calcCenter(Vector2DSpan<double const> positions) const;
+
+    //equivalent to Physics::angularMass
+    double calcAngularMass(Vector2DSpan<float const> relPositionOfMasses) const;
+    double calcAngularMass(Vector2DSpan<double const> relPositionOfMasses) const;
+
+    //same result as Physics::velocitiesOfCenter
+    Physics::Velocities calcVelocitiesOfCenter(
+        Physics::Velocities const& velocities,
+        Vector2DSpan<float const> relPositionOfMasses) const;
+
+    void translate(Vector2DSpan<float> positions, QVector2D const& delta) const;
+    void translate(Vector2DSpan<double> positions, QVector2D const& delta) const;
+
+    //same result as center + Physics::rotateClockwise(position - center, angle) for each position
+    void rotateClockwise(Vector2DSpan<float> positions, QVector2D const& center, double angle) const;
+
+private:
+    struct Sums
+    {
+        double x = 0;
+        double y = 0;
+        double lengthSquared = 0;
+    };
+    template <typename T>
+    Sums calcSums(Vector2DSpan<T const> positions) const;
+
+    bool _useSimd = true;
+};
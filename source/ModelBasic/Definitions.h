@@ -4,6 +4,7 @@
 
 #include "SimulationParameters.h"
 #include "ExecutionParameters.h"
+#include "RecordingParameters.h"
 #include "ElementaryTypes.h"
 #include "DllExport.h"
 
@@ -18,6 +19,8 @@ struct ClusterDescription;
 struct CellDescription;
 struct ParticleDescription;
 struct CellFeatureDescription;
+struct EntityQuery;
+struct EntityQueryResult;
 class SimulationAccess;
 class SimulationContext;
 class ModelBasicBuilderFacade;
@@ -26,6 +29,7 @@ class DescriptionHelper;
 class CellComputerCompiler;
 class Serializer;
 class SimulationMonitor;
+class MonitorHistory;
 class SymbolTable;
 class SpaceProperties;
 class SimulationController;
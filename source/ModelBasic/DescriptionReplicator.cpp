@@ -0,0 +1,191 @@
+#include <algorithm>
+
+#include <qmath.h>
+
+#include "Base/NumberGenerator.h"
+#include "Base/TaskScheduler.h"
+
+#include "DescriptionReplicator.h"
+
+namespace
+{
+    class Rotation
+    {
+    public:
+        Rotation(double angle, QVector2D const& center)
+            : _center(center)
+        {
+            auto const angleRad = qDegreesToRadians(angle);
+            _cos = qCos(angleRad);
+            _sin = qSin(angleRad);
+        }
+
+        QVector2D apply(QVector2D const& pos) const
+        {
+            auto const relPos = pos - _center;
+            return QVector2D(
+                _center.x() + _cos * relPos.x() - _sin * relPos.y(),
+                _center.y() + _sin * relPos.x() + _cos * relPos.y());
+        }
+
+    private:
+        QVector2D _center;
+        double _cos = 1.0;
+        double _sin = 0.0;
+    };
+}
+
+DescriptionReplicator::DescriptionReplicator(NumberGenerator* numberGen, int numThreads)
+    : _numberGen(numberGen)
+    , _numThreads(numThreads > 0 ? numThreads : std::max(1, static_cast<int>(std::thread::hardware_concurrency())))
+{
+}
+
+DataDescription DescriptionReplicator::replicate(
+    DataDescription const& templateData,
+    vector<Transform> const& transforms) const
+{
+    DataDescription result;
+    auto const info = calcTemplateInfo(templateData);
+    auto const numCopies = static_cast<int>(transforms.size());
+    if (0 == info.getNumIds() || 0 == numCopies) {
+        return result;
+    }
+
+    auto const firstId = _numberGen->getIds(static_cast<uint64_t>(info.getNumIds()) * numCopies);
+    if (info.numClusters > 0) {
+        result.clusters = vector<ClusterDescription>(info.numClusters * numCopies);
+    }
+    if (info.numParticles > 0) {
+        result.particles = vector<ParticleDescription>(info.numParticles * numCopies);
+    }
+
+    //each copy writes into its own slots of the result
+    auto const createCopies = [&](int startIndex, int endIndex) {
+        for (int copyIndex = startIndex; copyIndex < endIndex; ++copyIndex) {
+            createCopy(templateData, info, transforms.at(copyIndex), firstId, copyIndex, result);
+        }
+    };
+    auto const numThreads = std::min(_numThreads, numCopies);
+    TaskScheduler::getInstance().parallelFor(
+        0,
+        numThreads,
+        [&](int threadIndex) {
+            createCopies(numCopies * threadIndex / numThreads, numCopies * (threadIndex + 1) / numThreads);
+        },
+        1,
+        nullptr,
+        "DescriptionReplicator copies");
+    return result;
+}
+
+auto DescriptionReplicator::calcTemplateInfo(DataDescription const& templateData) const -> TemplateInfo
+{
+    TemplateInfo result;
+    int numEntities = 0;
+    unordered_map<uint64_t, int> cellIndexById;
+    if (templateData.clusters) {
+        result.numClusters = static_cast<int>(templateData.clusters->size());
+        for (auto const& cluster : *templateData.clusters) {
+            result.cellStartIndexByClusterIndex.emplace_back(result.numCells);
+            if (cluster.cells) {
+                for (auto const& cell : *cluster.cells) {
+                    cellIndexById.insert_or_assign(cell.id, result.numCells++);
+                    result.center += *cell.pos;
+                    ++numEntities;
+                }
+            }
+        }
+        for (auto const& cluster : *templateData.clusters) {
+            if (cluster.cells) {
+                for (auto const& cell : *cluster.cells) {
+                    vector<int> connectionIndices;
+                    if (cell.connectingCells) {
+                        for (auto const& connectingCellId : *cell.connectingCells) {
+                            connectionIndices.emplace_back(cellIndexById.at(connectingCellId));
+                        }
+                    }
+                    result.connectionIndicesByCellIndex.emplace_back(std::move(connectionIndices));
+                }
+            }
+        }
+    }
+    if (templateData.particles) {
+        result.numParticles = static_cast<int>(templateData.particles->size());
+        for (auto const& particle : *templateData.particles) {
+            result.center += *particle.pos;
+            ++numEntities;
+        }
+    }
+    if (numEntities > 0) {
+        result.center /= numEntities;
+    }
+    return result;
+}
+
+void DescriptionReplicator::createCopy(
+    DataDescription const& templateData,
+    TemplateInfo const& info,
+    Transform const& transform,
+    uint64_t firstId,
+    int copyIndex,
+    DataDescription& result) const
+{
+    auto const copyFirstId = firstId + static_cast<uint64_t>(copyIndex) * info.getNumIds();
+    auto const cellFirstId = copyFirstId + info.numClusters;
+    auto const particleFirstId = cellFirstId + info.numCells;
+    Rotation const rotation(transform.angle, info.center + transform.posDelta);
+    auto const rotate = 0.0 != transform.angle;
+
+    for (int clusterIndex = 0; clusterIndex < info.numClusters; ++clusterIndex) {
+        auto& cluster = result.clusters->at(copyIndex * info.numClusters + clusterIndex);
+        cluster = templateData.clusters->at(clusterIndex);
+        cluster.id = copyFirstId + clusterIndex;
+        if (cluster.pos) {
+            *cluster.pos += transform.posDelta;
+            if (rotate) {
+                *cluster.pos = rotation.apply(*cluster.pos);
+            }
+        }
+        if (cluster.vel) {
+            *cluster.vel += transform.velDelta;
+        }
+        if (cluster.angularVel) {
+            *cluster.angularVel += transform.angularVelDelta;
+        }
+        if (cluster.angle) {
+            *cluster.angle += transform.angle;
+        }
+        if (!cluster.cells) {
+            continue;
+        }
+        auto cellIndex = info.cellStartIndexByClusterIndex.at(clusterIndex);
+        for (auto& cell : *cluster.cells) {
+            cell.id = cellFirstId + cellIndex;
+            *cell.pos += transform.posDelta;
+            if (rotate) {
+                *cell.pos = rotation.apply(*cell.pos);
+            }
+            if (cell.connectingCells) {
+                auto connectingCellIdIter = cell.connectingCells->begin();
+                for (auto const& connectionIndex : info.connectionIndicesByCellIndex.at(cellIndex)) {
+                    *(connectingCellIdIter++) = cellFirstId + connectionIndex;
+                }
+            }
+            ++cellIndex;
+        }
+    }
+
+    for (int particleIndex = 0; particleIndex < info.numParticles; ++particleIndex) {
+        auto& particle = result.particles->at(copyIndex * info.numParticles + particleIndex);
+        particle = templateData.particles->at(particleIndex);
+        particle.id = particleFirstId + particleIndex;
+        *particle.pos += transform.posDelta;
+        if (rotate) {
+            *particle.pos = rotation.apply(*particle.pos);
+        }
+        if (particle.vel) {
+            *particle.vel += transform.velDelta;
+        }
+    }
+}
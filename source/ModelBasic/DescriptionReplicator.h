@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Descriptions.h"
+
+/**
+ * Creates many transformed copies of a template with fresh ids.
+ * The ids for all copies are reserved at once and the connection remapping is computed only once per template,
+ * so the copies can be filled independently on several threads.
+ */
+class MODELBASIC_EXPORT DescriptionReplicator
+{
+public:
+    struct Transform
+    {
+        QVector2D posDelta;
+        QVector2D velDelta;
+        double angularVelDelta = 0.0;
+        double angle = 0.0;     //rotation in degrees around the center of the copy
+    };
+
+    DescriptionReplicator(NumberGenerator* numberGen, int numThreads = 0);     //0 = number of threads of the TaskScheduler
+
+    DataDescription replicate(DataDescription const& templateData, vector<Transform> const& transforms) const;
+
+private:
+    struct TemplateInfo
+    {
+        int numClusters = 0;
+        int numCells = 0;
+        int numParticles = 0;
+        vector<int> cellStartIndexByClusterIndex;
+        vector<vector<int>> connectionIndicesByCellIndex;
+        QVector2D center;
+
+        int getNumIds() const { return numClusters + numCells + numParticles; }
+    };
+    TemplateInfo calcTemplateInfo(DataDescription const& templateData) const;
+
+    void createCopy(
+        DataDescription const& templateData,
+        TemplateInfo const& info,
+        Transform const& transform,
+        uint64_t firstId,
+        int copyIndex,
+        DataDescription& result) const;
+
+    NumberGenerator* _numberGen = nullptr;
+    int _numThreads = 1;
+};
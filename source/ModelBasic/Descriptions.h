@@ -182,6 +182,9 @@ struct ResolveDescription
 {
 	bool resolveIds = true;
 	bool resolveCellLinks = true;
+	int projection = Enums::DataProjection::ALL;	//combination of Enums::DataProjection::Type
+
+	ResolveDescription& setProjection(int value) { projection = value; return *this; }
 };
 
 struct DescriptionNavigator
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+
+#include "DomainDecomposition.h"
+
+DomainDecomposition::DomainDecomposition(IntVector2D const& universeSize, IntVector2D const& gridSize, int haloWidth)
+    : _universeSize(universeSize)
+    , _gridSize(gridSize)
+    , _haloWidth(haloWidth)
+{
+    CHECK(gridSize.x > 0 && gridSize.y > 0 && haloWidth >= 0);
+
+    //the halos of a subdomain must not overlap each other on the torus
+    auto const haloSize = getHaloSize();
+    CHECK(universeSize.x / gridSize.x + 2 * haloSize.x <= universeSize.x);
+    CHECK(universeSize.y / gridSize.y + 2 * haloSize.y <= universeSize.y);
+}
+
+IntVector2D DomainDecomposition::getUniverseSize() const
+{
+    return _universeSize;
+}
+
+IntVector2D DomainDecomposition::getGridSize() const
+{
+    return _gridSize;
+}
+
+int DomainDecomposition::getNumSubdomains() const
+{
+    return _gridSize.x * _gridSize.y;
+}
+
+IntRect DomainDecomposition::getSubdomainRect(int rank) const
+{
+    auto const gridPos = getGridPos(rank);
+    IntRect result;
+    result.p1 = {_universeSize.x * gridPos.x / _gridSize.x, _universeSize.y * gridPos.y / _gridSize.y};
+    result.p2 = {_universeSize.x * (gridPos.x + 1) / _gridSize.x - 1, _universeSize.y * (gridPos.y + 1) / _gridSize.y - 1};
+    return result;
+}
+
+int DomainDecomposition::getRankOfPosition(QVector2D const& pos) const
+{
+    auto const x = static_cast<int>(wrapCoordinate(pos.x(), _universeSize.x));
+    auto const y = static_cast<int>(wrapCoordinate(pos.y(), _universeSize.y));
+
+    //inverse of the rect boundaries in getSubdomainRect
+    auto gridX = (x * _gridSize.x) / _universeSize.x;
+    while (_universeSize.x * (gridX + 1) / _gridSize.x <= x) {
+        ++gridX;
+    }
+    while (_universeSize.x * gridX / _gridSize.x > x) {
+        --gridX;
+    }
+    auto gridY = (y * _gridSize.y) / _universeSize.y;
+    while (_universeSize.y * (gridY + 1) / _gridSize.y <= y) {
+        ++gridY;
+    }
+    while (_universeSize.y * gridY / _gridSize.y > y) {
+        --gridY;
+    }
+    return getRank({gridX, gridY});
+}
+
+vector<int> DomainDecomposition::getNeighborRanks(int rank) const
+{
+    auto const gridPos = getGridPos(rank);
+    set<int> neighborRanks;
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            IntVector2D neighborGridPos{
+                (gridPos.x + dx + _gridSize.x) % _gridSize.x, (gridPos.y + dy + _gridSize.y) % _gridSize.y};
+            neighborRanks.insert(getRank(neighborGridPos));
+        }
+    }
+    neighborRanks.erase(rank);
+    return vector<int>(neighborRanks.begin(), neighborRanks.end());
+}
+
+IntVector2D DomainDecomposition::getLocalUniverseSize(int rank) const
+{
+    auto const rect = getSubdomainRect(rank);
+    auto const haloSize = getHaloSize();
+    return {rect.p2.x - rect.p1.x + 1 + 2 * haloSize.x, rect.p2.y - rect.p1.y + 1 + 2 * haloSize.y};
+}
+
+QVector2D DomainDecomposition::toLocalPosition(int rank, QVector2D const& pos) const
+{
+    auto const rect = getSubdomainRect(rank);
+    auto const haloSize = getHaloSize();
+    return QVector2D(
+        wrapCoordinate(pos.x() - rect.p1.x + haloSize.x, _universeSize.x),
+        wrapCoordinate(pos.y() - rect.p1.y + haloSize.y, _universeSize.y));
+}
+
+QVector2D DomainDecomposition::toGlobalPosition(int rank, QVector2D const& localPos) const
+{
+    auto const rect = getSubdomainRect(rank);
+    auto const haloSize = getHaloSize();
+    return QVector2D(
+        wrapCoordinate(localPos.x() + rect.p1.x - haloSize.x, _universeSize.x),
+        wrapCoordinate(localPos.y() + rect.p1.y - haloSize.y, _universeSize.y));
+}
+
+bool DomainDecomposition::isInLocalUniverse(int rank, QVector2D const& pos) const
+{
+    auto const localPos = toLocalPosition(rank, pos);
+    auto const localSize = getLocalUniverseSize(rank);
+    return localPos.x() < localSize.x && localPos.y() < localSize.y;
+}
+
+bool DomainDecomposition::isInHalo(int rank, QVector2D const& pos) const
+{
+    return getRankOfPosition(pos) != rank && isInLocalUniverse(rank, pos);
+}
+
+IntVector2D DomainDecomposition::getGridPos(int rank) const
+{
+    CHECK(rank >= 0 && rank < getNumSubdomains());
+    return {rank % _gridSize.x, rank / _gridSize.x};
+}
+
+int DomainDecomposition::getRank(IntVector2D const& gridPos) const
+{
+    return gridPos.x + gridPos.y * _gridSize.x;
+}
+
+IntVector2D DomainDecomposition::getHaloSize() const
+{
+    return {_gridSize.x > 1 ? _haloWidth : 0, _gridSize.y > 1 ? _haloWidth : 0};
+}
+
+float DomainDecomposition::wrapCoordinate(float value, int size) const
+{
+    auto result = std::fmod(value, static_cast<float>(size));
+    if (result < 0) {
+        result += size;
+    }
+    return result < size ? result : 0.0f;
+}
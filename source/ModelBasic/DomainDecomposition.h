@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Definitions.h"
+
+/**
+ * Splits the toroidal universe into a grid of rectangular subdomains which are identified by their rank. Each
+ * subdomain is simulated in a local universe which contains its rect and a halo of the given width around it. The halo
+ * holds copies of the entities of the neighbor subdomains. In a grid dimension with only one subdomain there is no
+ * halo and the local universe wraps around like the global one.
+ */
+class MODELBASIC_EXPORT DomainDecomposition
+{
+public:
+    DomainDecomposition(IntVector2D const& universeSize, IntVector2D const& gridSize, int haloWidth);
+
+    IntVector2D getUniverseSize() const;
+    IntVector2D getGridSize() const;
+    int getNumSubdomains() const;
+
+    //rect including its lower right corner in global coordinates
+    IntRect getSubdomainRect(int rank) const;
+    int getRankOfPosition(QVector2D const& pos) const;
+    vector<int> getNeighborRanks(int rank) const;
+
+    IntVector2D getLocalUniverseSize(int rank) const;
+    QVector2D toLocalPosition(int rank, QVector2D const& pos) const;
+    QVector2D toGlobalPosition(int rank, QVector2D const& localPos) const;
+
+    bool isInLocalUniverse(int rank, QVector2D const& pos) const;
+    //position of another subdomain which lies in the halo of the given one
+    bool isInHalo(int rank, QVector2D const& pos) const;
+
+private:
+    IntVector2D getGridPos(int rank) const;
+    int getRank(IntVector2D const& gridPos) const;
+    IntVector2D getHaloSize() const;
+    float wrapCoordinate(float value, int size) const;
+
+    IntVector2D _universeSize;
+    IntVector2D _gridSize;
+    int _haloWidth = 0;
+};
@@ -221,6 +221,19 @@ namespace Enums
             STRIKE_SUCCESSFUL
         };
     };
+    //parts of the data transferred from the simulation, ids and positions are always included
+    struct DataProjection {
+        enum Type {
+            POSITIONS = 0,
+            VELOCITIES = 1 << 0,
+            ENERGIES = 1 << 1,
+            CELL_CONNECTIONS = 1 << 2,
+            METADATA = 1 << 3,
+            CELL_FUNCTION_DATA = 1 << 4,
+            TOKENS = 1 << 5,
+            ALL = (1 << 6) - 1
+        };
+    };
 }
 
 struct InstructionCoded {
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Definitions.h"
+#include "ElementaryTypes.h"
+
+/**
+ * Predicate on clusters and particles which is evaluated directly on the transfer data of a simulation.
+ * All given conditions have to be fulfilled. The cell conditions (cell function and energy range) have to be
+ * fulfilled by one cell of a cluster, the energy range of a particle refers to its own energy. Particles only match
+ * queries without conditions on cell functions or cluster properties.
+ */
+struct EntityQuery
+{
+    bool includeClusters = true;
+    bool includeParticles = false;
+
+    optional<IntRect> rect;     //clusters with a cell in the rect (p2 inclusive), particles in the rect
+
+    optional<Enums::CellFunction::Type> cellFunction;
+    optional<double> minEnergy;
+    optional<double> maxEnergy;     //exclusive
+
+    optional<int> minNumCells;
+    optional<int> maxNumCells;
+    optional<bool> hasTokens;
+    optional<QString> clusterName;
+
+    EntityQuery& setIncludeClusters(bool value) { includeClusters = value; return *this; }
+    EntityQuery& setIncludeParticles(bool value) { includeParticles = value; return *this; }
+    EntityQuery& setRect(IntRect const& value) { rect = value; return *this; }
+    EntityQuery& setCellFunction(Enums::CellFunction::Type value) { cellFunction = value; return *this; }
+    EntityQuery& setMinEnergy(double value) { minEnergy = value; return *this; }
+    EntityQuery& setMaxEnergy(double value) { maxEnergy = value; return *this; }
+    EntityQuery& setMinNumCells(int value) { minNumCells = value; return *this; }
+    EntityQuery& setMaxNumCells(int value) { maxNumCells = value; return *this; }
+    EntityQuery& setHasTokens(bool value) { hasTokens = value; return *this; }
+    EntityQuery& setClusterName(QString const& value) { clusterName = value; return *this; }
+};
+
+struct EntityQueryResult
+{
+    vector<uint64_t> clusterIds;
+    vector<uint64_t> particleIds;
+};
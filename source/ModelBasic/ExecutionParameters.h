@@ -4,6 +4,20 @@ struct ExecutionParameters
 {
     bool activateFreezing = false;
     int freezingTimesteps = 5;
+    int pagingTimesteps = 0;        //0 = frozen clusters remain in device memory
+
+    int reorderingTimesteps = 0;    //0 = no reordering of the entities in memory
+
+    bool tokenBucketing = true;     //tokens are sorted by the functions of their cells before they are processed
 
     bool imageGlow = true;
+
+    //zoomed-out views show the density or energy of the entities falling onto one output pixel instead of their colors
+    enum class ImageAggregation
+    {
+        Color,
+        Density,
+        Energy
+    };
+    ImageAggregation imageAggregation = ImageAggregation::Color;
 };
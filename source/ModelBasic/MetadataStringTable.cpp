@@ -0,0 +1,81 @@
+#include "MetadataStringTable.h"
+
+int MetadataStringTable::intern(QString const& value)
+{
+    auto const findResult = _idsByValue.constFind(value);
+    if (findResult != _idsByValue.constEnd()) {
+        auto const id = findResult.value();
+        ++_entries[id].refCount;
+        return id;
+    }
+
+    int id;
+    if (!_freeIds.empty()) {
+        id = _freeIds.back();
+        _freeIds.pop_back();
+    }
+    else {
+        id = static_cast<int>(_entries.size());
+        _entries.emplace_back();
+    }
+    _entries[id].value = value;
+    _entries[id].refCount = 1;
+    _idsByValue.insert(value, id);
+    _numBytes += value.size();
+    return id;
+}
+
+void MetadataStringTable::release(int id)
+{
+    auto& entry = _entries.at(id);
+    CHECK(entry.refCount > 0);
+    if (0 < --entry.refCount) {
+        return;
+    }
+    _numBytes -= entry.value.size();
+    _idsByValue.remove(entry.value);
+    entry.value.clear();
+    _freeIds.emplace_back(id);
+}
+
+void MetadataStringTable::clear()
+{
+    _entries.clear();
+    _idsByValue.clear();
+    _freeIds.clear();
+    _numBytes = 0;
+}
+
+optional<int> MetadataStringTable::getId(QString const& value) const
+{
+    auto const findResult = _idsByValue.constFind(value);
+    if (findResult == _idsByValue.constEnd()) {
+        return boost::none;
+    }
+    return findResult.value();
+}
+
+QString const& MetadataStringTable::getString(int id) const
+{
+    return _entries.at(id).value;
+}
+
+int MetadataStringTable::getRefCount(int id) const
+{
+    return _entries.at(id).refCount;
+}
+
+int MetadataStringTable::getNumStrings() const
+{
+    return static_cast<int>(_entries.size() - _freeIds.size());
+}
+
+int MetadataStringTable::getNumBytes() const
+{
+    return _numBytes;
+}
+
+int MetadataStringTable::getIdBound() const
+{
+    return static_cast<int>(_entries.size());
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QHash>
+
+#include "Definitions.h"
+
+/**
+ * Content-addressed table for the metadata strings of cells and clusters (names, descriptions and source code).
+ * Identical strings are stored once and referenced by an id; the table counts the references and drops a string
+ * when its last reference has been released. Ids of dropped strings are reused.
+ * The ids are dense, hence they can serve as indices in the transfer objects and in the snapshot format.
+ */
+class MODELBASIC_EXPORT MetadataStringTable
+{
+public:
+    //returns the id of the string and increases its reference count
+    int intern(QString const& value);
+    void release(int id);
+    void clear();
+
+    optional<int> getId(QString const& value) const;
+    QString const& getString(int id) const;
+    int getRefCount(int id) const;
+
+    int getNumStrings() const;
+    int getNumBytes() const;    //sum of the lengths of all stored strings
+    int getIdBound() const;     //all ids are less than the returned value
+
+private:
+    struct Entry
+    {
+        QString value;
+        int refCount = 0;
+    };
+    vector<Entry> _entries;
+    QHash<QString, int> _idsByValue;
+    vector<int> _freeIds;
+    int _numBytes = 0;
+};
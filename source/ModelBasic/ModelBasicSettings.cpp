@@ -198,6 +198,10 @@ ExecutionParameters ModelBasicSettings::getDefaultExecutionParameters()
     ExecutionParameters result;
     result.activateFreezing = false;
     result.freezingTimesteps = 5;
+    result.pagingTimesteps = 0;
+    result.reorderingTimesteps = 0;
+    result.tokenBucketing = true;
     result.imageGlow = true;
+    result.imageAggregation = ExecutionParameters::ImageAggregation::Color;
     return result;
 }
@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "MonitorHistory.h"
+
+namespace
+{
+    uint32_t const FileMagic = 0x484d4c41;  //"ALMH"
+    uint32_t const FileVersion = 1;
+
+    void accumulate(MonitorData& target, MonitorData const& source)
+    {
+        target.numClusters += source.numClusters;
+        target.numClustersWithTokens += source.numClustersWithTokens;
+        target.numCells += source.numCells;
+        target.numParticles += source.numParticles;
+        target.numTokens += source.numTokens;
+        target.totalInternalEnergy += source.totalInternalEnergy;
+        target.totalLinearKineticEnergy += source.totalLinearKineticEnergy;
+        target.totalRotationalKineticEnergy += source.totalRotationalKineticEnergy;
+    }
+
+    void accumulate(double* target, MonitorData const& source)
+    {
+        target[0] += source.numClusters;
+        target[1] += source.numClustersWithTokens;
+        target[2] += source.numCells;
+        target[3] += source.numParticles;
+        target[4] += source.numTokens;
+        target[5] += source.totalInternalEnergy;
+        target[6] += source.totalLinearKineticEnergy;
+        target[7] += source.totalRotationalKineticEnergy;
+    }
+
+    MonitorData divide(double const* sum, int divisor)
+    {
+        MonitorData result;
+        result.numClusters = static_cast<int>(std::lround(sum[0] / divisor));
+        result.numClustersWithTokens = static_cast<int>(std::lround(sum[1] / divisor));
+        result.numCells = static_cast<int>(std::lround(sum[2] / divisor));
+        result.numParticles = static_cast<int>(std::lround(sum[3] / divisor));
+        result.numTokens = static_cast<int>(std::lround(sum[4] / divisor));
+        result.totalInternalEnergy = sum[5] / divisor;
+        result.totalLinearKineticEnergy = sum[6] / divisor;
+        result.totalRotationalKineticEnergy = sum[7] / divisor;
+        return result;
+    }
+
+    MonitorData divide(MonitorData const& sum, int divisor)
+    {
+        double values[8] = {};
+        accumulate(values, sum);
+        return divide(values, divisor);
+    }
+
+    void applyMin(MonitorData& target, MonitorData const& source)
+    {
+        target.numClusters = std::min(target.numClusters, source.numClusters);
+        target.numClustersWithTokens = std::min(target.numClustersWithTokens, source.numClustersWithTokens);
+        target.numCells = std::min(target.numCells, source.numCells);
+        target.numParticles = std::min(target.numParticles, source.numParticles);
+        target.numTokens = std::min(target.numTokens, source.numTokens);
+        target.totalInternalEnergy = std::min(target.totalInternalEnergy, source.totalInternalEnergy);
+        target.totalLinearKineticEnergy = std::min(target.totalLinearKineticEnergy, source.totalLinearKineticEnergy);
+        target.totalRotationalKineticEnergy =
+            std::min(target.totalRotationalKineticEnergy, source.totalRotationalKineticEnergy);
+    }
+
+    void applyMax(MonitorData& target, MonitorData const& source)
+    {
+        target.numClusters = std::max(target.numClusters, source.numClusters);
+        target.numClustersWithTokens = std::max(target.numClustersWithTokens, source.numClustersWithTokens);
+        target.numCells = std::max(target.numCells, source.numCells);
+        target.numParticles = std::max(target.numParticles, source.numParticles);
+        target.numTokens = std::max(target.numTokens, source.numTokens);
+        target.totalInternalEnergy = std::max(target.totalInternalEnergy, source.totalInternalEnergy);
+        target.totalLinearKineticEnergy = std::max(target.totalLinearKineticEnergy, source.totalLinearKineticEnergy);
+        target.totalRotationalKineticEnergy =
+            std::max(target.totalRotationalKineticEnergy, source.totalRotationalKineticEnergy);
+    }
+
+    template<typename T>
+    void write(std::ofstream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void read(std::ifstream& stream, T& value)
+    {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    void writeSample(std::ofstream& stream, MonitorHistory::Sample const& sample)
+    {
+        write(stream, static_cast<int32_t>(sample.timestep));
+        write(stream, static_cast<int32_t>(sample.data.numClusters));
+        write(stream, static_cast<int32_t>(sample.data.numClustersWithTokens));
+        write(stream, static_cast<int32_t>(sample.data.numCells));
+        write(stream, static_cast<int32_t>(sample.data.numParticles));
+        write(stream, static_cast<int32_t>(sample.data.numTokens));
+        write(stream, sample.data.totalInternalEnergy);
+        write(stream, sample.data.totalLinearKineticEnergy);
+        write(stream, sample.data.totalRotationalKineticEnergy);
+    }
+
+    MonitorHistory::Sample readSample(std::ifstream& stream)
+    {
+        int32_t values[6];
+        for (auto& value : values) {
+            read(stream, value);
+        }
+        MonitorHistory::Sample result;
+        result.timestep = values[0];
+        result.data.numClusters = values[1];
+        result.data.numClustersWithTokens = values[2];
+        result.data.numCells = values[3];
+        result.data.numParticles = values[4];
+        result.data.numTokens = values[5];
+        read(stream, result.data.totalInternalEnergy);
+        read(stream, result.data.totalLinearKineticEnergy);
+        read(stream, result.data.totalRotationalKineticEnergy);
+        return result;
+    }
+}
+
+MonitorHistory::MonitorHistory(int capacityPerResolution)
+    : _capacityPerResolution(capacityPerResolution)
+{
+    for (auto& buffer : _buffers) {
+        buffer.init(capacityPerResolution);
+    }
+}
+
+void MonitorHistory::add(int timestep, MonitorData const& data)
+{
+    //timesteps must increase monotonically, otherwise a new simulation has been loaded
+    if (auto const lastSample = getLastSample()) {
+        if (timestep <= lastSample->timestep) {
+            clear();
+        }
+    }
+    addToResolution(0, Sample{timestep, data});
+}
+
+void MonitorHistory::clear()
+{
+    for (auto& buffer : _buffers) {
+        buffer.clear();
+    }
+    for (auto& accumulator : _accumulators) {
+        accumulator = Accumulator();
+    }
+}
+
+int MonitorHistory::getNumSamples(Resolution resolution) const
+{
+    return _buffers[static_cast<int>(resolution)].getSize();
+}
+
+auto MonitorHistory::getLastSample() const -> optional<Sample>
+{
+    auto const& buffer = _buffers[0];
+    if (0 == buffer.getSize()) {
+        return boost::none;
+    }
+    return buffer.at(buffer.getSize() - 1);
+}
+
+auto MonitorHistory::getSamples(int fromTimestep, int toTimestep, Resolution resolution) const -> vector<Sample>
+{
+    vector<Sample> result;
+    auto const& buffer = _buffers[static_cast<int>(resolution)];
+    for (int index = buffer.lowerBound(fromTimestep); index < buffer.getSize(); ++index) {
+        auto const& sample = buffer.at(index);
+        if (sample.timestep > toTimestep) {
+            break;
+        }
+        result.emplace_back(sample);
+    }
+    return result;
+}
+
+auto MonitorHistory::getAggregate(int fromTimestep, int toTimestep, Resolution resolution) const -> Aggregate
+{
+    Aggregate result;
+    double sum[8] = {};
+    auto const& buffer = _buffers[static_cast<int>(resolution)];
+    for (int index = buffer.lowerBound(fromTimestep); index < buffer.getSize(); ++index) {
+        auto const& sample = buffer.at(index);
+        if (sample.timestep > toTimestep) {
+            break;
+        }
+        if (0 == result.numSamples) {
+            result.min = sample.data;
+            result.max = sample.data;
+        }
+        else {
+            applyMin(result.min, sample.data);
+            applyMax(result.max, sample.data);
+        }
+        accumulate(sum, sample.data);
+        ++result.numSamples;
+    }
+    if (result.numSamples > 0) {
+        result.mean = divide(sum, result.numSamples);
+    }
+    return result;
+}
+
+bool MonitorHistory::saveToFile(string const& filename) const
+{
+    try {
+        std::ofstream stream(filename, std::ios_base::out | std::ios_base::binary);
+        write(stream, FileMagic);
+        write(stream, FileVersion);
+        write(stream, static_cast<int32_t>(_capacityPerResolution));
+        for (auto const& buffer : _buffers) {
+            write(stream, static_cast<int32_t>(buffer.getSize()));
+            for (int index = 0; index < buffer.getSize(); ++index) {
+                writeSample(stream, buffer.at(index));
+            }
+        }
+        for (auto const& accumulator : _accumulators) {
+            write(stream, static_cast<int32_t>(accumulator.numSamples));
+            writeSample(stream, Sample{accumulator.lastTimestep, accumulator.sum});
+        }
+        stream.close();
+        return !stream.fail();
+    }
+    catch (...) {
+        return false;
+    }
+}
+
+bool MonitorHistory::loadFromFile(string const& filename)
+{
+    try {
+        std::ifstream stream(filename, std::ios_base::in | std::ios_base::binary);
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        int32_t capacity = 0;
+        read(stream, magic);
+        read(stream, version);
+        read(stream, capacity);
+        if (stream.fail() || FileMagic != magic || FileVersion != version || capacity <= 0) {
+            return false;
+        }
+
+        MonitorHistory history(capacity);
+        for (auto& buffer : history._buffers) {
+            int32_t size = 0;
+            read(stream, size);
+            if (stream.fail() || size < 0 || size > capacity) {
+                return false;
+            }
+            for (int index = 0; index < size; ++index) {
+                buffer.add(readSample(stream));
+            }
+        }
+        for (auto& accumulator : history._accumulators) {
+            int32_t numSamples = 0;
+            read(stream, numSamples);
+            auto const sample = readSample(stream);
+            accumulator.numSamples = numSamples;
+            accumulator.lastTimestep = sample.timestep;
+            accumulator.sum = sample.data;
+        }
+        if (stream.fail()) {
+            return false;
+        }
+        *this = history;
+        return true;
+    }
+    catch (...) {
+        return false;
+    }
+}
+
+void MonitorHistory::addToResolution(int level, Sample const& sample)
+{
+    _buffers[level].add(sample);
+    if (level == NumResolutions - 1) {
+        return;
+    }
+
+    //the sum of the integer fields cannot overflow for DownsamplingFactor samples
+    auto& accumulator = _accumulators[level];
+    accumulate(accumulator.sum, sample.data);
+    accumulator.lastTimestep = sample.timestep;
+    if (++accumulator.numSamples == DownsamplingFactor) {
+        auto const downsampled = Sample{accumulator.lastTimestep, divide(accumulator.sum, DownsamplingFactor)};
+        accumulator = Accumulator();
+        addToResolution(level + 1, downsampled);
+    }
+}
+
+void MonitorHistory::RingBuffer::init(int capacity)
+{
+    _samples.resize(capacity);
+    clear();
+}
+
+void MonitorHistory::RingBuffer::clear()
+{
+    _start = 0;
+    _size = 0;
+}
+
+void MonitorHistory::RingBuffer::add(Sample const& sample)
+{
+    auto const capacity = getCapacity();
+    if (_size < capacity) {
+        _samples[(_start + _size) % capacity] = sample;
+        ++_size;
+    }
+    else {
+        _samples[_start] = sample;
+        _start = (_start + 1) % capacity;
+    }
+}
+
+auto MonitorHistory::RingBuffer::at(int index) const -> Sample const&
+{
+    return _samples[(_start + index) % getCapacity()];
+}
+
+int MonitorHistory::RingBuffer::lowerBound(int timestep) const
+{
+    int low = 0;
+    int high = _size;
+    while (low < high) {
+        auto const mid = (low + high) / 2;
+        if (at(mid).timestep < timestep) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return low;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Definitions.h"
+#include "MonitorData.h"
+
+/**
+ * Time series of monitor data with three resolutions (raw, every 10th and every 100th sample averaged).
+ * Each resolution is kept in a ring buffer so that memory consumption stays bounded on long runs.
+ */
+class MODELBASIC_EXPORT MonitorHistory
+{
+public:
+    enum class Resolution
+    {
+        Raw,
+        Tenth,
+        Hundredth
+    };
+
+    struct Sample
+    {
+        int timestep = 0;
+        MonitorData data;
+    };
+
+    struct Aggregate
+    {
+        int numSamples = 0;
+        MonitorData min;
+        MonitorData max;
+        MonitorData mean;
+    };
+
+    MonitorHistory(int capacityPerResolution = 100000);
+
+    void add(int timestep, MonitorData const& data);
+    void clear();
+
+    int getNumSamples(Resolution resolution) const;
+    optional<Sample> getLastSample() const;
+
+    //timestep range is inclusive
+    vector<Sample> getSamples(int fromTimestep, int toTimestep, Resolution resolution = Resolution::Raw) const;
+    Aggregate getAggregate(int fromTimestep, int toTimestep, Resolution resolution = Resolution::Raw) const;
+
+    bool saveToFile(string const& filename) const;
+    bool loadFromFile(string const& filename);
+
+private:
+    class RingBuffer
+    {
+    public:
+        void init(int capacity);
+        void clear();
+        void add(Sample const& sample);
+
+        int getSize() const { return _size; }
+        int getCapacity() const { return static_cast<int>(_samples.size()); }
+        Sample const& at(int index) const;  //index 0 is the oldest sample
+        int lowerBound(int timestep) const;
+
+    private:
+        vector<Sample> _samples;
+        int _start = 0;
+        int _size = 0;
+    };
+
+    struct Accumulator
+    {
+        int numSamples = 0;
+        int lastTimestep = 0;
+        MonitorData sum;
+    };
+
+    void addToResolution(int level, Sample const& sample);
+
+    static int const NumResolutions = 3;
+    static int const DownsamplingFactor = 10;
+
+    int _capacityPerResolution = 0;
+    RingBuffer _buffers[NumResolutions];
+    Accumulator _accumulators[NumResolutions - 1];
+};
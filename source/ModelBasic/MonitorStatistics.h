@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ElementaryTypes.h"
+
+/**
+ * Distributions of the simulation content. In contrast to MonitorData, it is meant to be collected only every few
+ * hundred timesteps.
+ */
+struct MonitorStatistics
+{
+    static int const NumClusterSizeBins = 16;   //bin i contains clusters with 2^i <= numCells < 2^(i+1)
+    static int const NumTokenEnergyBins = 16;   //bin i contains tokens with i * 10 <= energy < (i + 1) * 10
+    static int const TokenEnergyBinWidth = 10;
+
+    int numCellsByFunction[Enums::CellFunction::_COUNTER] = {};
+    int clusterSizeHistogram[NumClusterSizeBins] = {};
+    int tokenEnergyHistogram[NumTokenEnergyBins] = {};
+
+    //tokens located on constructor/weapon cells, i.e. the number of activations in the next timestep
+    int numConstructorActivities = 0;
+    int numWeaponActivities = 0;
+
+    int numParticles = 0;
+    double totalParticleEnergy = 0.0;
+
+    //the last bins also contain all larger values
+    static int getClusterSizeBin(int numCells)
+    {
+        int result = 0;
+        while (numCells > 1 && result < NumClusterSizeBins - 1) {
+            numCells >>= 1;
+            ++result;
+        }
+        return result;
+    }
+
+    static int getTokenEnergyBin(double energy)
+    {
+        if (energy <= 0.0) {
+            return 0;
+        }
+        auto const result = static_cast<int>(energy / TokenEnergyBinWidth);
+        return result < NumTokenEnergyBins ? result : NumTokenEnergyBins - 1;
+    }
+
+    void add(MonitorStatistics const& other)
+    {
+        for (int i = 0; i < Enums::CellFunction::_COUNTER; ++i) {
+            numCellsByFunction[i] += other.numCellsByFunction[i];
+        }
+        for (int i = 0; i < NumClusterSizeBins; ++i) {
+            clusterSizeHistogram[i] += other.clusterSizeHistogram[i];
+        }
+        for (int i = 0; i < NumTokenEnergyBins; ++i) {
+            tokenEnergyHistogram[i] += other.tokenEnergyHistogram[i];
+        }
+        numConstructorActivities += other.numConstructorActivities;
+        numWeaponActivities += other.numWeaponActivities;
+        numParticles += other.numParticles;
+        totalParticleEnergy += other.totalParticleEnergy;
+    }
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+
+struct RecordingParameters
+{
+    std::string directory;              //frames are written as frame_<timestep>.png
+    int timesteps = 10;                 //a frame is taken every timesteps
+    double scale = 1.0;                 //image pixels per universe unit
+    int maxFramePixels = 1920 * 1080;   //larger frames are scaled down keeping the aspect ratio
+    int queueCapacity = 16;             //frames waiting for encoding, further frames are dropped
+    int numEncodingThreads = 0;         //0 = number of hardware threads
+};
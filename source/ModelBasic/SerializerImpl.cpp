@@ -3,12 +3,14 @@
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/optional.hpp>
+#include <boost/serialization/version.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 
 #include <QVector2D>
 
 #include "Base/ServiceLocator.h"
+#include "Base/TraceRecorder.h"
 #include "ModelBasic/SimulationController.h"
 #include "ModelBasic/SimulationContext.h"
 #include "ModelBasic/SimulationAccess.h"
@@ -19,12 +21,73 @@
 #include "ModelBasic/SymbolTable.h"
 #include "ModelBasic/ModelBasicBuilderFacade.h"
 #include "ModelBasic/DescriptionHelper.h"
+#include "ModelBasic/MetadataStringTable.h"
 
 #include "SerializerImpl.h"
 
 using namespace std;
 using namespace boost;
 
+//since version 1 the metadata strings of a data description are stored once in a string table which is referenced by
+//ids from the metadata
+BOOST_CLASS_VERSION(CellMetadata, 1)
+BOOST_CLASS_VERSION(ClusterMetadata, 1)
+BOOST_CLASS_VERSION(DataDescription, 1)
+
+namespace
+{
+    //string table of the data description which is currently (de)serialized by this thread
+    thread_local MetadataStringTable const* stringTableToSave = nullptr;
+    thread_local vector<QString> const* loadedStrings = nullptr;
+
+    int const InlineString = -1;    //metadata serialized outside of a data description
+
+    template<typename T>
+    class ContextGuard
+    {
+    public:
+        ContextGuard(T*& context, T* value)
+            : _context(context)
+        {
+            _context = value;
+        }
+        ~ContextGuard() { _context = nullptr; }
+
+    private:
+        T*& _context;
+    };
+
+    template<class Archive>
+    void saveMetadataString(Archive& ar, QString const& value)
+    {
+        int id = InlineString;
+        if (stringTableToSave) {
+            if (auto const foundId = stringTableToSave->getId(value)) {
+                id = *foundId;
+            }
+        }
+        ar << id;
+        if (InlineString == id) {
+            ar << value.toStdString();
+        }
+    }
+
+    template<class Archive>
+    void loadMetadataString(Archive& ar, QString& value)
+    {
+        int id;
+        ar >> id;
+        if (InlineString == id) {
+            string str;
+            ar >> str;
+            value = QString::fromStdString(str);
+        }
+        else {
+            value = loadedStrings->at(id);  //implicitly shared
+        }
+    }
+}
+
 
 namespace boost {
 	namespace serialization {
@@ -109,9 +172,29 @@ namespace boost {
 			ar & data.energy & data.data;
 		}
 		template<class Archive>
-		inline void serialize(Archive & ar, CellMetadata& data, const unsigned int /*version*/)
+		inline void save(Archive& ar, CellMetadata const& data, const unsigned int /*version*/)
+		{
+			saveMetadataString(ar, data.computerSourcecode);
+			saveMetadataString(ar, data.name);
+			saveMetadataString(ar, data.description);
+			ar << data.color;
+		}
+		template<class Archive>
+		inline void load(Archive& ar, CellMetadata& data, const unsigned int version)
 		{
-			ar & data.computerSourcecode & data.name & data.description & data.color;
+			if (0 == version) {
+				ar >> data.computerSourcecode >> data.name >> data.description >> data.color;
+				return;
+			}
+			loadMetadataString(ar, data.computerSourcecode);
+			loadMetadataString(ar, data.name);
+			loadMetadataString(ar, data.description);
+			ar >> data.color;
+		}
+		template<class Archive>
+		inline void serialize(Archive & ar, CellMetadata& data, const unsigned int version)
+		{
+			boost::serialization::split_free(ar, data, version);
 		}
 		template<class Archive>
 		inline void serialize(Archive & ar, CellDescription& data, const unsigned int /*version*/)
@@ -120,10 +203,24 @@ namespace boost {
 			ar & data.tokenBlocked & data.tokenBranchNumber & data.metadata & data.cellFeature;
 			ar & data.tokens & data.tokenUsages;
 		}
-        template<class Archive>
-		inline void serialize(Archive & ar, ClusterMetadata& data, const unsigned int /*version*/)
+		template<class Archive>
+		inline void save(Archive& ar, ClusterMetadata const& data, const unsigned int /*version*/)
+		{
+			saveMetadataString(ar, data.name);
+		}
+		template<class Archive>
+		inline void load(Archive& ar, ClusterMetadata& data, const unsigned int version)
 		{
-			ar & data.name;
+			if (0 == version) {
+				ar >> data.name;
+				return;
+			}
+			loadMetadataString(ar, data.name);
+		}
+		template<class Archive>
+		inline void serialize(Archive & ar, ClusterMetadata& data, const unsigned int version)
+		{
+			boost::serialization::split_free(ar, data, version);
 		}
 		template<class Archive>
 		inline void serialize(Archive & ar, ClusterDescription& data, const unsigned int /*version*/)
@@ -141,9 +238,57 @@ namespace boost {
 			ar & data.id & data.pos & data.vel & data.energy & data.metadata;
 		}
 		template<class Archive>
-		inline void serialize(Archive & ar, DataDescription& data, const unsigned int /*version*/)
+		inline void save(Archive& ar, DataDescription const& data, const unsigned int /*version*/)
+		{
+			MetadataStringTable stringTable;
+			if (data.clusters) {
+				for (auto const& cluster : *data.clusters) {
+					if (cluster.metadata) {
+						stringTable.intern(cluster.metadata->name);
+					}
+					if (!cluster.cells) {
+						continue;
+					}
+					for (auto const& cell : *cluster.cells) {
+						if (cell.metadata) {
+							stringTable.intern(cell.metadata->computerSourcecode);
+							stringTable.intern(cell.metadata->name);
+							stringTable.intern(cell.metadata->description);
+						}
+					}
+				}
+			}
+			vector<string> strings;
+			for (int id = 0; id < stringTable.getIdBound(); ++id) {
+				strings.emplace_back(stringTable.getString(id).toStdString());
+			}
+			ar << strings;
+
+			ContextGuard<MetadataStringTable const> guard(stringTableToSave, &stringTable);
+			ar << data.clusters << data.particles;
+		}
+		template<class Archive>
+		inline void load(Archive& ar, DataDescription& data, const unsigned int version)
 		{
-			ar & data.clusters & data.particles;
+			if (0 == version) {
+				ar >> data.clusters >> data.particles;
+				return;
+			}
+			vector<string> strings;
+			ar >> strings;
+			vector<QString> convertedStrings;
+			convertedStrings.reserve(strings.size());
+			for (auto const& str : strings) {
+				convertedStrings.emplace_back(QString::fromStdString(str));
+			}
+
+			ContextGuard<vector<QString> const> guard(loadedStrings, &convertedStrings);
+			ar >> data.clusters >> data.particles;
+		}
+		template<class Archive>
+		inline void serialize(Archive & ar, DataDescription& data, const unsigned int version)
+		{
+			boost::serialization::split_free(ar, data, version);
 		}
         template<class Archive>
 		inline void serialize(Archive & ar, SimulationParameters& data, const unsigned int /*version*/)
@@ -281,6 +426,7 @@ string const& SerializerImpl::retrieveSerializedSimulation()
 
 SimulationController* SerializerImpl::deserializeSimulation(string const& content)
 {
+	TRACE_SCOPE("SerializerImpl::deserializeSimulation");
 	istringstream stream(content);
 	boost::archive::binary_iarchive ia(stream);
 
@@ -383,6 +529,7 @@ SimulationParameters SerializerImpl::deserializeSimulationParameters(string cons
 
 void SerializerImpl::dataReadyToRetrieve()
 {
+	TRACE_SCOPE("SerializerImpl::dataReadyToRetrieve");
 	ostringstream stream;
 	boost::archive::binary_oarchive archive(stream);
 
@@ -0,0 +1,36 @@
+#pragma once
+
+//internal header for the AVX2 paths of the batch functions, which are selected at runtime
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define ALIEN_SIMD_AVAILABLE
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ALIEN_AVX2_FUNCTION
+#else
+#define ALIEN_AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+#endif
+
+inline bool isAvx2Supported()
+{
+#if defined(ALIEN_SIMD_AVAILABLE) && defined(_MSC_VER)
+    static bool const result = [] {
+        int info[4];
+        __cpuid(info, 1);
+        auto const osSupportsAvx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        if (!osSupportsAvx) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    }();
+    return result;
+#elif defined(ALIEN_SIMD_AVAILABLE)
+    static bool const result = __builtin_cpu_supports("avx2");
+    return result;
+#else
+    return false;
+#endif
+}
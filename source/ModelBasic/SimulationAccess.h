@@ -4,6 +4,7 @@
 
 #include "Definitions.h"
 #include "Descriptions.h"
+#include "EntityQuery.h"
 
 class MODELBASIC_EXPORT SimulationAccess
 	: public QObject
@@ -20,9 +21,25 @@ public:
     virtual void requireImage(IntRect rect, QImagePtr const& target, std::mutex& mutex) = 0;
     virtual void applyAction(PhysicalAction const& action) = 0;
 
+    //the changes of a region are reported via regionChanged at most every interval timesteps, the first report
+    //contains all entities of the region as created
+    virtual int subscribeRegion(IntRect rect, ResolveDescription const& resolveDesc, int interval = 1) = 0;
+    virtual void unsubscribeRegion(int subscriptionId) = 0;
+
+    //queries are evaluated on the whole universe without converting it into descriptions, the result is reported
+    //via queryFinished, deleteEntities removes the matching clusters and particles in the simulation
+    virtual int queryEntities(EntityQuery const& query) = 0;
+    virtual int deleteEntities(EntityQuery const& query) = 0;
+
 	Q_SIGNAL void dataReadyToRetrieve();
 	Q_SIGNAL void dataUpdated();
 	Q_SIGNAL void imageReady();
 	virtual DataDescription const& retrieveData() = 0;
+
+	Q_SIGNAL void regionChanged(int subscriptionId);
+	virtual DataChangeDescription const& retrieveRegionChanges(int subscriptionId) = 0;
+
+	Q_SIGNAL void queryFinished(int queryId);
+	virtual EntityQueryResult retrieveQueryResult(int queryId) = 0;    //result can only be retrieved once
 };
 
@@ -21,4 +21,8 @@ public:
 
 	virtual void setSimulationParameters(SimulationParameters const& parameters) = 0;
     virtual void setExecutionParameters(ExecutionParameters const& parameters) = 0;
+
+    //frames are taken from the image path and encoded in the background without slowing down the simulation
+    virtual void startRecording(RecordingParameters const& parameters) = 0;
+    virtual void stopRecording() = 0;
 };
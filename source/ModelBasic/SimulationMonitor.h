@@ -3,6 +3,7 @@
 #include "Definitions.h"
 #include "Descriptions.h"
 #include "MonitorData.h"
+#include "MonitorStatistics.h"
 
 class MODELBASIC_EXPORT SimulationMonitor
 	: public QObject
@@ -15,5 +16,9 @@ public:
 	virtual void requireData() = 0;
 	Q_SIGNAL void dataReadyToRetrieve();
 	virtual MonitorData const& retrieveData() = 0;
+
+	virtual void requireStatistics() = 0;
+	Q_SIGNAL void statisticsReadyToRetrieve();
+	virtual MonitorStatistics const& retrieveStatistics() = 0;
 };
 
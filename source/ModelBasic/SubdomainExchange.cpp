@@ -0,0 +1,238 @@
+#include <sstream>
+
+#include "Serializer.h"
+#include "SubdomainExchange.h"
+
+namespace
+{
+    float correctComponent(float value, int size)
+    {
+        if (value > size / 2.0f) {
+            return value - size;
+        }
+        if (value < -size / 2.0f) {
+            return value + size;
+        }
+        return value;
+    }
+}
+
+SubdomainExchange::SubdomainExchange(DomainDecomposition const& decomposition, int rank)
+    : _decomposition(decomposition)
+    , _rank(rank)
+{
+}
+
+DataDescription SubdomainExchange::extractOwnedData(DataDescription const& data) const
+{
+    DataDescription result;
+    if (data.clusters) {
+        for (auto const& cluster : *data.clusters) {
+            if (_decomposition.getRankOfPosition(*cluster.pos) == _rank) {
+                result.addCluster(toLocal(cluster));
+            }
+        }
+    }
+    if (data.particles) {
+        for (auto const& particle : *data.particles) {
+            if (_decomposition.getRankOfPosition(*particle.pos) == _rank) {
+                result.addParticle(toLocal(particle));
+            }
+        }
+    }
+    return result;
+}
+
+map<int, SubdomainMessage> SubdomainExchange::split(DataDescription& localData, int timestep)
+{
+    map<int, SubdomainMessage> result;
+    for (int neighborRank : _decomposition.getNeighborRanks(_rank)) {
+        auto& message = result[neighborRank];
+        message.fromRank = _rank;
+        message.timestep = timestep;
+    }
+
+    _ghosts = DataDescription();
+    if (localData.clusters) {
+        vector<ClusterDescription> remainingClusters;
+        for (auto const& cluster : *localData.clusters) {
+            auto const globalCluster = toGlobal(cluster);
+            auto const owner = _decomposition.getRankOfPosition(*globalCluster.pos);
+            if (owner != _rank) {
+                result[owner].migrants.addCluster(globalCluster);
+                if (_decomposition.isInLocalUniverse(_rank, *globalCluster.pos)) {
+                    _ghosts.addCluster(cluster);
+                }
+                continue;
+            }
+            remainingClusters.emplace_back(cluster);
+
+            set<int> receivers;
+            if (globalCluster.cells) {
+                for (auto const& rankAndMessage : result) {
+                    for (auto const& cell : *globalCluster.cells) {
+                        if (_decomposition.isInLocalUniverse(rankAndMessage.first, *cell.pos)) {
+                            receivers.insert(rankAndMessage.first);
+                            break;
+                        }
+                    }
+                }
+            }
+            for (int receiver : receivers) {
+                result.at(receiver).ghosts.addCluster(globalCluster);
+            }
+        }
+        localData.clusters = remainingClusters;
+    }
+
+    if (localData.particles) {
+        vector<ParticleDescription> remainingParticles;
+        for (auto const& particle : *localData.particles) {
+            auto const globalParticle = toGlobal(particle);
+            auto const owner = _decomposition.getRankOfPosition(*globalParticle.pos);
+            if (owner != _rank) {
+                result[owner].migrants.addParticle(globalParticle);
+                continue;
+            }
+            remainingParticles.emplace_back(particle);
+        }
+        localData.particles = remainingParticles;
+    }
+    return result;
+}
+
+void SubdomainExchange::merge(DataDescription& localData, vector<SubdomainMessage> const& messages)
+{
+    for (auto const& message : messages) {
+        if (message.migrants.clusters) {
+            for (auto const& cluster : *message.migrants.clusters) {
+                localData.addCluster(toLocal(cluster));
+            }
+        }
+        if (message.migrants.particles) {
+            for (auto const& particle : *message.migrants.particles) {
+                localData.addParticle(toLocal(particle));
+            }
+        }
+        if (message.ghosts.clusters) {
+            for (auto const& cluster : *message.ghosts.clusters) {
+                _ghosts.addCluster(toLocal(cluster));
+            }
+        }
+    }
+}
+
+DataDescription const& SubdomainExchange::getGhosts() const
+{
+    return _ghosts;
+}
+
+DataDescription SubdomainExchange::getGlobalOwnedData(DataDescription const& localData) const
+{
+    DataDescription result;
+    if (localData.clusters) {
+        for (auto const& cluster : *localData.clusters) {
+            result.addCluster(toGlobal(cluster));
+        }
+    }
+    if (localData.particles) {
+        for (auto const& particle : *localData.particles) {
+            result.addParticle(toGlobal(particle));
+        }
+    }
+    return result;
+}
+
+SubdomainLoad SubdomainExchange::calcLoad(DataDescription const& localData)
+{
+    SubdomainLoad result;
+    if (localData.clusters) {
+        result.numClusters = static_cast<int>(localData.clusters->size());
+        for (auto const& cluster : *localData.clusters) {
+            result.numCells += cluster.cells ? static_cast<int>(cluster.cells->size()) : 0;
+        }
+    }
+    if (localData.particles) {
+        result.numParticles = static_cast<int>(localData.particles->size());
+    }
+    return result;
+}
+
+string SubdomainExchange::encodeMessage(SubdomainMessage const& message, Serializer* serializer)
+{
+    auto const migrants = serializer->serializeDataDescription(message.migrants);
+    auto const ghosts = serializer->serializeDataDescription(message.ghosts);
+    auto const& load = message.load;
+
+    std::ostringstream stream;
+    stream << message.fromRank << " " << message.timestep << " " << load.rank << " " << load.timestep << " "
+           << load.numClusters << " " << load.numCells << " " << load.numParticles << " " << load.calculationTime
+           << " " << load.exchangeTime << " " << migrants.size() << " " << ghosts.size() << "\n";
+    stream << migrants << ghosts;
+    return stream.str();
+}
+
+SubdomainMessage SubdomainExchange::decodeMessage(string const& data, Serializer* serializer)
+{
+    SubdomainMessage result;
+    auto& load = result.load;
+    size_t migrantsSize = 0;
+    size_t ghostsSize = 0;
+
+    std::istringstream stream(data);
+    stream >> result.fromRank >> result.timestep >> load.rank >> load.timestep >> load.numClusters >> load.numCells
+        >> load.numParticles >> load.calculationTime >> load.exchangeTime >> migrantsSize >> ghostsSize;
+    CHECK(!stream.fail() && stream.get() == '\n');
+
+    auto const headerSize = static_cast<size_t>(stream.tellg());
+    CHECK(headerSize + migrantsSize + ghostsSize == data.size());
+    result.migrants = serializer->deserializeDataDescription(data.substr(headerSize, migrantsSize));
+    result.ghosts = serializer->deserializeDataDescription(data.substr(headerSize + migrantsSize, ghostsSize));
+    return result;
+}
+
+void SubdomainExchange::moveCluster(
+    ClusterDescription& cluster,
+    QVector2D const& newPos,
+    IntVector2D const& universeSize) const
+{
+    auto const origPos = *cluster.pos;
+    cluster.pos = newPos;
+    if (!cluster.cells) {
+        return;
+    }
+    for (auto& cell : *cluster.cells) {
+        auto const relPos = *cell.pos - origPos;
+        cell.pos = newPos
+            + QVector2D(correctComponent(relPos.x(), universeSize.x), correctComponent(relPos.y(), universeSize.y));
+    }
+}
+
+ClusterDescription SubdomainExchange::toGlobal(ClusterDescription const& cluster) const
+{
+    auto result = cluster;
+    moveCluster(
+        result, _decomposition.toGlobalPosition(_rank, *cluster.pos), _decomposition.getLocalUniverseSize(_rank));
+    return result;
+}
+
+ClusterDescription SubdomainExchange::toLocal(ClusterDescription const& cluster) const
+{
+    auto result = cluster;
+    moveCluster(result, _decomposition.toLocalPosition(_rank, *cluster.pos), _decomposition.getUniverseSize());
+    return result;
+}
+
+ParticleDescription SubdomainExchange::toGlobal(ParticleDescription const& particle) const
+{
+    auto result = particle;
+    result.pos = _decomposition.toGlobalPosition(_rank, *particle.pos);
+    return result;
+}
+
+ParticleDescription SubdomainExchange::toLocal(ParticleDescription const& particle) const
+{
+    auto result = particle;
+    result.pos = _decomposition.toLocalPosition(_rank, *particle.pos);
+    return result;
+}
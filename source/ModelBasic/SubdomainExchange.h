@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Descriptions.h"
+#include "DomainDecomposition.h"
+
+struct SubdomainLoad
+{
+    int rank = 0;
+    int timestep = 0;
+    int numClusters = 0;
+    int numCells = 0;
+    int numParticles = 0;
+    double calculationTime = 0.0;   //in ms per timestep
+    double exchangeTime = 0.0;      //in ms per timestep
+};
+
+//entities are given in global coordinates
+struct SubdomainMessage
+{
+    int fromRank = 0;
+    int timestep = 0;
+    SubdomainLoad load;
+    DataDescription migrants;   //owned by the receiver from now on
+    DataDescription ghosts;     //copies of clusters for the halo of the receiver
+};
+
+/**
+ * Exchanges the entities at the boundary of a subdomain with its neighbors after each timestep. Clusters and
+ * particles whose position has left the subdomain are handed over to their new owner. Clusters which lie in the halo
+ * of a neighbor are sent as ghosts. Ghosts are kept apart from the local data and have to be simulated as immutable
+ * (see SimulationEnsembleGpu::addGhosts) during one timestep since the sender simulates the originals. Particles are
+ * not sent as ghosts because absorbing them would duplicate their energy.
+ */
+class MODELBASIC_EXPORT SubdomainExchange
+{
+public:
+    SubdomainExchange(DomainDecomposition const& decomposition, int rank);
+
+    //entities of global data which are owned by the subdomain in local coordinates
+    DataDescription extractOwnedData(DataDescription const& data) const;
+
+    //removes emigrated entities from the local data and returns the messages for all neighbors
+    //emigrated clusters remain ghosts as long as they are in the halo
+    map<int, SubdomainMessage> split(DataDescription& localData, int timestep);
+
+    //adds the migrants of the neighbors to the local data and their ghosts to getGhosts()
+    void merge(DataDescription& localData, vector<SubdomainMessage> const& messages);
+
+    //ghosts for the next timestep in local coordinates
+    DataDescription const& getGhosts() const;
+
+    //entities of local data in global coordinates
+    DataDescription getGlobalOwnedData(DataDescription const& localData) const;
+
+    static SubdomainLoad calcLoad(DataDescription const& localData);
+
+    static string encodeMessage(SubdomainMessage const& message, Serializer* serializer);
+    static SubdomainMessage decodeMessage(string const& data, Serializer* serializer);
+
+private:
+    //moves the cells by the same amount as the cluster
+    void moveCluster(ClusterDescription& cluster, QVector2D const& newPos, IntVector2D const& universeSize) const;
+    ClusterDescription toGlobal(ClusterDescription const& cluster) const;
+    ClusterDescription toLocal(ClusterDescription const& cluster) const;
+    ParticleDescription toGlobal(ParticleDescription const& particle) const;
+    ParticleDescription toLocal(ParticleDescription const& particle) const;
+
+    DomainDecomposition _decomposition;
+    int _rank = 0;
+    DataDescription _ghosts;
+};
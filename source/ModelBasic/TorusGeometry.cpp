@@ -0,0 +1,242 @@
+#include <cmath>
+
+#include "SimdSupport.h"
+#include "TorusGeometry.h"
+
+namespace
+{
+    //same operations as in SpaceProperties
+    double correctCoordinate(double value, int size)
+    {
+        int intPart = qFloor(value);
+        double fracPart = value - intPart;
+        intPart = ((intPart % size) + size) % size;
+        return static_cast<double>(intPart) + fracPart;
+    }
+
+    double correctDisplacementCoordinate(double displacement, int size)
+    {
+        int intDisplacement = qFloor(displacement);
+        double fracPart = displacement - static_cast<double>(intDisplacement);
+        intDisplacement += size / 2;
+        intDisplacement = ((intDisplacement % size) + size) % size;
+        intDisplacement -= size / 2;
+        return static_cast<double>(intDisplacement) + fracPart;
+    }
+
+    //differences of float coordinates are calculated in float as for QVector2D
+    template <typename T>
+    double calcDifference(T from, T to)
+    {
+        return static_cast<double>(static_cast<T>(to - from));
+    }
+
+#ifdef ALIEN_SIMD_AVAILABLE
+    ALIEN_AVX2_FUNCTION __m256d load4(double const* values)
+    {
+        return _mm256_loadu_pd(values);
+    }
+
+    ALIEN_AVX2_FUNCTION __m256d load4(float const* values)
+    {
+        return _mm256_cvtps_pd(_mm_loadu_ps(values));
+    }
+
+    ALIEN_AVX2_FUNCTION void store4(double* target, __m256d values)
+    {
+        _mm256_storeu_pd(target, values);
+    }
+
+    ALIEN_AVX2_FUNCTION void store4(float* target, __m256d values)
+    {
+        _mm_storeu_ps(target, _mm256_cvtpd_ps(values));
+    }
+
+    ALIEN_AVX2_FUNCTION __m256d loadDifference4(double const* from, double const* to)
+    {
+        return _mm256_sub_pd(_mm256_loadu_pd(to), _mm256_loadu_pd(from));
+    }
+
+    ALIEN_AVX2_FUNCTION __m256d loadDifference4(float const* from, float const* to)
+    {
+        return _mm256_cvtps_pd(_mm_sub_ps(_mm_loadu_ps(to), _mm_loadu_ps(from)));
+    }
+
+    //value - floor(value / size) * size is exact for integral values
+    ALIEN_AVX2_FUNCTION __m256d wrapIntegral4(__m256d value, __m256d size)
+    {
+        auto const quotient = _mm256_floor_pd(_mm256_div_pd(value, size));
+        return _mm256_sub_pd(value, _mm256_mul_pd(quotient, size));
+    }
+
+    ALIEN_AVX2_FUNCTION __m256d correctCoordinate4(__m256d value, __m256d size)
+    {
+        auto const intPart = _mm256_floor_pd(value);
+        auto const fracPart = _mm256_sub_pd(value, intPart);
+        return _mm256_add_pd(wrapIntegral4(intPart, size), fracPart);
+    }
+
+    ALIEN_AVX2_FUNCTION __m256d correctDisplacementCoordinate4(__m256d displacement, __m256d size, __m256d halfSize)
+    {
+        auto const intPart = _mm256_floor_pd(displacement);
+        auto const fracPart = _mm256_sub_pd(displacement, intPart);
+        auto const wrapped = wrapIntegral4(_mm256_add_pd(intPart, halfSize), size);
+        return _mm256_add_pd(_mm256_sub_pd(wrapped, halfSize), fracPart);
+    }
+
+    template <typename T>
+    ALIEN_AVX2_FUNCTION int correctPositionsAvx2(Vector2DSpan<T> positions, IntVector2D const& size)
+    {
+        auto const sizeX = _mm256_set1_pd(size.x);
+        auto const sizeY = _mm256_set1_pd(size.y);
+        int index = 0;
+        for (; index + 4 <= positions.size; index += 4) {
+            store4(positions.x + index, correctCoordinate4(load4(positions.x + index), sizeX));
+            store4(positions.y + index, correctCoordinate4(load4(positions.y + index), sizeY));
+        }
+        return index;
+    }
+
+    template <typename T>
+    ALIEN_AVX2_FUNCTION int calcDisplacementsAvx2(
+        Vector2DSpan<T const> fromPoints,
+        Vector2DSpan<T const> toPoints,
+        Vector2DSpan<T> result,
+        IntVector2D const& size)
+    {
+        auto const sizeX = _mm256_set1_pd(size.x);
+        auto const sizeY = _mm256_set1_pd(size.y);
+        auto const halfSizeX = _mm256_set1_pd(size.x / 2);
+        auto const halfSizeY = _mm256_set1_pd(size.y / 2);
+        int index = 0;
+        for (; index + 4 <= result.size; index += 4) {
+            auto const dx = loadDifference4(fromPoints.x + index, toPoints.x + index);
+            auto const dy = loadDifference4(fromPoints.y + index, toPoints.y + index);
+            store4(result.x + index, correctDisplacementCoordinate4(dx, sizeX, halfSizeX));
+            store4(result.y + index, correctDisplacementCoordinate4(dy, sizeY, halfSizeY));
+        }
+        return index;
+    }
+
+    template <typename T>
+    ALIEN_AVX2_FUNCTION void calcLengthsAvx2(Vector2DSpan<T const> vectors, T* result)
+    {
+        int index = 0;
+        for (; index + 4 <= vectors.size; index += 4) {
+            auto const x = load4(vectors.x + index);
+            auto const y = load4(vectors.y + index);
+            store4(result + index, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y))));
+        }
+        for (; index < vectors.size; ++index) {
+            result[index] = static_cast<T>(QVector2D(vectors.x[index], vectors.y[index]).length());
+        }
+    }
+#endif
+}
+
+TorusGeometry::TorusGeometry(IntVector2D const& size, bool useSimd)
+    : _size(size)
+    , _useSimd(useSimd && isAvx2Supported())
+{
+}
+
+void TorusGeometry::correctPositions(Vector2DSpan<float> positions) const
+{
+    correctPositionsIntern(positions);
+}
+
+void TorusGeometry::correctPositions(Vector2DSpan<double> positions) const
+{
+    correctPositionsIntern(positions);
+}
+
+void TorusGeometry::calcDisplacements(
+    Vector2DSpan<float const> fromPoints,
+    Vector2DSpan<float const> toPoints,
+    Vector2DSpan<float> result) const
+{
+    calcDisplacementsIntern(fromPoints, toPoints, result);
+}
+
+void TorusGeometry::calcDisplacements(
+    Vector2DSpan<double const> fromPoints,
+    Vector2DSpan<double const> toPoints,
+    Vector2DSpan<double> result) const
+{
+    calcDisplacementsIntern(fromPoints, toPoints, result);
+}
+
+void TorusGeometry::calcDistances(
+    Vector2DSpan<float const> fromPoints,
+    Vector2DSpan<float const> toPoints,
+    float* result) const
+{
+    Vector2DArrays<float> displacements(fromPoints.size);
+    calcDisplacementsIntern(fromPoints, toPoints, displacements.getSpan());
+    Vector2DSpan<float const> const displacementsSpan = displacements.getSpan();
+#ifdef ALIEN_SIMD_AVAILABLE
+    if (_useSimd) {
+        calcLengthsAvx2(displacementsSpan, result);
+        return;
+    }
+#endif
+    for (int index = 0; index < displacementsSpan.size; ++index) {
+        result[index] = displacements.get(index).length();
+    }
+}
+
+void TorusGeometry::calcDistances(
+    Vector2DSpan<double const> fromPoints,
+    Vector2DSpan<double const> toPoints,
+    double* result) const
+{
+    Vector2DArrays<double> displacements(fromPoints.size);
+    calcDisplacementsIntern(fromPoints, toPoints, displacements.getSpan());
+    Vector2DSpan<double const> const displacementsSpan = displacements.getSpan();
+#ifdef ALIEN_SIMD_AVAILABLE
+    if (_useSimd) {
+        calcLengthsAvx2(displacementsSpan, result);
+        return;
+    }
+#endif
+    for (int index = 0; index < displacementsSpan.size; ++index) {
+        auto const x = displacementsSpan.x[index];
+        auto const y = displacementsSpan.y[index];
+        result[index] = std::sqrt(x * x + y * y);
+    }
+}
+
+template <typename T>
+void TorusGeometry::correctPositionsIntern(Vector2DSpan<T> positions) const
+{
+    int index = 0;
+#ifdef ALIEN_SIMD_AVAILABLE
+    if (_useSimd) {
+        index = correctPositionsAvx2(positions, _size);
+    }
+#endif
+    for (; index < positions.size; ++index) {
+        positions.x[index] = static_cast<T>(correctCoordinate(positions.x[index], _size.x));
+        positions.y[index] = static_cast<T>(correctCoordinate(positions.y[index], _size.y));
+    }
+}
+
+template <typename T>
+void TorusGeometry::calcDisplacementsIntern(
+    Vector2DSpan<T const> fromPoints,
+    Vector2DSpan<T const> toPoints,
+    Vector2DSpan<T> result) const
+{
+    int index = 0;
+#ifdef ALIEN_SIMD_AVAILABLE
+    if (_useSimd) {
+        index = calcDisplacementsAvx2(fromPoints, toPoints, result, _size);
+    }
+#endif
+    for (; index < result.size; ++index) {
+        auto const dx = calcDifference(fromPoints.x[index], toPoints.x[index]);
+        auto const dy = calcDifference(fromPoints.y[index], toPoints.y[index]);
+        result.x[index] = static_cast<T>(correctDisplacementCoordinate(dx, _size.x));
+        result.y[index] = static_cast<T>(correctDisplacementCoordinate(dy, _size.y));
+    }
+}
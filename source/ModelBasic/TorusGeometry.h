@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Definitions.h"
+#include "Vector2DArrays.h"
+
+/**
+ * Non-virtual batch counterpart of the position corrections of SpaceProperties. The results are identical to
+ * correctPosition, displacement and distance of SpaceProperties with the same size; float spans are processed with
+ * the precision of QVector2D. AVX2 is used if it is supported by the processor and not disabled.
+ */
+class MODELBASIC_EXPORT TorusGeometry
+{
+public:
+    TorusGeometry(IntVector2D const& size, bool useSimd = true);
+
+    void correctPositions(Vector2DSpan<float> positions) const;
+    void correctPositions(Vector2DSpan<double> positions) const;
+
+    //result may alias toPoints
+    void calcDisplacements(
+        Vector2DSpan<float const> fromPoints,
+        Vector2DSpan<float const> toPoints,
+        Vector2DSpan<float> result) const;
+    void calcDisplacements(
+        Vector2DSpan<double const> fromPoints,
+        Vector2DSpan<double const> toPoints,
+        Vector2DSpan<double> result) const;
+
+    void calcDistances(Vector2DSpan<float const> fromPoints, Vector2DSpan<float const> toPoints, float* result) const;
+    void calcDistances(Vector2DSpan<double const> fromPoints, Vector2DSpan<double const> toPoints, double* result)
+        const;
+
+private:
+    template <typename T>
+    void correctPositionsIntern(Vector2DSpan<T> positions) const;
+    template <typename T>
+    void calcDisplacementsIntern(Vector2DSpan<T const> fromPoints, Vector2DSpan<T const> toPoints, Vector2DSpan<T> result)
+        const;
+
+    IntVector2D _size;
+    bool _useSimd = true;
+};
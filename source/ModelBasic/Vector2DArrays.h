@@ -0,0 +1,55 @@
+#pragma once
+
+#include <type_traits>
+#include <QVector2D>
+
+#include "Definitions.h"
+
+//structure-of-arrays view of 2D vectors
+template <typename T>
+struct Vector2DSpan
+{
+    T* x = nullptr;
+    T* y = nullptr;
+    int size = 0;
+
+    template <typename U = T, typename = std::enable_if_t<!std::is_const<U>::value>>
+    operator Vector2DSpan<T const>() const
+    {
+        return {x, y, size};
+    }
+};
+
+//structure-of-arrays storage of 2D vectors used for gathering positions from descriptions
+template <typename T>
+class Vector2DArrays
+{
+public:
+    Vector2DArrays() = default;
+    Vector2DArrays(int size) : _x(size), _y(size) {}
+
+    int size() const { return static_cast<int>(_x.size()); }
+    void reserve(int size)
+    {
+        _x.reserve(size);
+        _y.reserve(size);
+    }
+    void add(QVector2D const& value)
+    {
+        _x.emplace_back(static_cast<T>(value.x()));
+        _y.emplace_back(static_cast<T>(value.y()));
+    }
+    QVector2D get(int index) const { return QVector2D(_x[index], _y[index]); }
+    void set(int index, QVector2D const& value)
+    {
+        _x[index] = static_cast<T>(value.x());
+        _y[index] = static_cast<T>(value.y());
+    }
+
+    Vector2DSpan<T> getSpan() { return {_x.data(), _y.data(), size()}; }
+    Vector2DSpan<T const> getSpan() const { return {_x.data(), _y.data(), size()}; }
+
+private:
+    vector<T> _x;
+    vector<T> _y;
+};
@@ -8,36 +8,58 @@
 #include "Map.cuh"
 #include "EntityFactory.cuh"
 #include "CleanupKernels.cuh"
+#include "SharedStrings.cuh"
 
 #include "SimulationData.cuh"
 
+//the string index is resolved in resolveStringIndices since a shared string is copied by the first reference only
 __device__ void copyString(
     int& targetLen,
     int& targetStringIndex,
     int sourceLen,
     char* sourceString,
+    unsigned char* stringsBase,
     int& numStringBytes,
     char*& stringBytes)
 {
     targetLen = sourceLen;
     if (sourceLen > 0) {
-        targetStringIndex = atomicAdd(&numStringBytes, sourceLen);
-        for (int i = 0; i < sourceLen; ++i) {
-            stringBytes[targetStringIndex + i] = sourceString[i];
+        targetStringIndex = -1 - static_cast<int>(sourceString - reinterpret_cast<char*>(stringsBase));
+        if (claimString(sourceString)) {
+            auto const blockIndex = atomicAdd(&numStringBytes, getStringBlockSize(sourceLen));
+            *reinterpret_cast<unsigned long long*>(&stringBytes[blockIndex]) = 0;
+            auto const stringIndex = blockIndex + STRING_HEADER_SIZE;
+            for (int i = 0; i < sourceLen; ++i) {
+                stringBytes[stringIndex + i] = sourceString[i];
+            }
+            getStringHeader(sourceString) = stringIndex;
         }
     }
 }
 
+__device__ void resolveStringIndex(int len, int& stringIndex, unsigned char* stringsBase)
+{
+    if (len > 0) {
+        auto const string = reinterpret_cast<char*>(stringsBase) + (-1 - stringIndex);
+        stringIndex = static_cast<int>(getStringHeader(string));
+    }
+}
+
 __global__ void getClusterAccessData(int2 universeSize, int2 rectUpperLeft, int2 rectLowerRight,
-    Array<Cluster*> clusters, DataAccessTO dataTO)
+    Array<Cluster*> clusters, unsigned char* stringsBase, int projection, DataAccessTO dataTO)
 {
+    auto const withTokens = 0 != (projection & Enums::DataProjection::TOKENS);
+    auto const withMetadata = 0 != (projection & Enums::DataProjection::METADATA);
+    auto const withConnections = 0 != (projection & Enums::DataProjection::CELL_CONNECTIONS);
+    auto const withCellFunctionData = 0 != (projection & Enums::DataProjection::CELL_FUNCTION_DATA);
+
     PartitionData clusterBlock =
         calcPartition(clusters.getNumEntries(), blockIdx.x, gridDim.x);
 
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
 
         auto const& cluster = clusters.at(clusterIndex);
-        if (nullptr == cluster) {
+        if (nullptr == cluster || cluster->isGhost()) {
             continue;
         }
 
@@ -71,7 +93,8 @@ __global__ void getClusterAccessData(int2 universeSize, int2 rectUpperLeft, int2
                 cellTOIndex = atomicAdd(dataTO.numCells, cluster->numCellPointers);
                 cellTOs = &dataTO.cells[cellTOIndex];
 
-                tokenTOIndex = atomicAdd(dataTO.numTokens, cluster->numTokenPointers);
+                auto const numTokens = withTokens ? cluster->numTokenPointers : 0;
+                tokenTOIndex = atomicAdd(dataTO.numTokens, numTokens);
                 tokenTOs = &dataTO.tokens[tokenTOIndex];
 
                 ClusterAccessTO& clusterTO = dataTO.clusters[clusterAccessIndex];
@@ -81,17 +104,23 @@ __global__ void getClusterAccessData(int2 universeSize, int2 rectUpperLeft, int2
                 clusterTO.angle = cluster->angle;
                 clusterTO.angularVel = cluster->getAngularVelocity();
                 clusterTO.numCells = cluster->numCellPointers;
-                clusterTO.numTokens = cluster->numTokenPointers;
+                clusterTO.numTokens = numTokens;
                 clusterTO.cellStartIndex = cellTOIndex;
                 clusterTO.tokenStartIndex = tokenTOIndex;
 
-                copyString(
-                    clusterTO.metadata.nameLen,
-                    clusterTO.metadata.nameStringIndex,
-                    cluster->metadata.nameLen,
-                    cluster->metadata.name,
-                    *dataTO.numStringBytes,
-                    dataTO.stringBytes);
+                if (withMetadata) {
+                    copyString(
+                        clusterTO.metadata.nameLen,
+                        clusterTO.metadata.nameStringIndex,
+                        cluster->metadata.nameLen,
+                        cluster->metadata.name,
+                        stringsBase,
+                        *dataTO.numStringBytes,
+                        dataTO.stringBytes);
+                }
+                else {
+                    clusterTO.metadata.nameLen = 0;
+                }
             }
             __syncthreads();
 
@@ -104,50 +133,58 @@ __global__ void getClusterAccessData(int2 universeSize, int2 rectUpperLeft, int2
                 cellTO.pos = cell.absPos;
                 cellTO.energy = cell.getEnergy_safe();
                 cellTO.maxConnections = cell.maxConnections;
-                cellTO.numConnections = cell.numConnections;
+                cellTO.numConnections = withConnections ? cell.numConnections : 0;
                 cellTO.branchNumber = cell.branchNumber;
                 cellTO.tokenBlocked = cell.tokenBlocked;
-                cellTO.cellFunctionType = cell.getCellFunctionType();
-                cellTO.numStaticBytes = cell.numStaticBytes;
-                cellTO.tokenUsages = cell.tokenUsages;
-                cellTO.metadata.color = cell.metadata.color;
-
-                copyString(
-                    cellTO.metadata.nameLen,
-                    cellTO.metadata.nameStringIndex,
-                    cell.metadata.nameLen,
-                    cell.metadata.name,
-                    *dataTO.numStringBytes,
-                    dataTO.stringBytes);
-                copyString(
-                    cellTO.metadata.descriptionLen,
-                    cellTO.metadata.descriptionStringIndex,
-                    cell.metadata.descriptionLen,
-                    cell.metadata.description,
-                    *dataTO.numStringBytes,
-                    dataTO.stringBytes);
-                copyString(
-                    cellTO.metadata.sourceCodeLen,
-                    cellTO.metadata.sourceCodeStringIndex,
-                    cell.metadata.sourceCodeLen,
-                    cell.metadata.sourceCode,
-                    *dataTO.numStringBytes,
-                    dataTO.stringBytes);
-
-                for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
-                    cellTO.staticData[i] = cell.staticData[i];
-                }
-                cellTO.numMutableBytes = cell.numMutableBytes;
-                for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
-                    cellTO.mutableData[i] = cell.mutableData[i];
-                }
-                for (int i = 0; i < cell.numConnections; ++i) {
+                for (int i = 0; i < cellTO.numConnections; ++i) {
                     int connectingCellIndex = cell.connections[i]->tag + cellTOIndex;
                     cellTO.connectionIndices[i] = connectingCellIndex;
                 }
+                cellTO.tokenUsages = cell.tokenUsages;
+
+                //the fields below are only read by the host if they are projected, see getCellAccessTOPrefixSize
+                if (withMetadata) {
+                    cellTO.metadata.color = cell.metadata.color;
+                    copyString(
+                        cellTO.metadata.nameLen,
+                        cellTO.metadata.nameStringIndex,
+                        cell.metadata.nameLen,
+                        cell.metadata.name,
+                        stringsBase,
+                        *dataTO.numStringBytes,
+                        dataTO.stringBytes);
+                    copyString(
+                        cellTO.metadata.descriptionLen,
+                        cellTO.metadata.descriptionStringIndex,
+                        cell.metadata.descriptionLen,
+                        cell.metadata.description,
+                        stringsBase,
+                        *dataTO.numStringBytes,
+                        dataTO.stringBytes);
+                    copyString(
+                        cellTO.metadata.sourceCodeLen,
+                        cellTO.metadata.sourceCodeStringIndex,
+                        cell.metadata.sourceCodeLen,
+                        cell.metadata.sourceCode,
+                        stringsBase,
+                        *dataTO.numStringBytes,
+                        dataTO.stringBytes);
+                }
+
+                if (withCellFunctionData) {
+                    cellTO.cellFunctionType = cell.getCellFunctionType();
+                    cellTO.numStaticBytes = cell.numStaticBytes;
+                    for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
+                        cellTO.staticData[i] = cell.staticData[i];
+                    }
+                    cellTO.numMutableBytes = cell.numMutableBytes;
+                    for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
+                        cellTO.mutableData[i] = cell.mutableData[i];
+                    }
+                }
             }
 
-            PartitionData tokenBlock = calcPartition(cluster->numTokenPointers, threadIdx.x, blockDim.x);
+            PartitionData tokenBlock = calcPartition(withTokens ? cluster->numTokenPointers : 0, threadIdx.x, blockDim.x);
             for (auto tokenIndex = tokenBlock.startIndex; tokenIndex <= tokenBlock.endIndex; ++tokenIndex) {
                 Token const& token = *cluster->tokenPointers[tokenIndex];
                 TokenAccessTO& tokenTO = tokenTOs[tokenIndex];
@@ -162,6 +199,55 @@ __global__ void getClusterAccessData(int2 universeSize, int2 rectUpperLeft, int2
     }
 }
 
+__global__ void resolveStringIndices(DataAccessTO dataTO, unsigned char* stringsBase)
+{
+    PartitionData clusterBlock =
+        calcPartition(*dataTO.numClusters, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        auto& metadataTO = dataTO.clusters[clusterIndex].metadata;
+        resolveStringIndex(metadataTO.nameLen, metadataTO.nameStringIndex, stringsBase);
+    }
+
+    PartitionData cellBlock =
+        calcPartition(*dataTO.numCells, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
+        auto& metadataTO = dataTO.cells[cellIndex].metadata;
+        resolveStringIndex(metadataTO.nameLen, metadataTO.nameStringIndex, stringsBase);
+        resolveStringIndex(metadataTO.descriptionLen, metadataTO.descriptionStringIndex, stringsBase);
+        resolveStringIndex(metadataTO.sourceCodeLen, metadataTO.sourceCodeStringIndex, stringsBase);
+    }
+}
+
+__global__ void releaseStrings(Array<Cluster*> clusters)
+{
+    PartitionData clusterBlock = calcPartition(clusters.getNumEntries(), blockIdx.x, gridDim.x);
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        auto const& cluster = clusters.at(clusterIndex);
+        if (nullptr == cluster) {
+            continue;
+        }
+        if (0 == threadIdx.x) {
+            releaseString(cluster->metadata.nameLen, cluster->metadata.name);
+        }
+        PartitionData cellBlock = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        for (auto cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
+            auto const& cell = cluster->cellPointers[cellIndex];
+            releaseString(cell->metadata.nameLen, cell->metadata.name);
+            releaseString(cell->metadata.descriptionLen, cell->metadata.description);
+            releaseString(cell->metadata.sourceCodeLen, cell->metadata.sourceCode);
+        }
+    }
+}
+
+__global__ void copyStringBytes(int numStringBytes, char* source, char* target)
+{
+    PartitionData byteBlock =
+        calcPartition(numStringBytes, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = byteBlock.startIndex; index <= byteBlock.endIndex; ++index) {
+        target[index] = source[index];
+    }
+}
+
 __global__ void getParticleAccessData(int2 rectUpperLeft, int2 rectLowerRight,
     SimulationData data, DataAccessTO access)
 {
@@ -204,7 +290,8 @@ __device__ void filterCluster(int2 const& rectUpperLeft, int2 const& rectLowerRi
     }
     __syncthreads();
 
-    if (containedInRect && 0 == threadIdx.x) {
+    //ghosts are only valid until the next data manipulation
+    if ((containedInRect || cluster->isGhost()) && 0 == threadIdx.x) {
         cluster = nullptr;
     }
     __syncthreads();
@@ -260,12 +347,27 @@ __global__ void createDataFromTO(SimulationData data, DataAccessTO simulationTO)
     }
 }
 
+__global__ void createGhostsFromTO(SimulationData data, DataAccessTO simulationTO)
+{
+    __shared__ EntityFactory factory;
+    if (0 == threadIdx.x) {
+        factory.init(&data);
+    }
+    __syncthreads();
+
+    PartitionData clusterBlock = calcPartition(*simulationTO.numClusters, blockIdx.x, gridDim.x);
+
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        factory.createClusterFromTO_block(simulationTO.clusters[clusterIndex], &simulationTO, true);
+    }
+}
+
 /************************************************************************/
 /* Main      															*/
 /************************************************************************/
 
 __global__ void getSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRight,
-    SimulationData data, DataAccessTO access)
+    SimulationData data, int projection, DataAccessTO access)
 {
     *access.numClusters = 0;
     *access.numCells = 0;
@@ -273,8 +375,14 @@ __global__ void getSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRight,
     *access.numTokens = 0;
     *access.numStringBytes = 0;
 
-    KERNEL_CALL(getClusterAccessData, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterPointers, access);
-    KERNEL_CALL(getClusterAccessData, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterFreezedPointers, access);
+    auto const stringsBase = data.entities.strings.getData();
+    KERNEL_CALL(getClusterAccessData, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterPointers, stringsBase, projection, access);
+    KERNEL_CALL(getClusterAccessData, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterFreezedPointers, stringsBase, projection, access);
+    if (0 != (projection & Enums::DataProjection::METADATA)) {
+        KERNEL_CALL(resolveStringIndices, access, stringsBase);
+        KERNEL_CALL(releaseStrings, data.entities.clusterPointers);
+        KERNEL_CALL(releaseStrings, data.entities.clusterFreezedPointers);
+    }
     KERNEL_CALL(getParticleAccessData, rectUpperLeft, rectLowerRight, data, access);
 }
 
@@ -286,11 +394,44 @@ __global__ void setSimulationAccessData(int2 rectUpperLeft, int2 rectLowerRight,
 
     KERNEL_CALL(filterClusters, rectUpperLeft, rectLowerRight, data.entities.clusterPointers);
     KERNEL_CALL(filterParticles, rectUpperLeft, rectLowerRight, data.entities.particlePointers);
+
+    //the strings of the transfer object are adopted as a whole, hence strings shared there remain shared
+    auto const strings = data.entities.strings.getArray<char>(*access.numStringBytes);
+    KERNEL_CALL(copyStringBytes, *access.numStringBytes, access.stringBytes, strings);
+    access.stringBytes = strings;
     KERNEL_CALL(createDataFromTO, data, access);
 
     KERNEL_CALL_1_1(cleanupAfterDataManipulation, data);
 }
 
+//ghosts are clusters simulated elsewhere: they act on the other clusters but are neither moved nor changed,
+//particles of the transfer object are ignored
+__global__ void addGhostAccessData(SimulationData data, DataAccessTO access)
+{
+    auto const strings = data.entities.strings.getArray<char>(*access.numStringBytes);
+    KERNEL_CALL(copyStringBytes, *access.numStringBytes, access.stringBytes, strings);
+    access.stringBytes = strings;
+    KERNEL_CALL(createGhostsFromTO, data, access);
+
+    KERNEL_CALL_1_1(cleanupAfterDataManipulation, data);
+}
+
+//frozen clusters are removed from the device and their memory is reclaimed by the next cleanup
+__global__ void getFrozenClusterAccessData(SimulationData data, DataAccessTO access)
+{
+    *access.numClusters = 0;
+    *access.numCells = 0;
+    *access.numParticles = 0;
+    *access.numTokens = 0;
+    *access.numStringBytes = 0;
+
+    auto const stringsBase = data.entities.strings.getData();
+    KERNEL_CALL(getClusterAccessData, data.size, int2{0, 0}, data.size, data.entities.clusterFreezedPointers, stringsBase, Enums::DataProjection::ALL, access);
+    KERNEL_CALL(resolveStringIndices, access, stringsBase);
+    KERNEL_CALL(releaseStrings, data.entities.clusterFreezedPointers);
+    data.entities.clusterFreezedPointers.reset();
+}
+
 __global__ void clearData(SimulationData data)
 {
     data.entities.clusterFreezedPointers.reset();
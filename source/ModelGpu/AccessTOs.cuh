@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <cuda_runtime.h>
 
+#include "ModelBasic/ElementaryTypes.h"
+
 #include "CudaSimulation.cuh"
 
 #define MAX_TOKEN_MEM_SIZE 256
@@ -9,6 +12,16 @@
 #define MAX_CELL_STATIC_BYTES 48
 #define MAX_CELL_MUTABLE_BYTES 16
 
+//each metadata string in DataAccessTO::stringBytes is stored once and may be referenced by any number of cells and
+//clusters; it starts at a multiple of STRING_HEADER_SIZE and is preceded by a zeroed header used by the engine for
+//deduplication
+#define STRING_HEADER_SIZE 16
+
+__host__ __device__ __inline__ int getStringBlockSize(int len)
+{
+    return STRING_HEADER_SIZE + (len + STRING_HEADER_SIZE - 1) / STRING_HEADER_SIZE * STRING_HEADER_SIZE;
+}
+
 struct TokenAccessTO
 {
 	float energy;
@@ -44,6 +57,7 @@ struct CellMetadataAccessTO
     int sourceCodeStringIndex;
 };
 
+//the fields are ordered by Enums::DataProjection so that a projection can be transferred as a prefix of each cell
 struct CellAccessTO
 {
 	uint64_t id;
@@ -54,15 +68,32 @@ struct CellAccessTO
 	int branchNumber;
 	bool tokenBlocked;
 	int connectionIndices[MAX_CELL_BONDS];
+    int tokenUsages;
+    CellMetadataAccessTO metadata;
     int cellFunctionType;
     unsigned char numStaticBytes;
     char staticData[MAX_CELL_STATIC_BYTES];
     unsigned char numMutableBytes;
     char mutableData[MAX_CELL_MUTABLE_BYTES];
-    int tokenUsages;
-    CellMetadataAccessTO metadata;
 };
 
+__host__ __inline__ int getCellAccessTOPrefixSize(int projection)
+{
+    if (projection & Enums::DataProjection::CELL_FUNCTION_DATA) {
+        return sizeof(CellAccessTO);
+    }
+    if (projection & Enums::DataProjection::METADATA) {
+        return offsetof(CellAccessTO, cellFunctionType);
+    }
+    if (projection & Enums::DataProjection::CELL_CONNECTIONS) {
+        return offsetof(CellAccessTO, metadata);
+    }
+    if (projection & Enums::DataProjection::ENERGIES) {
+        return offsetof(CellAccessTO, maxConnections);
+    }
+    return offsetof(CellAccessTO, energy);
+}
+
 struct ClusterMetadataAccessTO
 {
     int nameLen;
@@ -13,28 +13,35 @@ private:
     int _size;
     int* _numEntries;
     T** _data;
+    MemoryAllocator* _allocator;
 
 public:
     Array()
         : _size(0)
+        , _allocator(nullptr)
     {}
 
-    __host__ __inline__ void init(int size)
+    //allocator = nullptr uses the allocator of the CudaMemoryManager
+    __host__ __inline__ void init(
+        int size,
+        MemorySubsystem::Type subsystem = MemorySubsystem::Entities,
+        MemoryAllocator* allocator = nullptr)
     {
         _size = size;
+        _allocator = allocator ? allocator : &CudaMemoryManager::getInstance().getAllocator();
         T* data = nullptr;
-        CudaMemoryManager::getInstance().acquireMemory<T>(size, data);
-        CudaMemoryManager::getInstance().acquireMemory<T*>(1, _data);
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numEntries);
+        _allocator->acquireMemory<T>(subsystem, size, data);
+        _allocator->acquireMemory<T*>(subsystem, 1, _data);
+        _allocator->acquireMemory<int>(subsystem, 1, _numEntries);
 
-        checkCudaErrors(cudaMemcpy(_data, &data, sizeof(T*), cudaMemcpyHostToDevice));
-        checkCudaErrors(cudaMemset(_numEntries, 0, sizeof(int)));
+        _allocator->copy(_data, &data, sizeof(T*));
+        _allocator->set(_numEntries, 0, sizeof(int));
     }
 
     __host__ __inline__ T* getArrayForHost() const
     {
         T* result;
-        checkCudaErrors(cudaMemcpy(&result, _data, sizeof(T*), cudaMemcpyDeviceToHost));
+        _allocator->copy(&result, _data, sizeof(T*));
         return result;
     }
 
@@ -44,11 +51,11 @@ public:
     __host__ __inline__ void free()
     {
         T* data = nullptr;
-        checkCudaErrors(cudaMemcpy(&data, _data, sizeof(T*), cudaMemcpyDeviceToHost));
+        _allocator->copy(&data, _data, sizeof(T*));
 
-        CudaMemoryManager::getInstance().freeMemory(data);
-        CudaMemoryManager::getInstance().freeMemory(_data);
-        CudaMemoryManager::getInstance().freeMemory(_numEntries);
+        _allocator->freeMemory(data);
+        _allocator->freeMemory(_data);
+        _allocator->freeMemory(_numEntries);
     }
 
     __device__ __inline__ void swapContent(Array& other)
@@ -62,7 +69,7 @@ public:
     int retrieveNumEntries() const
     {
         int result;
-        checkCudaErrors(cudaMemcpy(&result, _numEntries, sizeof(int), cudaMemcpyDeviceToHost));
+        _allocator->copy(&result, _numEntries, sizeof(int));
         return result;
     }
 
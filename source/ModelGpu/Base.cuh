@@ -5,6 +5,8 @@
 #include <device_launch_parameters.h>
 #include <helper_cuda.h>
 
+#include "Base/RandomStream.h"
+
 #include "Definitions.cuh"
 #include "Array.cuh"
 #include "CudaConstants.h"
@@ -25,50 +27,50 @@ struct PartitionData
 class CudaNumberGenerator
 {
 private:
-    unsigned int *_currentIndex;
-    int *_array;
-    int _size;
+    unsigned long long int* _currentPosition;
+    uint64_t _seed;
 
     uint64_t *_currentId;
 
+    //stream of the shared sequence, per-entity streams should use other ids
+    static uint64_t const SharedStreamId = ~0ull;
+
 public:
 
-    void init(int size)
+    //ids created on the device start with firstId
+    void init(uint64_t seed, uint64_t firstId = 1)
     {
-        _size = size;
-
-        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(1, _currentIndex);
-        CudaMemoryManager::getInstance().acquireMemory<int>(size, _array);
-        CudaMemoryManager::getInstance().acquireMemory<uint64_t>(1, _currentId);
+        _seed = seed;
 
-        checkCudaErrors(cudaMemset(_currentIndex, 0, sizeof(unsigned int)));
-        uint64_t hostCurrentId = 1;
-        checkCudaErrors(cudaMemcpy(_currentId, &hostCurrentId, sizeof(uint64_t), cudaMemcpyHostToDevice));
+        auto& memoryManager = CudaMemoryManager::getInstance();
+        memoryManager.acquireMemory<unsigned long long int>(MemorySubsystem::Other, 1, _currentPosition);
+        memoryManager.acquireMemory<uint64_t>(MemorySubsystem::Other, 1, _currentId);
 
-        std::vector<int> randomNumbers(size);
-        for (int i = 0; i < size; ++i) {
-            randomNumbers[i] = rand();
-        }
-        checkCudaErrors(cudaMemcpy(_array, randomNumbers.data(), sizeof(int)*size, cudaMemcpyHostToDevice));
+        memoryManager.set(_currentPosition, 0, sizeof(unsigned long long int));
+        uint64_t hostCurrentId = firstId;
+        memoryManager.copy(_currentId, &hostCurrentId, sizeof(uint64_t));
     }
 
 
     __device__ __inline__ int random(int maxVal)
     {
-        int number = getRandomNumber();
-        return number % (maxVal + 1);
+        return static_cast<int>(RandomStream::toRange(getRandomNumber(), static_cast<uint32_t>(maxVal) + 1));
     }
 
     __device__ __inline__ float random(float maxVal)
     {
-        int number = getRandomNumber();
-        return maxVal* static_cast<float>(number) / RAND_MAX;
+        return maxVal * RandomStream::toFloat(getRandomNumber());
     }
 
     __device__ __inline__ float random()
     {
-        int number = getRandomNumber();
-        return static_cast<float>(number) / RAND_MAX;
+        return RandomStream::toFloat(getRandomNumber());
+    }
+
+    //independent of the shared sequence and of other threads, e.g. streamId = cluster id
+    __device__ __inline__ RandomStream getStream(uint64_t streamId, uint64_t position = 0) const
+    {
+        return RandomStream(_seed, streamId, position);
     }
 
     __device__ __inline__ uint64_t createNewId_kernel()
@@ -78,20 +80,15 @@ public:
 
     void free()
     {
-        CudaMemoryManager::getInstance().freeMemory(_currentIndex);
-        CudaMemoryManager::getInstance().freeMemory(_array);
+        CudaMemoryManager::getInstance().freeMemory(_currentPosition);
         CudaMemoryManager::getInstance().freeMemory(_currentId);
-
-        cudaFree(_currentId);
-        cudaFree(_currentIndex);
-        cudaFree(_array);
     }
 
 private:
-    __device__ __inline__ int getRandomNumber()
+    __device__ __inline__ uint32_t getRandomNumber()
     {
-        int index = atomicInc(_currentIndex, _size - 1);
-        return _array[index];
+        auto const position = atomicAdd(_currentPosition, 1ull);
+        return RandomStream::generateNumber(_seed, SharedStreamId, position);
     }
 };
 
@@ -109,6 +106,39 @@ __device__ __inline__ PartitionData calcPartition(int numEntities, int division,
     return result;
 }
 
+//exclusive prefix sum of values[0..numValues-1] within one block, the total is written to values[numValues]
+__device__ __inline__ void calcExclusivePrefixSum_block(int* values, int numValues)
+{
+    __shared__ int chunkSums[1024];
+    auto const partition = calcPartition(numValues, threadIdx.x, blockDim.x);
+
+    int sum = 0;
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        sum += values[index];
+    }
+    chunkSums[threadIdx.x] = sum;
+    __syncthreads();
+
+    if (0 == threadIdx.x) {
+        int offset = 0;
+        for (int i = 0; i < blockDim.x; ++i) {
+            auto const chunkSum = chunkSums[i];
+            chunkSums[i] = offset;
+            offset += chunkSum;
+        }
+        values[numValues] = offset;
+    }
+    __syncthreads();
+
+    int offset = chunkSums[threadIdx.x];
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const value = values[index];
+        values[index] = offset;
+        offset += value;
+    }
+    __syncthreads();
+}
+
 __host__ __device__ __inline__ int2 toInt2(float2 const &p)
 {
     return{ static_cast<int>(p.x), static_cast<int>(p.y) };
@@ -291,3 +321,7 @@ __host__ __device__ __inline__ void swap(T &a, T &b)
 #define KERNEL_CALL_1_1(func, ...)  \
         func<<<1, 1>>>(##__VA_ARGS__); \
         cudaDeviceSynchronize();
+
+#define KERNEL_CALL_1_BLOCK(func, ...)  \
+        func<<<1, cudaConstants.NUM_THREADS_PER_BLOCK>>>(##__VA_ARGS__); \
+        cudaDeviceSynchronize();
@@ -6,9 +6,9 @@ struct CellFunctionData
 {
     MapSectionCollector mapSectionCollector;
 
-    __host__ __inline__ void init(int2 const& universeSize)
+    __host__ __inline__ void init(int2 const& universeSize, int maxClusters)
     {
-        mapSectionCollector.init(universeSize, 50);
+        mapSectionCollector.init(universeSize, 50, maxClusters);
     }
 
     __host__ __inline__ void free()
@@ -8,6 +8,8 @@
 #include "Cell.cuh"
 #include "Token.cuh"
 #include "FreezingKernels.cuh"
+#include "ReorderingKernels.cuh"
+#include "SharedStrings.cuh"
 
 namespace {
     __device__ const float FillLevelFactor = 2.0f / 3.0f;
@@ -259,6 +261,25 @@ __global__ void cleanupParticleMap(SimulationData data)
     data.particleMap.cleanup_system();
 }
 
+__device__ __inline__ void relocateString(int len, char* string, DynamicMemory& strings)
+{
+    if (len > 0 && claimString(string)) {
+        auto const newString = allocateString(strings, len);
+        for (int i = 0; i < len; ++i) {
+            newString[i] = string[i];
+        }
+        getStringHeader(string) = reinterpret_cast<unsigned long long>(newString);
+    }
+}
+
+__device__ __inline__ void redirectString(int len, char*& string)
+{
+    if (len > 0) {
+        string = reinterpret_cast<char*>(getStringHeader(string));
+    }
+}
+
+//shared strings are copied once, the references are redirected to the copies in redirectMetadata
 __global__ void cleanupMetadata(Array<Cluster*> clusterPointers, DynamicMemory strings)
 {
     auto const clusterBlock = calcPartition(clusterPointers.getNumEntries(), blockIdx.x, gridDim.x);
@@ -266,41 +287,35 @@ __global__ void cleanupMetadata(Array<Cluster*> clusterPointers, DynamicMemory s
         auto& cluster = clusterPointers.at(clusterIndex);
 
         if (0 == threadIdx.x) {
-            auto const len = cluster->metadata.nameLen;
-            auto newName = strings.getArray<char>(len);
-            for(int i = 0; i < len; ++i) {
-                newName[i] = cluster->metadata.name[i];
-            }
-            cluster->metadata.name = newName;
+            relocateString(cluster->metadata.nameLen, cluster->metadata.name, strings);
         }
 
         auto const cellBlock = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
         for (int cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
             auto& cell = cluster->cellPointers[cellIndex];
-            {
-                auto const len = cell->metadata.nameLen;
-                auto newName = strings.getArray<char>(len);
-                for (int i = 0; i < len; ++i) {
-                    newName[i] = cell->metadata.name[i];
-                }
-                cell->metadata.name = newName;
-            }
-            {
-                auto const len = cell->metadata.descriptionLen;
-                auto newDescription = strings.getArray<char>(len);
-                for (int i = 0; i < len; ++i) {
-                    newDescription[i] = cell->metadata.description[i];
-                }
-                cell->metadata.description = newDescription;
-            }
-            {
-                auto const len = cell->metadata.sourceCodeLen;
-                auto newSourceCode = strings.getArray<char>(len);
-                for (int i = 0; i < len; ++i) {
-                    newSourceCode[i] = cell->metadata.sourceCode[i];
-                }
-                cell->metadata.sourceCode = newSourceCode;
-            }
+            relocateString(cell->metadata.nameLen, cell->metadata.name, strings);
+            relocateString(cell->metadata.descriptionLen, cell->metadata.description, strings);
+            relocateString(cell->metadata.sourceCodeLen, cell->metadata.sourceCode, strings);
+        }
+    }
+}
+
+__global__ void redirectMetadata(Array<Cluster*> clusterPointers)
+{
+    auto const clusterBlock = calcPartition(clusterPointers.getNumEntries(), blockIdx.x, gridDim.x);
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        auto& cluster = clusterPointers.at(clusterIndex);
+
+        if (0 == threadIdx.x) {
+            redirectString(cluster->metadata.nameLen, cluster->metadata.name);
+        }
+
+        auto const cellBlock = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        for (int cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
+            auto& cell = cluster->cellPointers[cellIndex];
+            redirectString(cell->metadata.nameLen, cell->metadata.name);
+            redirectString(cell->metadata.descriptionLen, cell->metadata.description);
+            redirectString(cell->metadata.sourceCodeLen, cell->metadata.sourceCode);
         }
     }
 }
@@ -328,6 +343,11 @@ __global__ void cleanupAfterSimulation(SimulationData data)
         KERNEL_CALL_1_1(unfreeze, data);
         data.entities.clusterFreezedPointers.reset();
 
+        auto const reorderingTimesteps = cudaExecutionParameters.reorderingTimesteps;
+        if (reorderingTimesteps > 0 && (data.timestep % reorderingTimesteps) == 0) {
+            reorderEntities(data);
+        }
+
         if (data.entities.particles.getNumEntries() > cudaConstants.MAX_PARTICLES * FillLevelFactor) {
             data.entitiesForCleanup.particles.reset();
             KERNEL_CALL(cleanupParticles, data);
@@ -367,6 +387,7 @@ __global__ void cleanupAfterSimulation(SimulationData data)
         if (data.entities.strings.getNumBytes() > cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE * FillLevelFactor) {
             data.entitiesForCleanup.strings.reset();
             KERNEL_CALL(cleanupMetadata, data.entities.clusterPointers, data.entitiesForCleanup.strings);
+            KERNEL_CALL(redirectMetadata, data.entities.clusterPointers);
             data.entities.strings.swapContent(data.entitiesForCleanup.strings);
         }
     }
@@ -422,6 +443,7 @@ __global__ void cleanupAfterDataManipulation(SimulationData data)
     if (data.entities.strings.getNumBytes() > cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE * FillLevelFactor) {
         data.entitiesForCleanup.strings.reset();
         KERNEL_CALL(cleanupMetadata, data.entities.clusterPointers, data.entitiesForCleanup.strings);
+        KERNEL_CALL(redirectMetadata, data.entities.clusterPointers);
         data.entities.strings.swapContent(data.entitiesForCleanup.strings);
     }
 }
@@ -25,12 +25,19 @@ struct Cluster
     int decompositionRequired;  //0 = false, 1 = true
     int locked;	//0 = unlocked, 1 = locked
     Cluster* clusterToFuse;
+    int ghost;  //1 = copy of a cluster simulated elsewhere, which acts on other clusters but is not changed itself
 
     __device__ __inline__ void init()
     {
         _timestepsUntilFreezing = 30;
         _freezed = 0;
         _pointerArrayElement = nullptr;
+        ghost = 0;
+    }
+
+    __device__ __inline__ bool isGhost() const
+    {
+        return 1 == ghost;
     }
 
     __device__ __inline__ float2& getVelocity()
@@ -115,6 +122,7 @@ struct Cluster
     __device__ __inline__ bool isCandidateToFreeze()
     {
         return _timestepsUntilFreezing == 0
+            && 0 == ghost
             && numTokenPointers == 0
             && decompositionRequired == 0
             && clusterToFuse == nullptr;
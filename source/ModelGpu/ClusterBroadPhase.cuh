@@ -0,0 +1,144 @@
+#pragma once
+
+#include "Base.cuh"
+#include "Array.cuh"
+#include "Map.cuh"
+#include "CollisionBroadPhase.h"
+
+#include "Cluster.cuh"
+#include "Cell.cuh"
+
+/**
+ * Flags the clusters whose bounding circles overlap with another one (see CollisionBroadPhaseLayout).
+ * Usage per timestep: reset_system, insert_block, calcSectionOffsets_block (single block), scatter_system,
+ * flagCandidates_system. Clusters which are not flagged cannot touch cells of other clusters in the cell map.
+ */
+class ClusterBroadPhase
+{
+public:
+    //covers the cell map lookups in the collision handling: cells in neighboring map positions are closer than 2*sqrt(2)
+    static float constexpr Margin = 3.0f;
+    static int const SectionSize = 16;
+
+    __host__ __inline__ void init(int2 const& universeSize, int maxClusters, int maxEntries)
+    {
+        _layout.init(universeSize.x, universeSize.y, SectionSize, Margin);
+        _maxEntries = maxEntries;
+        _circles.init(maxClusters, MemorySubsystem::Maps);
+        _candidates.init(maxClusters, MemorySubsystem::Maps);
+        _entries.init(maxEntries, MemorySubsystem::Maps);
+        _sectionOffsets.init(_layout.getNumSections() + 1, MemorySubsystem::Maps);
+        _sectionCursors.init(_layout.getNumSections(), MemorySubsystem::Maps);
+    }
+
+    __host__ __inline__ void free()
+    {
+        _circles.free();
+        _candidates.free();
+        _entries.free();
+        _sectionOffsets.free();
+        _sectionCursors.free();
+    }
+
+    __device__ __inline__ void reset_system()
+    {
+        auto const partition = calcPartition(
+            _layout.getNumSections(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            _sectionOffsets.at(index) = 0;
+        }
+    }
+
+    __device__ __inline__ void insert_block(int clusterIndex, Cluster* cluster, MapInfo const& map)
+    {
+        __shared__ int radiusBits;     //radius is non-negative, hence the bits are ordered as integers
+        if (0 == threadIdx.x) {
+            radiusBits = 0;
+        }
+        __syncthreads();
+
+        auto const cellBlock = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        float radius = 0;
+        for (int cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
+            radius = max(radius, map.mapDistance(cluster->cellPointers[cellIndex]->absPos, cluster->pos));
+        }
+        atomicMax_block(&radiusBits, __float_as_int(radius));
+        __syncthreads();
+
+        if (0 == threadIdx.x) {
+            auto& circle = _circles.at(clusterIndex);
+            circle = {cluster->pos.x, cluster->pos.y, __int_as_float(radiusBits)};
+            _candidates.at(clusterIndex) = 0;
+            _layout.forEachSection(circle, [&](int sectionIndex) { atomicAdd(&_sectionOffsets.at(sectionIndex), 1); });
+        }
+        __syncthreads();
+    }
+
+    __device__ __inline__ void calcSectionOffsets_block()
+    {
+        auto const numSections = _layout.getNumSections();
+        calcExclusivePrefixSum_block(_sectionOffsets.getArrayForDevice(), numSections);
+
+        auto const partition = calcPartition(numSections, threadIdx.x, blockDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            _sectionCursors.at(index) = _sectionOffsets.at(index);
+        }
+        __syncthreads();
+    }
+
+    __device__ __inline__ void scatter_system(int numClusters)
+    {
+        if (isOverflown()) {
+            return;
+        }
+        auto const partition =
+            calcPartition(numClusters, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int clusterIndex = partition.startIndex; clusterIndex <= partition.endIndex; ++clusterIndex) {
+            _layout.forEachSection(_circles.at(clusterIndex), [&](int sectionIndex) {
+                _entries.at(atomicAdd(&_sectionCursors.at(sectionIndex), 1)) = clusterIndex;
+            });
+        }
+    }
+
+    __device__ __inline__ void flagCandidates_system(int numClusters)
+    {
+        if (isOverflown()) {
+            return;
+        }
+        auto const partition =
+            calcPartition(numClusters, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int clusterIndex = partition.startIndex; clusterIndex <= partition.endIndex; ++clusterIndex) {
+            auto const& circle = _circles.at(clusterIndex);
+            auto& candidate = _candidates.at(clusterIndex);
+            _layout.forEachSection(circle, [&](int sectionIndex) {
+                auto const endEntry = _sectionOffsets.at(sectionIndex + 1);
+                for (int entry = _sectionOffsets.at(sectionIndex); entry < endEntry && 0 == candidate; ++entry) {
+                    auto const otherClusterIndex = _entries.at(entry);
+                    if (otherClusterIndex != clusterIndex && _layout.overlaps(circle, _circles.at(otherClusterIndex))) {
+                        candidate = 1;
+                    }
+                }
+            });
+        }
+    }
+
+    //all clusters are candidates if the entries did not fit into memory
+    __device__ __inline__ bool isCandidate(int clusterIndex) const
+    {
+        return isOverflown() || 1 == _candidates.at(clusterIndex);
+    }
+
+private:
+    __device__ __inline__ bool isOverflown() const
+    {
+        return _sectionOffsets.at(_layout.getNumSections()) > _maxEntries;
+    }
+
+    CollisionBroadPhaseLayout _layout;
+    int _maxEntries;
+    Array<BoundingCircle> _circles;
+    Array<int> _candidates;
+    Array<int> _entries;
+    Array<int> _sectionOffsets;
+    Array<int> _sectionCursors;
+};
@@ -8,7 +8,7 @@
 #include "Physics.cuh"
 #include "Map.cuh"
 #include "EntityFactory.cuh"
-#include "Tagger.cuh"
+#include "ComponentLabeling.h"
 #include "DEBUG_cluster.cuh"
 
 class ClusterProcessor
@@ -29,8 +29,6 @@ public:
     __inline__ __device__ void processingClusterCopy_block();
 
 private:
-    __inline__ __device__ void processingDecomposition_optimizedForSmallCluster_block();
-    __inline__ __device__ void processingDecomposition_optimizedForLargeCluster_block();
 
     __inline__ __device__ void updateCellVelocity_block(Cluster* cluster);
     __inline__ __device__ void destroyDyingCell(Cell* cell);
@@ -65,6 +63,11 @@ private:
 
  __inline__ __device__ void ClusterProcessor::processingCollision_block()
 {
+    auto const clusterIndex = _clusterPointer - _data->entities.clusterPointers.getArrayForDevice();
+    if (_cluster->isGhost() || !_data->clusterBroadPhase.isCandidate(clusterIndex)) {
+        return;
+    }
+
     __shared__ Cluster* cluster;
     __shared__ unsigned long long int largestOtherClusterData;
     __shared__ Cluster* clustersArray;
@@ -335,11 +338,15 @@ private:
 
             cluster->setVelocity(vA2);
             cluster->setAngularVelocity(angularVelA2);
-            largestOtherCluster->setVelocity(vB2);
-            largestOtherCluster->setAngularVelocity(angularVelB2);
+            if (!largestOtherCluster->isGhost()) {
+                largestOtherCluster->setVelocity(vB2);
+                largestOtherCluster->setAngularVelocity(angularVelB2);
+            }
         }
         updateCellVelocity_block(cluster);
-        updateCellVelocity_block(largestOtherCluster);
+        if (!largestOtherCluster->isGhost()) {
+            updateCellVelocity_block(largestOtherCluster);
+        }
     }
     __syncthreads();
 
@@ -351,6 +358,9 @@ private:
 
 __inline__ __device__ void ClusterProcessor::destroyCloseCell_block()
 {
+    if (_cluster->isGhost()) {
+        return;
+    }
     for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
         Cell *cell = _cluster->cellPointers[cellIndex];
         destroyCloseCell(cell);
@@ -393,16 +403,92 @@ __inline__ __device__ void ClusterProcessor::processingDecomposition_block()
         return;
     }
 
-    if (_cluster->numCellPointers < 100) {
-        processingDecomposition_optimizedForSmallCluster_block();
+    __shared__ int* parents;
+    if (0 == threadIdx.x) {
+        parents = _data->dynamicMemory.getArray<int>(_cluster->numCellPointers);
     }
-    else {
-        processingDecomposition_optimizedForLargeCluster_block();
+    __syncthreads();
+
+    //cell tags serve as indices for the union-find
+    for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
+        Cell* cell = _cluster->cellPointers[cellIndex];
+        if (1 == cell->alive) {
+            for (int i = 0; i < cell->numConnections; ++i) {
+                if (1 != cell->connections[i]->alive) {
+                    for (int j = i + 1; j < cell->numConnections; ++j) {
+                        cell->connections[j - 1] = cell->connections[j];
+                    }
+                    --cell->numConnections;
+                    --i;
+                }
+            }
+        }
+        else {
+            cell->numConnections = 0;
+        }
+        cell->tag = cellIndex;
+        if (parents) {
+            ComponentLabeling::init(parents, cellIndex);
+        }
+    }
+    __syncthreads();
+
+    //dynamic memory exhausted: label propagation yields the same labels (smallest cell index per component)
+    //without scratch memory but needs a number of passes depending on the cluster diameter
+    if (!parents) {
+        __shared__ bool tagsChanged;
+        while (true) {
+            if (0 == threadIdx.x) {
+                tagsChanged = false;
+            }
+            __syncthreads();
+
+            for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
+                Cell* cell = _cluster->cellPointers[cellIndex];
+                for (int i = 0; i < cell->numConnections; ++i) {
+                    auto const otherTag = cell->connections[i]->tag;
+                    if (otherTag < cell->tag) {
+                        atomicMin(&cell->tag, otherTag);
+                        tagsChanged = true;
+                    }
+                }
+            }
+            __syncthreads();
+
+            if (!tagsChanged) {
+                break;
+            }
+            __syncthreads();
+        }
+        return;
     }
+
+    for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
+        Cell* cell = _cluster->cellPointers[cellIndex];
+        for (int i = 0; i < cell->numConnections; ++i) {
+            ComponentLabeling::unite(parents, cellIndex, cell->connections[i]->tag);
+        }
+    }
+    __syncthreads();
+
+    for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
+        ComponentLabeling::flatten(parents, cellIndex);
+    }
+    __syncthreads();
+
+    for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
+        _cluster->cellPointers[cellIndex]->tag = parents[cellIndex];
+    }
+    __syncthreads();
 }
 
 __inline__ __device__ void ClusterProcessor::processingMovement_block()
 {
+    //ghosts stay where the exchange has put them, only their cells are mapped
+    if (_cluster->isGhost()) {
+        return;
+    }
+
     __shared__ float rotMatrix[2][2];
     if (0 == threadIdx.x) {
         _cluster->angle += _cluster->getAngularVelocity();
@@ -433,6 +519,9 @@ __inline__ __device__ void ClusterProcessor::updateMap_block()
 
 __inline__ __device__ void ClusterProcessor::processingRadiation_block()
 {
+    if (_cluster->isGhost()) {
+        return;
+    }
     for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
         Cell *cell = _cluster->cellPointers[cellIndex];
 
@@ -516,7 +605,7 @@ __inline__ __device__ void ClusterProcessor::destroyCloseCell(float2 const & pos
     auto distance = _data->cellMap.mapDistance(cell->absPos, cellFromMap->absPos);
     if (distance < cudaSimulationParameters.cellMinDistance) {
         Cluster* cluster = cell->cluster;
-        if (mapCluster->numCellPointers >= cluster->numCellPointers) {
+        if (mapCluster->numCellPointers >= cluster->numCellPointers || mapCluster->isGhost()) {
             atomicExch(&cell->alive, 0);
             atomicExch(&cluster->decompositionRequired, 1);
         }
@@ -529,6 +618,9 @@ __inline__ __device__ void ClusterProcessor::destroyCloseCell(float2 const & pos
 
 __inline__ __device__ bool ClusterProcessor::areConnectable(Cell * cell1, Cell * cell2)
 {
+    if (cell1->cluster->isGhost() || cell2->cluster->isGhost()) {
+        return false;
+    }
     return cell1->numConnections < cell1->maxConnections && cell2->numConnections < cell2->maxConnections;
 }
 
@@ -956,123 +1048,3 @@ __inline__ __device__ void ClusterProcessor::processingClusterCopy_block()
     }
     _cluster->timestepSimulated();
 }
-
-__inline__ __device__ void ClusterProcessor::processingDecomposition_optimizedForSmallCluster_block()
-{
-    __shared__ bool changes;
-
-    for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
-        _cluster->cellPointers[cellIndex]->tag = cellIndex;
-    }
-    do {
-        changes = false;
-        __syncthreads();
-        for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
-            Cell* cell = _cluster->cellPointers[cellIndex];
-            if (1 == cell->alive) {
-                for (int i = 0; i < cell->numConnections; ++i) {
-                    Cell& otherCell = *cell->connections[i];
-                    if (1 == otherCell.alive) {
-                        if (otherCell.tag < cell->tag) {
-                            cell->tag = otherCell.tag;
-                            changes = true;
-                        }
-                    }
-                    else {
-                        for (int j = i + 1; j < cell->numConnections; ++j) {
-                            cell->connections[j - 1] = cell->connections[j];
-                        }
-                        --cell->numConnections;
-                        --i;
-                    }
-                }
-            }
-            else {
-                cell->numConnections = 0;
-            }
-        }
-        __syncthreads();
-    } while (changes);
-}
-
-__inline__ __device__ void ClusterProcessor::processingDecomposition_optimizedForLargeCluster_block()
-{
-    for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
-        auto& cell = _cluster->cellPointers[cellIndex];
-        if (1 == cell->alive) {
-            for (int i = 0; i < cell->numConnections; ++i) {
-                auto& otherCell = cell->connections[i];
-                if (1 != otherCell->alive) {
-                    for (int j = i + 1; j < cell->numConnections; ++j) {
-                        cell->connections[j - 1] = cell->connections[j];
-                    }
-                    --cell->numConnections;
-                    --i;
-                }
-            }
-        }
-        else {
-            cell->numConnections = 0;
-        }
-    }
-    __syncthreads();
-
-
-    for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
-        auto& cell = _cluster->cellPointers[cellIndex];
-        cell->tag = 0;
-    }
-    __syncthreads();
-
-    __shared__ int currentTag;
-    if (0 == threadIdx.x) {
-        currentTag = 1;
-    }
-    __syncthreads();
-
-    __shared__ Tagger::DynamicMemory dynamicMemory;
-    if (0 == threadIdx.x) {
-        dynamicMemory.cellsToEvaluate = _data->dynamicMemory.getArray<Cell*>(_cluster->numCellPointers);
-        dynamicMemory.cellsToEvaluateNextRound = _data->dynamicMemory.getArray<Cell*>(_cluster->numCellPointers);
-    }
-    __syncthreads();
-
-    __shared__ int startCellFound; // 0 = no, 1 = yes
-    __shared__ Cell* startCell;
-
-    do {
-        __syncthreads();
-        if (0 == threadIdx.x) {
-            startCellFound = 0;
-        }
-        __syncthreads();
-
-        for (int cellIndex = _cellBlock.startIndex; cellIndex <= _cellBlock.endIndex; ++cellIndex) {
-            auto& cell = _cluster->cellPointers[cellIndex];
-            if (0 == cell->tag && 0 == startCellFound) {
-                int orig = atomicExch_block(&startCellFound, 1);
-                if (0 == orig) {
-                    startCell = cell;
-                    startCell->tag = currentTag;
-                    break;
-                }
-            }
-        }
-        __syncthreads();
-
-        if (1 == startCellFound) {
-            if (startCell->alive) {
-                Tagger::tagComponent_block(_cluster, startCell, nullptr, currentTag, 0, dynamicMemory);
-            }
-            __syncthreads();
-
-            if (0 == threadIdx.x) {
-                ++currentTag;
-            }
-        }
-        __syncthreads();
-
-    } while (1 == startCellFound);
-
-    __syncthreads();
-}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Base.cuh"
+#include "Array.cuh"
+#include "WeightedPartitioning.h"
+
+#include "Cluster.cuh"
+
+/**
+ * Assigns clusters to blocks by the number of their cells and tokens instead of their count.
+ * Usage per timestep: calcWeights_system, calcOffsets_block (single block), getPartition in the cluster kernels.
+ * A single cluster is always processed by one block since the cluster kernels synchronize within the block.
+ */
+class ClusterWorkPartition
+{
+public:
+    __host__ __inline__ void init(int maxClusters)
+    {
+        _weightOffsets.init(maxClusters + 1, MemorySubsystem::Other);
+    }
+
+    __host__ __inline__ void free() { _weightOffsets.free(); }
+
+    __device__ __inline__ void calcWeights_system(Array<Cluster*> const& clusterPointers)
+    {
+        auto const numClusters = clusterPointers.getNumEntries();
+        auto const partition =
+            calcPartition(numClusters, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& cluster = clusterPointers.at(index);
+            _weightOffsets.at(index) = cluster ? 1 + cluster->numCellPointers + cluster->numTokenPointers : 1;
+        }
+        if (0 == threadIdx.x + blockIdx.x) {
+            _weightOffsets.setNumEntries(numClusters + 1);
+        }
+    }
+
+    __device__ __inline__ void calcOffsets_block()
+    {
+        calcExclusivePrefixSum_block(_weightOffsets.getArrayForDevice(), _weightOffsets.getNumEntries() - 1);
+    }
+
+    //falls back to the division by count if the number of clusters has changed since calcWeights_system
+    __device__ __inline__ PartitionData getPartition(int numClusters, int division, int numDivisions) const
+    {
+        if (numClusters != _weightOffsets.getNumEntries() - 1) {
+            return calcPartition(numClusters, division, numDivisions);
+        }
+        PartitionData result;
+        WeightedPartitioning::calcPartition(
+            _weightOffsets.getArrayForDevice(),
+            numClusters,
+            division,
+            numDivisions,
+            result.startIndex,
+            result.endIndex);
+        return result;
+    }
+
+private:
+    Array<int> _weightOffsets;
+};
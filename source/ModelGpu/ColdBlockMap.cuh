@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Base.cuh"
+#include "Map.cuh"
+#include "ColdClusterStore.h"
+
+#include "Cluster.cuh"
+#include "Cell.cuh"
+
+/**
+ * Device view on the blocks which contain clusters evicted to the ColdClusterStore. A block is woken up if a cell
+ * of an active cluster is located in it or in one of its neighbor blocks, i.e. if the evicted clusters might be
+ * hit by collisions or sensors.
+ */
+class ColdBlockMap
+{
+public:
+    __host__ __inline__ void init(int2 const& universeSize)
+    {
+        _numBlocksX = (universeSize.x + ColdClusterStore::BlockSize - 1) / ColdClusterStore::BlockSize;
+        _numBlocksY = (universeSize.y + ColdClusterStore::BlockSize - 1) / ColdClusterStore::BlockSize;
+
+        auto& memoryManager = CudaMemoryManager::getInstance();
+        memoryManager.acquireMemory<int>(MemorySubsystem::Maps, getNumBlocks(), _coldBlocks);
+        memoryManager.acquireMemory<int>(MemorySubsystem::Maps, getNumBlocks(), _wokenBlocks);
+        memoryManager.set(_coldBlocks, 0, sizeof(int) * getNumBlocks());
+        memoryManager.set(_wokenBlocks, 0, sizeof(int) * getNumBlocks());
+    }
+
+    __host__ __inline__ void free()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_coldBlocks);
+        CudaMemoryManager::getInstance().freeMemory(_wokenBlocks);
+    }
+
+    __host__ __device__ __inline__ int getNumBlocks() const { return _numBlocksX * _numBlocksY; }
+
+    __host__ __inline__ int* getColdBlocksForHost() const { return _coldBlocks; }
+    __host__ __inline__ int* getWokenBlocksForHost() const { return _wokenBlocks; }
+
+    __device__ __inline__ void markWokenBlocks_block(Cluster* cluster, MapInfo const& map)
+    {
+        auto const cellBlock = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        for (int cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
+            int2 posInt = {floorInt(cluster->cellPointers[cellIndex]->absPos.x),
+                           floorInt(cluster->cellPointers[cellIndex]->absPos.y)};
+            map.mapPosCorrection(posInt);
+            auto const blockX = posInt.x / ColdClusterStore::BlockSize;
+            auto const blockY = posInt.y / ColdClusterStore::BlockSize;
+            for (int dx = -1; dx <= 1; ++dx) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    auto const blockIndex = ((blockX + dx + _numBlocksX) % _numBlocksX)
+                        + ((blockY + dy + _numBlocksY) % _numBlocksY) * _numBlocksX;
+                    if (1 == _coldBlocks[blockIndex]) {
+                        _wokenBlocks[blockIndex] = 1;
+                    }
+                }
+            }
+        }
+        __syncthreads();
+    }
+
+private:
+    int _numBlocksX;
+    int _numBlocksY;
+    int* _coldBlocks;      //1 = block contains evicted clusters
+    int* _wokenBlocks;     //1 = evicted clusters of the block have to be restored
+};
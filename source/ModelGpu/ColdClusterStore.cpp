@@ -0,0 +1,500 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "ColdClusterStore.h"
+
+namespace
+{
+    class ByteWriter
+    {
+    public:
+        ByteWriter(vector<unsigned char>& bytes)
+            : _bytes(bytes)
+        {}
+
+        template <typename T>
+        void write(T const& value)
+        {
+            write(&value, sizeof(T));
+        }
+
+        void write(void const* data, int size)
+        {
+            auto const bytes = static_cast<unsigned char const*>(data);
+            _bytes.insert(_bytes.end(), bytes, bytes + size);
+        }
+
+    private:
+        vector<unsigned char>& _bytes;
+    };
+
+    class ByteReader
+    {
+    public:
+        ByteReader(vector<unsigned char> const& bytes)
+            : _bytes(bytes)
+        {}
+
+        template <typename T>
+        T read()
+        {
+            T result;
+            read(&result, sizeof(T));
+            return result;
+        }
+
+        void read(void* data, int size)
+        {
+            std::memcpy(data, &_bytes[_pos], size);
+            _pos += size;
+        }
+
+        void skip(int size) { _pos += size; }
+
+    private:
+        vector<unsigned char> const& _bytes;
+        int _pos = 0;
+    };
+
+    void writeVarInt(vector<unsigned char>& bytes, int value)
+    {
+        while (value >= 0x80) {
+            bytes.emplace_back(static_cast<unsigned char>(value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        bytes.emplace_back(static_cast<unsigned char>(value));
+    }
+
+    int readVarInt(vector<unsigned char> const& bytes, int& pos)
+    {
+        int result = 0;
+        int shift = 0;
+        unsigned char byte;
+        do {
+            byte = bytes[pos++];
+            result |= (byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return result;
+    }
+
+    //transfer objects consist mostly of zero bytes (unused memory, bonds and strings), hence each run of zeros is
+    //replaced by a zero byte followed by the run length
+    vector<unsigned char> encodeZeroRuns(vector<unsigned char> const& bytes)
+    {
+        vector<unsigned char> result;
+        result.reserve(bytes.size() / 2);
+        for (int pos = 0; pos < bytes.size();) {
+            if (0 != bytes[pos]) {
+                result.emplace_back(bytes[pos++]);
+                continue;
+            }
+            int runLength = 0;
+            while (pos < bytes.size() && 0 == bytes[pos]) {
+                ++runLength;
+                ++pos;
+            }
+            result.emplace_back(0);
+            writeVarInt(result, runLength);
+        }
+        result.shrink_to_fit();
+        return result;
+    }
+
+    vector<unsigned char> decodeZeroRuns(vector<unsigned char> const& bytes, int numDecodedBytes)
+    {
+        vector<unsigned char> result;
+        result.reserve(numDecodedBytes);
+        for (int pos = 0; pos < bytes.size();) {
+            auto const byte = bytes[pos++];
+            if (0 != byte) {
+                result.emplace_back(byte);
+                continue;
+            }
+            result.resize(result.size() + readVarInt(bytes, pos), 0);
+        }
+        return result;
+    }
+
+    //strings are copied with their header and remain shared within the record
+    void copyString(
+        int len,
+        int& stringIndex,
+        char const* sourceBytes,
+        vector<char>& targetBytes,
+        unordered_map<int, int>& targetIndexBySourceIndex)
+    {
+        if (len > 0) {
+            auto const findResult = targetIndexBySourceIndex.find(stringIndex);
+            if (findResult != targetIndexBySourceIndex.end()) {
+                stringIndex = findResult->second;
+                return;
+            }
+            auto const newStringIndex = static_cast<int>(targetBytes.size()) + STRING_HEADER_SIZE;
+            auto const blockStart = sourceBytes + stringIndex - STRING_HEADER_SIZE;
+            targetBytes.insert(targetBytes.end(), blockStart, blockStart + getStringBlockSize(len));
+            targetIndexBySourceIndex.emplace(stringIndex, newStringIndex);
+            stringIndex = newStringIndex;
+        }
+    }
+
+    void rebaseString(int len, int& stringIndex, int offset)
+    {
+        if (len > 0) {
+            stringIndex += offset;
+        }
+    }
+}
+
+ColdClusterStore::ColdClusterStore(IntVector2D const& universeSize, bool compress)
+    : _universeSize(universeSize)
+    , _numBlocksX((universeSize.x + BlockSize - 1) / BlockSize)
+    , _numBlocksY((universeSize.y + BlockSize - 1) / BlockSize)
+    , _compress(compress)
+{}
+
+void ColdClusterStore::evict(DataAccessTO const& dataTO)
+{
+    for (int clusterIndex = 0; clusterIndex < *dataTO.numClusters; ++clusterIndex) {
+        auto const& clusterTO = dataTO.clusters[clusterIndex];
+        removeRecord(clusterTO.id);
+
+        auto record = createRecord(dataTO, clusterTO);
+        for (int blockIndex : record.blockIndices) {
+            _clusterIdsByBlock[blockIndex].insert(clusterTO.id);
+        }
+        ++_memoryUsage.numClusters;
+        _memoryUsage.numCells += record.numCells;
+        _memoryUsage.numTokens += record.numTokens;
+        _memoryUsage.numStringBytes += record.numStringBytes;
+        _memoryUsage.numBytes += record.bytes.size();
+        _memoryUsage.numUncompressedBytes += record.numUncompressedBytes;
+        _recordsByClusterId.emplace(clusterTO.id, std::move(record));
+    }
+}
+
+int ColdClusterStore::restore(
+    vector<int> const& blockIndices,
+    DataAccessTO const& dataTO,
+    Capacity const& capacity)
+{
+    int result = 0;
+    for (auto const& clusterId : getClusterIds(blockIndices)) {
+        auto const& record = _recordsByClusterId.at(clusterId);
+        if (!readRecord(record, decodeRecord(record), dataTO, capacity, Enums::DataProjection::ALL)) {
+            break;
+        }
+        removeRecord(clusterId);
+        ++result;
+    }
+    return result;
+}
+
+int ColdClusterStore::restore(
+    IntVector2D const& rectUpperLeft,
+    IntVector2D const& rectLowerRight,
+    DataAccessTO const& dataTO,
+    Capacity const& capacity)
+{
+    return restore(getBlockIndices(rectUpperLeft, rectLowerRight), dataTO, capacity);
+}
+
+int ColdClusterStore::restoreAll(DataAccessTO const& dataTO, Capacity const& capacity)
+{
+    vector<int> blockIndices;
+    for (auto const& clusterIdsByBlock : _clusterIdsByBlock) {
+        blockIndices.emplace_back(clusterIdsByBlock.first);
+    }
+    return restore(blockIndices, dataTO, capacity);
+}
+
+bool ColdClusterStore::copy(
+    IntVector2D const& rectUpperLeft,
+    IntVector2D const& rectLowerRight,
+    DataAccessTO const& dataTO,
+    Capacity const& capacity,
+    int projection,
+    int& position) const
+{
+    auto const clusterIds = getClusterIds(getBlockIndices(rectUpperLeft, rectLowerRight));
+    for (; position < clusterIds.size(); ++position) {
+        auto const& record = _recordsByClusterId.at(clusterIds[position]);
+        auto const bytes = decodeRecord(record);
+        if (!hasCellInRect(record, bytes, rectUpperLeft, rectLowerRight)) {
+            continue;
+        }
+        if (!readRecord(record, bytes, dataTO, capacity, projection)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int ColdClusterStore::remove(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    int result = 0;
+    for (auto const& clusterId : getClusterIds(getBlockIndices(rectUpperLeft, rectLowerRight))) {
+        auto const& record = _recordsByClusterId.at(clusterId);
+        if (hasCellInRect(record, decodeRecord(record), rectUpperLeft, rectLowerRight)) {
+            removeRecord(clusterId);
+            ++result;
+        }
+    }
+    return result;
+}
+
+void ColdClusterStore::clear()
+{
+    _recordsByClusterId.clear();
+    _clusterIdsByBlock.clear();
+    _memoryUsage = MemoryUsage();
+}
+
+int ColdClusterStore::getNumBlocks() const
+{
+    return _numBlocksX * _numBlocksY;
+}
+
+vector<int> ColdClusterStore::getColdBlocks() const
+{
+    vector<int> result(getNumBlocks(), 0);
+    for (auto const& clusterIdsByBlock : _clusterIdsByBlock) {
+        result[clusterIdsByBlock.first] = 1;
+    }
+    return result;
+}
+
+auto ColdClusterStore::getMemoryUsage() const -> MemoryUsage
+{
+    return _memoryUsage;
+}
+
+auto ColdClusterStore::createRecord(DataAccessTO const& dataTO, ClusterAccessTO const& clusterTO) const -> Record
+{
+    Record result;
+    result.numCells = clusterTO.numCells;
+    result.numTokens = clusterTO.numTokens;
+
+    //indices are stored relative to the cluster
+    vector<char> stringBytes;
+    unordered_map<int, int> stringIndexBySourceIndex;
+    auto cluster = clusterTO;
+    cluster.cellStartIndex = 0;
+    cluster.tokenStartIndex = 0;
+    copyString(cluster.metadata.nameLen, cluster.metadata.nameStringIndex, dataTO.stringBytes, stringBytes, stringIndexBySourceIndex);
+
+    auto const cellTOs = dataTO.cells + clusterTO.cellStartIndex;
+    vector<CellAccessTO> cells(cellTOs, cellTOs + clusterTO.numCells);
+    for (auto& cell : cells) {
+        for (int i = 0; i < cell.numConnections; ++i) {
+            cell.connectionIndices[i] -= clusterTO.cellStartIndex;
+        }
+        std::fill(cell.connectionIndices + cell.numConnections, cell.connectionIndices + MAX_CELL_BONDS, 0);
+        copyString(cell.metadata.nameLen, cell.metadata.nameStringIndex, dataTO.stringBytes, stringBytes, stringIndexBySourceIndex);
+        copyString(cell.metadata.descriptionLen, cell.metadata.descriptionStringIndex, dataTO.stringBytes, stringBytes, stringIndexBySourceIndex);
+        copyString(cell.metadata.sourceCodeLen, cell.metadata.sourceCodeStringIndex, dataTO.stringBytes, stringBytes, stringIndexBySourceIndex);
+
+        auto const blockIndex = getBlockIndex(cell.pos);
+        auto const& blockIndices = result.blockIndices;
+        if (std::find(blockIndices.begin(), blockIndices.end(), blockIndex) == blockIndices.end()) {
+            result.blockIndices.emplace_back(blockIndex);
+        }
+    }
+
+    auto const tokenTOs = dataTO.tokens + clusterTO.tokenStartIndex;
+    vector<TokenAccessTO> tokens(tokenTOs, tokenTOs + clusterTO.numTokens);
+    for (auto& token : tokens) {
+        token.cellIndex -= clusterTO.cellStartIndex;
+    }
+    result.numStringBytes = static_cast<int>(stringBytes.size());
+
+    vector<unsigned char> bytes;
+    ByteWriter writer(bytes);
+    writer.write(cluster);
+    writer.write(cells.data(), sizeof(CellAccessTO) * result.numCells);
+    writer.write(tokens.data(), sizeof(TokenAccessTO) * result.numTokens);
+    writer.write(stringBytes.data(), result.numStringBytes);
+    result.numUncompressedBytes = static_cast<int>(bytes.size());
+
+    if (_compress) {
+        result.bytes = encodeZeroRuns(bytes);
+    }
+    else {
+        result.bytes = std::move(bytes);
+    }
+    return result;
+}
+
+vector<unsigned char> ColdClusterStore::decodeRecord(Record const& record) const
+{
+    return _compress ? decodeZeroRuns(record.bytes, record.numUncompressedBytes) : record.bytes;
+}
+
+bool ColdClusterStore::readRecord(
+    Record const& record,
+    vector<unsigned char> const& bytes,
+    DataAccessTO const& dataTO,
+    Capacity const& capacity,
+    int projection) const
+{
+    auto const withTokens = 0 != (projection & Enums::DataProjection::TOKENS);
+    auto const withMetadata = 0 != (projection & Enums::DataProjection::METADATA);
+    auto const withConnections = 0 != (projection & Enums::DataProjection::CELL_CONNECTIONS);
+    auto const numTokens = withTokens ? record.numTokens : 0;
+    auto const numStringBytes = withMetadata ? record.numStringBytes : 0;
+
+    if (*dataTO.numClusters + 1 > capacity.numClusters
+        || *dataTO.numCells + record.numCells > capacity.numCells
+        || *dataTO.numTokens + numTokens > capacity.numTokens
+        || *dataTO.numStringBytes + numStringBytes > capacity.numStringBytes) {
+        return false;
+    }
+
+    ByteReader reader(bytes);
+
+    auto const cellOffset = *dataTO.numCells;
+    auto const tokenOffset = *dataTO.numTokens;
+    auto const stringOffset = *dataTO.numStringBytes;
+
+    auto& cluster = dataTO.clusters[(*dataTO.numClusters)++];
+    cluster = reader.read<ClusterAccessTO>();
+    cluster.cellStartIndex = cellOffset;
+    cluster.tokenStartIndex = tokenOffset;
+    cluster.numTokens = numTokens;
+    if (withMetadata) {
+        rebaseString(cluster.metadata.nameLen, cluster.metadata.nameStringIndex, stringOffset);
+    }
+    else {
+        cluster.metadata.nameLen = 0;
+    }
+
+    auto const cells = dataTO.cells + cellOffset;
+    reader.read(cells, sizeof(CellAccessTO) * record.numCells);
+    for (int index = 0; index < record.numCells; ++index) {
+        auto& cell = cells[index];
+        if (!withConnections) {
+            cell.numConnections = 0;
+        }
+        for (int i = 0; i < cell.numConnections; ++i) {
+            cell.connectionIndices[i] += cellOffset;
+        }
+        if (withMetadata) {
+            rebaseString(cell.metadata.nameLen, cell.metadata.nameStringIndex, stringOffset);
+            rebaseString(cell.metadata.descriptionLen, cell.metadata.descriptionStringIndex, stringOffset);
+            rebaseString(cell.metadata.sourceCodeLen, cell.metadata.sourceCodeStringIndex, stringOffset);
+        }
+        else {
+            cell.metadata.nameLen = 0;
+            cell.metadata.descriptionLen = 0;
+            cell.metadata.sourceCodeLen = 0;
+        }
+    }
+
+    if (withTokens) {
+        auto const tokens = dataTO.tokens + tokenOffset;
+        reader.read(tokens, sizeof(TokenAccessTO) * record.numTokens);
+        for (int index = 0; index < record.numTokens; ++index) {
+            tokens[index].cellIndex += cellOffset;
+        }
+    }
+    else {
+        reader.skip(sizeof(TokenAccessTO) * record.numTokens);
+    }
+
+    if (withMetadata) {
+        reader.read(dataTO.stringBytes + stringOffset, record.numStringBytes);
+    }
+
+    *dataTO.numCells += record.numCells;
+    *dataTO.numTokens += numTokens;
+    *dataTO.numStringBytes += numStringBytes;
+    return true;
+}
+
+bool ColdClusterStore::hasCellInRect(
+    Record const& record,
+    vector<unsigned char> const& bytes,
+    IntVector2D const& rectUpperLeft,
+    IntVector2D const& rectLowerRight) const
+{
+    ByteReader reader(bytes);
+    reader.skip(sizeof(ClusterAccessTO));
+    for (int index = 0; index < record.numCells; ++index) {
+        auto const pos = mapPos(reader.read<CellAccessTO>().pos);
+        if (pos.x >= rectUpperLeft.x && pos.x <= rectLowerRight.x && pos.y >= rectUpperLeft.y
+            && pos.y <= rectLowerRight.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+vector<uint64_t> ColdClusterStore::getClusterIds(vector<int> const& blockIndices) const
+{
+    vector<uint64_t> result;
+    for (int blockIndex : blockIndices) {
+        auto const findResult = _clusterIdsByBlock.find(blockIndex);
+        if (findResult != _clusterIdsByBlock.end()) {
+            result.insert(result.end(), findResult->second.begin(), findResult->second.end());
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+vector<int> ColdClusterStore::getBlockIndices(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight) const
+{
+    auto const startBlockX = std::max(0, rectUpperLeft.x / BlockSize);
+    auto const startBlockY = std::max(0, rectUpperLeft.y / BlockSize);
+    auto const endBlockX = std::min(_numBlocksX - 1, rectLowerRight.x / BlockSize);
+    auto const endBlockY = std::min(_numBlocksY - 1, rectLowerRight.y / BlockSize);
+    vector<int> result;
+    for (int blockY = startBlockY; blockY <= endBlockY; ++blockY) {
+        for (int blockX = startBlockX; blockX <= endBlockX; ++blockX) {
+            result.emplace_back(blockX + blockY * _numBlocksX);
+        }
+    }
+    return result;
+}
+
+void ColdClusterStore::removeRecord(uint64_t clusterId)
+{
+    auto const findResult = _recordsByClusterId.find(clusterId);
+    if (findResult == _recordsByClusterId.end()) {
+        return;
+    }
+    auto const& record = findResult->second;
+    for (int blockIndex : record.blockIndices) {
+        auto& clusterIds = _clusterIdsByBlock.at(blockIndex);
+        clusterIds.erase(clusterId);
+        if (clusterIds.empty()) {
+            _clusterIdsByBlock.erase(blockIndex);
+        }
+    }
+    --_memoryUsage.numClusters;
+    _memoryUsage.numCells -= record.numCells;
+    _memoryUsage.numTokens -= record.numTokens;
+    _memoryUsage.numStringBytes -= record.numStringBytes;
+    _memoryUsage.numBytes -= record.bytes.size();
+    _memoryUsage.numUncompressedBytes -= record.numUncompressedBytes;
+    _recordsByClusterId.erase(findResult);
+}
+
+//same as MapInfo::mapPosCorrection
+float2 ColdClusterStore::mapPos(float2 const& pos) const
+{
+    auto const intPartX = static_cast<int>(std::floor(pos.x));
+    auto const intPartY = static_cast<int>(std::floor(pos.y));
+    auto const x = ((intPartX % _universeSize.x) + _universeSize.x) % _universeSize.x;
+    auto const y = ((intPartY % _universeSize.y) + _universeSize.y) % _universeSize.y;
+    return {static_cast<float>(x) + (pos.x - intPartX), static_cast<float>(y) + (pos.y - intPartY)};
+}
+
+int ColdClusterStore::getBlockIndex(float2 const& pos) const
+{
+    auto const x = ((static_cast<int>(std::floor(pos.x)) % _universeSize.x) + _universeSize.x) % _universeSize.x;
+    auto const y = ((static_cast<int>(std::floor(pos.y)) % _universeSize.y) + _universeSize.y) % _universeSize.y;
+    return x / BlockSize + y / BlockSize * _numBlocksX;
+}
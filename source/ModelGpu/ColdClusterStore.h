@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Definitions.h"
+#include "AccessTOs.cuh"
+
+/**
+ * Host-side cold storage for frozen clusters. Evicted clusters are serialized with their cells, tokens and metadata
+ * strings into compact records (optionally zero-run-length encoded) so that they no longer occupy device memory.
+ * The universe is divided into blocks of BlockSize x BlockSize positions; clusters are restored into a transfer
+ * object when one of the blocks they occupy is woken up or affected by a physical action, while data and image
+ * requests copy them without restoring.
+ */
+class MODELGPU_EXPORT ColdClusterStore
+{
+public:
+    static int const BlockSize = 64;
+
+    ColdClusterStore(IntVector2D const& universeSize, bool compress = true);
+
+    //upper bounds for the number fields of a transfer object
+    struct Capacity
+    {
+        int numClusters = 0;
+        int numCells = 0;
+        int numTokens = 0;
+        int numStringBytes = 0;
+    };
+
+    //stores all clusters of dataTO, particles are ignored
+    void evict(DataAccessTO const& dataTO);
+
+    //moves the stored clusters occupying the given blocks to dataTO as long as the number fields of dataTO stay within
+    //the capacity and returns the number of restored clusters, the number fields of dataTO must be initialized
+    int restore(vector<int> const& blockIndices, DataAccessTO const& dataTO, Capacity const& capacity);
+    int restore(
+        IntVector2D const& rectUpperLeft,
+        IntVector2D const& rectLowerRight,
+        DataAccessTO const& dataTO,
+        Capacity const& capacity);
+    int restoreAll(DataAccessTO const& dataTO, Capacity const& capacity);
+
+    //appends copies of the stored clusters with a cell inside the rect to dataTO like getClusterAccessData does for
+    //the clusters on the device, i.e. cell positions are mapped into the universe before they are compared with the
+    //rect and fields not contained in projection are left out; the clusters are copied in the order of their ids
+    //beginning at position, which is advanced to the first cluster that exceeds the capacity, and true is returned if
+    //all clusters have been copied
+    bool copy(
+        IntVector2D const& rectUpperLeft,
+        IntVector2D const& rectLowerRight,
+        DataAccessTO const& dataTO,
+        Capacity const& capacity,
+        int projection,
+        int& position) const;
+
+    //removes the stored clusters with a cell inside the rect and returns their number
+    int remove(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+
+    void clear();
+
+    int getNumBlocks() const;
+    vector<int> getColdBlocks() const;  //1 = block contains stored clusters
+
+    struct MemoryUsage
+    {
+        int numClusters = 0;
+        int numCells = 0;
+        int numTokens = 0;
+        int numStringBytes = 0;
+        uint64_t numBytes = 0;
+        uint64_t numUncompressedBytes = 0;
+    };
+    MemoryUsage getMemoryUsage() const;
+
+private:
+    struct Record
+    {
+        vector<unsigned char> bytes;
+        int numUncompressedBytes = 0;
+        int numCells = 0;
+        int numTokens = 0;
+        int numStringBytes = 0;
+        vector<int> blockIndices;
+    };
+
+    Record createRecord(DataAccessTO const& dataTO, ClusterAccessTO const& clusterTO) const;
+    vector<unsigned char> decodeRecord(Record const& record) const;
+    bool readRecord(
+        Record const& record,
+        vector<unsigned char> const& bytes,
+        DataAccessTO const& dataTO,
+        Capacity const& capacity,
+        int projection) const;
+    bool hasCellInRect(
+        Record const& record,
+        vector<unsigned char> const& bytes,
+        IntVector2D const& rectUpperLeft,
+        IntVector2D const& rectLowerRight) const;
+    vector<uint64_t> getClusterIds(vector<int> const& blockIndices) const;
+    vector<int> getBlockIndices(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight) const;
+    void removeRecord(uint64_t clusterId);
+    float2 mapPos(float2 const& pos) const;
+    int getBlockIndex(float2 const& pos) const;
+
+    IntVector2D _universeSize;
+    int _numBlocksX = 0;
+    int _numBlocksY = 0;
+    bool _compress = true;
+
+    unordered_map<uint64_t, Record> _recordsByClusterId;
+    unordered_map<int, unordered_set<uint64_t>> _clusterIdsByBlock;
+    MemoryUsage _memoryUsage;
+};
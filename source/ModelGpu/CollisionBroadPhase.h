@@ -0,0 +1,174 @@
+#pragma once
+
+#include <vector>
+
+#ifdef __CUDACC__
+#define BROADPHASE_FUNCTION __host__ __device__ __inline__
+#else
+#define BROADPHASE_FUNCTION inline
+#endif
+
+/**
+ * Bounding circle of a cluster around its center.
+ */
+struct BoundingCircle
+{
+    float posX;
+    float posY;
+    float radius;
+};
+
+/**
+ * Broad phase of the collision detection: two clusters can only collide if their bounding circles, enlarged by a
+ * margin, overlap on the toroidal map. Each enlarged circle is binned into all map sections its bounding box
+ * covers, hence overlapping circles share at least one section.
+ */
+class CollisionBroadPhaseLayout
+{
+public:
+    BROADPHASE_FUNCTION void init(int universeSizeX, int universeSizeY, int sectionSize, float margin)
+    {
+        _universeSizeX = universeSizeX;
+        _universeSizeY = universeSizeY;
+        _sectionSize = sectionSize;
+        _numSectionsX = (universeSizeX + sectionSize - 1) / sectionSize;
+        _numSectionsY = (universeSizeY + sectionSize - 1) / sectionSize;
+        _margin = margin;
+    }
+
+    BROADPHASE_FUNCTION int getNumSections() const { return _numSectionsX * _numSectionsY; }
+
+    BROADPHASE_FUNCTION bool overlaps(BoundingCircle const& circle1, BoundingCircle const& circle2) const
+    {
+        auto const deltaX = calcMapDelta(circle1.posX - circle2.posX, _universeSizeX);
+        auto const deltaY = calcMapDelta(circle1.posY - circle2.posY, _universeSizeY);
+        auto const maxDistance = circle1.radius + circle2.radius + _margin;
+        return deltaX * deltaX + deltaY * deltaY < maxDistance * maxDistance;
+    }
+
+    //calls func(sectionIndex) once for each section covered by the enlarged circle
+    template <typename Func>
+    BROADPHASE_FUNCTION void forEachSection(BoundingCircle const& circle, Func const& func) const
+    {
+        auto const radius = circle.radius + _margin;
+        int segmentsX[2][2], segmentsY[2][2];
+        auto const numSegmentsX =
+            calcSectionSegments(circle.posX - radius, circle.posX + radius, _universeSizeX, _numSectionsX, segmentsX);
+        auto const numSegmentsY =
+            calcSectionSegments(circle.posY - radius, circle.posY + radius, _universeSizeY, _numSectionsY, segmentsY);
+        for (int i = 0; i < numSegmentsY; ++i) {
+            for (int sectionY = segmentsY[i][0]; sectionY <= segmentsY[i][1]; ++sectionY) {
+                for (int j = 0; j < numSegmentsX; ++j) {
+                    for (int sectionX = segmentsX[j][0]; sectionX <= segmentsX[j][1]; ++sectionX) {
+                        func(sectionX + sectionY * _numSectionsX);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    BROADPHASE_FUNCTION static float calcMapDelta(float delta, int universeSize)
+    {
+        delta = delta < 0 ? -delta : delta;
+        delta = delta - static_cast<int>(delta / universeSize) * universeSize;
+        return delta > universeSize / 2.0f ? universeSize - delta : delta;
+    }
+
+    //splits the interval [start, end] at the map border and returns the number of section ranges
+    BROADPHASE_FUNCTION int
+    calcSectionSegments(float start, float end, int universeSize, int numSections, int (&segments)[2][2]) const
+    {
+        if (end - start >= universeSize) {
+            segments[0][0] = 0;
+            segments[0][1] = numSections - 1;
+            return 1;
+        }
+        auto const wrappedStart = start - floorInt(start / universeSize) * universeSize;
+        auto const wrappedEnd = wrappedStart + (end - start);
+        if (wrappedEnd < universeSize) {
+            segments[0][0] = toSection(wrappedStart, numSections);
+            segments[0][1] = toSection(wrappedEnd, numSections);
+            return 1;
+        }
+        auto const startSection = toSection(wrappedStart, numSections);
+        auto const endSection = toSection(wrappedEnd - universeSize, numSections);
+        if (endSection >= startSection) {
+            segments[0][0] = 0;
+            segments[0][1] = numSections - 1;
+            return 1;
+        }
+        segments[0][0] = startSection;
+        segments[0][1] = numSections - 1;
+        segments[1][0] = 0;
+        segments[1][1] = endSection;
+        return 2;
+    }
+
+    BROADPHASE_FUNCTION int toSection(float pos, int numSections) const
+    {
+        auto const result = static_cast<int>(pos) / _sectionSize;
+        return result < numSections ? result : numSections - 1;
+    }
+
+    BROADPHASE_FUNCTION static int floorInt(float value)
+    {
+        auto const result = static_cast<int>(value);
+        return result > value ? result - 1 : result;
+    }
+
+    int _universeSizeX = 0;
+    int _universeSizeY = 0;
+    int _sectionSize = 1;
+    int _numSectionsX = 0;
+    int _numSectionsY = 0;
+    float _margin = 0;
+};
+
+/**
+ * Host implementation which flags all circles with at least one overlapping other circle.
+ */
+class HostCollisionBroadPhase
+{
+public:
+    HostCollisionBroadPhase(int universeSizeX, int universeSizeY, int sectionSize, float margin)
+    {
+        _layout.init(universeSizeX, universeSizeY, sectionSize, margin);
+    }
+
+    CollisionBroadPhaseLayout const& getLayout() const { return _layout; }
+
+    std::vector<bool> calcCandidates(std::vector<BoundingCircle> const& circles) const
+    {
+        auto const numCircles = static_cast<int>(circles.size());
+        std::vector<int> sectionOffsets(_layout.getNumSections() + 1, 0);
+        for (auto const& circle : circles) {
+            _layout.forEachSection(circle, [&](int sectionIndex) { ++sectionOffsets[sectionIndex + 1]; });
+        }
+        for (int section = 0; section < _layout.getNumSections(); ++section) {
+            sectionOffsets[section + 1] += sectionOffsets[section];
+        }
+
+        auto cursors = sectionOffsets;
+        std::vector<int> entries(sectionOffsets.back());
+        for (int index = 0; index < numCircles; ++index) {
+            _layout.forEachSection(circles[index], [&](int sectionIndex) { entries[cursors[sectionIndex]++] = index; });
+        }
+
+        std::vector<bool> result(numCircles, false);
+        for (int index = 0; index < numCircles; ++index) {
+            _layout.forEachSection(circles[index], [&](int sectionIndex) {
+                for (int entry = sectionOffsets[sectionIndex]; entry < sectionOffsets[sectionIndex + 1]; ++entry) {
+                    auto const otherIndex = entries[entry];
+                    if (!result[index] && otherIndex != index && _layout.overlaps(circles[index], circles[otherIndex])) {
+                        result[index] = true;
+                    }
+                }
+            });
+        }
+        return result;
+    }
+
+private:
+    CollisionBroadPhaseLayout _layout;
+};
@@ -209,19 +209,17 @@ __inline__ __device__ void CommunicatorFunction::receiveMessage(Token * token) c
 __inline__ __device__ void CommunicatorFunction::sendMessageToNearbyCommunicators(MessageData const & messageDataToSend, 
     Cell * senderCell, Cell * senderPreviousCell, int & numMessages) const
 { 
-    __shared__ List<Cluster*> clusterList;
-    _data->cellFunctionData.mapSectionCollector.getClusters_block(senderCell->absPos,
-        cudaSimulationParameters.cellFunctionCommunicatorRange, _data->cellMap, &_data->dynamicMemory, clusterList);
-
     __shared__ Cluster** clusters;
+    __shared__ int numClusters;
+    _data->cellFunctionData.mapSectionCollector.getClusters_block(senderCell->absPos,
+        cudaSimulationParameters.cellFunctionCommunicatorRange, _data->cellMap, &_data->dynamicMemory, clusters, numClusters);
 
     if (0 == threadIdx.x) {
         numMessages = 0;
-        clusters = clusterList.asArray(&_data->dynamicMemory);
     }
     __syncthreads();
 
-    auto const clusterPartition = calcPartition(clusterList.getSize(), threadIdx.x, blockDim.x);
+    auto const clusterPartition = calcPartition(numClusters, threadIdx.x, blockDim.x);
 
     for (auto clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
         auto const& cluster = clusters[clusterIndex];
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#ifdef __CUDACC__
+#define LABELING_FUNCTION __host__ __device__ __inline__
+#else
+#define LABELING_FUNCTION inline
+#endif
+
+/**
+ * Lock-free union-find over node indices for labeling connected components.
+ * Each edge is united exactly once, hence the number of passes does not depend on the diameter of the components
+ * (in contrast to frontier search or label propagation). Roots are always the smallest index of their component,
+ * i.e. the labels are independent of the order in which the edges are united.
+ */
+class ComponentLabeling
+{
+public:
+    LABELING_FUNCTION static void init(int* parents, int index) { parents[index] = index; }
+
+    //path halving, concurrent calls only shorten paths
+    LABELING_FUNCTION static int find(int* parents, int index)
+    {
+        auto parent = parents[index];
+        while (parent != index) {
+            auto const grandParent = parents[parent];
+            if (grandParent != parent) {
+                parents[index] = grandParent;
+            }
+            index = parent;
+            parent = grandParent;
+        }
+        return index;
+    }
+
+    //the root with the larger index is linked to the root with the smaller index
+    LABELING_FUNCTION static void unite(int* parents, int index1, int index2)
+    {
+        auto root1 = find(parents, index1);
+        auto root2 = find(parents, index2);
+        while (root1 != root2) {
+            if (root1 > root2) {
+                auto const temp = root1;
+                root1 = root2;
+                root2 = temp;
+            }
+#ifdef __CUDA_ARCH__
+            auto const origParent = atomicCAS(&parents[root2], root2, root1);
+#else
+            auto const origParent = parents[root2];
+            if (origParent == root2) {
+                parents[root2] = root1;
+            }
+#endif
+            if (origParent == root2) {
+                return;
+            }
+            //root2 has been linked in the meantime
+            root2 = find(parents, origParent);
+            root1 = find(parents, root1);
+        }
+    }
+
+    //should be called after all unions are done, afterwards parents[index] is the label
+    LABELING_FUNCTION static void flatten(int* parents, int index) { parents[index] = find(parents, index); }
+};
+
+/**
+ * Host implementation for graphs given by their edges.
+ */
+class HostComponentLabeling
+{
+public:
+    //label of a node is the smallest node index of its component
+    std::vector<int> calcLabels(int numNodes, std::vector<std::pair<int, int>> const& edges) const
+    {
+        std::vector<int> result(numNodes);
+        for (int index = 0; index < numNodes; ++index) {
+            ComponentLabeling::init(result.data(), index);
+        }
+        for (auto const& edge : edges) {
+            ComponentLabeling::unite(result.data(), edge.first, edge.second);
+        }
+        for (int index = 0; index < numNodes; ++index) {
+            ComponentLabeling::flatten(result.data(), index);
+        }
+        return result;
+    }
+};
@@ -13,6 +13,7 @@ struct CudaConstants
     int MAX_CLUSTERPOINTERS = 0;/* MAX_CLUSTERS * 10*/
     int MAX_PARTICLEPOINTERS = 0;/* MAX_PARTICLES * 10*/
     int MAX_TOKENPOINTERS = 0;/* MAX_TOKENS * 10*/
+    int MAX_MAPTILES = 0;/* tiles of 32x32 positions per map, 0 = as many as the map entries can populate*/
 
     int DYNAMIC_MEMORY_SIZE = 0;
     int METADATA_DYNAMIC_MEMORY_SIZE = 0;
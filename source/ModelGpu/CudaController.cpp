@@ -80,6 +80,18 @@ void CudaController::setExecutionParameters(ExecutionParameters const & paramete
     _worker->addJob(job);
 }
 
+void CudaController::startRecording(RecordingParameters const& parameters)
+{
+    auto const job = boost::make_shared<_StartRecordingJob>(ThreadControllerId, parameters);
+    _worker->addJob(job);
+}
+
+void CudaController::stopRecording()
+{
+    auto const job = boost::make_shared<_StopRecordingJob>(ThreadControllerId);
+    _worker->addJob(job);
+}
+
 void CudaController::timestepCalculatedWithGpu()
 {
 	Q_EMIT timestepCalculated();
@@ -25,6 +25,8 @@ public:
 	void restrictTimestepsPerSecond(optional<int> tps);
 	void setSimulationParameters(SimulationParameters const& parameters);
     void setExecutionParameters(ExecutionParameters const& parameters);
+    void startRecording(RecordingParameters const& parameters);
+    void stopRecording();
 
 	Q_SIGNAL void timestepCalculated();
 
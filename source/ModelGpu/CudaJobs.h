@@ -64,12 +64,39 @@ private:
     MonitorData _monitorData;
 };
 
+class _GetMonitorStatisticsJob
+    : public _CudaJob
+{
+public:
+    _GetMonitorStatisticsJob(string const& originId)
+        : _CudaJob(originId, true) { }
+
+    virtual ~_GetMonitorStatisticsJob() = default;
+
+    void setMonitorStatistics(MonitorStatistics const& monitorStatistics)
+    {
+        _monitorStatistics = monitorStatistics;
+    }
+
+    MonitorStatistics getMonitorStatistics()
+    {
+        return _monitorStatistics;
+    }
+
+private:
+    MonitorStatistics _monitorStatistics;
+};
+
 class _GetDataJob 
 	: public _CudaJob
 {
 public:
-	_GetDataJob(string const& originId, IntRect const& rect, DataAccessTO const& dataTO)
-		: _CudaJob(originId, true), _rect(rect), _dataTO(dataTO) { }
+	_GetDataJob(
+		string const& originId,
+		IntRect const& rect,
+		DataAccessTO const& dataTO,
+		int projection = Enums::DataProjection::ALL)
+		: _CudaJob(originId, true), _rect(rect), _dataTO(dataTO), _projection(projection) { }
 
 	virtual ~_GetDataJob() = default;
 
@@ -83,9 +110,15 @@ public:
 		return _dataTO;
 	}
 
+	int getProjection() const
+	{
+		return _projection;
+	}
+
 private:
 	DataAccessTO _dataTO;
 	IntRect _rect;
+	int _projection;
 };
 
 class _GetImageJob
@@ -95,10 +128,9 @@ public:
     _GetImageJob(string const& originId, IntRect const& rect, QImagePtr const& targetImage, std::mutex& mutex)
 		: _CudaJob(originId, true), _targetImage(targetImage), _mutex(mutex)
     {
-        auto imageSize = targetImage->size();
-
+        //the rect is rendered into the whole target image which may have a lower resolution than the rect
         IntVector2D upperLeft = { std::max(0, rect.p1.x), std::max(0, rect.p1.y) };
-        _rect = { upperLeft, {upperLeft.x + imageSize.width() - 1, upperLeft.y + imageSize.height() - 1 } };
+        _rect = { upperLeft, rect.p2 };
     }
 
     virtual ~_GetImageJob() = default;
@@ -108,6 +140,11 @@ public:
         return _rect;
     }
 
+    IntVector2D getImageSize() const
+    {
+        return { _targetImage->width(), _targetImage->height() };
+    }
+
     QImagePtr getTargetImage() const
 	{
 		return _targetImage;
@@ -128,13 +165,49 @@ class _GetDataForEditJob
 	: public _GetDataJob
 {
 public:
-	_GetDataForEditJob(string const& originId, IntRect const& rect, DataAccessTO const& dataTO)
-		: _GetDataJob(originId, rect, dataTO) { }
+	_GetDataForEditJob(string const& originId, IntRect const& rect, DataAccessTO const& dataTO, int projection)
+		: _GetDataJob(originId, rect, dataTO, projection) { }
 
 	virtual ~_GetDataForEditJob() = default;
 
 };
 
+class _GetDataForSubscriptionJob
+	: public _GetDataJob
+{
+public:
+	_GetDataForSubscriptionJob(string const& originId, IntRect const& rect, DataAccessTO const& dataTO, int projection, int subscriptionId)
+		: _GetDataJob(originId, rect, dataTO, projection), _subscriptionId(subscriptionId) { }
+
+	virtual ~_GetDataForSubscriptionJob() = default;
+
+	int getSubscriptionId() const
+	{
+		return _subscriptionId;
+	}
+
+private:
+	int _subscriptionId;
+};
+
+class _GetDataForQueryJob
+	: public _GetDataJob
+{
+public:
+	_GetDataForQueryJob(string const& originId, IntRect const& rect, DataAccessTO const& dataTO, int queryId)
+		: _GetDataJob(originId, rect, dataTO), _queryId(queryId) { }
+
+	virtual ~_GetDataForQueryJob() = default;
+
+	int getQueryId() const
+	{
+		return _queryId;
+	}
+
+private:
+	int _queryId;
+};
+
 class _GetDataForUpdateJob
 	: public _GetDataJob
 {
@@ -266,6 +339,36 @@ private:
     ExecutionParameters _parameters;
 };
 
+class _StartRecordingJob
+    : public _CudaJob
+{
+public:
+    _StartRecordingJob(string const& originId, RecordingParameters const& parameters, bool notifyFinish = false)
+        : _CudaJob(originId, notifyFinish)
+        , _parameters(parameters)
+    {}
+
+    virtual ~_StartRecordingJob() = default;
+
+    RecordingParameters const& getRecordingParameters() const
+    {
+        return _parameters;
+    }
+
+private:
+    RecordingParameters _parameters;
+};
+
+class _StopRecordingJob
+    : public _CudaJob
+{
+public:
+    _StopRecordingJob(string const& originId, bool notifyFinish = false)
+        : _CudaJob(originId, notifyFinish) { }
+
+    virtual ~_StopRecordingJob() = default;
+};
+
 class _PhysicalActionJob
     : public _CudaJob
 {
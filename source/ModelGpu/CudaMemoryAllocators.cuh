@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstring>
+
+#include <cuda_runtime.h>
+#include <helper_cuda.h>
+
+#include "MemoryAllocator.h"
+
+class DeviceMemoryAllocator : public MemoryAllocator
+{
+public:
+    virtual ~DeviceMemoryAllocator() = default;
+
+    void copy(void* target, void const* source, uint64_t size) override
+    {
+        checkCudaErrors(cudaMemcpy(target, source, size, cudaMemcpyDefault));
+    }
+
+    void set(void* target, int value, uint64_t size) override
+    {
+        checkCudaErrors(cudaMemset(target, value, size));
+    }
+
+protected:
+    void* allocate(uint64_t size) override
+    {
+        void* result;
+        checkCudaErrors(cudaMalloc(&result, size));
+        return result;
+    }
+
+    void deallocate(void* memory) override
+    {
+        checkCudaErrors(cudaFree(memory));
+    }
+};
+
+/**
+ * Page-locked host memory which is mapped into the device address space. Kernels can access it directly,
+ * which is useful for buffers that are mainly transferred to the host, e.g. the access transfer objects.
+ */
+class PinnedMemoryAllocator : public MemoryAllocator
+{
+public:
+    virtual ~PinnedMemoryAllocator() = default;
+
+    void copy(void* target, void const* source, uint64_t size) override
+    {
+        checkCudaErrors(cudaMemcpy(target, source, size, cudaMemcpyDefault));
+    }
+
+    void set(void* target, int value, uint64_t size) override
+    {
+        memset(target, value, size);
+    }
+
+protected:
+    void* allocate(uint64_t size) override
+    {
+        void* result;
+        checkCudaErrors(cudaHostAlloc(&result, size, cudaHostAllocMapped | cudaHostAllocPortable));
+        return result;
+    }
+
+    void deallocate(void* memory) override
+    {
+        checkCudaErrors(cudaFreeHost(memory));
+    }
+};
@@ -1,7 +1,14 @@
 #pragma once
 
-#include <helper_cuda.h>
+#include <memory>
 
+#include "CudaMemoryAllocators.cuh"
+
+/**
+ * Gives the data structures access to the selected memory backend. The default is device memory, other backends
+ * can be selected by setAllocator() before the data structures are initialized.
+ * Array, DynamicMemory and the maps can also be given their own allocator in init(), which takes precedence.
+ */
 class CudaMemoryManager
 {
 public:
@@ -16,30 +23,52 @@ public:
 
     void reset()
     {
-        _bytes = 0;
+        _allocator->resetHighWaterMarks();
+    }
+
+    //should only be called when no memory is acquired
+    void setAllocator(std::shared_ptr<MemoryAllocator> const& allocator)
+    {
+        _allocator = allocator;
     }
 
     template<typename T>
-    void acquireMemory(uint64_t arraySize, T*& result)
+    void acquireMemory(MemorySubsystem::Type subsystem, uint64_t arraySize, T*& result)
     {
-        checkCudaErrors(cudaMalloc(&result, sizeof(T)*arraySize));
-        _bytes += sizeof(T)*arraySize;
+        _allocator->acquireMemory(subsystem, arraySize, result);
     }
 
     template<typename T>
-    void freeMemory(T& memory)
+    void freeMemory(T* memory)
+    {
+        _allocator->freeMemory(memory);
+    }
+
+    void copy(void* target, void const* source, uint64_t size)
+    {
+        _allocator->copy(target, source, size);
+    }
+
+    void set(void* target, int value, uint64_t size)
+    {
+        _allocator->set(target, value, size);
+    }
+
+    MemoryAllocator& getAllocator() const
     {
-        checkCudaErrors(cudaFree(memory));
+        return *_allocator;
     }
 
     uint64_t getSizeOfAcquiredMemory() const
     {
-        return _bytes;
+        return _allocator->getTotalUsage().bytes;
     }
 
 private:
-    CudaMemoryManager() {}
+    CudaMemoryManager()
+        : _allocator(std::make_shared<DeviceMemoryAllocator>())
+    {}
     ~CudaMemoryManager() {}
 
-    uint64_t _bytes = 0;
-};
\ No newline at end of file
+    std::shared_ptr<MemoryAllocator> _allocator;
+};
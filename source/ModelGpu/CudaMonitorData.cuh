@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ModelBasic/MonitorData.h"
+#include "ModelBasic/MonitorStatistics.h"
 
 #include "Base.cuh"
 #include "Definitions.cuh"
@@ -11,26 +12,43 @@ class CudaMonitorData
 public:
     __host__ void init()
     {
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numClusters);
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numClustersWithTokens);
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numCells);
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numTokens);
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _numParticles);
-        CudaMemoryManager::getInstance().acquireMemory<double>(1, _rotationalKineticEnergy);
-        CudaMemoryManager::getInstance().acquireMemory<double>(1, _linearKineticEnergy);
-        CudaMemoryManager::getInstance().acquireMemory<double>(1, _internalEnergy);
-
-        checkCudaErrors(cudaMemset(_numClusters, 0, sizeof(int)));
-        checkCudaErrors(cudaMemset(_numClustersWithTokens, 0, sizeof(int)));
-        checkCudaErrors(cudaMemset(_numCells, 0, sizeof(int)));
-        checkCudaErrors(cudaMemset(_numTokens, 0, sizeof(int)));
-        checkCudaErrors(cudaMemset(_numParticles, 0, sizeof(int)));
+        CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::Other, 1, _numClusters);
+        CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::Other, 1, _numClustersWithTokens);
+        CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::Other, 1, _numCells);
+        CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::Other, 1, _numTokens);
+        CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::Other, 1, _numParticles);
+        CudaMemoryManager::getInstance().acquireMemory<double>(MemorySubsystem::Other, 1, _rotationalKineticEnergy);
+        CudaMemoryManager::getInstance().acquireMemory<double>(MemorySubsystem::Other, 1, _linearKineticEnergy);
+        CudaMemoryManager::getInstance().acquireMemory<double>(MemorySubsystem::Other, 1, _internalEnergy);
+        CudaMemoryManager::getInstance().acquireMemory<int>(
+            MemorySubsystem::Other, Enums::CellFunction::_COUNTER, _numCellsByFunction);
+        CudaMemoryManager::getInstance().acquireMemory<int>(
+            MemorySubsystem::Other, MonitorStatistics::NumClusterSizeBins, _clusterSizeHistogram);
+        CudaMemoryManager::getInstance().acquireMemory<int>(
+            MemorySubsystem::Other, MonitorStatistics::NumTokenEnergyBins, _tokenEnergyHistogram);
+        CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::Other, 1, _numConstructorActivities);
+        CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::Other, 1, _numWeaponActivities);
+        CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::Other, 1, _numParticlesForStatistics);
+        CudaMemoryManager::getInstance().acquireMemory<double>(MemorySubsystem::Other, 1, _particleEnergy);
+
+        CudaMemoryManager::getInstance().set(_numClusters, 0, sizeof(int));
+        CudaMemoryManager::getInstance().set(_numClustersWithTokens, 0, sizeof(int));
+        CudaMemoryManager::getInstance().set(_numCells, 0, sizeof(int));
+        CudaMemoryManager::getInstance().set(_numTokens, 0, sizeof(int));
+        CudaMemoryManager::getInstance().set(_numParticles, 0, sizeof(int));
 
         double zero = 0.0;
-        checkCudaErrors(cudaMemcpy(_rotationalKineticEnergy, &zero, sizeof(double), cudaMemcpyHostToDevice));
-        checkCudaErrors(cudaMemcpy(_linearKineticEnergy, &zero, sizeof(double), cudaMemcpyHostToDevice));
-        checkCudaErrors(cudaMemcpy(_internalEnergy, &zero, sizeof(double), cudaMemcpyHostToDevice));
-
+        CudaMemoryManager::getInstance().copy(_rotationalKineticEnergy, &zero, sizeof(double));
+        CudaMemoryManager::getInstance().copy(_linearKineticEnergy, &zero, sizeof(double));
+        CudaMemoryManager::getInstance().copy(_internalEnergy, &zero, sizeof(double));
+
+        CudaMemoryManager::getInstance().set(_numCellsByFunction, 0, sizeof(int) * Enums::CellFunction::_COUNTER);
+        CudaMemoryManager::getInstance().set(_clusterSizeHistogram, 0, sizeof(int) * MonitorStatistics::NumClusterSizeBins);
+        CudaMemoryManager::getInstance().set(_tokenEnergyHistogram, 0, sizeof(int) * MonitorStatistics::NumTokenEnergyBins);
+        CudaMemoryManager::getInstance().set(_numConstructorActivities, 0, sizeof(int));
+        CudaMemoryManager::getInstance().set(_numWeaponActivities, 0, sizeof(int));
+        CudaMemoryManager::getInstance().set(_numParticlesForStatistics, 0, sizeof(int));
+        CudaMemoryManager::getInstance().copy(_particleEnergy, &zero, sizeof(double));
     }
 
     __host__ void free()
@@ -43,6 +61,13 @@ public:
         CudaMemoryManager::getInstance().freeMemory(_rotationalKineticEnergy);
         CudaMemoryManager::getInstance().freeMemory(_linearKineticEnergy);
         CudaMemoryManager::getInstance().freeMemory(_internalEnergy);
+        CudaMemoryManager::getInstance().freeMemory(_numCellsByFunction);
+        CudaMemoryManager::getInstance().freeMemory(_clusterSizeHistogram);
+        CudaMemoryManager::getInstance().freeMemory(_tokenEnergyHistogram);
+        CudaMemoryManager::getInstance().freeMemory(_numConstructorActivities);
+        CudaMemoryManager::getInstance().freeMemory(_numWeaponActivities);
+        CudaMemoryManager::getInstance().freeMemory(_numParticlesForStatistics);
+        CudaMemoryManager::getInstance().freeMemory(_particleEnergy);
     }
 
     __host__ MonitorData getMonitorData()
@@ -59,6 +84,31 @@ public:
         return result;
     }
 
+    __host__ MonitorStatistics getMonitorStatistics()
+    {
+        MonitorStatistics result;
+        checkCudaErrors(cudaMemcpy(
+            result.numCellsByFunction,
+            _numCellsByFunction,
+            sizeof(int) * Enums::CellFunction::_COUNTER,
+            cudaMemcpyDeviceToHost));
+        checkCudaErrors(cudaMemcpy(
+            result.clusterSizeHistogram,
+            _clusterSizeHistogram,
+            sizeof(int) * MonitorStatistics::NumClusterSizeBins,
+            cudaMemcpyDeviceToHost));
+        checkCudaErrors(cudaMemcpy(
+            result.tokenEnergyHistogram,
+            _tokenEnergyHistogram,
+            sizeof(int) * MonitorStatistics::NumTokenEnergyBins,
+            cudaMemcpyDeviceToHost));
+        checkCudaErrors(cudaMemcpy(&result.numConstructorActivities, _numConstructorActivities, sizeof(int), cudaMemcpyDeviceToHost));
+        checkCudaErrors(cudaMemcpy(&result.numWeaponActivities, _numWeaponActivities, sizeof(int), cudaMemcpyDeviceToHost));
+        checkCudaErrors(cudaMemcpy(&result.numParticles, _numParticlesForStatistics, sizeof(int), cudaMemcpyDeviceToHost));
+        checkCudaErrors(cudaMemcpy(&result.totalParticleEnergy, _particleEnergy, sizeof(double), cudaMemcpyDeviceToHost));
+        return result;
+    }
+
     __inline__ __device__ void reset()
     {
         *_numClusters = 0;
@@ -71,6 +121,23 @@ public:
         *_internalEnergy = 0.0f;
     }
 
+    __inline__ __device__ void resetStatistics()
+    {
+        for (int i = 0; i < Enums::CellFunction::_COUNTER; ++i) {
+            _numCellsByFunction[i] = 0;
+        }
+        for (int i = 0; i < MonitorStatistics::NumClusterSizeBins; ++i) {
+            _clusterSizeHistogram[i] = 0;
+        }
+        for (int i = 0; i < MonitorStatistics::NumTokenEnergyBins; ++i) {
+            _tokenEnergyHistogram[i] = 0;
+        }
+        *_numConstructorActivities = 0;
+        *_numWeaponActivities = 0;
+        *_numParticlesForStatistics = 0;
+        *_particleEnergy = 0.0;
+    }
+
     __inline__ __device__ void incNumClusters(int changeValue)
     {
         atomicAdd(_numClusters, changeValue);
@@ -111,6 +178,48 @@ public:
         atomicAdd(_internalEnergy, static_cast<double>(changeValue));
     }
 
+    __inline__ __device__ void incNumCellsByFunction(Enums::CellFunction::Type cellFunction, int changeValue)
+    {
+        atomicAdd(&_numCellsByFunction[cellFunction], changeValue);
+    }
+
+    //binning must match MonitorStatistics::getClusterSizeBin
+    __inline__ __device__ void incClusterSizeHistogram(int numCells)
+    {
+        auto const bin = numCells > 1 ? min(31 - __clz(numCells), MonitorStatistics::NumClusterSizeBins - 1) : 0;
+        atomicAdd(&_clusterSizeHistogram[bin], 1);
+    }
+
+    //binning must match MonitorStatistics::getTokenEnergyBin
+    __inline__ __device__ void incTokenEnergyHistogram(float energy)
+    {
+        auto const bin = energy > 0.0f
+            ? min(static_cast<int>(energy / MonitorStatistics::TokenEnergyBinWidth), MonitorStatistics::NumTokenEnergyBins - 1)
+            : 0;
+        atomicAdd(&_tokenEnergyHistogram[bin], 1);
+    }
+
+    __inline__ __device__ void incNumConstructorActivities(int changeValue)
+    {
+        atomicAdd(_numConstructorActivities, changeValue);
+    }
+
+    __inline__ __device__ void incNumWeaponActivities(int changeValue)
+    {
+        atomicAdd(_numWeaponActivities, changeValue);
+    }
+
+    //separate from the particle counter of the monitor data since both are computed in different kernels
+    __inline__ __device__ void incNumParticlesForStatistics(int changeValue)
+    {
+        atomicAdd(_numParticlesForStatistics, changeValue);
+    }
+
+    __inline__ __device__ void incParticleEnergy(float changeValue)
+    {
+        atomicAdd(_particleEnergy, static_cast<double>(changeValue));
+    }
+
 private:
     int* _numClusters;
     int* _numClustersWithTokens;
@@ -120,5 +229,13 @@ private:
     double* _rotationalKineticEnergy;
     double* _linearKineticEnergy;
     double* _internalEnergy;
+
+    int* _numCellsByFunction;
+    int* _clusterSizeHistogram;
+    int* _tokenEnergyHistogram;
+    int* _numConstructorActivities;
+    int* _numWeaponActivities;
+    int* _numParticlesForStatistics;
+    double* _particleEnergy;
 };
 
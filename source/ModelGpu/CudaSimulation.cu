@@ -4,6 +4,7 @@
 #include <list>
 #include <iostream>
 #include <functional>
+#include <algorithm>
 
 #include "ModelBasic/SimulationParameters.h"
 #include "Base.cuh"
@@ -57,12 +58,15 @@ CudaSimulation::CudaSimulation(
     int2 const& size,
     int timestep,
     SimulationParameters const& parameters,
-    CudaConstants const& cudaConstants)
+    CudaConstants const& cudaConstants,
+    uint64_t firstId)
 {
 
     CudaInitializer::init();
     CudaMemoryManager::getInstance().reset();
 
+    checkCudaErrors(cudaMallocHost(&_constantMemoryData, sizeof(ConstantMemoryData)));
+    setExecutionParameters(ExecutionParameters());
     setSimulationParameters(parameters);
     setCudaConstants(cudaConstants);
 
@@ -72,23 +76,24 @@ CudaSimulation::CudaSimulation(
 
     auto const memorySizeBefore = CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
 
-    _cudaSimulationData->init(size, cudaConstants, timestep);
+    _cudaSimulationData->init(size, cudaConstants, timestep, firstId);
     _cudaMonitorData->init();
 
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numCells);
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numClusters);
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numParticles);
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numTokens);
-    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numStringBytes);
-    CudaMemoryManager::getInstance().acquireMemory<ClusterAccessTO>(cudaConstants.MAX_CLUSTERS, _cudaAccessTO->clusters);
-    CudaMemoryManager::getInstance().acquireMemory<CellAccessTO>(cudaConstants.MAX_CELLS, _cudaAccessTO->cells);
-    CudaMemoryManager::getInstance().acquireMemory<ParticleAccessTO>(cudaConstants.MAX_PARTICLES, _cudaAccessTO->particles);
-    CudaMemoryManager::getInstance().acquireMemory<TokenAccessTO>(cudaConstants.MAX_TOKENS, _cudaAccessTO->tokens);
-    CudaMemoryManager::getInstance().acquireMemory<char>(cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE, _cudaAccessTO->stringBytes);
+    CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::AccessTOs, 1, _cudaAccessTO->numCells);
+    CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::AccessTOs, 1, _cudaAccessTO->numClusters);
+    CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::AccessTOs, 1, _cudaAccessTO->numParticles);
+    CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::AccessTOs, 1, _cudaAccessTO->numTokens);
+    CudaMemoryManager::getInstance().acquireMemory<int>(MemorySubsystem::AccessTOs, 1, _cudaAccessTO->numStringBytes);
+    CudaMemoryManager::getInstance().acquireMemory<ClusterAccessTO>(MemorySubsystem::AccessTOs, cudaConstants.MAX_CLUSTERS, _cudaAccessTO->clusters);
+    CudaMemoryManager::getInstance().acquireMemory<CellAccessTO>(MemorySubsystem::AccessTOs, cudaConstants.MAX_CELLS, _cudaAccessTO->cells);
+    CudaMemoryManager::getInstance().acquireMemory<ParticleAccessTO>(MemorySubsystem::AccessTOs, cudaConstants.MAX_PARTICLES, _cudaAccessTO->particles);
+    CudaMemoryManager::getInstance().acquireMemory<TokenAccessTO>(MemorySubsystem::AccessTOs, cudaConstants.MAX_TOKENS, _cudaAccessTO->tokens);
+    CudaMemoryManager::getInstance().acquireMemory<char>(MemorySubsystem::AccessTOs, cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE, _cudaAccessTO->stringBytes);
 
     auto const memorySizeAfter = CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
 
     std::cerr << "[CUDA] " << (memorySizeAfter - memorySizeBefore) / (1024 * 1024) << "mb memory acquired" << std::endl;
+    printMemoryUsage();
 }
 
 CudaSimulation::~CudaSimulation()
@@ -107,6 +112,8 @@ CudaSimulation::~CudaSimulation()
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->tokens);
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->stringBytes);
 
+    checkCudaErrors(cudaFreeHost(_constantMemoryData));
+
     std::cerr << "[CUDA] memory released" << std::endl;
 
     delete _cudaAccessTO;
@@ -115,12 +122,69 @@ CudaSimulation::~CudaSimulation()
 
 }
 
+void CudaSimulation::printMemoryUsage() const
+{
+    std::string const subsystemNames[] = {"entities", "maps", "dynamic memory", "images", "access TOs", "other"};
+    auto const& allocator = CudaMemoryManager::getInstance().getAllocator();
+    for (int subsystem = 0; subsystem < MemorySubsystem::_COUNTER; ++subsystem) {
+        auto const usage = allocator.getUsage(static_cast<MemorySubsystem::Type>(subsystem));
+        std::cerr << "[CUDA] " << subsystemNames[subsystem] << ": " << usage.bytes / (1024 * 1024) << "mb in "
+                  << usage.numAllocations << " allocations, peak " << usage.highWaterMark / (1024 * 1024) << "mb"
+                  << std::endl;
+    }
+}
+
+void CudaSimulation::reportLostMapEntries()
+{
+    auto const numLostMapEntries = _cudaSimulationData->cellMap.retrieveNumLostEntries()
+        + _cudaSimulationData->particleMap.retrieveNumLostEntries();
+    if (numLostMapEntries > _numReportedLostMapEntries) {
+        std::cerr << "[CUDA] " << numLostMapEntries - _numReportedLostMapEntries
+                  << " entities could not be stored in the maps, increase MAX_MAPTILES" << std::endl;
+        _numReportedLostMapEntries = numLostMapEntries;
+    }
+}
+
 void CudaSimulation::calcCudaTimestep()
 {
-    GPU_FUNCTION(calcSimulationTimestep, *_cudaSimulationData);
+    launchTimestep();
+    synchronize();
+}
+
+//cudaMemcpyToSymbol would block until the kernels of the previously activated simulation are finished, hence the
+//upload is enqueued into the default stream as the kernels, from page-locked memory to be truly asynchronous
+void CudaSimulation::activate()
+{
+    checkCudaErrors(cudaMemcpyToSymbolAsync(
+        cudaConstants, &_constantMemoryData->cudaConstants, sizeof(CudaConstants), 0, cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpyToSymbolAsync(
+        cudaImageBlurFactors, _constantMemoryData->imageBlurFactors, sizeof(int) * 7, 0, cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpyToSymbolAsync(
+        cudaSimulationParameters,
+        &_constantMemoryData->simulationParameters,
+        sizeof(SimulationParameters),
+        0,
+        cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpyToSymbolAsync(
+        cudaExecutionParameters,
+        &_constantMemoryData->executionParameters,
+        sizeof(ExecutionParameters),
+        0,
+        cudaMemcpyHostToDevice));
+}
+
+void CudaSimulation::launchTimestep()
+{
+    calcSimulationTimestep<<<1, 1>>>(*_cudaSimulationData);
     ++_cudaSimulationData->timestep;
 }
 
+void CudaSimulation::synchronize()
+{
+    cudaDeviceSynchronize();
+    checkCudaErrors(cudaGetLastError());
+}
+
 void CudaSimulation::DEBUG_printNumEntries()
 {
     std::cerr
@@ -133,49 +197,101 @@ void CudaSimulation::DEBUG_printNumEntries()
         << std::endl;
 }
 
-void CudaSimulation::getSimulationImage(int2 const & rectUpperLeft, int2 const & rectLowerRight, unsigned char* imageData)
+void CudaSimulation::getSimulationImage(
+    int2 const& rectUpperLeft,
+    int2 const& rectLowerRight,
+    int2 const& imageSize,
+    unsigned char* imageData)
 {
-    int width = rectLowerRight.x - rectUpperLeft.x + 1;
-    int height = rectLowerRight.y - rectUpperLeft.y + 1;
-    int numPixels = width * height;
+    auto const numPixels = imageSize.x * imageSize.y;
+    _cudaSimulationData->resizeImageData(numPixels);
 
-    GPU_FUNCTION(drawImage, rectUpperLeft, rectLowerRight, *_cudaSimulationData);
+    GPU_FUNCTION(drawImage, rectUpperLeft, rectLowerRight, imageSize, *_cudaSimulationData);
     checkCudaErrors(cudaMemcpy(
         imageData, _cudaSimulationData->finalImageData, sizeof(unsigned int) * numPixels, cudaMemcpyDeviceToHost));
 }
 
-void CudaSimulation::getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO)
+void CudaSimulation::getSimulationData(
+    int2 const& rectUpperLeft,
+    int2 const& rectLowerRight,
+    DataAccessTO const& dataTO,
+    int projection)
 {
-    GPU_FUNCTION(getSimulationAccessData, rectUpperLeft, rectLowerRight, *_cudaSimulationData, *_cudaAccessTO);
+    GPU_FUNCTION(getSimulationAccessData, rectUpperLeft, rectLowerRight, *_cudaSimulationData, projection, *_cudaAccessTO);
 
-    checkCudaErrors(cudaMemcpy(dataTO.numClusters, _cudaAccessTO->numClusters, sizeof(int), cudaMemcpyDeviceToHost));
-    checkCudaErrors(cudaMemcpy(dataTO.numCells, _cudaAccessTO->numCells, sizeof(int), cudaMemcpyDeviceToHost));
-    checkCudaErrors(cudaMemcpy(dataTO.numParticles, _cudaAccessTO->numParticles, sizeof(int), cudaMemcpyDeviceToHost));
-    checkCudaErrors(cudaMemcpy(dataTO.numTokens, _cudaAccessTO->numTokens, sizeof(int), cudaMemcpyDeviceToHost));
-    checkCudaErrors(cudaMemcpy(dataTO.numStringBytes, _cudaAccessTO->numStringBytes, sizeof(int), cudaMemcpyDeviceToHost));
-    checkCudaErrors(cudaMemcpy(dataTO.clusters, _cudaAccessTO->clusters, sizeof(ClusterAccessTO) * (*dataTO.numClusters), cudaMemcpyDeviceToHost));
-    checkCudaErrors(cudaMemcpy(dataTO.cells, _cudaAccessTO->cells, sizeof(CellAccessTO) * (*dataTO.numCells), cudaMemcpyDeviceToHost));
-    checkCudaErrors(cudaMemcpy(dataTO.particles, _cudaAccessTO->particles, sizeof(ParticleAccessTO) * (*dataTO.numParticles), cudaMemcpyDeviceToHost));
-    checkCudaErrors(cudaMemcpy(dataTO.tokens, _cudaAccessTO->tokens, sizeof(TokenAccessTO) * (*dataTO.numTokens), cudaMemcpyDeviceToHost));
-    checkCudaErrors(cudaMemcpy(dataTO.stringBytes, _cudaAccessTO->stringBytes, sizeof(char) * (*dataTO.numStringBytes), cudaMemcpyDeviceToHost));
+    copyDataTOtoHost(dataTO, projection);
 }
 
 void CudaSimulation::setSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO)
 {
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numClusters, dataTO.numClusters, sizeof(int), cudaMemcpyHostToDevice));
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numCells, dataTO.numCells, sizeof(int), cudaMemcpyHostToDevice));
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numParticles, dataTO.numParticles, sizeof(int), cudaMemcpyHostToDevice));
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numTokens, dataTO.numTokens, sizeof(int), cudaMemcpyHostToDevice));
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numStringBytes, dataTO.numStringBytes, sizeof(int), cudaMemcpyHostToDevice));
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->clusters, dataTO.clusters, sizeof(ClusterAccessTO) * (*dataTO.numClusters), cudaMemcpyHostToDevice));
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->cells, dataTO.cells, sizeof(CellAccessTO) * (*dataTO.numCells), cudaMemcpyHostToDevice));
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->particles, dataTO.particles, sizeof(ParticleAccessTO) * (*dataTO.numParticles), cudaMemcpyHostToDevice));
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->tokens, dataTO.tokens, sizeof(TokenAccessTO) * (*dataTO.numTokens), cudaMemcpyHostToDevice));
-    checkCudaErrors(cudaMemcpy(_cudaAccessTO->stringBytes, dataTO.stringBytes, sizeof(char) * (*dataTO.numStringBytes), cudaMemcpyHostToDevice));
+    copyDataTOtoDevice(dataTO);
 
     GPU_FUNCTION(setSimulationAccessData, rectUpperLeft, rectLowerRight, *_cudaSimulationData, *_cudaAccessTO);
 }
 
+void CudaSimulation::addGhostData(DataAccessTO const& dataTO)
+{
+    copyDataTOtoDevice(dataTO);
+
+    GPU_FUNCTION(addGhostAccessData, *_cudaSimulationData, *_cudaAccessTO);
+}
+
+void CudaSimulation::evictFrozenClusters(DataAccessTO const& dataTO)
+{
+    GPU_FUNCTION(getFrozenClusterAccessData, *_cudaSimulationData, *_cudaAccessTO);
+    copyDataTOtoHost(dataTO);
+}
+
+auto CudaSimulation::getFreeCapacity() const -> FreeCapacity
+{
+    auto const& entities = _cudaSimulationData->entities;
+    FreeCapacity result;
+    result.numClusters = std::min(
+        _cudaConstants.MAX_CLUSTERS - entities.clusters.retrieveNumEntries(),
+        _cudaConstants.MAX_CLUSTERPOINTERS - entities.clusterPointers.retrieveNumEntries());
+    result.numCells = std::min(
+        _cudaConstants.MAX_CELLS - entities.cells.retrieveNumEntries(),
+        _cudaConstants.MAX_CELLPOINTERS - entities.cellPointers.retrieveNumEntries());
+    result.numTokens = std::min(
+        _cudaConstants.MAX_TOKENS - entities.tokens.retrieveNumEntries(),
+        _cudaConstants.MAX_TOKENPOINTERS - entities.tokenPointers.retrieveNumEntries());
+
+    //the string bytes are allocated in one piece which is padded to 16 bytes (see DynamicMemory::getArray)
+    result.numStringBytes =
+        std::max(0, _cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE - entities.strings.retrieveNumBytes() - 16);
+    return result;
+}
+
+vector<int> CudaSimulation::getWokenColdBlocks()
+{
+    auto const& coldBlockMap = _cudaSimulationData->coldBlockMap;
+    auto const numBlocks = coldBlockMap.getNumBlocks();
+    GPU_FUNCTION(findWokenColdBlocks, *_cudaSimulationData);
+
+    vector<int> wokenBlocks(numBlocks);
+    checkCudaErrors(cudaMemcpy(
+        wokenBlocks.data(), coldBlockMap.getWokenBlocksForHost(), sizeof(int) * numBlocks, cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemset(coldBlockMap.getWokenBlocksForHost(), 0, sizeof(int) * numBlocks));
+
+    vector<int> result;
+    for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex) {
+        if (1 == wokenBlocks[blockIndex]) {
+            result.emplace_back(blockIndex);
+        }
+    }
+    return result;
+}
+
+void CudaSimulation::setColdBlocks(vector<int> const& coldBlocks)
+{
+    auto const& coldBlockMap = _cudaSimulationData->coldBlockMap;
+    checkCudaErrors(cudaMemcpy(
+        coldBlockMap.getColdBlocksForHost(),
+        coldBlocks.data(),
+        sizeof(int) * coldBlockMap.getNumBlocks(),
+        cudaMemcpyHostToDevice));
+}
+
 void CudaSimulation::applyForce(ApplyForceData const& applyData)
 {
     CudaApplyForceData cudaApplyData{ applyData.startPos, applyData.endPos, applyData.force, applyData.onlyRotation };
@@ -185,9 +301,16 @@ void CudaSimulation::applyForce(ApplyForceData const& applyData)
 MonitorData CudaSimulation::getMonitorData()
 {
     GPU_FUNCTION(getCudaMonitorData, *_cudaSimulationData, *_cudaMonitorData);
+    reportLostMapEntries();
     return _cudaMonitorData->getMonitorData();
 }
 
+MonitorStatistics CudaSimulation::getMonitorStatistics()
+{
+    GPU_FUNCTION(getCudaMonitorStatistics, *_cudaSimulationData, *_cudaMonitorData);
+    return _cudaMonitorData->getMonitorStatistics();
+}
+
 int CudaSimulation::getTimestep() const
 {
     return _cudaSimulationData->timestep;
@@ -200,18 +323,22 @@ void CudaSimulation::setTimestep(int timestep)
 
 void CudaSimulation::setSimulationParameters(SimulationParameters const & parameters)
 {
+    _parameters = parameters;
     checkCudaErrors(cudaMemcpyToSymbol(
         cudaSimulationParameters, &parameters, sizeof(SimulationParameters), 0, cudaMemcpyHostToDevice));
+    _constantMemoryData->simulationParameters = parameters;  //pending uploads are finished after cudaMemcpyToSymbol
 }
 
 void CudaSimulation::setExecutionParameters(ExecutionParameters const & parameters)
 {
+    _executionParameters = parameters;
     checkCudaErrors(cudaMemcpyToSymbol(
         cudaExecutionParameters,
         &parameters,
         sizeof(ExecutionParameters),
         0,
         cudaMemcpyHostToDevice));
+    _constantMemoryData->executionParameters = parameters;
 }
 
 void CudaSimulation::clear()
@@ -219,36 +346,57 @@ void CudaSimulation::clear()
     GPU_FUNCTION(clearData, *_cudaSimulationData);
 }
 
-namespace
+void CudaSimulation::copyDataTOtoHost(DataAccessTO const& dataTO, int projection)
 {
-    void calcImageBlurFactors(int* imageBlurFactors)
-    {
-        imageBlurFactors[0] = 300;
-        imageBlurFactors[1] = 40;
-        imageBlurFactors[2] = 7;
-        imageBlurFactors[3] = 7;
-        imageBlurFactors[4] = 7;
-        imageBlurFactors[5] = 7;
-
-        int sum = 0;
-        int2 relPos;
-        for (relPos.x = -5; relPos.x <= 5; ++relPos.x) {
-            for (relPos.y = -5; relPos.y <= 5; ++relPos.y) {
-                auto r = Math::length(toFloat2(relPos));
-                if (r <= 5 + FP_PRECISION) {
-                    sum += imageBlurFactors[floorInt(r)];
-                }
-            }
-        }
-        imageBlurFactors[6] = sum - 400;
+    checkCudaErrors(cudaMemcpy(dataTO.numClusters, _cudaAccessTO->numClusters, sizeof(int), cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(dataTO.numCells, _cudaAccessTO->numCells, sizeof(int), cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(dataTO.numParticles, _cudaAccessTO->numParticles, sizeof(int), cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(dataTO.numTokens, _cudaAccessTO->numTokens, sizeof(int), cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(dataTO.numStringBytes, _cudaAccessTO->numStringBytes, sizeof(int), cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(dataTO.clusters, _cudaAccessTO->clusters, sizeof(ClusterAccessTO) * (*dataTO.numClusters), cudaMemcpyDeviceToHost));
+    auto const cellPrefixSize = getCellAccessTOPrefixSize(projection);
+    if (sizeof(CellAccessTO) == cellPrefixSize) {
+        checkCudaErrors(cudaMemcpy(dataTO.cells, _cudaAccessTO->cells, sizeof(CellAccessTO) * (*dataTO.numCells), cudaMemcpyDeviceToHost));
     }
+    else if (*dataTO.numCells > 0) {
+        //only the projected prefix of each cell is transferred
+        checkCudaErrors(cudaMemcpy2D(
+            dataTO.cells,
+            sizeof(CellAccessTO),
+            _cudaAccessTO->cells,
+            sizeof(CellAccessTO),
+            cellPrefixSize,
+            *dataTO.numCells,
+            cudaMemcpyDeviceToHost));
+    }
+    checkCudaErrors(cudaMemcpy(dataTO.particles, _cudaAccessTO->particles, sizeof(ParticleAccessTO) * (*dataTO.numParticles), cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(dataTO.tokens, _cudaAccessTO->tokens, sizeof(TokenAccessTO) * (*dataTO.numTokens), cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(dataTO.stringBytes, _cudaAccessTO->stringBytes, sizeof(char) * (*dataTO.numStringBytes), cudaMemcpyDeviceToHost));
+}
+
+void CudaSimulation::copyDataTOtoDevice(DataAccessTO const& dataTO)
+{
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numClusters, dataTO.numClusters, sizeof(int), cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numCells, dataTO.numCells, sizeof(int), cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numParticles, dataTO.numParticles, sizeof(int), cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numTokens, dataTO.numTokens, sizeof(int), cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->numStringBytes, dataTO.numStringBytes, sizeof(int), cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->clusters, dataTO.clusters, sizeof(ClusterAccessTO) * (*dataTO.numClusters), cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->cells, dataTO.cells, sizeof(CellAccessTO) * (*dataTO.numCells), cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->particles, dataTO.particles, sizeof(ParticleAccessTO) * (*dataTO.numParticles), cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->tokens, dataTO.tokens, sizeof(TokenAccessTO) * (*dataTO.numTokens), cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(_cudaAccessTO->stringBytes, dataTO.stringBytes, sizeof(char) * (*dataTO.numStringBytes), cudaMemcpyHostToDevice));
 }
 
 void CudaSimulation::setCudaConstants(CudaConstants const & cudaConstants_)
 {
+    _cudaConstants = cudaConstants_;
     checkCudaErrors(cudaMemcpyToSymbol(cudaConstants, &cudaConstants_, sizeof(CudaConstants), 0, cudaMemcpyHostToDevice));
 
     int imageBlurFactors[7];
     calcImageBlurFactors(imageBlurFactors);
     checkCudaErrors(cudaMemcpyToSymbol(cudaImageBlurFactors, &imageBlurFactors, sizeof(int) * 7, 0, cudaMemcpyHostToDevice));
+
+    _constantMemoryData->cudaConstants = cudaConstants_;
+    std::copy(imageBlurFactors, imageBlurFactors + 7, _constantMemoryData->imageBlurFactors);
 }
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "ModelBasic/MonitorData.h"
+#include "ModelBasic/MonitorStatistics.h"
 #include "ModelBasic/ExecutionParameters.h"
+#include "ModelBasic/SimulationParameters.h"
+#include "ModelBasic/ElementaryTypes.h"
 
 #include "Definitions.cuh"
+#include "CudaConstants.h"
 
 class CudaSimulation
 {
@@ -12,15 +16,51 @@ public:
         int2 const& size,
         int timestep,
         SimulationParameters const& parameters,
-        CudaConstants const& cudaConstants);
+        CudaConstants const& cudaConstants,
+        uint64_t firstId = 1);
     ~CudaSimulation();
 
     void calcCudaTimestep();
 
-    void getSimulationImage(int2 const& rectUpperLeft, int2 const& rectLowerRight, unsigned char* imageData);
-    void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
+    //for running several simulations in one process (see Ensemble): constant memory is shared by all simulations,
+    //hence activate() has to be called before a simulation is used after another one
+    //the upload is queued behind the kernels launched so far without waiting for them
+    void activate();
+    void launchTimestep();
+    static void synchronize();
+
+    void getSimulationImage(
+        int2 const& rectUpperLeft,
+        int2 const& rectLowerRight,
+        int2 const& imageSize,
+        unsigned char* imageData);
+    void getSimulationData(
+        int2 const& rectUpperLeft,
+        int2 const& rectLowerRight,
+        DataAccessTO const& dataTO,
+        int projection = Enums::DataProjection::ALL);
     void setSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
 
+    //clusters of dataTO are added as ghosts (see addGhostAccessData), they are removed by the next setSimulationData
+    void addGhostData(DataAccessTO const& dataTO);
+
+    //frozen clusters are moved to dataTO and removed from the simulation
+    void evictFrozenClusters(DataAccessTO const& dataTO);
+
+    //number of entities and string bytes which can still be added by setSimulationData
+    struct FreeCapacity
+    {
+        int numClusters;
+        int numCells;
+        int numTokens;
+        int numStringBytes;
+    };
+    FreeCapacity getFreeCapacity() const;
+
+    //returns the indices of the cold blocks (see ColdClusterStore) which active clusters have approached
+    vector<int> getWokenColdBlocks();
+    void setColdBlocks(vector<int> const& coldBlocks);
+
     struct ApplyForceData
     {
         float2 startPos;
@@ -31,6 +71,7 @@ public:
     void applyForce(ApplyForceData const& applyData);
 
     MonitorData getMonitorData();
+    MonitorStatistics getMonitorStatistics();
     int getTimestep() const;
     void setTimestep(int timestep);
 
@@ -41,10 +82,29 @@ public:
 
 private:
     void setCudaConstants(CudaConstants const& cudaConstants);
+    void copyDataTOtoHost(DataAccessTO const& dataTO, int projection = Enums::DataProjection::ALL);
+    void copyDataTOtoDevice(DataAccessTO const& dataTO);
+    void printMemoryUsage() const;
+    void reportLostMapEntries();
     void DEBUG_printNumEntries();
 
 private:
     SimulationData* _cudaSimulationData;
     DataAccessTO* _cudaAccessTO;
     CudaMonitorData* _cudaMonitorData;
+
+    CudaConstants _cudaConstants;
+    SimulationParameters _parameters;
+    ExecutionParameters _executionParameters;
+    int _numReportedLostMapEntries = 0;
+
+    //page-locked copies for the asynchronous upload in activate(), only written after the device is idle
+    struct ConstantMemoryData
+    {
+        CudaConstants cudaConstants;
+        SimulationParameters simulationParameters;
+        ExecutionParameters executionParameters;
+        int imageBlurFactors[7];
+    };
+    ConstantMemoryData* _constantMemoryData = nullptr;
 };
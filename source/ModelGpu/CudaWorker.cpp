@@ -1,19 +1,29 @@
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <iostream>
 #include <QImage>
 #include <QElapsedTimer>
 #include <QThread>
 
+#include "Base/TraceRecorder.h"
+
 #include "ModelBasic/SpaceProperties.h"
 #include "ModelBasic/PhysicalActions.h"
 
 #include "AccessTOs.cuh"
 #include "CudaJobs.h"
 #include "CudaWorker.h"
+#include "FrameRecorder.h"
+#include "ImageRenderer.h"
 #include "ModelGpuData.h"
 
 CudaWorker::~CudaWorker()
 {
 	delete _cudaSimulation;
+	delete _coldClusterStore;
+	delete _frameRecorder;
+	deletePagingDataTO();
 }
 
 void CudaWorker::init(
@@ -26,6 +36,14 @@ void CudaWorker::init(
 	auto size = space->getSize();
 	delete _cudaSimulation;
 	_cudaSimulation = new CudaSimulation({ size.x, size.y }, timestep, parameters, cudaConstants);
+
+	delete _coldClusterStore;
+	_coldClusterStore = new ColdClusterStore(size);
+	delete _frameRecorder;
+	_frameRecorder = nullptr;
+	deletePagingDataTO();
+	_cudaConstants = cudaConstants;
+	_timestepOfLastPaging = timestep;
 }
 
 void CudaWorker::terminateWorker()
@@ -61,6 +79,7 @@ vector<CudaJob> CudaWorker::getFinishedJobs(string const & originId)
 
 void CudaWorker::run()
 {
+	TRACE_THREAD_NAME("CudaWorker");
 	do {
 		QElapsedTimer timer;
 		timer.start();
@@ -68,10 +87,16 @@ void CudaWorker::run()
 		processJobs();
 
 		if (isSimulationRunning()) {
-			_cudaSimulation->calcCudaTimestep();
+			{
+				TRACE_SCOPE("calcCudaTimestep");
+				_cudaSimulation->calcCudaTimestep();
+			}
+			pageFrozenClustersIfRequired();
+			recordFrameIfDue();
 			if (_tpsRestriction) {
 				int remainingTime = 1000000 / (*_tpsRestriction) - timer.nsecsElapsed() / 1000;
 				if (remainingTime > 0) {
+					TRACE_SCOPE("tpsRestriction");
 					QThread::usleep(remainingTime);
 				}
 			}
@@ -80,6 +105,7 @@ void CudaWorker::run()
 
 		std::unique_lock<std::mutex> uniqueLock(_mutex);
 		if (!_jobs.empty() && !_terminate) {
+			TRACE_SCOPE("waitForJobs");
 			_condition.wait(uniqueLock, [this]() {
 				return !_jobs.empty() || _terminate;
 			});
@@ -93,28 +119,43 @@ void CudaWorker::processJobs()
 	if (_jobs.empty()) {
 		return;
 	}
+	TRACE_SCOPE("processJobs");
+	TRACE_COUNTER("jobs", _jobs.size());
 	bool notify = false;
 
 	for (auto const& job : _jobs) {
 
         if (auto _job = boost::dynamic_pointer_cast<_GetImageJob>(job)) {
             auto rect = _job->getRect();
+            auto imageSize = _job->getImageSize();
             auto image = _job->getTargetImage();
             auto& mutex = _job->getMutex();
 
-            std::lock_guard<std::mutex> lock(mutex);
-            _cudaSimulation->getSimulationImage({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, image->bits());
+            TRACE_SCOPE("getSimulationImage");
+            std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+            {
+                TRACE_SCOPE("waitForImageMutex");
+                lock.lock();
+            }
+            _cudaSimulation->getSimulationImage(
+                { rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, { imageSize.x, imageSize.y }, image->bits());
+            renderColdClusters(rect, imageSize, reinterpret_cast<unsigned int*>(image->bits()));
         }
 
 		if (auto _job = boost::dynamic_pointer_cast<_GetDataJob>(job)) {
 			auto rect = _job->getRect();
 			auto dataTO = _job->getDataTO();
-			_cudaSimulation->getSimulationData({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO);
+			TRACE_SCOPE("getSimulationData");
+			_cudaSimulation->getSimulationData(
+                { rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO, _job->getProjection());
+			copyColdClusters(rect, dataTO, _job->getProjection());
 		}
 
 		if (auto _job = boost::dynamic_pointer_cast<_SetDataJob>(job)) {
             auto rect = _job->getRect();
 			auto dataTO = _job->getDataTO();
+			TRACE_SCOPE("setSimulationData");
+			removeColdClusters(rect);
 			_cudaSimulation->setSimulationData({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO);
 		}
 
@@ -127,7 +168,10 @@ void CudaWorker::processJobs()
 		}
 
 		if (auto _job = boost::dynamic_pointer_cast<_CalcSingleTimestepJob>(job)) {
+			TRACE_SCOPE("calcCudaTimestep");
 			_cudaSimulation->calcCudaTimestep();
+			pageFrozenClustersIfRequired();
+			recordFrameIfDue();
 			Q_EMIT timestepCalculated();
 		}
 
@@ -140,15 +184,36 @@ void CudaWorker::processJobs()
 		}
 
         if (auto _job = boost::dynamic_pointer_cast<_SetExecutionParametersJob>(job)) {
-            _cudaSimulation->setExecutionParameters(_job->getSimulationExecutionParameters());
+            _executionParameters = _job->getSimulationExecutionParameters();
+            _cudaSimulation->setExecutionParameters(_executionParameters);
+        }
+
+        if (auto _job = boost::dynamic_pointer_cast<_StartRecordingJob>(job)) {
+            delete _frameRecorder;
+            _frameRecorder = new FrameRecorder(_job->getRecordingParameters(), _space->getSize());
+        }
+
+        if (auto _job = boost::dynamic_pointer_cast<_StopRecordingJob>(job)) {
+            //waits at most for the encoding of the pending frames
+            delete _frameRecorder;
+            _frameRecorder = nullptr;
         }
 
         if (auto _job = boost::dynamic_pointer_cast<_GetMonitorDataJob>(job)) {
+            TRACE_SCOPE("getMonitorData");
             _job->setMonitorData(_cudaSimulation->getMonitorData());
         }
 
+        if (auto _job = boost::dynamic_pointer_cast<_GetMonitorStatisticsJob>(job)) {
+            _job->setMonitorStatistics(_cudaSimulation->getMonitorStatistics());
+        }
+
         if (auto _job = boost::dynamic_pointer_cast<_ClearDataJob>(job)) {
             _cudaSimulation->clear();
+            if (_coldClusterStore->getMemoryUsage().numClusters > 0) {
+                _coldClusterStore->clear();
+                _cudaSimulation->setColdBlocks(_coldClusterStore->getColdBlocks());
+            }
         }
 
         if (auto _job = boost::dynamic_pointer_cast<_PhysicalActionJob>(job)) {
@@ -157,12 +222,14 @@ void CudaWorker::processJobs()
                 float2 startPos = { _action->getStartPos().x(), _action->getStartPos().y() };
                 float2 endPos = { _action->getEndPos().x(), _action->getEndPos().y() };
                 float2 force = { _action->getForce().x(), _action->getForce().y() };
+                restoreColdClustersForAction(startPos, endPos);
                 _cudaSimulation->applyForce({ startPos, endPos, force, false });
             }
             if (auto _action = boost::dynamic_pointer_cast<_ApplyRotationAction>(action)) {
                 float2 startPos = { _action->getStartPos().x(), _action->getStartPos().y() };
                 float2 endPos = { _action->getEndPos().x(), _action->getEndPos().y() };
                 float2 force = { _action->getForce().x(), _action->getForce().y() };
+                restoreColdClustersForAction(startPos, endPos);
                 _cudaSimulation->applyForce({ startPos, endPos, force, true });
             }
         }
@@ -204,3 +271,218 @@ void CudaWorker::setTimestep(int timestep)
     std::lock_guard<std::mutex> lock(_mutex);
     return _cudaSimulation->setTimestep(timestep);
 }
+
+void CudaWorker::pageFrozenClustersIfRequired()
+{
+    if (!_executionParameters.activateFreezing || _executionParameters.pagingTimesteps <= 0) {
+        return;
+    }
+    auto const timestep = _cudaSimulation->getTimestep();
+    if (timestep - _timestepOfLastPaging < _executionParameters.pagingTimesteps) {
+        return;
+    }
+
+    //all clusters have just been unfrozen in the last timestep
+    if ((timestep - 1) % _executionParameters.freezingTimesteps == 0) {
+        return;
+    }
+    _timestepOfLastPaging = timestep;
+    TRACE_SCOPE("pageFrozenClusters");
+
+    if (!_pagingDataTO) {
+        createPagingDataTO();
+    }
+    auto const hasColdClusters = _coldClusterStore->getMemoryUsage().numClusters > 0;
+    auto const wokenBlocks = hasColdClusters ? _cudaSimulation->getWokenColdBlocks() : vector<int>();
+
+    _cudaSimulation->evictFrozenClusters(*_pagingDataTO);
+    auto const numEvictedClusters = *_pagingDataTO->numClusters;
+    _coldClusterStore->evict(*_pagingDataTO);
+
+    if (!wokenBlocks.empty()) {
+        resetPagingDataTO();
+        addRestoredClusters(_coldClusterStore->restore(wokenBlocks, *_pagingDataTO, getFreeCapacity()));
+    }
+    if (numEvictedClusters > 0 || !wokenBlocks.empty()) {
+        _cudaSimulation->setColdBlocks(_coldClusterStore->getColdBlocks());
+    }
+}
+
+void CudaWorker::recordFrameIfDue()
+{
+    if (!_frameRecorder) {
+        return;
+    }
+    auto const timestep = _cudaSimulation->getTimestep();
+    if (!_frameRecorder->isFrameDue(timestep)) {
+        return;
+    }
+    TRACE_SCOPE("recordFrame");
+
+    //the simulation thread only renders into a free frame and hands it over to the encoding threads
+    if (auto const frame = _frameRecorder->acquireFrame(timestep)) {
+        auto const size = _space->getSize();
+        _cudaSimulation->getSimulationImage(
+            { 0, 0 },
+            { size.x - 1, size.y - 1 },
+            { frame->size.x, frame->size.y },
+            reinterpret_cast<unsigned char*>(frame->pixels.data()));
+        renderColdClusters({ { 0, 0 }, { size.x - 1, size.y - 1 } }, frame->size, frame->pixels.data());
+        _frameRecorder->submitFrame(frame);
+    }
+}
+
+void CudaWorker::restoreColdClusters(IntVector2D const & rectUpperLeft, IntVector2D const & rectLowerRight)
+{
+    if (0 == _coldClusterStore->getMemoryUsage().numClusters) {
+        return;
+    }
+    if (!_pagingDataTO) {
+        createPagingDataTO();
+    }
+    resetPagingDataTO();
+    auto const numRestoredClusters =
+        _coldClusterStore->restore(rectUpperLeft, rectLowerRight, *_pagingDataTO, getFreeCapacity());
+    addRestoredClusters(numRestoredClusters);
+    if (numRestoredClusters > 0) {
+        _cudaSimulation->setColdBlocks(_coldClusterStore->getColdBlocks());
+    }
+}
+
+//the action affects cells within a radius of 20 around the segment (see actionRadius in PhysicalActionKernels.cuh),
+//the segment is not wrapped around the borders of the universe
+void CudaWorker::restoreColdClustersForAction(float2 const& startPos, float2 const& endPos)
+{
+    auto const actionRadius = 20.0f;
+    IntVector2D const rectUpperLeft{ static_cast<int>(std::floor(std::min(startPos.x, endPos.x) - actionRadius)),
+                                     static_cast<int>(std::floor(std::min(startPos.y, endPos.y) - actionRadius)) };
+    IntVector2D const rectLowerRight{ static_cast<int>(std::ceil(std::max(startPos.x, endPos.x) + actionRadius)),
+                                      static_cast<int>(std::ceil(std::max(startPos.y, endPos.y) + actionRadius)) };
+    restoreColdClusters(rectUpperLeft, rectLowerRight);
+}
+
+//the data of the rect is replaced by the subsequent setSimulationData, which contains the cold clusters of the rect
+//since they have been copied by the preceding getSimulationData
+void CudaWorker::removeColdClusters(IntRect const& rect)
+{
+    if (0 == _coldClusterStore->getMemoryUsage().numClusters) {
+        return;
+    }
+    if (_coldClusterStore->remove({ rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }) > 0) {
+        _cudaSimulation->setColdBlocks(_coldClusterStore->getColdBlocks());
+    }
+}
+
+//cold clusters are copied from the host memory without restoring them, so that the transfer object contains the
+//same clusters as if paging was inactive
+void CudaWorker::copyColdClusters(IntRect const& rect, DataAccessTO const& dataTO, int projection)
+{
+    if (0 == _coldClusterStore->getMemoryUsage().numClusters) {
+        return;
+    }
+    int position = 0;
+    if (!_coldClusterStore->copy(
+            { rect.p1.x, rect.p1.y }, { rect.p2.x, rect.p2.y }, dataTO, getTransferCapacity(), projection, position)) {
+        std::cerr << "[CUDA] cold clusters exceed the transfer capacity, data of rect (" << rect.p1.x << ", "
+                  << rect.p1.y << ") - (" << rect.p2.x << ", " << rect.p2.y << ") is incomplete" << std::endl;
+    }
+}
+
+//cold clusters are rendered on the host in portions of the paging transfer object and added to the device image
+void CudaWorker::renderColdClusters(IntRect const& rect, IntVector2D const& imageSize, unsigned int* imageData)
+{
+    if (0 == _coldClusterStore->getMemoryUsage().numClusters) {
+        return;
+    }
+    if (!_pagingDataTO) {
+        createPagingDataTO();
+    }
+    ImageRenderer const renderer(_executionParameters);
+    auto const universeSize = _space->getSize();
+    int position = 0;
+    bool complete = false;
+    while (!complete) {
+        resetPagingDataTO();
+        complete = _coldClusterStore->copy(
+            { rect.p1.x, rect.p1.y },
+            { rect.p2.x, rect.p2.y },
+            *_pagingDataTO,
+            getTransferCapacity(),
+            Enums::DataProjection::ALL,
+            position);
+        if (0 == *_pagingDataTO->numClusters) {
+            break;
+        }
+        for (int index = 0; index < *_pagingDataTO->numCells; ++index) {
+            auto& pos = _pagingDataTO->cells[index].pos;
+            pos.x = std::fmod(std::fmod(pos.x, static_cast<float>(universeSize.x)) + universeSize.x, universeSize.x);
+            pos.y = std::fmod(std::fmod(pos.y, static_cast<float>(universeSize.y)) + universeSize.y, universeSize.y);
+        }
+        renderer.renderOver(*_pagingDataTO, rect, imageSize, imageData);
+    }
+}
+
+auto CudaWorker::getFreeCapacity() const -> ColdClusterStore::Capacity
+{
+    auto const freeCapacity = _cudaSimulation->getFreeCapacity();
+    return { freeCapacity.numClusters, freeCapacity.numCells, freeCapacity.numTokens, freeCapacity.numStringBytes };
+}
+
+auto CudaWorker::getTransferCapacity() const -> ColdClusterStore::Capacity
+{
+    return { _cudaConstants.MAX_CLUSTERS,
+             _cudaConstants.MAX_CELLS,
+             _cudaConstants.MAX_TOKENS,
+             _cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE };
+}
+
+void CudaWorker::addRestoredClusters(int numRestoredClusters)
+{
+    if (numRestoredClusters > 0) {
+        //empty rect: no entities are removed before the restored clusters are added
+        _cudaSimulation->setSimulationData({ 0, 0 }, { -1, -1 }, *_pagingDataTO);
+    }
+}
+
+void CudaWorker::resetPagingDataTO()
+{
+    *_pagingDataTO->numClusters = 0;
+    *_pagingDataTO->numCells = 0;
+    *_pagingDataTO->numParticles = 0;
+    *_pagingDataTO->numTokens = 0;
+    *_pagingDataTO->numStringBytes = 0;
+}
+
+void CudaWorker::createPagingDataTO()
+{
+    DataAccessTO dataTO;
+    dataTO.numClusters = new int;
+    dataTO.numCells = new int;
+    dataTO.numParticles = new int;
+    dataTO.numTokens = new int;
+    dataTO.numStringBytes = new int;
+    dataTO.clusters = new ClusterAccessTO[_cudaConstants.MAX_CLUSTERS];
+    dataTO.cells = new CellAccessTO[_cudaConstants.MAX_CELLS];
+    dataTO.particles = new ParticleAccessTO[_cudaConstants.MAX_PARTICLES];
+    dataTO.tokens = new TokenAccessTO[_cudaConstants.MAX_TOKENS];
+    dataTO.stringBytes = new char[_cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE];
+    _pagingDataTO = dataTO;
+}
+
+void CudaWorker::deletePagingDataTO()
+{
+    if (!_pagingDataTO) {
+        return;
+    }
+    delete _pagingDataTO->numClusters;
+    delete _pagingDataTO->numCells;
+    delete _pagingDataTO->numParticles;
+    delete _pagingDataTO->numTokens;
+    delete _pagingDataTO->numStringBytes;
+    delete[] _pagingDataTO->clusters;
+    delete[] _pagingDataTO->cells;
+    delete[] _pagingDataTO->particles;
+    delete[] _pagingDataTO->tokens;
+    delete[] _pagingDataTO->stringBytes;
+    _pagingDataTO = boost::none;
+}
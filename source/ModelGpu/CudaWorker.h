@@ -4,7 +4,10 @@
 #include <QThread>
 
 #include "ModelBasic/ChangeDescriptions.h"
+#include "ModelBasic/ExecutionParameters.h"
 #include "AccessTOs.cuh"
+#include "CudaConstants.h"
+#include "ColdClusterStore.h"
 #include "DefinitionsImpl.h"
 
 class CudaWorker
@@ -38,9 +41,29 @@ private:
 	void processJobs();
 	bool isTerminate();
 
+	void pageFrozenClustersIfRequired();
+	void recordFrameIfDue();
+	void restoreColdClusters(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+	void restoreColdClustersForAction(float2 const& startPos, float2 const& endPos);
+	void removeColdClusters(IntRect const& rect);
+	void copyColdClusters(IntRect const& rect, DataAccessTO const& dataTO, int projection);
+	void renderColdClusters(IntRect const& rect, IntVector2D const& imageSize, unsigned int* imageData);
+	ColdClusterStore::Capacity getFreeCapacity() const;
+	ColdClusterStore::Capacity getTransferCapacity() const;
+	void addRestoredClusters(int numRestoredClusters);
+	void resetPagingDataTO();
+	void createPagingDataTO();
+	void deletePagingDataTO();
+
 private:
 	SpaceProperties* _space = nullptr;
 	CudaSimulation* _cudaSimulation = nullptr;
+	ColdClusterStore* _coldClusterStore = nullptr;
+	FrameRecorder* _frameRecorder = nullptr;
+	CudaConstants _cudaConstants;
+	ExecutionParameters _executionParameters;
+	optional<DataAccessTO> _pagingDataTO;
+	int _timestepOfLastPaging = 0;
 
 	mutable std::mutex _mutex;
 	std::condition_variable _condition;
@@ -4,9 +4,10 @@
 #include "ModelBasic/Physics.h"
 
 #include "DataConverter.h"
+#include "SpaceFillingCurve.h"
 
-DataConverter::DataConverter(DataAccessTO& dataTO, NumberGenerator* numberGen, SimulationParameters const& parameters)
-	: _dataTO(dataTO), _numberGen(numberGen), _parameters(parameters)
+DataConverter::DataConverter(DataAccessTO& dataTO, NumberGenerator* numberGen, SimulationParameters const& parameters, IntVector2D const& universeSize)
+	: _dataTO(dataTO), _numberGen(numberGen), _parameters(parameters), _universeSize(universeSize)
 {}
 
 void DataConverter::updateData(DataChangeDescription const & data)
@@ -31,16 +32,38 @@ void DataConverter::updateData(DataChangeDescription const & data)
 	processDeletions();
 	processModifications();
 
+	//new entities are added in Morton order for memory locality on the device, the same bins as for the reordering on
+	//the device are used such that both yield the same order
+	vector<ClusterDescription> clustersToAdd;
 	for (auto const& cluster : data.clusters) {
 		if (cluster.isAdded()) {
-			addCluster(cluster.getValue());
+			clustersToAdd.emplace_back(cluster.getValue());
 		}
 	}
+	auto const clusterOrder = calcSpaceFillingCurveOrder(clustersToAdd, _universeSize.x, _universeSize.y,
+		[](ClusterDescription const& cluster) {
+			auto const pos = cluster.pos ? *cluster.pos : cluster.getClusterPosFromCells();
+			return std::make_pair(pos.x(), pos.y());
+		},
+		SpaceFillingCurve::NumBitsPerAxisForReordering);
+	for (int index : clusterOrder) {
+		addCluster(clustersToAdd[index]);
+	}
+
+	vector<ParticleDescription> particlesToAdd;
 	for (auto const& particle : data.particles) {
 		if (particle.isAdded()) {
-			addParticle(particle.getValue());
+			particlesToAdd.emplace_back(particle.getValue());
 		}
 	}
+	auto const particleOrder = calcSpaceFillingCurveOrder(particlesToAdd, _universeSize.x, _universeSize.y,
+		[](ParticleDescription const& particle) {
+			return std::make_pair(particle.pos->x(), particle.pos->y());
+		},
+		SpaceFillingCurve::NumBitsPerAxisForReordering);
+	for (int index : particleOrder) {
+		addParticle(particlesToAdd[index]);
+	}
 }
 
 namespace
@@ -68,91 +91,118 @@ namespace
     }
 }
 
-DataDescription DataConverter::getDataDescription() const
+DataDescription DataConverter::getDataDescription(int projection) const
 {
+    _stringsByIndex.clear();
+
 	DataDescription result;
-	list<uint64_t> connectingCellIds;
-	unordered_map<int, int> cellIndexByCellTOIndex;
-	unordered_map<int, int> clusterIndexByCellTOIndex;
 	for (int i = 0; i < *_dataTO.numClusters; ++i) {
-		ClusterAccessTO const& clusterTO = _dataTO.clusters[i];
+		result.addCluster(getClusterDescription(i, projection));
+	}
+	for (int i = 0; i < *_dataTO.numParticles; ++i) {
+		result.addParticle(getParticleDescription(i, projection));
+	}
+	return result;
+}
 
+ClusterDescription DataConverter::getClusterDescription(int clusterIndex, int projection) const
+{
+    auto const withVelocities = 0 != (projection & Enums::DataProjection::VELOCITIES);
+    auto const withEnergies = 0 != (projection & Enums::DataProjection::ENERGIES);
+    auto const withConnections = 0 != (projection & Enums::DataProjection::CELL_CONNECTIONS);
+    auto const withMetadata = 0 != (projection & Enums::DataProjection::METADATA);
+    auto const withCellFunctionData = 0 != (projection & Enums::DataProjection::CELL_FUNCTION_DATA);
+    auto const withTokens = 0 != (projection & Enums::DataProjection::TOKENS);
+
+	ClusterAccessTO const& clusterTO = _dataTO.clusters[clusterIndex];
+
+	auto result = ClusterDescription().setId(clusterTO.id).setPos({ clusterTO.pos.x, clusterTO.pos.y });
+    if (withVelocities) {
+        result.setVel({clusterTO.vel.x, clusterTO.vel.y})
+            .setAngle(clusterTO.angle)
+            .setAngularVel(clusterTO.angularVel);
+    }
+    if (withMetadata) {
         auto metadata = ClusterMetadata();
         auto const metadataTO = clusterTO.metadata;
         if (metadataTO.nameLen > 0) {
-            auto const name = QString::fromLatin1(&_dataTO.stringBytes[metadataTO.nameStringIndex], metadataTO.nameLen);
-            metadata.setName(name);
+            metadata.setName(getString(metadataTO.nameLen, metadataTO.nameStringIndex));
         }
+        result.setMetadata(metadata);
+    }
 
-		auto clusterDesc = ClusterDescription().setId(clusterTO.id).setPos({ clusterTO.pos.x, clusterTO.pos.y })
-			.setVel({ clusterTO.vel.x, clusterTO.vel.y })
-			.setAngle(clusterTO.angle)
-			.setAngularVel(clusterTO.angularVel).setMetadata(metadata);
-
-		for (int j = 0; j < clusterTO.numCells; ++j) {
-			CellAccessTO const& cellTO = _dataTO.cells[clusterTO.cellStartIndex + j];
-			auto pos = cellTO.pos;
-			auto id = cellTO.id;
-			connectingCellIds.clear();
-			for (int i = 0; i < cellTO.numConnections; ++i) {
-				connectingCellIds.emplace_back(_dataTO.cells[cellTO.connectionIndices[i]].id);
-			}
-			cellIndexByCellTOIndex.insert_or_assign(clusterTO.cellStartIndex + j, j);
-			clusterIndexByCellTOIndex.insert_or_assign(clusterTO.cellStartIndex + j, i);
-
-            auto feature = CellFeatureDescription().setType(static_cast<Enums::CellFunction::Type>(cellTO.cellFunctionType))
-                .setConstData(convertToQByteArray(cellTO.staticData, cellTO.numStaticBytes)).setVolatileData(convertToQByteArray(cellTO.mutableData, cellTO.numMutableBytes));
-
+	list<uint64_t> connectingCellIds;
+	for (int j = 0; j < clusterTO.numCells; ++j) {
+		CellAccessTO const& cellTO = _dataTO.cells[clusterTO.cellStartIndex + j];
+		auto pos = cellTO.pos;
+		auto id = cellTO.id;
+
+        auto cellDesc = CellDescription().setPos({pos.x, pos.y}).setId(id);
+        if (withEnergies) {
+            cellDesc.setEnergy(cellTO.energy);
+        }
+        if (withConnections) {
+            connectingCellIds.clear();
+            for (int i = 0; i < cellTO.numConnections; ++i) {
+                connectingCellIds.emplace_back(_dataTO.cells[cellTO.connectionIndices[i]].id);
+            }
+            cellDesc.setConnectingCells(connectingCellIds)
+                .setMaxConnections(cellTO.maxConnections)
+                .setTokenBranchNumber(cellTO.branchNumber)
+                .setFlagTokenBlocked(cellTO.tokenBlocked)
+                .setTokenUsages(cellTO.tokenUsages);
+        }
+        if (withMetadata) {
             auto const& metadataTO = cellTO.metadata;
             auto metadata = CellMetadata().setColor(metadataTO.color);
             if (metadataTO.nameLen > 0) {
-                auto const name = QString::fromLatin1(&_dataTO.stringBytes[metadataTO.nameStringIndex], metadataTO.nameLen);
-                metadata.setName(name);
+                metadata.setName(getString(metadataTO.nameLen, metadataTO.nameStringIndex));
             }
             if (metadataTO.descriptionLen > 0) {
-                auto const description = QString::fromLatin1(&_dataTO.stringBytes[metadataTO.descriptionStringIndex], metadataTO.descriptionLen);
-                metadata.setDescription(description);
+                metadata.setDescription(getString(metadataTO.descriptionLen, metadataTO.descriptionStringIndex));
             }
             if (metadataTO.sourceCodeLen > 0) {
-                auto const sourceCode = QString::fromLatin1(&_dataTO.stringBytes[metadataTO.sourceCodeStringIndex], metadataTO.sourceCodeLen);
-                metadata.setSourceCode(sourceCode);
+                metadata.setSourceCode(getString(metadataTO.sourceCodeLen, metadataTO.sourceCodeStringIndex));
             }
-
-            clusterDesc.addCell(CellDescription()
-                                    .setPos({pos.x, pos.y})
-                                    .setMetadata(CellMetadata())
-                                    .setEnergy(cellTO.energy)
-                                    .setId(id)
-                                    .setConnectingCells(connectingCellIds)
-                                    .setMaxConnections(cellTO.maxConnections)
-                                    .setTokenBranchNumber(0)
-                                    .setMetadata(metadata)
-                                    .setTokens(vector<TokenDescription>{})
-                                    .setTokenBranchNumber(cellTO.branchNumber)
-                                    .setFlagTokenBlocked(cellTO.tokenBlocked)
-                                    .setTokenUsages(cellTO.tokenUsages)
-                                    .setCellFeature(feature));
+            cellDesc.setMetadata(metadata);
         }
-		result.addCluster(clusterDesc);
-	}
-
-	for (int i = 0; i < *_dataTO.numParticles; ++i) {
-		ParticleAccessTO const& particle = _dataTO.particles[i];
-		result.addParticle(ParticleDescription().setId(particle.id).setPos({ particle.pos.x, particle.pos.y })
-			.setVel({ particle.vel.x, particle.vel.y }).setEnergy(particle.energy).setMetadata(ParticleMetadata().setColor(particle.metadata.color)));
-	}
+        if (withCellFunctionData) {
+            auto feature = CellFeatureDescription().setType(static_cast<Enums::CellFunction::Type>(cellTO.cellFunctionType))
+                .setConstData(convertToQByteArray(cellTO.staticData, cellTO.numStaticBytes)).setVolatileData(convertToQByteArray(cellTO.mutableData, cellTO.numMutableBytes));
+            cellDesc.setCellFeature(feature);
+        }
+        if (withTokens) {
+            cellDesc.setTokens(vector<TokenDescription>{});
+        }
+        result.addCell(cellDesc);
+    }
 
-	for (int i = 0; i < *_dataTO.numTokens; ++i) {
-		TokenAccessTO const& token = _dataTO.tokens[i];
-		ClusterDescription& cluster = result.clusters->at(clusterIndexByCellTOIndex.at(token.cellIndex));
-		CellDescription& cell = cluster.cells->at(cellIndexByCellTOIndex.at(token.cellIndex));
+    //the tokens of a cluster are stored consecutively
+	for (int i = 0; i < (withTokens ? clusterTO.numTokens : 0); ++i) {
+		TokenAccessTO const& token = _dataTO.tokens[clusterTO.tokenStartIndex + i];
+		CellDescription& cell = result.cells->at(token.cellIndex - clusterTO.cellStartIndex);
 		QByteArray data(_parameters.tokenMemorySize, 0);
 		for (int i = 0; i < _parameters.tokenMemorySize; ++i) {
 			data[i] = token.memory[i];
 		}
 		cell.addToken(TokenDescription().setEnergy(token.energy).setData(data));
 	}
+	return result;
+}
 
+ParticleDescription DataConverter::getParticleDescription(int particleIndex, int projection) const
+{
+	ParticleAccessTO const& particle = _dataTO.particles[particleIndex];
+	auto result = ParticleDescription().setId(particle.id).setPos({ particle.pos.x, particle.pos.y });
+    if (0 != (projection & Enums::DataProjection::VELOCITIES)) {
+        result.setVel({particle.vel.x, particle.vel.y});
+    }
+    if (0 != (projection & Enums::DataProjection::ENERGIES)) {
+        result.setEnergy(particle.energy);
+    }
+    if (0 != (projection & Enums::DataProjection::METADATA)) {
+        result.setMetadata(ParticleMetadata().setColor(particle.metadata.color));
+    }
 	return result;
 }
 
@@ -409,14 +459,33 @@ void DataConverter::processModifications()
 	}
 }
 
+QString DataConverter::getString(int len, int stringIndex) const
+{
+    auto findResult = _stringsByIndex.find(stringIndex);
+    if (findResult == _stringsByIndex.end()) {
+        findResult = _stringsByIndex.emplace(stringIndex, QString::fromLatin1(&_dataTO.stringBytes[stringIndex], len)).first;
+    }
+    return findResult->second;
+}
+
 int DataConverter::convertStringAndReturnStringIndex(QString const& s)
 {
-    auto const result = *_dataTO.numStringBytes;
+    auto const id = _stringTable.intern(s);
+    if (id < _stringIndexById.size()) {
+        return _stringIndexById[id];
+    }
+
+    auto const blockIndex = *_dataTO.numStringBytes;
+    auto const blockSize = getStringBlockSize(s.size());
+    std::fill(_dataTO.stringBytes + blockIndex, _dataTO.stringBytes + blockIndex + blockSize, 0);
+
+    auto const result = blockIndex + STRING_HEADER_SIZE;
     auto const len = s.size();
     for (int i = 0; i < len; ++i) {
         _dataTO.stringBytes[result + i] = s.at(i).toLatin1();
     }
-    (*_dataTO.numStringBytes) += len;
+    (*_dataTO.numStringBytes) += blockSize;
+    _stringIndexById.emplace_back(result);
     return result;
 }
 
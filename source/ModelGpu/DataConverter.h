@@ -1,17 +1,21 @@
 #pragma once
 
 #include "ModelBasic/Definitions.h"
+#include "ModelBasic/MetadataStringTable.h"
 #include "Definitions.h"
 #include "AccessTOs.cuh"
 
-class DataConverter
+class MODELGPU_EXPORT DataConverter
 {
 public:
-	DataConverter(DataAccessTO& dataTO, NumberGenerator* numberGen, SimulationParameters const& parameters);
+	DataConverter(DataAccessTO& dataTO, NumberGenerator* numberGen, SimulationParameters const& parameters, IntVector2D const& universeSize);
 
 	void updateData(DataChangeDescription const& data);
 
-	DataDescription getDataDescription() const;
+	//fields not contained in projection (combination of Enums::DataProjection::Type) remain unset
+	DataDescription getDataDescription(int projection = Enums::DataProjection::ALL) const;
+	ClusterDescription getClusterDescription(int clusterIndex, int projection = Enums::DataProjection::ALL) const;
+	ParticleDescription getParticleDescription(int particleIndex, int projection = Enums::DataProjection::ALL) const;
 
 private:
 	void addCluster(ClusterDescription const& clusterDesc);
@@ -34,15 +38,23 @@ private:
 	void applyChangeDescription(CellChangeDescription const& cellChanges, CellAccessTO& cell);
 
     int convertStringAndReturnStringIndex(QString const& s);
+    QString getString(int len, int stringIndex) const;
 
 private:
 	DataAccessTO& _dataTO;
 	NumberGenerator* _numberGen;
 	SimulationParameters _parameters;
+	IntVector2D _universeSize;
 
 	std::unordered_set<uint64_t> _clusterIdsToDelete;
 	std::unordered_map<uint64_t, ClusterChangeDescription> _clusterToModifyById;
 	std::unordered_map<uint64_t, CellChangeDescription> _cellToModifyById;
 	std::unordered_set<uint64_t> _particleIdsToDelete;
 	std::unordered_map<uint64_t, ParticleChangeDescription> _particleToModifyById;
+
+    MetadataStringTable _stringTable;
+    vector<int> _stringIndexById;
+
+    //strings shared in the transfer object are converted once and then shared by the implicitly shared QStrings
+    mutable unordered_map<int, QString> _stringsByIndex;
 };
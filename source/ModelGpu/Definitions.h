@@ -8,4 +8,5 @@ class SimulationControllerGpu;
 class SimulationAccessGpu;
 class ModelGpuData;
 class SimulationMonitorGpu;
+class SimulationEnsembleGpu;
 struct DataAccessTO;
@@ -7,6 +7,8 @@ class SimulationContextGpuImpl;
 class CudaWorker;
 class GpuObserver;
 class CudaController;
+class ColdClusterStore;
+class FrameRecorder;
 struct CudaConstants;
 class ModelGpuData;
 
@@ -12,32 +12,46 @@ private:
     int _size;
     int* _bytesOccupied;
     unsigned char** _data;
+    MemoryAllocator* _allocator;
 
 public:
     DynamicMemory()
         : _size(0)
+        , _allocator(nullptr)
     {}
 
-    __host__ __inline__ void init(uint64_t size)
+    //allocator = nullptr uses the allocator of the CudaMemoryManager
+    __host__ __inline__ void init(
+        uint64_t size,
+        MemorySubsystem::Type subsystem = MemorySubsystem::DynamicMemory,
+        MemoryAllocator* allocator = nullptr)
     {
         _size = size;
+        _allocator = allocator ? allocator : &CudaMemoryManager::getInstance().getAllocator();
         unsigned char* data = nullptr;
-        CudaMemoryManager::getInstance().acquireMemory<unsigned char>(size, data);
-        CudaMemoryManager::getInstance().acquireMemory<unsigned char*>(1, _data);
-        CudaMemoryManager::getInstance().acquireMemory<int>(1, _bytesOccupied);
+        _allocator->acquireMemory<unsigned char>(subsystem, size, data);
+        _allocator->acquireMemory<unsigned char*>(subsystem, 1, _data);
+        _allocator->acquireMemory<int>(subsystem, 1, _bytesOccupied);
 
-        checkCudaErrors(cudaMemcpy(_data, &data, sizeof(unsigned char*), cudaMemcpyHostToDevice));
-        checkCudaErrors(cudaMemset(_bytesOccupied, 0, sizeof(int)));
+        _allocator->copy(_data, &data, sizeof(unsigned char*));
+        _allocator->set(_bytesOccupied, 0, sizeof(int));
     }
 
     __host__ __inline__ void free()
     {
         unsigned char* data = nullptr;
-        checkCudaErrors(cudaMemcpy(&data, _data, sizeof(unsigned char*), cudaMemcpyDeviceToHost));
+        _allocator->copy(&data, _data, sizeof(unsigned char*));
 
-        CudaMemoryManager::getInstance().freeMemory(data);
-        CudaMemoryManager::getInstance().freeMemory(_data);
-        CudaMemoryManager::getInstance().freeMemory(_bytesOccupied);
+        _allocator->freeMemory(data);
+        _allocator->freeMemory(_data);
+        _allocator->freeMemory(_bytesOccupied);
+    }
+
+    int retrieveNumBytes() const
+    {
+        int result;
+        _allocator->copy(&result, _bytesOccupied, sizeof(int));
+        return result;
     }
 
     template<typename T>
@@ -56,6 +70,8 @@ public:
 
     __device__ __inline__ int getNumBytes() { return *_bytesOccupied; }
 
+    __device__ __inline__ unsigned char* getData() { return *_data; }
+
     __device__ __inline__ void reset() { *_bytesOccupied = 0; }
 
     __device__ __inline__ void swapContent(DynamicMemory& other)
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Base/Definitions.h"
+
+/**
+ * Runs many small independent universes in one engine instance, e.g. for parameter studies. The members are stepped
+ * in lock step: a timestep is launched for all members before waiting once for their completion, so that the
+ * synchronization per timestep is shared by the whole ensemble.
+ * The constant memory of the device is global, hence a member has to be activated (i.e. its parameters uploaded)
+ * before it is used. Access to the members is only granted via getActivatedMember() for this reason.
+ * Activating must not wait for the device (the upload is ordered behind the launched timesteps), otherwise the members
+ * would be run one after another.
+ *
+ * Universe has to provide activate(), launchTimestep() and a static synchronize().
+ */
+template<typename Universe>
+class Ensemble
+{
+public:
+    Ensemble() = default;
+    Ensemble(Ensemble const&) = delete;
+    void operator=(Ensemble const&) = delete;
+
+    ~Ensemble() { clear(); }
+
+    //takes ownership and returns the index of the new member
+    int add(Universe* universe)
+    {
+        _members.emplace_back(universe);
+        _activeIndex = -1;      //a new universe uploads its parameters on construction
+        return static_cast<int>(_members.size()) - 1;
+    }
+
+    int getNumMembers() const { return static_cast<int>(_members.size()); }
+
+    Universe& getActivatedMember(int index)
+    {
+        activate(index);
+        return *_members.at(index);
+    }
+
+    void calcTimesteps(int numTimesteps)
+    {
+        for (int timestep = 0; timestep < numTimesteps; ++timestep) {
+            for (int index = 0; index < getNumMembers(); ++index) {
+                activate(index);
+                _members[index]->launchTimestep();
+            }
+            Universe::synchronize();
+        }
+    }
+
+    void clear()
+    {
+        for (auto const& member : _members) {
+            delete member;
+        }
+        _members.clear();
+        _activeIndex = -1;
+    }
+
+private:
+    void activate(int index)
+    {
+        if (index != _activeIndex) {
+            _members.at(index)->activate();
+            _activeIndex = index;
+        }
+    }
+
+    vector<Universe*> _members;
+    int _activeIndex = -1;
+};
@@ -32,12 +32,14 @@ public:
     __inline__ __device__ Cluster* createCluster(Cluster** clusterPointerToReuse = nullptr);
     __inline__ __device__ void createClusterFromTO_block(
         ClusterAccessTO const& clusterTO,
-        DataAccessTO const* _simulationTO);
+        DataAccessTO const* _simulationTO,
+        bool ghost = false);
     __inline__ __device__ Cluster* createClusterWithRandomCell(float energy, float2 const& pos, float2 const& vel);
 
 private:
+    //stringBytes of the transfer object must already reside in the dynamic memory for strings
     __inline__ __device__ void
-    copyString(int& targetLen, char*& targetString, int sourceLen, int sourceStringIndex, char* stringBytes);
+    adoptString(int& targetLen, char*& targetString, int sourceLen, int sourceStringIndex, char* stringBytes);
 };
 
 /************************************************************************/
@@ -63,7 +65,8 @@ __inline__ __device__ Cluster * EntityFactory::createCluster(Cluster** clusterPo
 
 __inline__ __device__ void EntityFactory::createClusterFromTO_block(
     ClusterAccessTO const& clusterTO,
-    DataAccessTO const* simulationTO)
+    DataAccessTO const* simulationTO,
+    bool ghost)
 {
     __shared__ Cluster* cluster;
     __shared__ Cell* cells;
@@ -86,11 +89,11 @@ __inline__ __device__ void EntityFactory::createClusterFromTO_block(
         cluster->numCellPointers = clusterTO.numCells;
         cluster->cellPointers = _data->entities.cellPointers.getNewSubarray(cluster->numCellPointers);
         cells = _data->entities.cells.getNewSubarray(cluster->numCellPointers);
-        cluster->numTokenPointers = clusterTO.numTokens;
+        cluster->numTokenPointers = ghost ? 0 : clusterTO.numTokens;    //ghosts do not run cell functions
         cluster->tokenPointers = _data->entities.tokenPointers.getNewSubarray(cluster->numTokenPointers);
         tokens = _data->entities.tokens.getNewSubarray(cluster->numTokenPointers);
 
-        copyString(
+        adoptString(
             cluster->metadata.nameLen,
             cluster->metadata.name,
             clusterTO.metadata.nameLen,
@@ -101,6 +104,7 @@ __inline__ __device__ void EntityFactory::createClusterFromTO_block(
         cluster->locked = 0;
         cluster->clusterToFuse = nullptr;
         cluster->init();
+        cluster->ghost = ghost ? 1 : 0;
 
         angularMass = 0.0f;
         Math::inverseRotationMatrix(cluster->angle, invRotMatrix);
@@ -161,21 +165,21 @@ __inline__ __device__ void EntityFactory::createClusterFromTO_block(
         cell.tokenUsages = cellTO.tokenUsages;
         cell.metadata.color = cellTO.metadata.color;
 
-        copyString(
+        adoptString(
             cell.metadata.nameLen,
             cell.metadata.name,
             cellTO.metadata.nameLen,
             cellTO.metadata.nameStringIndex,
             simulationTO->stringBytes);
 
-        copyString(
+        adoptString(
             cell.metadata.descriptionLen,
             cell.metadata.description,
             cellTO.metadata.descriptionLen,
             cellTO.metadata.descriptionStringIndex,
             simulationTO->stringBytes);
 
-        copyString(
+        adoptString(
             cell.metadata.sourceCodeLen,
             cell.metadata.sourceCode,
             cellTO.metadata.sourceCodeLen,
@@ -323,14 +327,11 @@ EntityFactory::createClusterWithRandomCell(float energy, float2 const& pos, floa
 }
 
 __inline__ __device__ void
-EntityFactory::copyString(int& targetLen, char*& targetString, int sourceLen, int sourceStringIndex, char* stringBytes)
+EntityFactory::adoptString(int& targetLen, char*& targetString, int sourceLen, int sourceStringIndex, char* stringBytes)
 {
     targetLen = sourceLen;
     if (sourceLen > 0) {
-        targetString = _data->entities.strings.getArray<char>(sourceLen);
-        for (int i = 0; i < sourceLen; ++i) {
-            targetString[i] = stringBytes[sourceStringIndex + i];
-        }
+        targetString = &stringBytes[sourceStringIndex];
     }
 }
 
@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "Base/TaskScheduler.h"
+
+#include "EntityQueryEvaluator.h"
+
+EntityQueryEvaluator::EntityQueryEvaluator(EntityQuery const& query)
+{
+    _includeClusters = query.includeClusters;
+    _includeParticles = query.includeParticles;
+    if (query.rect) {
+        _checkRect = true;
+        _rectUpperLeft = {static_cast<float>(query.rect->p1.x), static_cast<float>(query.rect->p1.y)};
+        _rectLowerRight = {static_cast<float>(query.rect->p2.x), static_cast<float>(query.rect->p2.y)};
+    }
+    _checkCells = query.cellFunction || query.minEnergy || query.maxEnergy;
+    _clusterSpecific = query.cellFunction || query.minNumCells || query.maxNumCells || query.hasTokens
+        || query.clusterName;
+    _cellFunction = query.cellFunction ? static_cast<int>(*query.cellFunction) : -1;
+    _minEnergy = static_cast<float>(query.minEnergy.get_value_or(-std::numeric_limits<float>::infinity()));
+    _maxEnergy = static_cast<float>(query.maxEnergy.get_value_or(std::numeric_limits<float>::infinity()));
+    _minNumCells = query.minNumCells.get_value_or(0);
+    _maxNumCells = query.maxNumCells.get_value_or(std::numeric_limits<int>::max());
+    _hasTokens = query.hasTokens ? (*query.hasTokens ? 1 : 0) : -1;
+    //names are stored in Latin-1 (see DataConverter), the comparison is equivalent to comparing the query with the
+    //decoded names as QString, hence a name containing other characters matches no cluster
+    if (query.clusterName) {
+        _checkName = true;
+        for (int i = 0; i < query.clusterName->size(); ++i) {
+            auto const character = query.clusterName->at(i);
+            if (character.unicode() > 0xff) {
+                _nameRepresentable = false;
+            }
+            _name.push_back(character.toLatin1());
+        }
+    }
+}
+
+EntityQueryResult EntityQueryEvaluator::evaluate(DataAccessTO const& dataTO) const
+{
+    vector<char> clusterMatches;
+    vector<char> particleMatches;
+    calcMatches(dataTO, clusterMatches, particleMatches);
+    return getIds(dataTO, clusterMatches, particleMatches);
+}
+
+EntityQueryResult EntityQueryEvaluator::deleteMatching(DataAccessTO const& dataTO) const
+{
+    vector<char> clusterMatches;
+    vector<char> particleMatches;
+    calcMatches(dataTO, clusterMatches, particleMatches);
+    auto result = getIds(dataTO, clusterMatches, particleMatches);
+
+    //compaction in order since the target ranges may overlap the source ranges of preceding entities
+    auto const numClusters = *dataTO.numClusters;
+    vector<int> cellIndexShifts(numClusters, 0);
+    int newNumClusters = 0;
+    int newNumCells = 0;
+    int newNumTokens = 0;
+    for (int clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex) {
+        if (clusterMatches[clusterIndex]) {
+            continue;
+        }
+        auto cluster = dataTO.clusters[clusterIndex];
+        cellIndexShifts[newNumClusters] = cluster.cellStartIndex - newNumCells;
+        std::memmove(
+            &dataTO.cells[newNumCells], &dataTO.cells[cluster.cellStartIndex], sizeof(CellAccessTO) * cluster.numCells);
+        std::memmove(
+            &dataTO.tokens[newNumTokens],
+            &dataTO.tokens[cluster.tokenStartIndex],
+            sizeof(TokenAccessTO) * cluster.numTokens);
+        cluster.cellStartIndex = newNumCells;
+        cluster.tokenStartIndex = newNumTokens;
+        newNumCells += cluster.numCells;
+        newNumTokens += cluster.numTokens;
+        dataTO.clusters[newNumClusters++] = cluster;
+    }
+
+    //cells are only connected within their clusters
+    TaskScheduler::getInstance().parallelFor(
+        0,
+        newNumClusters,
+        [&](int clusterIndex) {
+            auto const shift = cellIndexShifts[clusterIndex];
+            if (0 == shift) {
+                return;
+            }
+            auto const& cluster = dataTO.clusters[clusterIndex];
+            for (int cellIndex = cluster.cellStartIndex; cellIndex < cluster.cellStartIndex + cluster.numCells;
+                 ++cellIndex) {
+                auto& cell = dataTO.cells[cellIndex];
+                for (int connectionIndex = 0; connectionIndex < cell.numConnections; ++connectionIndex) {
+                    cell.connectionIndices[connectionIndex] -= shift;
+                }
+            }
+            for (int tokenIndex = cluster.tokenStartIndex; tokenIndex < cluster.tokenStartIndex + cluster.numTokens;
+                 ++tokenIndex) {
+                dataTO.tokens[tokenIndex].cellIndex -= shift;
+            }
+        },
+        0,
+        nullptr,
+        "EntityQueryEvaluator shift");
+    *dataTO.numClusters = newNumClusters;
+    *dataTO.numCells = newNumCells;
+    *dataTO.numTokens = newNumTokens;
+
+    auto const numParticles = *dataTO.numParticles;
+    int newNumParticles = 0;
+    for (int particleIndex = 0; particleIndex < numParticles; ++particleIndex) {
+        if (!particleMatches[particleIndex]) {
+            dataTO.particles[newNumParticles++] = dataTO.particles[particleIndex];
+        }
+    }
+    *dataTO.numParticles = newNumParticles;
+
+    return result;
+}
+
+void EntityQueryEvaluator::calcMatches(
+    DataAccessTO const& dataTO,
+    vector<char>& clusterMatches,
+    vector<char>& particleMatches) const
+{
+    auto& scheduler = TaskScheduler::getInstance();
+    clusterMatches.assign(*dataTO.numClusters, 0);
+    if (_includeClusters) {
+        scheduler.parallelFor(
+            0,
+            *dataTO.numClusters,
+            [&](int clusterIndex) {
+                clusterMatches[clusterIndex] = isMatching(dataTO, dataTO.clusters[clusterIndex]) ? 1 : 0;
+            },
+            0,
+            nullptr,
+            "EntityQueryEvaluator clusters");
+    }
+    particleMatches.assign(*dataTO.numParticles, 0);
+    if (_includeParticles) {
+        scheduler.parallelFor(
+            0,
+            *dataTO.numParticles,
+            [&](int particleIndex) {
+                particleMatches[particleIndex] = isMatching(dataTO.particles[particleIndex]) ? 1 : 0;
+            },
+            0,
+            nullptr,
+            "EntityQueryEvaluator particles");
+    }
+}
+
+bool EntityQueryEvaluator::isMatching(DataAccessTO const& dataTO, ClusterAccessTO const& cluster) const
+{
+    if (cluster.numCells < _minNumCells || cluster.numCells > _maxNumCells) {
+        return false;
+    }
+    if (_hasTokens != -1 && (cluster.numTokens > 0 ? 1 : 0) != _hasTokens) {
+        return false;
+    }
+    if (_checkName) {
+        if (!_nameRepresentable || cluster.metadata.nameLen != static_cast<int>(_name.size())) {
+            return false;
+        }
+        auto const name = &dataTO.stringBytes[cluster.metadata.nameStringIndex];
+        if (!_name.empty() && 0 != std::memcmp(_name.data(), name, _name.size())) {
+            return false;
+        }
+    }
+
+    auto const cells = dataTO.cells + cluster.cellStartIndex;
+    if (_checkRect) {
+        auto const containedInRect = std::any_of(
+            cells, cells + cluster.numCells, [this](CellAccessTO const& cell) { return isContainedInRect(cell.pos); });
+        if (!containedInRect) {
+            return false;
+        }
+    }
+    if (_checkCells) {
+        return std::any_of(cells, cells + cluster.numCells, [this](CellAccessTO const& cell) {
+            auto const cellFunction =
+                static_cast<int>(static_cast<unsigned int>(cell.cellFunctionType) % Enums::CellFunction::_COUNTER);
+            return (-1 == _cellFunction || cellFunction == _cellFunction)
+                && cell.energy >= _minEnergy && cell.energy < _maxEnergy;
+        });
+    }
+    return true;
+}
+
+bool EntityQueryEvaluator::isMatching(ParticleAccessTO const& particle) const
+{
+    if (_clusterSpecific) {
+        return false;
+    }
+    if (_checkRect && !isContainedInRect(particle.pos)) {
+        return false;
+    }
+    return particle.energy >= _minEnergy && particle.energy < _maxEnergy;
+}
+
+bool EntityQueryEvaluator::isContainedInRect(float2 const& pos) const
+{
+    return pos.x >= _rectUpperLeft.x && pos.x <= _rectLowerRight.x && pos.y >= _rectUpperLeft.y
+        && pos.y <= _rectLowerRight.y;
+}
+
+EntityQueryResult EntityQueryEvaluator::getIds(
+    DataAccessTO const& dataTO,
+    vector<char> const& clusterMatches,
+    vector<char> const& particleMatches) const
+{
+    EntityQueryResult result;
+    for (int clusterIndex = 0; clusterIndex < static_cast<int>(clusterMatches.size()); ++clusterIndex) {
+        if (clusterMatches[clusterIndex]) {
+            result.clusterIds.emplace_back(dataTO.clusters[clusterIndex].id);
+        }
+    }
+    for (int particleIndex = 0; particleIndex < static_cast<int>(particleMatches.size()); ++particleIndex) {
+        if (particleMatches[particleIndex]) {
+            result.particleIds.emplace_back(dataTO.particles[particleIndex].id);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "ModelBasic/EntityQuery.h"
+
+#include "Definitions.h"
+#include "AccessTOs.cuh"
+
+/**
+ * Host-side evaluation of an EntityQuery on the arrays of a transfer object. The query is compiled into bounds at
+ * construction so that the evaluation needs no optional checks per entity. Clusters and particles are evaluated as
+ * tasks of the TaskScheduler.
+ */
+class MODELGPU_EXPORT EntityQueryEvaluator
+{
+public:
+    EntityQueryEvaluator(EntityQuery const& query);
+
+    EntityQueryResult evaluate(DataAccessTO const& dataTO) const;
+
+    //removes the matching clusters (with their cells and tokens) and particles from the transfer object
+    EntityQueryResult deleteMatching(DataAccessTO const& dataTO) const;
+
+private:
+    void calcMatches(DataAccessTO const& dataTO, vector<char>& clusterMatches, vector<char>& particleMatches) const;
+    bool isMatching(DataAccessTO const& dataTO, ClusterAccessTO const& cluster) const;
+    bool isMatching(ParticleAccessTO const& particle) const;
+    bool isContainedInRect(float2 const& pos) const;
+
+    EntityQueryResult getIds(
+        DataAccessTO const& dataTO,
+        vector<char> const& clusterMatches,
+        vector<char> const& particleMatches) const;
+
+    bool _includeClusters = true;
+    bool _includeParticles = false;
+    bool _checkRect = false;
+    float2 _rectUpperLeft = {0, 0};
+    float2 _rectLowerRight = {0, 0};
+    bool _checkCells = false;
+    bool _clusterSpecific = false;
+    int _cellFunction = -1;     //-1 = any
+    float _minEnergy = 0;
+    float _maxEnergy = 0;
+    int _minNumCells = 0;
+    int _maxNumCells = 0;
+    int _hasTokens = -1;        //-1 = any
+    bool _checkName = false;
+    bool _nameRepresentable = true;     //false if the name contains characters beyond Latin-1
+    string _name;
+};
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <QImage>
+
+#include "Base/TraceRecorder.h"
+
+#include "FrameRecorder.h"
+
+namespace
+{
+    void writePng(string const& directory, FrameRecorder::Frame const& frame)
+    {
+        QImage const image(
+            reinterpret_cast<unsigned char const*>(frame.pixels.data()),
+            frame.size.x,
+            frame.size.y,
+            QImage::Format_RGB32);
+        auto const filename = QString("%1/frame_%2.png")
+                                  .arg(QString::fromStdString(directory))
+                                  .arg(frame.timestep, 9, 10, QChar('0'));
+        if (!image.save(filename, "PNG")) {
+            std::cerr << "[recording] could not write " << filename.toStdString() << std::endl;
+        }
+    }
+
+    IntVector2D calcFrameSize(RecordingParameters const& parameters, IntVector2D const& universeSize)
+    {
+        auto scale = parameters.scale;
+        auto const numPixels = static_cast<double>(universeSize.x) * universeSize.y * scale * scale;
+        if (parameters.maxFramePixels > 0 && numPixels > parameters.maxFramePixels) {
+            scale *= std::sqrt(parameters.maxFramePixels / numPixels);
+        }
+        return {std::max(1, static_cast<int>(universeSize.x * scale)),
+                std::max(1, static_cast<int>(universeSize.y * scale))};
+    }
+}
+
+FrameRecorder::FrameRecorder(
+    RecordingParameters const& parameters,
+    IntVector2D const& universeSize,
+    Encoder const& encoder)
+    : _parameters(parameters)
+    , _frameSize(calcFrameSize(parameters, universeSize))
+    , _queueCapacity(std::max(1, parameters.queueCapacity))
+    , _encoder(encoder)
+{
+    if (!_encoder) {
+        auto const directory = parameters.directory;
+        _encoder = [directory](Frame const& frame) { writePng(directory, frame); };
+    }
+
+    auto const numThreads = parameters.numEncodingThreads > 0
+        ? parameters.numEncodingThreads
+        : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int index = 0; index < numThreads; ++index) {
+        _threads.emplace_back([this] { encodeFrames(); });
+    }
+}
+
+FrameRecorder::~FrameRecorder()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+    }
+    _condition.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+bool FrameRecorder::isFrameDue(int timestep) const
+{
+    return _parameters.timesteps <= 1 || timestep % _parameters.timesteps == 0;
+}
+
+auto FrameRecorder::acquireFrame(int timestep) -> Frame*
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    //frames are only allocated when the encoders fall behind
+    if (_freeFrames.empty()) {
+        if (_frames.size() == _queueCapacity) {
+            ++_statistics.numDroppedFrames;
+            return nullptr;
+        }
+        _frames.emplace_back(std::make_unique<Frame>());
+        _freeFrames.emplace_back(_frames.back().get());
+    }
+    auto const result = _freeFrames.back();
+    _freeFrames.pop_back();
+
+    result->timestep = timestep;
+    result->size = _frameSize;
+    auto const numPendingFrames = _frames.size() - _freeFrames.size();
+    if (_queueCapacity - numPendingFrames < _queueCapacity / 2) {
+        result->size = {std::max(1, _frameSize.x / 2), std::max(1, _frameSize.y / 2)};
+        ++_statistics.numDownsampledFrames;
+    }
+    result->pixels.resize(result->size.x * result->size.y);
+    return result;
+}
+
+void FrameRecorder::submitFrame(Frame* frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _submittedFrames.emplace_back(frame);
+    }
+    _condition.notify_one();
+}
+
+auto FrameRecorder::getStatistics() const -> Statistics
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _statistics;
+}
+
+void FrameRecorder::encodeFrames()
+{
+    TRACE_THREAD_NAME("FrameEncoder");
+    while (true) {
+        Frame* frame;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return !_submittedFrames.empty() || _terminate; });
+            if (_submittedFrames.empty()) {
+                return;
+            }
+            frame = _submittedFrames.front();
+            _submittedFrames.pop_front();
+        }
+        {
+            TRACE_SCOPE("encodeFrame");
+            _encoder(*frame);
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_statistics.numEncodedFrames;
+        _freeFrames.emplace_back(frame);
+    }
+}
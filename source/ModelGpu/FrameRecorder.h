@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "ModelBasic/RecordingParameters.h"
+
+#include "Definitions.h"
+
+/**
+ * Bounded pipeline from the simulation thread to a pool of encoding threads. The simulation thread acquires one of
+ * at most queueCapacity frames, renders into it and hands it over without ever waiting for the encoders. As soon as
+ * half of the frames are pending, further frames are taken at half resolution; if all frames are pending, they are
+ * dropped.
+ */
+class MODELGPU_EXPORT FrameRecorder
+{
+public:
+    struct Frame
+    {
+        int timestep = 0;
+        IntVector2D size;
+        vector<unsigned int> pixels;    //in the format of QImage::Format_RGB32
+    };
+    using Encoder = std::function<void(Frame const&)>;
+
+    struct Statistics
+    {
+        int numEncodedFrames = 0;
+        int numDownsampledFrames = 0;
+        int numDroppedFrames = 0;
+    };
+
+    //frames are written as png sequence into the directory of the parameters if no encoder is given
+    FrameRecorder(
+        RecordingParameters const& parameters,
+        IntVector2D const& universeSize,
+        Encoder const& encoder = Encoder());
+    ~FrameRecorder();   //pending frames are encoded before returning
+
+    bool isFrameDue(int timestep) const;
+    Frame* acquireFrame(int timestep);    //nullptr if the frame has to be dropped
+    void submitFrame(Frame* frame);
+
+    Statistics getStatistics() const;
+
+private:
+    void encodeFrames();
+
+    RecordingParameters _parameters;
+    IntVector2D _frameSize;         //capped to maxFramePixels
+    size_t _queueCapacity;
+    Encoder _encoder;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    vector<std::unique_ptr<Frame>> _frames;     //allocated on demand up to the queue capacity
+    vector<Frame*> _freeFrames;
+    std::deque<Frame*> _submittedFrames;
+    Statistics _statistics;
+    bool _terminate = false;
+    vector<std::thread> _threads;
+};
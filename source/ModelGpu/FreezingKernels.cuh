@@ -48,6 +48,16 @@ __global__ void unfreezeAllClusters(SimulationData data)
 
 }
 
+__global__ void markWokenColdBlocks(SimulationData data)
+{
+    PartitionData clusterBlock = calcPartition(data.entities.clusterPointers.getNumEntries(), blockIdx.x, gridDim.x);
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        if (auto const& cluster = data.entities.clusterPointers.at(clusterIndex)) {
+            data.coldBlockMap.markWokenBlocks_block(cluster, data.cellMap);
+        }
+    }
+}
+
 /************************************************************************/
 /* Main      															*/
 /************************************************************************/
@@ -57,3 +67,8 @@ __global__ void unfreeze(SimulationData data)
     KERNEL_CALL(unfreezeAllClusters, data);
 }
 
+__global__ void findWokenColdBlocks(SimulationData data)
+{
+    KERNEL_CALL(markWokenColdBlocks, data);
+}
+
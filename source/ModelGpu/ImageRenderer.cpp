@@ -0,0 +1,150 @@
+#include <algorithm>
+
+#include "RenderingFunctions.cuh"
+#include "ImageRenderer.h"
+
+ImageRenderer::ImageRenderer(ExecutionParameters const& parameters)
+    : _parameters(parameters)
+{
+}
+
+vector<unsigned int>
+ImageRenderer::render(DataAccessTO const& dataTO, IntRect const& rect, IntVector2D const& imageSize_) const
+{
+    int2 const rectUpperLeft{rect.p1.x, rect.p1.y};
+    int2 const rectLowerRight{rect.p2.x, rect.p2.y};
+    int2 const imageSize{imageSize_.x, imageSize_.y};
+    auto const imageScale = calcImageScale(rectUpperLeft, rectLowerRight, imageSize);
+    auto const aggregation = _parameters.imageAggregation;
+
+    auto const clearValue = ExecutionParameters::ImageAggregation::Color == aggregation ? ImageBackgroundColor : 0;
+    vector<unsigned int> result(imageSize.x * imageSize.y, clearValue);
+
+    auto const drawAt = [&](float2 const& pos, unsigned int color, float energy) {
+        int2 const intPos{static_cast<int>(pos.x), static_cast<int>(pos.y)};
+        auto const imagePos = mapUniversePosToImagePos(rectUpperLeft, imageScale, intPos);
+        if (isContainedInImage(imageSize, imagePos)) {
+            drawEntity(result, imageSize, imagePos, color, energy);
+        }
+    };
+
+    for (int index = 0; index < *dataTO.numCells; ++index) {
+        auto const& cellTO = dataTO.cells[index];
+        drawAt(cellTO.pos, calcCellColor(cellTO.metadata.color, cellTO.energy), cellTO.energy);
+    }
+    if (ExecutionParameters::ImageAggregation::Color == aggregation) {
+        for (int index = 0; index < *dataTO.numTokens; ++index) {
+            auto const& cellTO = dataTO.cells[dataTO.tokens[index].cellIndex];
+            drawAt(cellTO.pos, calcTokenColor(), 0);
+        }
+    }
+    for (int index = 0; index < *dataTO.numParticles; ++index) {
+        auto const& particleTO = dataTO.particles[index];
+        drawAt(particleTO.pos, calcParticleColor(particleTO.energy), particleTO.energy);
+    }
+
+    if (ExecutionParameters::ImageAggregation::Color != aggregation) {
+        for (auto& pixel : result) {
+            pixel = calcAggregatedColor(pixel, imageScale, aggregation);
+        }
+    }
+    if (_parameters.imageGlow) {
+        return blurImage(result, imageSize);
+    }
+    return result;
+}
+
+void ImageRenderer::renderOver(
+    DataAccessTO const& dataTO,
+    IntRect const& rect,
+    IntVector2D const& imageSize,
+    unsigned int* imageData) const
+{
+    int2 const rectUpperLeft{rect.p1.x, rect.p1.y};
+    int2 const rectLowerRight{rect.p2.x, rect.p2.y};
+    auto const imageScale = calcImageScale(rectUpperLeft, rectLowerRight, {imageSize.x, imageSize.y});
+    auto const aggregation = _parameters.imageAggregation;
+    auto const background = ExecutionParameters::ImageAggregation::Color == aggregation
+        ? ImageBackgroundColor
+        : calcAggregatedColor(0, imageScale, aggregation);
+
+    //channel-wise saturated addition of the difference to the background
+    auto const overlay = render(dataTO, rect, imageSize);
+    for (int index = 0; index < imageSize.x * imageSize.y; ++index) {
+        auto& pixel = imageData[index];
+        for (int shift : {0, 8, 16}) {
+            auto const value = static_cast<int>((overlay[index] >> shift) & 0xff);
+            auto const backgroundValue = static_cast<int>((background >> shift) & 0xff);
+            auto const pixelValue = static_cast<int>((pixel >> shift) & 0xff);
+            auto const sum = std::min(255, pixelValue + std::max(0, value - backgroundValue));
+            pixel = (pixel & ~(0xffu << shift)) | (static_cast<unsigned int>(sum) << shift);
+        }
+    }
+}
+
+void ImageRenderer::drawEntity(
+    vector<unsigned int>& imageData,
+    int2 const& imageSize,
+    int2 const& imagePos,
+    unsigned int color,
+    float energy) const
+{
+    auto const index = imagePos.x + imagePos.y * imageSize.x;
+    auto const aggregation = _parameters.imageAggregation;
+    if (ExecutionParameters::ImageAggregation::Density == aggregation) {
+        ++imageData[index];
+        return;
+    }
+    if (ExecutionParameters::ImageAggregation::Energy == aggregation) {
+        imageData[index] += static_cast<unsigned int>(energy);
+        return;
+    }
+
+    color = (color >> 1) & 0x7e7e7e;
+    addingColor(imageData[index], color);
+
+    color = (color >> 1) & 0x7e7e7e;
+    addingColor(imageData[index - 1], color);
+    addingColor(imageData[index + 1], color);
+    addingColor(imageData[index - imageSize.x], color);
+    addingColor(imageData[index + imageSize.x], color);
+}
+
+vector<unsigned int> ImageRenderer::blurImage(vector<unsigned int> const& imageData, int2 const& imageSize) const
+{
+    int imageBlurFactors[7];
+    calcImageBlurFactors(imageBlurFactors);
+
+    vector<unsigned int> result(imageData.size());
+    for (int y = 0; y < imageSize.y; ++y) {
+        for (int x = 0; x < imageSize.x; ++x) {
+            int red = 0;
+            int green = 0;
+            int blue = 0;
+            for (int relY = -ImageBlurRadius; relY <= ImageBlurRadius; ++relY) {
+                for (int relX = -ImageBlurRadius; relX <= ImageBlurRadius; ++relX) {
+                    auto const scanX = x - relX;
+                    auto const scanY = y - relY;
+                    if (scanX < 0 || scanY < 0 || scanX >= imageSize.x || scanY >= imageSize.y) {
+                        continue;
+                    }
+                    auto const r = sqrtf(static_cast<float>(relX * relX + relY * relY));
+                    if (r > ImageBlurRadius + 0.00001f) {
+                        continue;
+                    }
+                    auto const pixel = imageData[scanX + scanY * imageSize.x];
+                    auto const factor = imageBlurFactors[static_cast<int>(floorf(r))];
+                    red += ((pixel >> 16) & 0xff) * factor;
+                    green += ((pixel >> 8) & 0xff) * factor;
+                    blue += (pixel & 0xff) * factor;
+                }
+            }
+            auto const sum = imageBlurFactors[6];
+            red = std::min(255, red / sum);
+            green = std::min(255, green / sum);
+            blue = std::min(255, blue / sum);
+            result[x + y * imageSize.x] = 0xff000000 | (red << 16) | (green << 8) | blue;
+        }
+    }
+    return result;
+}
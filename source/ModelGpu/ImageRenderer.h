@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ModelBasic/ExecutionParameters.h"
+
+#include "Definitions.h"
+#include "AccessTOs.cuh"
+
+/**
+ * Host reference of the rendering kernels. A rect of the universe is rendered from a transfer object into an image of
+ * arbitrary size with the same color, aggregation and glow functions as on the device. The positions in the transfer
+ * object are expected to be already mapped into the universe.
+ */
+class MODELGPU_EXPORT ImageRenderer
+{
+public:
+    ImageRenderer(ExecutionParameters const& parameters);
+
+    //returns the pixels in the format of QImage::Format_RGB32
+    vector<unsigned int>
+    render(DataAccessTO const& dataTO, IntRect const& rect, IntVector2D const& imageSize) const;
+
+    //adds the rendering of dataTO without its background to an image of the same rect, e.g. rendered by the device;
+    //for the color aggregation without glow the result equals the joint rendering apart from rounding where entities
+    //overlap, the other modes are approximated
+    void renderOver(
+        DataAccessTO const& dataTO,
+        IntRect const& rect,
+        IntVector2D const& imageSize,
+        unsigned int* imageData) const;
+
+private:
+    void drawEntity(
+        vector<unsigned int>& imageData,
+        int2 const& imageSize,
+        int2 const& imagePos,
+        unsigned int color,
+        float energy) const;
+    vector<unsigned int> blurImage(vector<unsigned int> const& imageData, int2 const& imageSize) const;
+
+    ExecutionParameters _parameters;
+};
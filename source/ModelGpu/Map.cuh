@@ -1,8 +1,13 @@
 #pragma once
 
+#include <iostream>
+#include <numeric>
+
 #include "Cluster.cuh"
 #include "Particle.cuh"
 #include "device_functions.h"
+#include "OccupancyPyramid.h"
+#include "TiledMap.h"
 
 class MapInfo
 {
@@ -63,36 +68,124 @@ template <typename T>
 class BasicMap : public MapInfo
 {
 public:
-    __host__ __inline__ void init(int2 const& size, int maxEntries)
+    //maxTiles = 0 reserves as many tiles as maxEntries can populate, allocator = nullptr uses the allocator of the
+    //CudaMemoryManager
+    __host__ __inline__ void init(int2 const& size, int maxEntries, int maxTiles, MemoryAllocator* allocator = nullptr)
     {
         MapInfo::init(size);
-        CudaMemoryManager::getInstance().acquireMemory<T>(size.x * size.y, _map);
-        _mapEntries.init(maxEntries);
 
-        std::vector<T> hostMap(size.x * size.y, 0);
-        checkCudaErrors(cudaMemcpy(_map, hostMap.data(), sizeof(T) * size.x * size.y, cudaMemcpyHostToDevice));
+        _allocator = allocator ? allocator : &CudaMemoryManager::getInstance().getAllocator();
+        auto const numDirectoryEntries = TiledMap<T>::getNumDirectoryEntries(size.x, size.y);
+        auto const numRequiredPoolTiles = TiledMap<T>::getNumRequiredPoolTiles(size.x, size.y, maxEntries);
+        auto const numPoolTiles =
+            TiledMap<T>::getNumPoolTiles(size.x, size.y, maxTiles > 0 ? maxTiles : numRequiredPoolTiles);
+        if (numPoolTiles < numRequiredPoolTiles) {
+            std::cerr << "[CUDA] " << numPoolTiles << " map tiles may not suffice for " << maxEntries
+                      << " entries, increase MAX_MAPTILES to " << numRequiredPoolTiles << std::endl;
+        }
+        _allocator->acquireMemory<int>(MemorySubsystem::Maps, numDirectoryEntries, _tileDirectory);
+        _allocator->acquireMemory<T>(
+            MemorySubsystem::Maps, static_cast<uint64_t>(numPoolTiles) * TiledMap<T>::NumEntriesPerTile, _tilePool);
+        _allocator->acquireMemory<int>(MemorySubsystem::Maps, numPoolTiles, _tileEntryCounts);
+        _allocator->acquireMemory<int>(MemorySubsystem::Maps, numPoolTiles, _freeTiles);
+        _allocator->acquireMemory<int>(MemorySubsystem::Maps, numPoolTiles, _spareTiles);
+        _allocator->acquireMemory<int>(MemorySubsystem::Maps, 3, _tileCounters);
+
+        _allocator->set(_tileDirectory, 0xff, sizeof(int) * numDirectoryEntries);
+        _allocator->set(_tilePool, 0, sizeof(T) * numPoolTiles * TiledMap<T>::NumEntriesPerTile);
+        _allocator->set(_tileEntryCounts, 0, sizeof(int) * numPoolTiles);
+        std::vector<int> freeTiles(numPoolTiles);
+        std::iota(freeTiles.begin(), freeTiles.end(), 0);
+        _allocator->copy(_freeTiles, freeTiles.data(), sizeof(int) * numPoolTiles);
+        int const counters[] = {numPoolTiles, 0, 0};
+        _allocator->copy(_tileCounters, counters, sizeof(counters));
+
+        _tiles.init(size.x, _tileDirectory, _tilePool, _tileEntryCounts, _freeTiles, _spareTiles, _tileCounters);
+        _mapEntries.init(maxEntries, MemorySubsystem::Maps, _allocator);
     }
 
     __device__ __inline__ void reset() { _mapEntries.reset(); }
 
+    //number of entities which could not be stored in the map since the tile pool was exhausted
+    __host__ __inline__ int retrieveNumLostEntries() const
+    {
+        int result;
+        _allocator->copy(&result, &_tileCounters[2], sizeof(int));
+        return result;
+    }
+
     __host__ __inline__ void free()
     {
-        CudaMemoryManager::getInstance().freeMemory(_map);
+        _allocator->freeMemory(_tileDirectory);
+        _allocator->freeMemory(_tilePool);
+        _allocator->freeMemory(_tileEntryCounts);
+        _allocator->freeMemory(_freeTiles);
+        _allocator->freeMemory(_spareTiles);
+        _allocator->freeMemory(_tileCounters);
         _mapEntries.free();
     }
 
 protected:
-    T* _map;
+    //map entries of positions whose tile could not be allocated are stored as -1
+    __device__ __inline__ T* getOrCreateEntry(int2 const& posInt) { return _tiles.getOrCreateEntry(posInt.x, posInt.y); }
+
+    __device__ __inline__ T getEntry(int2 const& posInt) const { return _tiles.get(posInt.x, posInt.y); }
+
+    __device__ __inline__ void cleanupEntries_system()
+    {
+        if (0 == threadIdx.x + blockIdx.x) {
+            _tiles.reclaimSpareTiles();
+        }
+        auto partition =
+            calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& mapEntry = _mapEntries.at(index);
+            if (mapEntry >= 0) {
+                _tiles.clear(mapEntry % _size.x, mapEntry / _size.x);
+            }
+        }
+    }
+
+    TiledMap<T> _tiles;
     Array<int> _mapEntries;
+    MemoryAllocator* _allocator;
+
+private:
+    int* _tileDirectory;
+    T* _tilePool;
+    int* _tileEntryCounts;
+    int* _freeTiles;
+    int* _spareTiles;
+    int* _tileCounters;
 };
 
 class CellMap : public BasicMap<unsigned long long int>
 {
 public:
-    __host__ __inline__ void init(int2 const& size, int maxEntries, Cell** cellPointerArray)
+    __host__ __inline__ void init(
+        int2 const& size,
+        int maxEntries,
+        int maxTiles,
+        Cell** cellPointerArray,
+        MemoryAllocator* allocator = nullptr)
     {
         _cellPointersArray = cellPointerArray;
-        BasicMap<unsigned long long int>::init(size, maxEntries);
+        BasicMap<unsigned long long int>::init(size, maxEntries, maxTiles, allocator);
+
+        auto const numTileWords = OccupancyPyramid::getNumTileWords(size.x, size.y);
+        auto const numBlockWords = OccupancyPyramid::getNumBlockWords(size.x, size.y);
+        _allocator->acquireMemory<unsigned long long>(MemorySubsystem::Maps, numTileWords, _occupancyTileWords);
+        _allocator->acquireMemory<unsigned long long>(MemorySubsystem::Maps, numBlockWords, _occupancyBlockWords);
+        _allocator->set(_occupancyTileWords, 0, sizeof(unsigned long long) * numTileWords);
+        _allocator->set(_occupancyBlockWords, 0, sizeof(unsigned long long) * numBlockWords);
+        _occupancy.init(size.x, size.y, _occupancyTileWords, _occupancyBlockWords);
+    }
+
+    __host__ __inline__ void free()
+    {
+        _allocator->freeMemory(_occupancyTileWords);
+        _allocator->freeMemory(_occupancyBlockWords);
+        BasicMap<unsigned long long int>::free();
     }
 
     __device__ __inline__ void set_block(int numEntities, Cell** cellsToSet)
@@ -114,12 +207,17 @@ public:
             auto const& entity = cellsToSet[index];
             int2 posInt = {floorInt(entity->absPos.x), floorInt(entity->absPos.y)};
             mapPosCorrection(posInt);
-            auto mapEntry = posInt.x + posInt.y * _size.x;
-        
+            auto const entry = getOrCreateEntry(posInt);
+            if (!entry) {
+                entrySubarray[index] = -1;
+                continue;
+            }
+
             unsigned long long int value =  &entity - _cellPointersArray;
             value |= numEntriesBits;
-            atomicMax(_map + mapEntry, value);
-            entrySubarray[index] = mapEntry;
+            atomicMax(entry, value);
+            _occupancy.set(posInt.x, posInt.y);
+            entrySubarray[index] = posInt.x + posInt.y * _size.x;
         }
         __syncthreads();
     }
@@ -128,8 +226,7 @@ public:
     {
         int2 posInt = { floorInt(pos.x), floorInt(pos.y) };
         mapPosCorrection(posInt);
-        auto mapEntry = posInt.x + posInt.y * _size.x;
-        auto cellIndex = _map[mapEntry];
+        auto cellIndex = getEntry(posInt);
         if (0 == cellIndex) {
             return nullptr;
         }
@@ -138,16 +235,26 @@ public:
 
     __device__ __inline__ void cleanup_system()
     {
+        cleanupEntries_system();
+
         auto partition =
             calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
             auto const& mapEntry = _mapEntries.at(index);
-            _map[mapEntry] = 0;
+            if (mapEntry >= 0) {
+                _occupancy.clear(mapEntry % _size.x, mapEntry / _size.x);
+            }
         }
     }
 
+    //allows searches to skip empty regions without reading the map itself
+    __device__ __inline__ OccupancyPyramid const& getOccupancy() const { return _occupancy; }
+
 private:
     Cell** _cellPointersArray;
+    OccupancyPyramid _occupancy;
+    unsigned long long* _occupancyTileWords;
+    unsigned long long* _occupancyBlockWords;
 
 };
 
@@ -171,9 +278,13 @@ public:
             auto const& entity = entities[index];
             int2 posInt = {floorInt(entity->absPos.x), floorInt(entity->absPos.y)};
             mapPosCorrection(posInt);
-            auto mapEntry = posInt.x + posInt.y * _size.x;
-            _map[mapEntry] = entity;
-            entrySubarray[index] = mapEntry;
+            auto const entry = getOrCreateEntry(posInt);
+            if (!entry) {
+                entrySubarray[index] = -1;
+                continue;
+            }
+            *entry = entity;
+            entrySubarray[index] = posInt.x + posInt.y * _size.x;
         }
         __syncthreads();
     }
@@ -182,17 +293,8 @@ public:
     {
         int2 posInt = { floorInt(pos.x), floorInt(pos.y) };
         mapPosCorrection(posInt);
-        auto mapEntry = posInt.x + posInt.y * _size.x;
-        return _map[mapEntry];
+        return getEntry(posInt);
     }
 
-    __device__ __inline__ void cleanup_system()
-    {
-        auto partition =
-            calcPartition(_mapEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
-        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-            auto const& mapEntry = _mapEntries.at(index);
-            _map[mapEntry] = nullptr;
-        }
-    }
+    __device__ __inline__ void cleanup_system() { cleanupEntries_system(); }
 };
@@ -4,106 +4,157 @@
 
 #include "Base.cuh"
 #include "Array.cuh"
-#include "List.cuh"
+#include "SpatialBinning.h"
 
 #include "Cluster.cuh"
 
+/**
+ * Bins clusters by map sections via counting sort (see SpatialBinningLayout).
+ * Usage per timestep: reset_system, insert, calcSectionOffsets_block (single block), scatter_system, queries.
+ */
 class MapSectionCollector
 {
 public:
-    __host__ __inline__ void
-    init(int2 const& universeSize, int sectionSize)
+    __host__ __inline__ void init(int2 const& universeSize, int sectionSize, int maxEntries)
     {
-        _numSections = { universeSize.x / sectionSize, universeSize.y / sectionSize };
-        _sectionSize = sectionSize;
-        _clusterListBySectionIndex.init(_numSections.x *_numSections.y);
+        _layout.init(universeSize.x, universeSize.y, sectionSize);
+        _insertedEntries.init(maxEntries, MemorySubsystem::Maps);
+        _sortedClusters.init(maxEntries, MemorySubsystem::Maps);
+        _sectionOffsets.init(_layout.getNumSections() + 1, MemorySubsystem::Maps);
+        _sectionCursors.init(_layout.getNumSections(), MemorySubsystem::Maps);
     }
 
     __host__ __inline__ void free()
     {
-        _clusterListBySectionIndex.free();
+        _insertedEntries.free();
+        _sortedClusters.free();
+        _sectionOffsets.free();
+        _sectionCursors.free();
     }
 
     __device__ __inline__ void reset_system()
     {
         auto const partition = calcPartition(
-            _numSections.x * _numSections.y, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+            _layout.getNumSections(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-            _clusterListBySectionIndex.at(index).init();
+            _sectionCursors.at(index) = 0;
         }
+        if (0 == threadIdx.x + blockIdx.x) {
+            _insertedEntries.reset();
+        }
+    }
+
+    __device__ __inline__ void insert(Cluster* cluster)
+    {
+        auto const entry = _insertedEntries.getNewElement();
+        if (!entry) {
+            return;
+        }
+        entry->cluster = cluster;
+        entry->sectionIndex = _layout.getSectionIndex(cluster->pos.x, cluster->pos.y);
+        atomicAdd(&_sectionCursors.at(entry->sectionIndex), 1);
     }
 
-    __device__ __inline__ void insert(Cluster* cluster, DynamicMemory* dynamicMemory)
+    //exclusive prefix sum over the section counts, the counts are replaced by the write cursors
+    __device__ __inline__ void calcSectionOffsets_block()
     {
-        auto const section = getSection(cluster->pos);
+        auto const numSections = _layout.getNumSections();
+        auto const partition = calcPartition(numSections, threadIdx.x, blockDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            _sectionOffsets.at(index) = _sectionCursors.at(index);
+        }
+        __syncthreads();
 
-        auto& clusterList = _clusterListBySectionIndex.at(section.x + section.y * _numSections.x);
-        clusterList.pushBack(cluster, dynamicMemory);
+        calcExclusivePrefixSum_block(_sectionOffsets.getArrayForDevice(), numSections);
+
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            _sectionCursors.at(index) = _sectionOffsets.at(index);
+        }
+        __syncthreads();
+    }
+
+    __device__ __inline__ void scatter_system()
+    {
+        auto const partition = calcPartition(
+            _insertedEntries.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& entry = _insertedEntries.at(index);
+            auto const sortedIndex = atomicAdd(&_sectionCursors.at(entry.sectionIndex), 1);
+            _sortedClusters.at(sortedIndex) = entry.cluster;
+        }
     }
 
-    __device__ __inline__ void getClusters_block(float2 const& pos, float radius, MapInfo const& map, 
-        DynamicMemory* dynamicMemory, List<Cluster*>& result)
+    //clusters in the radius around pos are written to an array from dynamic memory
+    __device__ __inline__ void getClusters_block(
+        float2 const& pos,
+        float radius,
+        MapInfo const& map,
+        DynamicMemory* dynamicMemory,
+        Cluster**& result,
+        int& numResults)
     {
-        __shared__ int2 sectionCenter;
-        __shared__ int sectionLength;
+        __shared__ int startSectionX, startSectionY, endSectionX, endSectionY;
+        __shared__ int numCandidates;
         if (0 == threadIdx.x) {
-            sectionCenter = getSection(pos);
-            sectionLength = floorInt(radius) / _sectionSize + 1;
-            result.init();
+            _layout.getSectionRange(
+                pos.x, pos.y, radius, startSectionX, startSectionY, endSectionX, endSectionY);
+            numCandidates = 0;
+            numResults = 0;
         }
         __syncthreads();
 
-        int2 section;
-        for (section.x = sectionCenter.x - sectionLength; section.x <= sectionCenter.x + sectionLength; ++section.x) {
-            for (section.y = sectionCenter.y - sectionLength; section.y <= sectionCenter.y + sectionLength; ++section.y) {
-                __shared__ int numClusters;
-                __shared__ Cluster** clusterArray;
-                if (0 == threadIdx.x) {
-                    auto const& clusterList = getClusters(section);
-                    numClusters = clusterList.getSize();
-                    clusterArray = clusterList.asArray(dynamicMemory);
-                }
-                __syncthreads();
-
-                if (numClusters > 0) {
-                    auto const partition = calcPartition(numClusters, threadIdx.x, blockDim.x);
-                    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-                        auto const& cluster = clusterArray[index];
-                        auto const distance = map.mapDistance(cluster->pos, pos);
-                        if (distance < radius) {
-                            result.pushBack(cluster, dynamicMemory);
-                        }
-                    }
+        auto const numSectionsX = endSectionX - startSectionX + 1;
+        auto const numSections = numSectionsX * (endSectionY - startSectionY + 1);
+        auto const sectionPartition = calcPartition(numSections, threadIdx.x, blockDim.x);
+        for (int index = sectionPartition.startIndex; index <= sectionPartition.endIndex; ++index) {
+            auto const sectionIndex = getSectionIndex(index, numSectionsX, startSectionX, startSectionY);
+            atomicAdd_block(&numCandidates, getNumClusters(sectionIndex));
+        }
+        __syncthreads();
+
+        if (0 == threadIdx.x) {
+            result = numCandidates > 0 ? dynamicMemory->getArray<Cluster*>(numCandidates) : nullptr;
+        }
+        __syncthreads();
+
+        if (!result) {
+            return;
+        }
+        for (int index = sectionPartition.startIndex; index <= sectionPartition.endIndex; ++index) {
+            auto const sectionIndex = getSectionIndex(index, numSectionsX, startSectionX, startSectionY);
+            auto const startIndex = _sectionOffsets.at(sectionIndex);
+            auto const endIndex = _sectionOffsets.at(sectionIndex + 1);
+            for (int clusterIndex = startIndex; clusterIndex < endIndex; ++clusterIndex) {
+                auto const& cluster = _sortedClusters.at(clusterIndex);
+                if (map.mapDistance(cluster->pos, pos) < radius) {
+                    result[atomicAdd_block(&numResults, 1)] = cluster;
                 }
-                __syncthreads();
             }
         }
+        __syncthreads();
     }
 
 private:
-    __device__ __inline__ int2 getSection(float2 const& pos)
+    __device__ __inline__ int getNumClusters(int sectionIndex)
     {
-        auto const intPos = toInt2(pos);
-        auto section = int2{ intPos.x / _sectionSize, intPos.y / _sectionSize };
-        correctSection(section);
-        return section;
-
+        return _sectionOffsets.at(sectionIndex + 1) - _sectionOffsets.at(sectionIndex);
     }
 
-    __device__ __inline__ List<Cluster*> const& getClusters(int2 section)
+    __device__ __inline__ int
+    getSectionIndex(int index, int numSectionsX, int startSectionX, int startSectionY) const
     {
-        correctSection(section);
-        return _clusterListBySectionIndex.at(section.x + section.y * _numSections.x);
+        return _layout.getSectionIndex(startSectionX + index % numSectionsX, startSectionY + index / numSectionsX);
     }
 
-    __device__ __inline__ void correctSection(int2& section)
+    struct Entry
     {
-        section.x = ((section.x % _numSections.x) + _numSections.x) % _numSections.x;
-        section.y = ((section.y % _numSections.y) + _numSections.y) % _numSections.y;
-    }
-
-private:
-    int2 _numSections;
-    int _sectionSize;
-    Array<List<Cluster*>> _clusterListBySectionIndex;
+        Cluster* cluster;
+        int sectionIndex;
+    };
+
+    SpatialBinningLayout _layout;
+    Array<Entry> _insertedEntries;
+    Array<Cluster*> _sortedClusters;
+    Array<int> _sectionOffsets;
+    Array<int> _sectionCursors;
 };
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "MemoryAllocator.h"
+
+void* MemoryAllocator::acquireBytes(MemorySubsystem::Type subsystem, uint64_t size)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto const result = allocate(size);
+    _allocationByMemory.insert_or_assign(result, Allocation{subsystem, size});
+    for (auto usage : {&_usageBySubsystem[subsystem], &_totalUsage}) {
+        usage->bytes += size;
+        usage->highWaterMark = std::max(usage->highWaterMark, usage->bytes);
+        ++usage->numAllocations;
+    }
+    return result;
+}
+
+void MemoryAllocator::releaseBytes(void* memory)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto const allocationIter = _allocationByMemory.find(memory);
+    if (allocationIter == _allocationByMemory.end()) {
+        return;
+    }
+    auto const& allocation = allocationIter->second;
+    for (auto usage : {&_usageBySubsystem[allocation.subsystem], &_totalUsage}) {
+        usage->bytes -= allocation.size;
+        --usage->numAllocations;
+    }
+    _allocationByMemory.erase(allocationIter);
+    deallocate(memory);
+}
+
+MemoryUsage MemoryAllocator::getUsage(MemorySubsystem::Type subsystem) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _usageBySubsystem[subsystem];
+}
+
+MemoryUsage MemoryAllocator::getTotalUsage() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _totalUsage;
+}
+
+void MemoryAllocator::resetHighWaterMarks()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& usage : _usageBySubsystem) {
+        usage.highWaterMark = usage.bytes;
+    }
+    _totalUsage.highWaterMark = _totalUsage.bytes;
+}
+
+HostArenaAllocator::HostArenaAllocator(uint64_t capacity)
+    : _capacity(capacity)
+{
+    _arena = static_cast<unsigned char*>(std::malloc(capacity));
+    if (!_arena) {
+        throw std::bad_alloc();
+    }
+}
+
+HostArenaAllocator::~HostArenaAllocator()
+{
+    std::free(_arena);
+}
+
+void HostArenaAllocator::copy(void* target, void const* source, uint64_t size)
+{
+    std::memcpy(target, source, size);
+}
+
+void HostArenaAllocator::set(void* target, int value, uint64_t size)
+{
+    std::memset(target, value, size);
+}
+
+uint64_t HostArenaAllocator::getCapacity() const
+{
+    return _capacity;
+}
+
+uint64_t HostArenaAllocator::getOccupiedBytes() const
+{
+    return _occupiedBytes;
+}
+
+void* HostArenaAllocator::allocate(uint64_t size)
+{
+    auto const alignedSize = (size + Alignment - 1) / Alignment * Alignment;
+    if (_occupiedBytes + alignedSize > _capacity) {
+        throw std::bad_alloc();
+    }
+    auto const result = _arena + _occupiedBytes;
+    _occupiedBytes += alignedSize;
+    ++_numAllocations;
+    return result;
+}
+
+void HostArenaAllocator::deallocate(void* memory)
+{
+    if (0 == --_numAllocations) {
+        _occupiedBytes = 0;
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <mutex>
+
+#include "Definitions.h"
+
+struct MemorySubsystem
+{
+    enum Type
+    {
+        Entities,
+        Maps,
+        DynamicMemory,
+        Images,
+        AccessTOs,
+        Other,
+        _COUNTER
+    };
+};
+
+struct MemoryUsage
+{
+    uint64_t bytes = 0;
+    uint64_t highWaterMark = 0;
+    int numAllocations = 0;
+};
+
+/**
+ * Backend for the memory of the simulation data structures.
+ * The base class keeps track of the currently acquired bytes and their high-water marks per subsystem.
+ * Host code must use copy() and set() instead of calling cudaMemcpy or cudaMemset directly, so that the data
+ * structures work with every backend.
+ */
+class MODELGPU_EXPORT MemoryAllocator
+{
+public:
+    virtual ~MemoryAllocator() = default;
+
+    template<typename T>
+    void acquireMemory(MemorySubsystem::Type subsystem, uint64_t arraySize, T*& result)
+    {
+        result = static_cast<T*>(acquireBytes(subsystem, sizeof(T) * arraySize));
+    }
+
+    template<typename T>
+    void freeMemory(T* memory)
+    {
+        releaseBytes(memory);
+    }
+
+    void* acquireBytes(MemorySubsystem::Type subsystem, uint64_t size);
+    void releaseBytes(void* memory);
+
+    virtual void copy(void* target, void const* source, uint64_t size) = 0;    //any direction between host and backend
+    virtual void set(void* target, int value, uint64_t size) = 0;
+
+    MemoryUsage getUsage(MemorySubsystem::Type subsystem) const;
+    MemoryUsage getTotalUsage() const;
+    void resetHighWaterMarks();
+
+protected:
+    virtual void* allocate(uint64_t size) = 0;
+    virtual void deallocate(void* memory) = 0;
+
+private:
+    struct Allocation
+    {
+        MemorySubsystem::Type subsystem;
+        uint64_t size;
+    };
+    mutable std::mutex _mutex;
+    unordered_map<void*, Allocation> _allocationByMemory;
+    MemoryUsage _usageBySubsystem[MemorySubsystem::_COUNTER];
+    MemoryUsage _totalUsage;
+};
+
+/**
+ * Plain host memory carved out of a preallocated block. Allows to use the data structures on machines without GPU.
+ * Single allocations are not returned to the arena, but the whole arena is rewound when all allocations are freed.
+ */
+class MODELGPU_EXPORT HostArenaAllocator : public MemoryAllocator
+{
+public:
+    HostArenaAllocator(uint64_t capacity);
+    virtual ~HostArenaAllocator();
+
+    void copy(void* target, void const* source, uint64_t size) override;
+    void set(void* target, int value, uint64_t size) override;
+
+    uint64_t getCapacity() const;
+    uint64_t getOccupiedBytes() const;
+
+protected:
+    void* allocate(uint64_t size) override;
+    void deallocate(void* memory) override;
+
+private:
+    static uint64_t const Alignment = 256;  //same as cudaMalloc
+
+    unsigned char* _arena = nullptr;
+    uint64_t _capacity = 0;
+    uint64_t _occupiedBytes = 0;
+    int _numAllocations = 0;
+};
@@ -20,6 +20,7 @@ public:
 		, uint timestepAtBeginning = 0) const = 0;
 	virtual SimulationAccessGpu* buildSimulationAccess() const = 0;
 	virtual SimulationMonitorGpu* buildSimulationMonitor() const = 0;
+	virtual SimulationEnsembleGpu* buildSimulationEnsemble() const = 0;
 
     virtual CudaConstants getDefaultCudaConstants() const = 0;
 };
@@ -6,6 +6,7 @@
 #include "SimulationContextGpuImpl.h"
 #include "SimulationAccessGpuImpl.h"
 #include "SimulationMonitorGpuImpl.h"
+#include "SimulationEnsembleGpuImpl.h"
 #include "ModelGpuBuilderFacadeImpl.h"
 #include "ModelGpuSettings.h"
 
@@ -33,6 +34,11 @@ SimulationMonitorGpu * ModelGpuBuilderFacadeImpl::buildSimulationMonitor() const
 	return new SimulationMonitorGpuImpl();
 }
 
+SimulationEnsembleGpu * ModelGpuBuilderFacadeImpl::buildSimulationEnsemble() const
+{
+	return new SimulationEnsembleGpuImpl();
+}
+
 CudaConstants ModelGpuBuilderFacadeImpl::getDefaultCudaConstants() const
 {
     return ModelGpuSettings::getDefaultCudaConstants();
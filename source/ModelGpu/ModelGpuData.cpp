@@ -15,6 +15,7 @@ namespace
     string const maxClusterPointers_key = "maxClusterPointers";
     string const maxParticlePointers_key = "maxParticlePointers";
     string const maxTokenPointers_key = "maxTokenPointers";
+    string const maxMapTiles_key = "maxMapTiles";
     string const dynamicMemorySize_key = "dynamicMemorySize";
     string const metadataDynamicMemorySize_key = "stringByteSize";
 }
@@ -37,6 +38,7 @@ ModelGpuData::ModelGpuData(CudaConstants const & value)
     _data.insert_or_assign(maxParticlePointers_key, value.MAX_PARTICLEPOINTERS);
     _data.insert_or_assign(maxTokens_key, value.MAX_TOKENS);
     _data.insert_or_assign(maxTokenPointers_key, value.MAX_TOKENPOINTERS);
+    _data.insert_or_assign(maxMapTiles_key, value.MAX_MAPTILES);
     _data.insert_or_assign(dynamicMemorySize_key, value.DYNAMIC_MEMORY_SIZE);
     _data.insert_or_assign(metadataDynamicMemorySize_key, value.METADATA_DYNAMIC_MEMORY_SIZE);
 }
@@ -54,6 +56,8 @@ CudaConstants ModelGpuData::getCudaConstants() const
     result.MAX_CLUSTERPOINTERS = _data.at(maxClusterPointers_key);
     result.MAX_PARTICLEPOINTERS = _data.at(maxParticlePointers_key);
     result.MAX_TOKENPOINTERS = _data.at(maxTokenPointers_key);
+    auto const maxMapTilesIt = _data.find(maxMapTiles_key);    //not contained in older settings
+    result.MAX_MAPTILES = maxMapTilesIt != _data.end() ? maxMapTilesIt->second : 0;
     result.DYNAMIC_MEMORY_SIZE = _data.at(dynamicMemorySize_key);
     result.METADATA_DYNAMIC_MEMORY_SIZE = _data.at(metadataDynamicMemorySize_key);
     return result;
@@ -13,6 +13,7 @@ CudaConstants ModelGpuSettings::getDefaultCudaConstants()
     result.MAX_TOKENPOINTERS = result.MAX_TOKENS * 10;
     result.MAX_PARTICLES = 1000000;
     result.MAX_PARTICLEPOINTERS = result.MAX_PARTICLES;
+    result.MAX_MAPTILES = 0;
     result.DYNAMIC_MEMORY_SIZE = 50000000;
     result.METADATA_DYNAMIC_MEMORY_SIZE = 10000000;
 
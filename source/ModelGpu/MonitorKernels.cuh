@@ -76,6 +76,54 @@ __global__ void getMonitorDataForParticles(SimulationData data, CudaMonitorData
     }
 }
 
+__global__ void getMonitorStatisticsForClusters(Array<Cluster*> clusterPointers, CudaMonitorData monitorData)
+{
+    auto const clusterPartition = calcPartition(clusterPointers.getNumEntries(), blockIdx.x, gridDim.x);
+    for (auto clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
+        auto const cluster = clusterPointers.at(clusterIndex);
+        if (nullptr == cluster) {
+            continue;
+        }
+        if (0 == threadIdx.x) {
+            monitorData.incClusterSizeHistogram(cluster->numCellPointers);
+        }
+
+        auto const cellPartition = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        for (auto cellIndex = cellPartition.startIndex; cellIndex <= cellPartition.endIndex; ++cellIndex) {
+            auto const cell = cluster->cellPointers[cellIndex];
+            monitorData.incNumCellsByFunction(cell->getCellFunctionType(), 1);
+        }
+        auto const tokenPartition = calcPartition(cluster->numTokenPointers, threadIdx.x, blockDim.x);
+        for (auto tokenIndex = tokenPartition.startIndex; tokenIndex <= tokenPartition.endIndex; ++tokenIndex) {
+            auto const token = cluster->tokenPointers[tokenIndex];
+            monitorData.incTokenEnergyHistogram(token->getEnergy());
+
+            auto const cellFunction = token->cell->getCellFunctionType();
+            if (Enums::CellFunction::CONSTRUCTOR == cellFunction) {
+                monitorData.incNumConstructorActivities(1);
+            }
+            if (Enums::CellFunction::WEAPON == cellFunction) {
+                monitorData.incNumWeaponActivities(1);
+            }
+        }
+    }
+}
+
+__global__ void getMonitorStatisticsForParticles(SimulationData data, CudaMonitorData monitorData)
+{
+    if (0 == threadIdx.x && 0 == blockIdx.x) {
+        monitorData.incNumParticlesForStatistics(data.entities.particlePointers.getNumEntries());
+    }
+
+    auto const partition = calcPartition(
+        data.entities.particlePointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+    for (auto index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const particle = data.entities.particlePointers.at(index);
+        monitorData.incParticleEnergy(particle->getEnergy());
+    }
+}
+
 /************************************************************************/
 /* Main      															*/
 /************************************************************************/
@@ -89,3 +137,11 @@ __global__ void getCudaMonitorData(SimulationData data, CudaMonitorData monitorD
     KERNEL_CALL(getMonitorDataForParticles, data, monitorData);
 }
 
+__global__ void getCudaMonitorStatistics(SimulationData data, CudaMonitorData monitorData)
+{
+    monitorData.resetStatistics();
+
+    KERNEL_CALL(getMonitorStatisticsForClusters, data.entities.clusterPointers, monitorData);
+    KERNEL_CALL(getMonitorStatisticsForClusters, data.entities.clusterFreezedPointers, monitorData);
+    KERNEL_CALL(getMonitorStatisticsForParticles, data, monitorData);
+}
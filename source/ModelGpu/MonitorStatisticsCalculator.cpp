@@ -0,0 +1,90 @@
+#include <algorithm>
+
+#include "Base/TaskScheduler.h"
+
+#include "MonitorStatisticsCalculator.h"
+
+namespace
+{
+    struct Partition
+    {
+        int startIndex;
+        int endIndex;   //exclusive
+    };
+
+    Partition calcPartition(int numEntities, int division, int numDivisions)
+    {
+        auto const entitiesByDivision = numEntities / numDivisions;
+        auto const remainder = numEntities % numDivisions;
+        auto const startIndex = division * entitiesByDivision + std::min(division, remainder);
+        auto const endIndex = startIndex + entitiesByDivision + (division < remainder ? 1 : 0);
+        return Partition{startIndex, endIndex};
+    }
+
+    int getCellFunction(CellAccessTO const& cellTO)
+    {
+        return static_cast<int>(static_cast<unsigned int>(cellTO.cellFunctionType) % Enums::CellFunction::_COUNTER);
+    }
+}
+
+MonitorStatisticsCalculator::MonitorStatisticsCalculator(int numThreads)
+    : _numThreads(numThreads > 0 ? numThreads : TaskScheduler::getInstance().getNumThreads())
+{
+}
+
+MonitorStatistics MonitorStatisticsCalculator::calcStatistics(DataAccessTO const& dataTO) const
+{
+    vector<MonitorStatistics> partialResults(_numThreads);
+    TaskScheduler::getInstance().parallelFor(
+        0,
+        _numThreads,
+        [&](int partitionIndex) { partialResults[partitionIndex] = calcStatisticsForPartition(dataTO, partitionIndex); },
+        1,
+        nullptr,
+        "MonitorStatisticsCalculator partition");
+
+    MonitorStatistics result;
+    for (auto const& partialResult : partialResults) {
+        result.add(partialResult);
+    }
+    return result;
+}
+
+MonitorStatistics MonitorStatisticsCalculator::calcStatisticsForPartition(
+    DataAccessTO const& dataTO,
+    int partitionIndex) const
+{
+    MonitorStatistics result;
+
+    auto const clusterPartition = calcPartition(*dataTO.numClusters, partitionIndex, _numThreads);
+    for (int clusterIndex = clusterPartition.startIndex; clusterIndex < clusterPartition.endIndex; ++clusterIndex) {
+        auto const& clusterTO = dataTO.clusters[clusterIndex];
+        ++result.clusterSizeHistogram[MonitorStatistics::getClusterSizeBin(clusterTO.numCells)];
+
+        for (int cellIndex = clusterTO.cellStartIndex; cellIndex < clusterTO.cellStartIndex + clusterTO.numCells;
+             ++cellIndex) {
+            ++result.numCellsByFunction[getCellFunction(dataTO.cells[cellIndex])];
+        }
+        for (int tokenIndex = clusterTO.tokenStartIndex; tokenIndex < clusterTO.tokenStartIndex + clusterTO.numTokens;
+             ++tokenIndex) {
+            auto const& tokenTO = dataTO.tokens[tokenIndex];
+            ++result.tokenEnergyHistogram[MonitorStatistics::getTokenEnergyBin(tokenTO.energy)];
+
+            auto const cellFunction = getCellFunction(dataTO.cells[tokenTO.cellIndex]);
+            if (Enums::CellFunction::CONSTRUCTOR == cellFunction) {
+                ++result.numConstructorActivities;
+            }
+            if (Enums::CellFunction::WEAPON == cellFunction) {
+                ++result.numWeaponActivities;
+            }
+        }
+    }
+
+    auto const particlePartition = calcPartition(*dataTO.numParticles, partitionIndex, _numThreads);
+    for (int particleIndex = particlePartition.startIndex; particleIndex < particlePartition.endIndex;
+         ++particleIndex) {
+        ++result.numParticles;
+        result.totalParticleEnergy += dataTO.particles[particleIndex].energy;
+    }
+    return result;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ModelBasic/MonitorStatistics.h"
+
+#include "Definitions.h"
+#include "AccessTOs.cuh"
+
+/**
+ * Host-side counterpart of the monitor kernels: reduces the transfer arrays to MonitorStatistics.
+ * The work is split into contiguous cluster and particle ranges which are processed as tasks of the
+ * TaskScheduler.
+ */
+class MODELGPU_EXPORT MonitorStatisticsCalculator
+{
+public:
+    MonitorStatisticsCalculator(int numThreads = 0);   //0 = number of threads of the TaskScheduler
+
+    MonitorStatistics calcStatistics(DataAccessTO const& dataTO) const;
+
+private:
+    MonitorStatistics calcStatisticsForPartition(DataAccessTO const& dataTO, int partitionIndex) const;
+
+    int _numThreads = 1;
+};
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifdef __CUDACC__
+#define OCCUPANCY_FUNCTION __host__ __device__ __inline__
+#else
+#define OCCUPANCY_FUNCTION inline
+#endif
+
+/**
+ * Two-level bit-packed occupancy of a toroidal map.
+ * A tile word holds the occupancy of 8x8 positions and a block word holds one bit per non-empty tile of 8x8 tiles,
+ * i.e. 64x64 positions. Queries on rectangles skip empty blocks and tiles without touching the dense map.
+ * The words are allocated by CellMap::init().
+ */
+class OccupancyPyramid
+{
+public:
+    static int const TileSize = 8;
+    static int const BlockSize = TileSize * TileSize;
+
+    OCCUPANCY_FUNCTION static int getNumTileWords(int width, int height)
+    {
+        return divUp(width, TileSize) * divUp(height, TileSize);
+    }
+
+    OCCUPANCY_FUNCTION static int getNumBlockWords(int width, int height)
+    {
+        return divUp(width, BlockSize) * divUp(height, BlockSize);
+    }
+
+    //words must be zero-initialized
+    OCCUPANCY_FUNCTION void init(int width, int height, unsigned long long* tileWords, unsigned long long* blockWords)
+    {
+        _width = width;
+        _height = height;
+        _numTilesX = divUp(width, TileSize);
+        _numBlocksX = divUp(width, BlockSize);
+        _tileWords = tileWords;
+        _blockWords = blockWords;
+    }
+
+    //position must be inside the map
+    OCCUPANCY_FUNCTION void set(int x, int y)
+    {
+        auto const tileX = x / TileSize;
+        auto const tileY = y / TileSize;
+        auto const tileBit = 1ull << ((y % TileSize) * TileSize + x % TileSize);
+        auto const blockBit = 1ull << ((tileY % TileSize) * TileSize + tileX % TileSize);
+        auto& tileWord = _tileWords[tileY * _numTilesX + tileX];
+        auto& blockWord = _blockWords[tileY / TileSize * _numBlocksX + tileX / TileSize];
+#ifdef __CUDA_ARCH__
+        if (!(tileWord & tileBit)) {
+            atomicOr(&tileWord, tileBit);
+        }
+        if (!(blockWord & blockBit)) {
+            atomicOr(&blockWord, blockBit);
+        }
+#else
+        tileWord |= tileBit;
+        blockWord |= blockBit;
+#endif
+    }
+
+    //clears the whole tile and block of the position, should only be used when all positions are cleared
+    OCCUPANCY_FUNCTION void clear(int x, int y)
+    {
+        auto const tileX = x / TileSize;
+        auto const tileY = y / TileSize;
+        _tileWords[tileY * _numTilesX + tileX] = 0;
+        _blockWords[tileY / TileSize * _numBlocksX + tileX / TileSize] = 0;
+    }
+
+    OCCUPANCY_FUNCTION bool isOccupied(int x, int y) const
+    {
+        x = wrap(x, _width);
+        y = wrap(y, _height);
+        auto const tileWord = _tileWords[y / TileSize * _numTilesX + x / TileSize];
+        return 0 != (tileWord & (1ull << ((y % TileSize) * TileSize + x % TileSize)));
+    }
+
+    //rectangle bounds are inclusive and may exceed the map
+    OCCUPANCY_FUNCTION bool isRectEmpty(int x0, int y0, int x1, int y1) const
+    {
+        return visitRect(x0, y0, x1, y1, [](int, int) { return false; });
+    }
+
+    //calls func(x, y) for each occupied position, coordinates are given in the frame of the rectangle
+    template <typename Func>
+    OCCUPANCY_FUNCTION void forEachOccupied(int x0, int y0, int x1, int y1, Func const& func) const
+    {
+        visitRect(x0, y0, x1, y1, [&](int x, int y) {
+            func(x, y);
+            return true;
+        });
+    }
+
+private:
+    OCCUPANCY_FUNCTION static int divUp(int value, int divisor) { return (value + divisor - 1) / divisor; }
+
+    OCCUPANCY_FUNCTION static int wrap(int value, int size) { return ((value % size) + size) % size; }
+
+    OCCUPANCY_FUNCTION static int countTrailingZeros(unsigned long long value)
+    {
+#if defined(__CUDA_ARCH__)
+        return __ffsll(static_cast<long long>(value)) - 1;
+#elif defined(_MSC_VER)
+        unsigned long result;
+        _BitScanForward64(&result, value);
+        return static_cast<int>(result);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
+    //bits of the positions [start, end] x [start, end] inside a tile or block
+    OCCUPANCY_FUNCTION static unsigned long long getMask(int startX, int startY, int endX, int endY)
+    {
+        auto const rowMask = (0xffull >> (TileSize - 1 - (endX - startX))) << startX;
+        unsigned long long result = 0;
+        for (int y = startY; y <= endY; ++y) {
+            result |= rowMask << (y * TileSize);
+        }
+        return result;
+    }
+
+    //visitor returns false to stop, the result is false if the visit has been stopped
+    template <typename Visitor>
+    OCCUPANCY_FUNCTION bool visitRect(int x0, int y0, int x1, int y1, Visitor const& visitor) const
+    {
+        auto const spanX = x1 - x0 < _width ? x1 - x0 : _width - 1;
+        auto const spanY = y1 - y0 < _height ? y1 - y0 : _height - 1;
+        auto const startX = wrap(x0, _width);
+        auto const startY = wrap(y0, _height);
+
+        //split rectangle at the map borders
+        int const segmentsX[2][3] = {
+            {startX, startX + spanX < _width ? startX + spanX : _width - 1, x0 - startX},
+            {0, startX + spanX - _width, x0 - startX + _width}};
+        int const segmentsY[2][3] = {
+            {startY, startY + spanY < _height ? startY + spanY : _height - 1, y0 - startY},
+            {0, startY + spanY - _height, y0 - startY + _height}};
+        auto const numSegmentsX = startX + spanX < _width ? 1 : 2;
+        auto const numSegmentsY = startY + spanY < _height ? 1 : 2;
+        for (int i = 0; i < numSegmentsY; ++i) {
+            for (int j = 0; j < numSegmentsX; ++j) {
+                auto const& segmentX = segmentsX[j];
+                auto const& segmentY = segmentsY[i];
+                if (!visitRectInsideMap(
+                        segmentX[0], segmentY[0], segmentX[1], segmentY[1], segmentX[2], segmentY[2], visitor)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename Visitor>
+    OCCUPANCY_FUNCTION bool
+    visitRectInsideMap(int x0, int y0, int x1, int y1, int offsetX, int offsetY, Visitor const& visitor) const
+    {
+        auto const tileX0 = x0 / TileSize;
+        auto const tileY0 = y0 / TileSize;
+        auto const tileX1 = x1 / TileSize;
+        auto const tileY1 = y1 / TileSize;
+        for (int blockY = tileY0 / TileSize; blockY <= tileY1 / TileSize; ++blockY) {
+            for (int blockX = tileX0 / TileSize; blockX <= tileX1 / TileSize; ++blockX) {
+                auto const firstTileX = blockX * TileSize;
+                auto const firstTileY = blockY * TileSize;
+                auto const blockMask = getMask(
+                    max(tileX0, firstTileX) - firstTileX,
+                    max(tileY0, firstTileY) - firstTileY,
+                    min(tileX1, firstTileX + TileSize - 1) - firstTileX,
+                    min(tileY1, firstTileY + TileSize - 1) - firstTileY);
+                auto blockWord = _blockWords[blockY * _numBlocksX + blockX] & blockMask;
+                while (blockWord) {
+                    auto const blockBit = countTrailingZeros(blockWord);
+                    blockWord &= blockWord - 1;
+
+                    auto const tileX = firstTileX + blockBit % TileSize;
+                    auto const tileY = firstTileY + blockBit / TileSize;
+                    auto const firstX = tileX * TileSize;
+                    auto const firstY = tileY * TileSize;
+                    auto const tileMask = getMask(
+                        max(x0, firstX) - firstX,
+                        max(y0, firstY) - firstY,
+                        min(x1, firstX + TileSize - 1) - firstX,
+                        min(y1, firstY + TileSize - 1) - firstY);
+                    auto tileWord = _tileWords[tileY * _numTilesX + tileX] & tileMask;
+                    while (tileWord) {
+                        auto const tileBit = countTrailingZeros(tileWord);
+                        tileWord &= tileWord - 1;
+                        if (!visitor(firstX + tileBit % TileSize + offsetX, firstY + tileBit / TileSize + offsetY)) {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    OCCUPANCY_FUNCTION static int min(int a, int b) { return a < b ? a : b; }
+    OCCUPANCY_FUNCTION static int max(int a, int b) { return a > b ? a : b; }
+
+    int _width = 0;
+    int _height = 0;
+    int _numTilesX = 0;
+    int _numBlocksX = 0;
+    unsigned long long* _tileWords = nullptr;
+    unsigned long long* _blockWords = nullptr;
+};
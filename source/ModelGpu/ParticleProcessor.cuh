@@ -110,7 +110,7 @@ __inline__ __device__ void ParticleProcessor::processingDataCopy_system()
             continue;
 		}
         if (auto cell = _data->cellMap.get(particle->absPos)) {
-			if (1 == cell->alive) {
+			if (1 == cell->alive && !cell->cluster->isGhost()) {
                 cell->changeEnergy_safe(particle->getEnergy_safe());
                 particle = nullptr;
 			}
@@ -0,0 +1,184 @@
+#include <algorithm>
+
+#include "Base/TaskScheduler.h"
+#include "ModelBasic/Descriptions.h"
+
+#include "DataConverter.h"
+#include "RegionDeltaBuilder.h"
+
+namespace
+{
+    struct Partition
+    {
+        int startIndex;
+        int endIndex;   //exclusive
+    };
+
+    Partition calcPartition(int numEntities, int division, int numDivisions)
+    {
+        auto const entitiesByDivision = numEntities / numDivisions;
+        auto const remainder = numEntities % numDivisions;
+        auto const startIndex = division * entitiesByDivision + std::min(division, remainder);
+        auto const endIndex = startIndex + entitiesByDivision + (division < remainder ? 1 : 0);
+        return Partition{startIndex, endIndex};
+    }
+
+    QVector2D toVector2D(float2 const& value)
+    {
+        return QVector2D(value.x, value.y);
+    }
+}
+
+RegionDeltaBuilder::RegionDeltaBuilder(int numThreads)
+    : _numThreads(numThreads > 0 ? numThreads : TaskScheduler::getInstance().getNumThreads())
+{
+}
+
+DataChangeDescription
+RegionDeltaBuilder::calcDelta(DataAccessTO const& dataTO, DataConverter const& converter, int projection)
+{
+    vector<PartialDelta> partialDeltas(_numThreads);
+    TaskScheduler::getInstance().parallelFor(
+        0,
+        _numThreads,
+        [&](int partitionIndex) {
+            partialDeltas[partitionIndex] = calcDeltaForPartition(dataTO, partitionIndex, projection);
+        },
+        1,
+        nullptr,
+        "RegionDeltaBuilder partition");
+
+    unordered_map<uint64_t, ClusterState> clusterStateById;
+    unordered_map<uint64_t, ParticleState> particleStateById;
+    for (auto& partialDelta : partialDeltas) {
+        for (auto& clusterState : partialDelta.clusterStates) {
+            clusterStateById.emplace(clusterState.first, std::move(clusterState.second));
+        }
+        for (auto const& particleState : partialDelta.particleStates) {
+            particleStateById.emplace(particleState.first, particleState.second);
+        }
+    }
+
+    DataChangeDescription result;
+    for (auto const& clusterStateAndId : _clusterStateById) {
+        if (clusterStateById.find(clusterStateAndId.first) == clusterStateById.end()) {
+            result.addDeletedCluster(
+                ClusterChangeDescription().setId(clusterStateAndId.first).setPos(clusterStateAndId.second.pos));
+        }
+    }
+    for (auto const& particleStateAndId : _particleStateById) {
+        if (particleStateById.find(particleStateAndId.first) == particleStateById.end()) {
+            result.addDeletedParticle(
+                ParticleChangeDescription().setId(particleStateAndId.first).setPos(particleStateAndId.second.pos));
+        }
+    }
+
+    //the conversion of created entities is not parallelized since the converter caches the strings
+    for (auto const& partialDelta : partialDeltas) {
+        for (auto const& clusterIndex : partialDelta.createdClusterIndices) {
+            auto const clusterDesc = converter.getClusterDescription(clusterIndex, projection);
+            auto const previousStateIt = _clusterStateById.find(clusterDesc.id);
+            if (previousStateIt != _clusterStateById.end()) {
+                result.addDeletedCluster(ClusterChangeDescription().setId(clusterDesc.id).setPos(previousStateIt->second.pos));
+            }
+            result.addNewCluster(ClusterChangeDescription(clusterDesc));
+        }
+        for (auto const& movedCluster : partialDelta.movedClusters) {
+            result.addModifiedCluster(movedCluster);
+        }
+        for (auto const& particleIndex : partialDelta.createdParticleIndices) {
+            result.addNewParticle(ParticleChangeDescription(converter.getParticleDescription(particleIndex, projection)));
+        }
+        for (auto const& movedParticle : partialDelta.movedParticles) {
+            result.addModifiedParticle(movedParticle);
+        }
+    }
+
+    _clusterStateById = std::move(clusterStateById);
+    _particleStateById = std::move(particleStateById);
+    return result;
+}
+
+void RegionDeltaBuilder::clear()
+{
+    _clusterStateById.clear();
+    _particleStateById.clear();
+}
+
+auto RegionDeltaBuilder::calcDeltaForPartition(DataAccessTO const& dataTO, int partitionIndex, int projection) const
+    -> PartialDelta
+{
+    auto const withVelocities = 0 != (projection & Enums::DataProjection::VELOCITIES);
+
+    PartialDelta result;
+    auto const clusterPartition = calcPartition(*dataTO.numClusters, partitionIndex, _numThreads);
+    for (int clusterIndex = clusterPartition.startIndex; clusterIndex < clusterPartition.endIndex; ++clusterIndex) {
+        auto const& clusterTO = dataTO.clusters[clusterIndex];
+
+        ClusterState state{toVector2D(clusterTO.pos),
+                           toVector2D(clusterTO.vel),
+                           clusterTO.angle,
+                           clusterTO.angularVel,
+                           vector<uint64_t>(clusterTO.numCells),
+                           vector<QVector2D>(clusterTO.numCells)};
+        for (int index = 0; index < clusterTO.numCells; ++index) {
+            auto const& cellTO = dataTO.cells[clusterTO.cellStartIndex + index];
+            state.cellIds[index] = cellTO.id;
+            state.cellPositions[index] = toVector2D(cellTO.pos);
+        }
+
+        auto const previousStateIt = _clusterStateById.find(clusterTO.id);
+        if (previousStateIt == _clusterStateById.end() || previousStateIt->second.cellIds != state.cellIds) {
+            result.createdClusterIndices.emplace_back(clusterIndex);
+        }
+        else {
+            auto const& previousState = previousStateIt->second;
+            ClusterChangeDescription change;
+            change.id = clusterTO.id;
+            change.pos = ValueTracker<QVector2D>(previousState.pos, state.pos);
+            if (withVelocities) {
+                change.vel = ValueTracker<QVector2D>(previousState.vel, state.vel);
+                change.angle = ValueTracker<double>(previousState.angle, state.angle);
+                change.angularVel = ValueTracker<double>(previousState.angularVel, state.angularVel);
+            }
+            for (int index = 0; index < clusterTO.numCells; ++index) {
+                if (previousState.cellPositions[index] != state.cellPositions[index]) {
+                    CellChangeDescription cellChange;
+                    cellChange.id = state.cellIds[index];
+                    cellChange.pos = ValueTracker<QVector2D>(previousState.cellPositions[index], state.cellPositions[index]);
+                    change.addModifiedCell(cellChange);
+                }
+            }
+            if (!change.isEmpty()) {
+                result.movedClusters.emplace_back(change);
+            }
+        }
+        result.clusterStates.emplace_back(clusterTO.id, std::move(state));
+    }
+
+    auto const particlePartition = calcPartition(*dataTO.numParticles, partitionIndex, _numThreads);
+    for (int particleIndex = particlePartition.startIndex; particleIndex < particlePartition.endIndex;
+         ++particleIndex) {
+        auto const& particleTO = dataTO.particles[particleIndex];
+        ParticleState state{toVector2D(particleTO.pos), toVector2D(particleTO.vel)};
+
+        auto const previousStateIt = _particleStateById.find(particleTO.id);
+        if (previousStateIt == _particleStateById.end()) {
+            result.createdParticleIndices.emplace_back(particleIndex);
+        }
+        else {
+            auto const& previousState = previousStateIt->second;
+            ParticleChangeDescription change;
+            change.id = particleTO.id;
+            change.pos = ValueTracker<QVector2D>(previousState.pos, state.pos);
+            if (withVelocities) {
+                change.vel = ValueTracker<QVector2D>(previousState.vel, state.vel);
+            }
+            if (!change.isEmpty()) {
+                result.movedParticles.emplace_back(change);
+            }
+        }
+        result.particleStates.emplace_back(particleTO.id, state);
+    }
+    return result;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QVector2D>
+
+#include "ModelBasic/ChangeDescriptions.h"
+
+#include "Definitions.h"
+#include "AccessTOs.cuh"
+
+class DataConverter;
+
+/**
+ * Host-side builder of the changes of a region between successive transfer objects. The clusters and particles of
+ * a transfer object are compared by their ids with the snapshot of the previous call in contiguous ranges on separate
+ * threads.
+ * Created entities are reported completely, destroyed entities (or entities which have left the region) by id and
+ * position and moved entities by their changed positions and velocities. A cluster whose cells have changed is
+ * reported as destroyed and created again.
+ */
+class MODELGPU_EXPORT RegionDeltaBuilder
+{
+public:
+    RegionDeltaBuilder(int numThreads = 0);   //0 = number of threads of the TaskScheduler
+
+    //converter has to refer to dataTO, the first call reports all entities as created
+    DataChangeDescription calcDelta(DataAccessTO const& dataTO, DataConverter const& converter, int projection);
+
+    void clear();
+
+private:
+    struct ClusterState
+    {
+        QVector2D pos;
+        QVector2D vel;
+        double angle;
+        double angularVel;
+        vector<uint64_t> cellIds;
+        vector<QVector2D> cellPositions;
+    };
+    struct ParticleState
+    {
+        QVector2D pos;
+        QVector2D vel;
+    };
+    struct PartialDelta
+    {
+        vector<int> createdClusterIndices;
+        vector<ClusterChangeDescription> movedClusters;
+        vector<pair<uint64_t, ClusterState>> clusterStates;
+        vector<int> createdParticleIndices;
+        vector<ParticleChangeDescription> movedParticles;
+        vector<pair<uint64_t, ParticleState>> particleStates;
+    };
+
+    PartialDelta calcDeltaForPartition(DataAccessTO const& dataTO, int partitionIndex, int projection) const;
+
+    int _numThreads = 1;
+    unordered_map<uint64_t, ClusterState> _clusterStateById;
+    unordered_map<uint64_t, ParticleState> _particleStateById;
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cmath>
+#include <cuda_runtime.h>
+
+#include "ModelBasic/Colors.h"
+#include "ModelBasic/ExecutionParameters.h"
+
+//functions shared by the rendering kernels and the host reference renderer
+
+unsigned int const ImageBackgroundColor = 0xff00001b;
+int const ImageBlurRadius = 5;
+
+__host__ __device__ __inline__ unsigned int calcCellColor(unsigned char colorCode, float energy)
+{
+    unsigned int result;
+    switch (colorCode % 7)
+    {
+    case 0: {
+        result = Const::IndividualCellColor1;
+        break;
+    }
+    case 1: {
+        result = Const::IndividualCellColor2;
+        break;
+    }
+    case 2: {
+        result = Const::IndividualCellColor3;
+        break;
+    }
+    case 3: {
+        result = Const::IndividualCellColor4;
+        break;
+    }
+    case 4: {
+        result = Const::IndividualCellColor5;
+        break;
+    }
+    case 5: {
+        result = Const::IndividualCellColor6;
+        break;
+    }
+    case 6: {
+        result = Const::IndividualCellColor7;
+        break;
+    }
+    }
+
+    auto const factor = static_cast<int>(energy / 2 + 20.0f < 150.0f ? energy / 2 + 20.0f : 150.0f);
+    auto r = ((result >> 16) & 0xff) * factor / 150;
+    auto g = ((result >> 8) & 0xff) * factor / 150;
+    auto b = (result & 0xff) * factor / 150;
+    return 0xff000000 | (r << 16) | (g << 8) | b;
+}
+
+__host__ __device__ __inline__ unsigned int calcParticleColor(float energy)
+{
+    auto const e = (static_cast<int>(energy) + 10) * 5;
+    return ((e < 150 ? e : 150) << 16) | 0xff000030;
+}
+
+__host__ __device__ __inline__ unsigned int calcTokenColor()
+{
+    return 0xffffffff;
+}
+
+__host__ __device__ __inline__ void addingColor(unsigned int& color, unsigned int const& colorToAdd)
+{
+    auto newColor = (color & 0xfefefe) + (colorToAdd & 0xfefefe);
+    if ((newColor & 0x1000000) != 0) {
+        newColor |= 0xff0000;
+    }
+    if ((newColor & 0x10000) != 0) {
+        newColor |= 0xff00;
+    }
+    if ((newColor & 0x100) != 0) {
+        newColor |= 0xff;
+    }
+    color = newColor | 0xff000000;
+}
+
+//pixels per universe unit, the image covers the rect including its lower right corner
+__host__ __device__ __inline__ float2
+calcImageScale(int2 const& rectUpperLeft, int2 const& rectLowerRight, int2 const& imageSize)
+{
+    return {static_cast<float>(imageSize.x) / (rectLowerRight.x - rectUpperLeft.x + 1),
+            static_cast<float>(imageSize.y) / (rectLowerRight.y - rectUpperLeft.y + 1)};
+}
+
+__host__ __device__ __inline__ int2
+mapUniversePosToImagePos(int2 const& rectUpperLeft, float2 const& imageScale, int2 const& intPos)
+{
+    return {static_cast<int>(floorf((intPos.x - rectUpperLeft.x) * imageScale.x)),
+            static_cast<int>(floorf((intPos.y - rectUpperLeft.y) * imageScale.y))};
+}
+
+//leaves a margin for the neighbor pixels of an entity
+__host__ __device__ __inline__ bool isContainedInImage(int2 const& imageSize, int2 const& imagePos)
+{
+    return imagePos.x >= 1 && imagePos.y >= 1 && imagePos.x < imageSize.x - 1 && imagePos.y < imageSize.y - 1;
+}
+
+//an aggregated value is the number of entities or their energy falling onto one pixel
+__host__ __device__ __inline__ unsigned int calcAggregatedColor(
+    unsigned int value,
+    float2 const& imageScale,
+    ExecutionParameters::ImageAggregation aggregation)
+{
+    if (0 == value) {
+        return ImageBackgroundColor;
+    }
+    auto const unitsPerPixel = 1.0f / (imageScale.x * imageScale.y);
+    auto const referenceValue =
+        ExecutionParameters::ImageAggregation::Energy == aggregation ? unitsPerPixel * 100.0f : unitsPerPixel;
+    auto intensity = static_cast<float>(value) / referenceValue;
+    intensity = intensity < 1.0f ? intensity : 1.0f;
+    intensity = 0.2f + 0.8f * intensity;    //single entities remain visible
+
+    if (ExecutionParameters::ImageAggregation::Energy == aggregation) {
+        auto const r = static_cast<unsigned int>(255 * (intensity < 0.5f ? 2 * intensity : 1.0f));
+        auto const g = static_cast<unsigned int>(255 * (intensity < 0.5f ? 0.0f : 2 * intensity - 1));
+        return 0xff000000 | (r << 16) | (g << 8) | 0x1b;
+    }
+    auto const r = static_cast<unsigned int>(150 * intensity);
+    auto const g = static_cast<unsigned int>(200 * intensity);
+    auto const b = static_cast<unsigned int>(255 * intensity);
+    return 0xff000000 | (r << 16) | (g << 8) | b;
+}
+
+//factors by distance for the glow effect, the last entry is the normalization
+__host__ __inline__ void calcImageBlurFactors(int* imageBlurFactors)
+{
+    imageBlurFactors[0] = 300;
+    imageBlurFactors[1] = 40;
+    imageBlurFactors[2] = 7;
+    imageBlurFactors[3] = 7;
+    imageBlurFactors[4] = 7;
+    imageBlurFactors[5] = 7;
+
+    int sum = 0;
+    for (int x = -ImageBlurRadius; x <= ImageBlurRadius; ++x) {
+        for (int y = -ImageBlurRadius; y <= ImageBlurRadius; ++y) {
+            auto const r = sqrtf(static_cast<float>(x * x + y * y));
+            if (r <= ImageBlurRadius + 0.00001f) {
+                sum += imageBlurFactors[static_cast<int>(floorf(r))];
+            }
+        }
+    }
+    imageBlurFactors[6] = sum - 400;
+}
@@ -1,7 +1,5 @@
 #pragma once
 
-#include "ModelBasic/Colors.h"
-
 #include "device_functions.h"
 #include "sm_60_atomic_functions.h"
 
@@ -11,92 +9,34 @@
 #include "EntityFactory.cuh"
 #include "CleanupKernels.cuh"
 #include "SimulationData.cuh"
+#include "RenderingFunctions.cuh"
 
-__global__ void clearImageMap(unsigned int* imageData, int size)
+__global__ void clearImageMap(unsigned int* imageData, int size, unsigned int value)
 {
     auto const block = calcPartition(size, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
     for (int index = block.startIndex; index <= block.endIndex; ++index) {
-        imageData[index] = 0xff00001b;
+        imageData[index] = value;
     }
 }
 
-__device__ __inline__ int mapUniversePosToImageIndex(int2 const& imageSize, int2 const& rectUpperLeft, int2 const& intPos)
-{
-    return (intPos.x - rectUpperLeft.x) + (intPos.y - rectUpperLeft.y) * imageSize.x;
-}
-
 __device__ __inline__ unsigned int calcColor(Cell* cell)
 {
-    unsigned char colorCode = cell->metadata.color;
-    
-    unsigned int result;
-    switch (colorCode % 7)
-    {
-    case 0: {
-        result = Const::IndividualCellColor1;
-        break;
-    }
-    case 1: {
-        result = Const::IndividualCellColor2;
-        break;
-    }
-    case 2: {
-        result = Const::IndividualCellColor3;
-        break;
-    }
-    case 3: {
-        result = Const::IndividualCellColor4;
-        break;
-    }
-    case 4: {
-        result = Const::IndividualCellColor5;
-        break;
-    }
-    case 5: {
-        result = Const::IndividualCellColor6;
-        break;
-    }
-    case 6: {
-        result = Const::IndividualCellColor7;
-        break;
-    }
-    }
-
-    auto factor = static_cast<int>(min(150.0f, cell->getEnergy() / 2 + 20.0f));
-    auto r = ((result >> 16) & 0xff) * factor / 150;
-    auto g = ((result >> 8) & 0xff) * factor / 150;
-    auto b = (result & 0xff) * factor / 150;
-    return 0xff000000 | (r << 16) | (g << 8) | b;
+    return calcCellColor(cell->metadata.color, cell->getEnergy());
 }
 
 __device__ __inline__ unsigned int calcColor(Particle* particle)
 {
-    auto e = min(150, (static_cast<int>(particle->getEnergy()) + 10) * 5);
-    return (e << 16) | 0xff000030;
+    return calcParticleColor(particle->getEnergy());
 }
 
 __device__ __inline__ unsigned int calcColor(Token* token)
 {
-    return 0xffffffff;
+    return calcTokenColor();
 }
 
-__device__ __inline__ void addingColor(unsigned int& color, unsigned int const& colorToAdd)
-{
-    auto newColor = (color & 0xfefefe) + (colorToAdd & 0xfefefe);
-    if ((newColor & 0x1000000) != 0) {
-        newColor |= 0xff0000;
-    }
-    if ((newColor & 0x10000) != 0) {
-        newColor |= 0xff00;
-    }
-    if ((newColor & 0x100) != 0) {
-        newColor |= 0xff;
-    }
-    color = newColor | 0xff000000;
-}
-
-__device__ __inline__ void drawEntity(unsigned int* imageData, int2 const& imageSize, int const& index, unsigned int color)
+__device__ __inline__ void drawEntity(unsigned int* imageData, int2 const& imageSize, int2 const& imagePos, unsigned int color)
 {
+    auto const index = imagePos.x + imagePos.y * imageSize.x;
     color = (color >> 1) & 0x7e7e7e;
     addingColor(imageData[index], color);
 
@@ -107,13 +47,28 @@ __device__ __inline__ void drawEntity(unsigned int* imageData, int2 const& image
     addingColor(imageData[index + imageSize.x], color);
 }
 
+//in aggregation modes the pixels accumulate the number or the energy of the entities
+__device__ __inline__ void
+drawEntity(unsigned int* imageData, int2 const& imageSize, int2 const& imagePos, unsigned int color, float energy)
+{
+    auto const aggregation = cudaExecutionParameters.imageAggregation;
+    if (ExecutionParameters::ImageAggregation::Color == aggregation) {
+        drawEntity(imageData, imageSize, imagePos, color);
+        return;
+    }
+    auto const value =
+        ExecutionParameters::ImageAggregation::Energy == aggregation ? static_cast<unsigned int>(energy) : 1;
+    atomicAdd(&imageData[imagePos.x + imagePos.y * imageSize.x], value);
+}
+
 __global__ void drawClusters(
     int2 universeSize,
     int2 rectUpperLeft,
     int2 rectLowerRight,
     Array<Cluster*> clusters,
     unsigned int* imageData,
-    int2 imageSize)
+    int2 imageSize,
+    float2 imageScale)
 {
     auto const clusterBlock =
         calcPartition(clusters.getNumEntries(), blockIdx.x, gridDim.x);
@@ -136,24 +91,29 @@ __global__ void drawClusters(
             auto const& cell = cluster->cellPointers[cellIndex];
             auto intPos = toInt2(cell->absPos);
             map.mapPosCorrection(intPos);
-            if (isContainedInRect(rectUpperLeft, rectLowerRight, intPos, 1)) {
-                auto const index = mapUniversePosToImageIndex(imageSize, rectUpperLeft, intPos);
-                auto const color = calcColor(cell);
-                drawEntity(imageData, imageSize, index, color);
+            if (isContainedInRect(rectUpperLeft, rectLowerRight, intPos)) {
+                auto const imagePos = mapUniversePosToImagePos(rectUpperLeft, imageScale, intPos);
+                if (isContainedInImage(imageSize, imagePos)) {
+                    drawEntity(imageData, imageSize, imagePos, calcColor(cell), cell->getEnergy());
+                }
             }
         }
         __syncthreads();
 
+        if (ExecutionParameters::ImageAggregation::Color != cudaExecutionParameters.imageAggregation) {
+            continue;
+        }
         auto const tokenBlock = calcPartition(cluster->numTokenPointers, threadIdx.x, blockDim.x);
         for (auto tokenIndex = tokenBlock.startIndex; tokenIndex <= tokenBlock.endIndex; ++tokenIndex) {
             auto const& token = cluster->tokenPointers[tokenIndex];
             auto const& cell = token->cell;
             auto intPos = toInt2(cell->absPos);
             map.mapPosCorrection(intPos);
-            if (isContainedInRect(rectUpperLeft, rectLowerRight, intPos, 1)) {
-                auto const index = mapUniversePosToImageIndex(imageSize, rectUpperLeft, intPos);
-                auto const color = calcColor(token);
-                drawEntity(imageData, imageSize, index, color);
+            if (isContainedInRect(rectUpperLeft, rectLowerRight, intPos)) {
+                auto const imagePos = mapUniversePosToImagePos(rectUpperLeft, imageScale, intPos);
+                if (isContainedInImage(imageSize, imagePos)) {
+                    drawEntity(imageData, imageSize, imagePos, calcColor(token));
+                }
             }
         }
         __syncthreads();
@@ -161,12 +121,12 @@ __global__ void drawClusters(
 }
 
 __global__ void drawParticles(
-    int2 universeSize,
     int2 rectUpperLeft,
     int2 rectLowerRight,
     Array<Particle*> particles,
     unsigned int* imageData,
-    int2 imageSize)
+    int2 imageSize,
+    float2 imageScale)
 {
     auto const particleBlock =
         calcPartition(particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
@@ -174,20 +134,30 @@ __global__ void drawParticles(
     for (int index = particleBlock.startIndex; index <= particleBlock.endIndex; ++index) {
         auto const& particle = particles.at(index);
         auto intPos = toInt2(particle->absPos);
-        if (isContainedInRect(rectUpperLeft, rectLowerRight, intPos, 1)) {
-            auto const index = mapUniversePosToImageIndex(imageSize, rectUpperLeft, intPos);
-            auto const color = calcColor(particle);
-            drawEntity(imageData, imageSize, index, color);
+        if (isContainedInRect(rectUpperLeft, rectLowerRight, intPos)) {
+            auto const imagePos = mapUniversePosToImagePos(rectUpperLeft, imageScale, intPos);
+            if (isContainedInImage(imageSize, imagePos)) {
+                drawEntity(imageData, imageSize, imagePos, calcColor(particle), particle->getEnergy());
+            }
         }
     }
 }
 
+__global__ void colorizeAggregates(unsigned int* imageData, int size, float2 imageScale)
+{
+    auto const block = calcPartition(size, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = block.startIndex; index <= block.endIndex; ++index) {
+        imageData[index] =
+            calcAggregatedColor(imageData[index], imageScale, cudaExecutionParameters.imageAggregation);
+    }
+}
+
 __global__ void blurImage(
     unsigned int* sourceImage,
     unsigned int* targetImage,
     int2 imageSize)
 {
-    auto constexpr Radius = 5;
+    auto constexpr Radius = ImageBlurRadius;
 
     auto const pixelBlock =
         calcPartition(imageSize.x*imageSize.y, blockIdx.x, gridDim.x);
@@ -202,7 +172,7 @@ __global__ void blurImage(
         __syncthreads();
 
         int2 pos{index % imageSize.x, index / imageSize.x };
-        int2 relPos{ static_cast<int>(threadIdx.x) - 5, static_cast<int>(threadIdx.y) - 5 };
+        int2 relPos{ static_cast<int>(threadIdx.x) - Radius, static_cast<int>(threadIdx.y) - Radius };
 
         auto scanPos = pos - relPos;
         if (scanPos.x >= 0 && scanPos.y >= 0 && scanPos.x < imageSize.x && scanPos.y < imageSize.y) {
@@ -236,12 +206,12 @@ __global__ void blurImage(
 /* Main      															*/
 /************************************************************************/
 
-__global__ void drawImage(int2 rectUpperLeft, int2 rectLowerRight, SimulationData data)
+//the image size may be smaller than the rect so that zoomed-out views are rendered with one pixel per output pixel
+__global__ void drawImage(int2 rectUpperLeft, int2 rectLowerRight, int2 imageSize, SimulationData data)
 {
-    int width = rectLowerRight.x - rectUpperLeft.x + 1;
-    int height = rectLowerRight.y - rectUpperLeft.y + 1;
-    int numPixels = width * height;
-    int2 imageSize{ width, height };
+    auto const numPixels = imageSize.x * imageSize.y;
+    auto const imageScale = calcImageScale(rectUpperLeft, rectLowerRight, imageSize);
+    auto const aggregation = cudaExecutionParameters.imageAggregation;
 
     unsigned int* targetImage;
     if (cudaExecutionParameters.imageGlow) {
@@ -250,12 +220,16 @@ __global__ void drawImage(int2 rectUpperLeft, int2 rectLowerRight, SimulationDat
     else {
         targetImage = data.finalImageData;
     }
-    KERNEL_CALL(clearImageMap, targetImage, numPixels);
-    KERNEL_CALL(drawClusters, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterPointers, targetImage, imageSize);
+    auto const clearValue = ExecutionParameters::ImageAggregation::Color == aggregation ? ImageBackgroundColor : 0;
+    KERNEL_CALL(clearImageMap, targetImage, numPixels, clearValue);
+    KERNEL_CALL(drawClusters, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterPointers, targetImage, imageSize, imageScale);
     if (data.entities.clusterFreezedPointers.getNumEntries() > 0) {
-        KERNEL_CALL(drawClusters, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterFreezedPointers, targetImage, imageSize);
+        KERNEL_CALL(drawClusters, data.size, rectUpperLeft, rectLowerRight, data.entities.clusterFreezedPointers, targetImage, imageSize, imageScale);
+    }
+    KERNEL_CALL(drawParticles, rectUpperLeft, rectLowerRight, data.entities.particlePointers, targetImage, imageSize, imageScale);
+    if (ExecutionParameters::ImageAggregation::Color != aggregation) {
+        KERNEL_CALL(colorizeAggregates, targetImage, numPixels, imageScale);
     }
-    KERNEL_CALL(drawParticles, data.size, rectUpperLeft, rectLowerRight, data.entities.particlePointers, targetImage, imageSize);
 
     if (cudaExecutionParameters.imageGlow) {
         auto const numBlocks = cudaConstants.NUM_BLOCKS*cudaConstants.NUM_THREADS_PER_BLOCK / 8;
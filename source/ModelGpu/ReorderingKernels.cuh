@@ -0,0 +1,230 @@
+#pragma once
+
+#include "device_functions.h"
+#include "sm_60_atomic_functions.h"
+
+#include "SimulationData.cuh"
+#include "Cluster.cuh"
+#include "Cell.cuh"
+#include "Token.cuh"
+#include "Particle.cuh"
+#include "SpaceFillingCurve.h"
+
+/************************************************************************/
+/* Helpers                                                              */
+/************************************************************************/
+
+namespace
+{
+    __device__ int const ReorderingNumBitsPerAxis = SpaceFillingCurve::NumBitsPerAxisForReordering;
+
+    //the curve keys are sorted by a radix sort with one pass per axis
+    __device__ int const ReorderingNumBitsPerDigit = ReorderingNumBitsPerAxis;
+    __device__ int const ReorderingNumDigitValues = 1 << ReorderingNumBitsPerDigit;
+    __device__ int const ReorderingChunkSize = 256;
+
+    __device__ __inline__ float2 getPosition(Cluster* cluster)
+    {
+        return cluster->pos;
+    }
+
+    __device__ __inline__ float2 getPosition(Particle* particle)
+    {
+        return particle->absPos;
+    }
+
+    __device__ __inline__ int getDigit(int key, int shift)
+    {
+        return (key >> shift) & (ReorderingNumDigitValues - 1);
+    }
+}
+
+template<typename T>
+__global__ void calcCurveKeys(int2 universeSize, Array<T*> pointers, int* keys, int* indices)
+{
+    auto const partition =
+        calcPartition(pointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const pos = getPosition(pointers.at(index));
+        keys[index] =
+            SpaceFillingCurve::calcKey(pos.x, pos.y, universeSize.x, universeSize.y, ReorderingNumBitsPerAxis);
+        indices[index] = index;
+    }
+}
+
+//each thread processes its chunks sequentially, counts are stored digit-major such that their prefix sum yields the
+//target offset of each digit and chunk in a stable order
+__global__ void countDigitsPerChunk(int* keys, int* indices, int numIndices, int shift, int numChunks, int* counts)
+{
+    auto const partition = calcPartition(numChunks, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int chunk = partition.startIndex; chunk <= partition.endIndex; ++chunk) {
+        for (int digit = 0; digit < ReorderingNumDigitValues; ++digit) {
+            counts[digit * numChunks + chunk] = 0;
+        }
+        auto const endIndex = min((chunk + 1) * ReorderingChunkSize, numIndices);
+        for (int i = chunk * ReorderingChunkSize; i < endIndex; ++i) {
+            ++counts[getDigit(keys[indices[i]], shift) * numChunks + chunk];
+        }
+    }
+}
+
+__global__ void scatterIndicesByDigit(
+    int* keys,
+    int* indices,
+    int numIndices,
+    int shift,
+    int numChunks,
+    int* offsets,
+    int* sortedIndices)
+{
+    auto const partition = calcPartition(numChunks, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int chunk = partition.startIndex; chunk <= partition.endIndex; ++chunk) {
+        auto const endIndex = min((chunk + 1) * ReorderingChunkSize, numIndices);
+        for (int i = chunk * ReorderingChunkSize; i < endIndex; ++i) {
+            auto const index = indices[i];
+            sortedIndices[offsets[getDigit(keys[index], shift) * numChunks + chunk]++] = index;
+        }
+    }
+}
+
+template<typename T>
+__global__ void gatherEntitiesByIndex(Array<T*> pointers, int* sortedIndices, T** sortedPointers)
+{
+    auto const partition =
+        calcPartition(pointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        sortedPointers[index] = pointers.at(sortedIndices[index]);
+    }
+}
+
+__global__ void reorderParticles(Array<Particle*> particlePointers, Particle* newParticles)
+{
+    auto const partition =
+        calcPartition(particlePointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto& particlePointer = particlePointers.at(index);
+        newParticles[index] = *particlePointer;
+        particlePointer = &newParticles[index];
+    }
+}
+
+__global__ void reorderClusters(Array<Cluster*> clusterPointers, Cluster* newClusters)
+{
+    auto const partition =
+        calcPartition(clusterPointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int clusterIndex = partition.startIndex; clusterIndex <= partition.endIndex; ++clusterIndex) {
+        auto& clusterPointer = clusterPointers.at(clusterIndex);
+        auto& newCluster = newClusters[clusterIndex];
+        newCluster = *clusterPointer;
+        clusterPointer = &newCluster;
+        for (int cellIndex = 0; cellIndex < newCluster.numCellPointers; ++cellIndex) {
+            newCluster.cellPointers[cellIndex]->cluster = &newCluster;
+        }
+    }
+}
+
+__global__ void getNumCellsPerCluster(Array<Cluster*> clusterPointers, int* numCells)
+{
+    auto const partition =
+        calcPartition(clusterPointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int clusterIndex = partition.startIndex; clusterIndex <= partition.endIndex; ++clusterIndex) {
+        numCells[clusterIndex] = clusterPointers.at(clusterIndex)->numCellPointers;
+    }
+}
+
+//cells are stored in the order of the clusters
+__global__ void reorderCells(Array<Cluster*> clusterPointers, int* cellOffsets, Cell* cells)
+{
+    PartitionData clusterBlock = calcPartition(clusterPointers.getNumEntries(), blockIdx.x, gridDim.x);
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        auto& cluster = clusterPointers.at(clusterIndex);
+        auto const newCells = cells + cellOffsets[clusterIndex];
+
+        auto cellBlock = calcPartition(cluster->numCellPointers, threadIdx.x, blockDim.x);
+        cluster->tagCellByIndex_block(cellBlock);
+
+        for (int cellIndex = cellBlock.startIndex; cellIndex <= cellBlock.endIndex; ++cellIndex) {
+            auto& origCellPtr = cluster->cellPointers[cellIndex];
+            auto& newCell = newCells[cellIndex];
+            newCell = *origCellPtr;
+            origCellPtr = &newCells[cellIndex];
+
+            for (int i = 0; i < newCell.numConnections; ++i) {
+                auto relCellIndex = origCellPtr->connections[i]->tag;
+                newCell.connections[i] = newCells + relCellIndex;
+            }
+        }
+
+        PartitionData tokenBlock = calcPartition(cluster->numTokenPointers, threadIdx.x, blockDim.x);
+        for (int tokenIndex = tokenBlock.startIndex; tokenIndex <= tokenBlock.endIndex; ++tokenIndex) {
+            auto token = cluster->tokenPointers[tokenIndex];
+            token->cell = newCells + token->cell->tag;
+            token->sourceCell = newCells + token->sourceCell->tag;
+        }
+        __syncthreads();
+    }
+}
+
+//stable LSD radix sort of the curve keys
+template<typename T>
+__device__ void sortBySpaceFillingCurve(SimulationData& data, Array<T*>& pointers, Array<T*>& pointersForCleanup)
+{
+    auto const numEntities = pointers.getNumEntries();
+    auto const numChunks = (numEntities + ReorderingChunkSize - 1) / ReorderingChunkSize;
+    auto const keys = data.dynamicMemory.getArray<int>(numEntities);
+    auto indices = data.dynamicMemory.getArray<int>(numEntities);
+    auto sortedIndices = data.dynamicMemory.getArray<int>(numEntities);
+    auto const counts = data.dynamicMemory.getArray<int>(ReorderingNumDigitValues * numChunks + 1);
+    if (!keys || !indices || !sortedIndices || !counts) {
+        return;
+    }
+    KERNEL_CALL(calcCurveKeys<T>, data.size, pointers, keys, indices);
+    for (int shift = 0; shift < 2 * ReorderingNumBitsPerAxis; shift += ReorderingNumBitsPerDigit) {
+        KERNEL_CALL(countDigitsPerChunk, keys, indices, numEntities, shift, numChunks, counts);
+        KERNEL_CALL_1_BLOCK(calcExclusivePrefixSum, counts, ReorderingNumDigitValues * numChunks);
+        KERNEL_CALL(scatterIndicesByDigit, keys, indices, numEntities, shift, numChunks, counts, sortedIndices);
+        swap(indices, sortedIndices);
+    }
+
+    pointersForCleanup.reset();
+    auto const sortedPointers = pointersForCleanup.getNewSubarray(numEntities);
+    KERNEL_CALL(gatherEntitiesByIndex<T>, pointers, indices, sortedPointers);
+    pointers.swapContent(pointersForCleanup);
+}
+
+/************************************************************************/
+/* Main                                                                 */
+/************************************************************************/
+
+//sorts clusters and particles stably in Morton order of their positions and compacts particles, clusters and cells in that
+//order, should only be called if no cluster is frozen
+__device__ void reorderEntities(SimulationData& data)
+{
+    sortBySpaceFillingCurve(data, data.entities.particlePointers, data.entitiesForCleanup.particlePointers);
+    data.entitiesForCleanup.particles.reset();
+    KERNEL_CALL(
+        reorderParticles,
+        data.entities.particlePointers,
+        data.entitiesForCleanup.particles.getNewSubarray(data.entities.particlePointers.getNumEntries()));
+    data.entities.particles.swapContent(data.entitiesForCleanup.particles);
+
+    sortBySpaceFillingCurve(data, data.entities.clusterPointers, data.entitiesForCleanup.clusterPointers);
+    auto const numClusters = data.entities.clusterPointers.getNumEntries();
+    data.entitiesForCleanup.clusters.reset();
+    KERNEL_CALL(reorderClusters, data.entities.clusterPointers, data.entitiesForCleanup.clusters.getNewSubarray(numClusters));
+    data.entities.clusters.swapContent(data.entitiesForCleanup.clusters);
+
+    auto const cellOffsets = data.dynamicMemory.getArray<int>(numClusters + 1);
+    if (!cellOffsets) {
+        return;
+    }
+    KERNEL_CALL(getNumCellsPerCluster, data.entities.clusterPointers, cellOffsets);
+    KERNEL_CALL_1_BLOCK(calcExclusivePrefixSum, cellOffsets, numClusters);
+    data.entitiesForCleanup.cells.reset();
+    KERNEL_CALL(
+        reorderCells,
+        data.entities.clusterPointers,
+        cellOffsets,
+        data.entitiesForCleanup.cells.getNewSubarray(cellOffsets[numClusters]));
+    data.entities.cells.swapContent(data.entitiesForCleanup.cells);
+}
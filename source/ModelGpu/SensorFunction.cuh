@@ -177,36 +177,46 @@ SensorFunction::getNearbyCell(float2 const& pos, int range, int minSize, int max
     }
     __syncthreads();
 
-    auto const threadPartition = calcPartition(numScanPointsPerAxis * numScanPointsPerAxis, threadIdx.x, blockDim.x);
-    for (int index = threadPartition.startIndex; index <= threadPartition.endIndex; ++index) {
-        int x = index % numScanPointsPerAxis;
-        int y = index / numScanPointsPerAxis;
-        auto const posDelta =
-            float2{static_cast<float>(x * stepSize - range), static_cast<float>(y * stepSize - range)};
-        if (Math::length(posDelta) > range) {
-            continue;
-        }
-        auto const scanCell = _data->cellMap.get(pos + posDelta);
-        if (!scanCell) {
-            continue;
-        }
-        auto const scanCluster = scanCell->cluster;
-        if (_cluster == scanCluster) {
-            continue;
-        }
-        auto const scanSize = scanCluster->numCellPointers;
-        if (scanSize >= minSize && scanSize <= maxSize) {
-            auto const distance = _data->cellMap.mapDistance(scanCell->absPos, pos);
-
-            while (1 == atomicExch_block(&resultLock, 1)) {}
-            __threadfence_block();
-            if (!result || (distance < distanceToResult)) {
-                result = scanCell;
-                distanceToResult = distance;
+    //only the occupied positions of each scan row are visited
+    auto const& occupancy = _data->cellMap.getOccupancy();
+    int2 const posInt = {floorInt(pos.x), floorInt(pos.y)};
+    auto const threadPartition = calcPartition(numScanPointsPerAxis, threadIdx.x, blockDim.x);
+    for (int y = threadPartition.startIndex; y <= threadPartition.endIndex; ++y) {
+        auto const posDeltaY = y * stepSize - range;
+        auto const scanRowY = posInt.y + posDeltaY;
+        auto const scanRowStartX = posInt.x - range;
+        auto const scanRowEndX = scanRowStartX + (numScanPointsPerAxis - 1) * stepSize;
+        occupancy.forEachOccupied(scanRowStartX, scanRowY, scanRowEndX, scanRowY, [&](int x, int) {
+            auto const posDeltaX = x - posInt.x;
+            if ((posDeltaX + range) % stepSize != 0) {
+                return;
             }
-            __threadfence_block();
-            atomicExch_block(&resultLock, 0);
-        }
+            auto const posDelta = float2{static_cast<float>(posDeltaX), static_cast<float>(posDeltaY)};
+            if (Math::length(posDelta) > range) {
+                return;
+            }
+            auto const scanCell = _data->cellMap.get(pos + posDelta);
+            if (!scanCell) {
+                return;
+            }
+            auto const scanCluster = scanCell->cluster;
+            if (_cluster == scanCluster) {
+                return;
+            }
+            auto const scanSize = scanCluster->numCellPointers;
+            if (scanSize >= minSize && scanSize <= maxSize) {
+                auto const distance = _data->cellMap.mapDistance(scanCell->absPos, pos);
+
+                while (1 == atomicExch_block(&resultLock, 1)) {}
+                __threadfence_block();
+                if (!result || (distance < distanceToResult)) {
+                    result = scanCell;
+                    distanceToResult = distance;
+                }
+                __threadfence_block();
+                atomicExch_block(&resultLock, 0);
+            }
+        });
     }
     __syncthreads();
 }
@@ -228,10 +238,18 @@ SensorFunction::getNearbyCellAlongBeam(float2 const& pos, float angle, int minSi
     }
     __syncthreads();
 
+    auto const& occupancy = _data->cellMap.getOccupancy();
     auto const threadPartition =
         calcPartition((cudaSimulationParameters.cellFunctionSensorRange - 1) / 2, threadIdx.x, blockDim.x);
-    for (int index = threadPartition.startIndex; index <= threadPartition.startIndex; ++index) {
+    for (int index = threadPartition.startIndex; index <= threadPartition.endIndex; ++index) {
         auto const distance = index * 2 + 1;
+
+        //one position margin because of rounding when adding the deltas below
+        auto const scanCenter = pos + direction * distance;
+        int2 const scanCenterInt = {floorInt(scanCenter.x), floorInt(scanCenter.y)};
+        if (occupancy.isRectEmpty(scanCenterInt.x - 2, scanCenterInt.y - 2, scanCenterInt.x + 2, scanCenterInt.y + 2)) {
+            continue;
+        }
         for (int deltaX = -1; deltaX < 2; ++deltaX) {
             for (int deltaY = -1; deltaY < 2; ++deltaY) {
                 auto const scanPos =
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Base.cuh"
+#include "AccessTOs.cuh"
+#include "DynamicMemory.cuh"
+
+/**
+ * Metadata strings in the dynamic memory are shared by all cells and clusters which refer to the same string, e.g.
+ * by the cells of replicators transferred with the same source code. Each string is preceded by a header of
+ * STRING_HEADER_SIZE bytes which is zero outside of the copying kernels: the first reference claiming a string
+ * copies it and stores the location of the copy in the header, all references are redirected to the copy in a
+ * subsequent kernel. Hence a shared string is copied only once.
+ */
+unsigned long long const StringClaimed = 0xffffffffffffffffull;
+
+__device__ __inline__ unsigned long long& getStringHeader(char* string)
+{
+    return *reinterpret_cast<unsigned long long*>(string - STRING_HEADER_SIZE);
+}
+
+//returns true for the first reference
+__device__ __inline__ bool claimString(char* string)
+{
+    return 0ull == atomicCAS(&getStringHeader(string), 0ull, StringClaimed);
+}
+
+__device__ __inline__ char* allocateString(DynamicMemory& strings, int len)
+{
+    auto const block = strings.getArray<char>(getStringBlockSize(len));
+    *reinterpret_cast<unsigned long long*>(block) = 0;
+    return block + STRING_HEADER_SIZE;
+}
+
+__device__ __inline__ void releaseString(int len, char* string)
+{
+    if (len > 0) {
+        getStringHeader(string) = 0;
+    }
+}
@@ -1,7 +1,10 @@
 #include <sstream>
 #include <QImage>
 
+#include "Base/TraceRecorder.h"
+
 #include "ModelBasic/SpaceProperties.h"
+#include "ModelBasic/TorusGeometry.h"
 
 #include "CudaWorker.h"
 #include "CudaController.h"
@@ -10,6 +13,7 @@
 #include "SimulationControllerGpu.h"
 #include "CudaJobs.h"
 #include "DataConverter.h"
+#include "EntityQueryEvaluator.h"
 
 namespace
 {
@@ -39,6 +43,7 @@ void SimulationAccessGpuImpl::init(SimulationControllerGpu* controller)
 		QObject::disconnect(connection);
 	}
 	_connections.push_back(connect(worker, &CudaWorker::jobsFinished, this, &SimulationAccessGpuImpl::jobsFinished, Qt::QueuedConnection));
+	_connections.push_back(connect(worker, &CudaWorker::timestepCalculated, this, &SimulationAccessGpuImpl::timestepCalculated, Qt::QueuedConnection));
 }
 
 void SimulationAccessGpuImpl::clear()
@@ -71,7 +76,7 @@ void SimulationAccessGpuImpl::requireData(ResolveDescription const & resolveDesc
 
 void SimulationAccessGpuImpl::requireData(IntRect rect, ResolveDescription const & resolveDesc)
 {
-	auto job = boost::make_shared<_GetDataForEditJob>(getObjectId(), rect, _dataTOCache->getDataTO());
+	auto job = boost::make_shared<_GetDataForEditJob>(getObjectId(), rect, _dataTOCache->getDataTO(), resolveDesc.projection);
     scheduleJob(job);
 }
 
@@ -92,6 +97,51 @@ DataDescription const & SimulationAccessGpuImpl::retrieveData()
 	return _dataCollected;
 }
 
+int SimulationAccessGpuImpl::subscribeRegion(IntRect rect, ResolveDescription const& resolveDesc, int interval)
+{
+	auto const subscriptionId = _nextSubscriptionId++;
+	auto& subscription = _subscriptionsById[subscriptionId];
+	subscription.rect = rect;
+	subscription.projection = resolveDesc.projection;
+	subscription.interval = std::max(1, interval);
+	requireRegionChangesIfOutdated(subscriptionId);
+	return subscriptionId;
+}
+
+void SimulationAccessGpuImpl::unsubscribeRegion(int subscriptionId)
+{
+	_subscriptionsById.erase(subscriptionId);
+}
+
+DataChangeDescription const& SimulationAccessGpuImpl::retrieveRegionChanges(int subscriptionId)
+{
+	auto& subscription = _subscriptionsById.at(subscriptionId);
+	subscription.changesReadyToRetrieve = false;
+	requireRegionChangesIfOutdated(subscriptionId);		//changes are overwritten after the job has been finished
+	return subscription.changes;
+}
+
+int SimulationAccessGpuImpl::queryEntities(EntityQuery const& query)
+{
+	return scheduleQuery(query, false);
+}
+
+int SimulationAccessGpuImpl::deleteEntities(EntityQuery const& query)
+{
+	return scheduleQuery(query, true);
+}
+
+EntityQueryResult SimulationAccessGpuImpl::retrieveQueryResult(int queryId)
+{
+	auto queryIt = _queriesById.find(queryId);
+	if (queryIt == _queriesById.end() || !queryIt->second.finished) {
+		return EntityQueryResult();
+	}
+	auto result = std::move(queryIt->second.result);
+	_queriesById.erase(queryIt);
+	return result;
+}
+
 void SimulationAccessGpuImpl::scheduleJob(CudaJob const & job)
 {
     auto worker = _context->getCudaController()->getCudaWorker();
@@ -106,6 +156,7 @@ void SimulationAccessGpuImpl::scheduleJob(CudaJob const & job)
 
 void SimulationAccessGpuImpl::jobsFinished()
 {
+	TRACE_SCOPE("SimulationAccessGpuImpl::jobsFinished");
 	auto worker = _context->getCudaController()->getCudaWorker();
 	auto finishedJobs = worker->getFinishedJobs(getObjectId());
 	for (auto const& job : finishedJobs) {
@@ -120,9 +171,19 @@ void SimulationAccessGpuImpl::jobsFinished()
 			Q_EMIT imageReady();
 		}
 
+		if (auto const& getDataForSubscriptionJob = boost::dynamic_pointer_cast<_GetDataForSubscriptionJob>(job)) {
+			auto dataTO = getDataForSubscriptionJob->getDataTO();
+			createRegionChangesFromGpuModel(dataTO, getDataForSubscriptionJob->getSubscriptionId());
+			_dataTOCache->releaseDataTO(dataTO);
+		}
+
+		if (auto const& getDataForQueryJob = boost::dynamic_pointer_cast<_GetDataForQueryJob>(job)) {
+			evaluateQuery(getDataForQueryJob->getDataTO(), getDataForQueryJob->getQueryId());
+		}
+
 		if (auto const& getDataForEditJob = boost::dynamic_pointer_cast<_GetDataForEditJob>(job)) {
 			auto dataTO = getDataForEditJob->getDataTO();
-			createDataFromGpuModel(dataTO, getDataForEditJob->getRect());
+			createDataFromGpuModel(dataTO, getDataForEditJob->getRect(), getDataForEditJob->getProjection());
 			_dataTOCache->releaseDataTO(dataTO);
 			Q_EMIT dataReadyToRetrieve();
 		}
@@ -134,13 +195,105 @@ void SimulationAccessGpuImpl::jobsFinished()
 				worker->addJob(job);
 			}
 			_waitingJobs.clear();
+			for (auto& subscriptionAndId : _subscriptionsById) {
+				subscriptionAndId.second.outdated = true;
+				requireRegionChangesIfOutdated(subscriptionAndId.first);
+			}
 		}
 	}
 }
 
+void SimulationAccessGpuImpl::timestepCalculated()
+{
+	for (auto& subscriptionAndId : _subscriptionsById) {
+		auto& subscription = subscriptionAndId.second;
+		if (++subscription.timestepsSinceRequest < subscription.interval) {
+			continue;
+		}
+		subscription.outdated = true;
+		requireRegionChangesIfOutdated(subscriptionAndId.first);
+	}
+}
+
+void SimulationAccessGpuImpl::requireRegionChangesIfOutdated(int subscriptionId)
+{
+	auto& subscription = _subscriptionsById.at(subscriptionId);
+	if (!subscription.outdated || subscription.changesRequired || subscription.changesReadyToRetrieve) {
+		return;
+	}
+	subscription.timestepsSinceRequest = 0;
+	subscription.outdated = false;
+	subscription.changesRequired = true;
+
+	auto job = boost::make_shared<_GetDataForSubscriptionJob>(
+		getObjectId(), subscription.rect, _dataTOCache->getDataTO(), subscription.projection, subscriptionId);
+	scheduleJob(job);
+}
+
+void SimulationAccessGpuImpl::createRegionChangesFromGpuModel(DataAccessTO dataTO, int subscriptionId)
+{
+	TRACE_SCOPE("SimulationAccessGpuImpl::createRegionChangesFromGpuModel");
+	auto subscriptionIt = _subscriptionsById.find(subscriptionId);
+	if (subscriptionIt == _subscriptionsById.end()) {
+		return;		//unsubscribed in the meantime
+	}
+	auto& subscription = subscriptionIt->second;
+	subscription.changesRequired = false;
+
+	DataConverter converter(dataTO, _numberGen, _context->getSimulationParameters(), _context->getSpaceProperties()->getSize());
+	auto changes = subscription.deltaBuilder.calcDelta(dataTO, converter, subscription.projection);
+	if (!changes.empty()) {
+		subscription.changes = std::move(changes);
+		subscription.changesReadyToRetrieve = true;
+		Q_EMIT regionChanged(subscriptionId);
+	}
+	else {
+		requireRegionChangesIfOutdated(subscriptionId);
+	}
+}
+
+int SimulationAccessGpuImpl::scheduleQuery(EntityQuery const& query, bool deletion)
+{
+	auto const queryId = _nextQueryId++;
+	auto& pendingQuery = _queriesById[queryId];
+	pendingQuery.query = query;
+	pendingQuery.deletion = deletion;
+
+	auto const space = _context->getSpaceProperties();
+	auto job = boost::make_shared<_GetDataForQueryJob>(
+		getObjectId(), IntRect{ { 0, 0 }, space->getSize() }, _dataTOCache->getDataTO(), queryId);
+	scheduleJob(job);
+	if (deletion) {
+		_updateInProgress = true;	//following jobs have to see the data after the deletion
+	}
+	return queryId;
+}
+
+void SimulationAccessGpuImpl::evaluateQuery(DataAccessTO dataTO, int queryId)
+{
+	TRACE_SCOPE("SimulationAccessGpuImpl::evaluateQuery");
+	auto& query = _queriesById.at(queryId);
+	EntityQueryEvaluator evaluator(query.query);
+	if (query.deletion) {
+		query.result = evaluator.deleteMatching(dataTO);
+
+		auto const space = _context->getSpaceProperties();
+		auto cudaWorker = _context->getCudaController()->getCudaWorker();
+		CudaJob job = boost::make_shared<_SetDataJob>(getObjectId(), true, IntRect{ { 0, 0 }, space->getSize() }, dataTO);
+		cudaWorker->addJob(job);
+	}
+	else {
+		query.result = evaluator.evaluate(dataTO);
+		_dataTOCache->releaseDataTO(dataTO);
+	}
+	query.finished = true;
+	Q_EMIT queryFinished(queryId);
+}
+
 void SimulationAccessGpuImpl::updateDataToGpu(DataAccessTO dataToUpdateTO, IntRect const& rect, DataChangeDescription const& updateDesc)
 {
-	DataConverter converter(dataToUpdateTO, _numberGen, _context->getSimulationParameters());
+	TRACE_SCOPE("SimulationAccessGpuImpl::updateDataToGpu");
+	DataConverter converter(dataToUpdateTO, _numberGen, _context->getSimulationParameters(), _context->getSpaceProperties()->getSize());
 	converter.updateData(updateDesc);
 
 	auto cudaWorker = _context->getCudaController()->getCudaWorker();
@@ -148,21 +301,31 @@ void SimulationAccessGpuImpl::updateDataToGpu(DataAccessTO dataToUpdateTO, IntRe
 	cudaWorker->addJob(job);
 }
 
-void SimulationAccessGpuImpl::createDataFromGpuModel(DataAccessTO dataTO, IntRect const& rect)
+void SimulationAccessGpuImpl::createDataFromGpuModel(DataAccessTO dataTO, IntRect const& rect, int projection)
 {
+	TRACE_SCOPE("SimulationAccessGpuImpl::createDataFromGpuModel");
 	_lastDataRect = rect;
 
-	DataConverter converter(dataTO, _numberGen, _context->getSimulationParameters());
-	_dataCollected = converter.getDataDescription();
+	DataConverter converter(dataTO, _numberGen, _context->getSimulationParameters(), _context->getSpaceProperties()->getSize());
+	_dataCollected = converter.getDataDescription(projection);
 }
 
 void SimulationAccessGpuImpl::metricCorrection(DataChangeDescription & data) const
 {
-	SpaceProperties* space = _context->getSpaceProperties();
+	Vector2DArrays<float> positions;
+	positions.reserve(static_cast<int>(data.clusters.size() + data.particles.size()));
+	for (auto const& cluster : data.clusters) {
+		positions.add(cluster->pos.getValue());
+	}
+	for (auto const& particle : data.particles) {
+		positions.add(particle->pos.getValue());
+	}
+	TorusGeometry(_context->getSpaceProperties()->getSize()).correctPositions(positions.getSpan());
+
+	int index = 0;
 	for (auto& cluster : data.clusters) {
 		QVector2D origPos = cluster->pos.getValue();
-		auto pos = origPos;
-		space->correctPosition(pos);
+		auto pos = positions.get(index++);
 		auto correctionDelta = pos - origPos;
 		if (!correctionDelta.isNull()) {
 			cluster->pos.setValue(pos);
@@ -172,10 +335,8 @@ void SimulationAccessGpuImpl::metricCorrection(DataChangeDescription & data) con
 		}
 	}
 	for (auto& particle : data.particles) {
-		QVector2D origPos = particle->pos.getValue();
-		auto pos = origPos;
-		space->correctPosition(pos);
-		if (pos != origPos) {
+		auto pos = positions.get(index++);
+		if (pos != particle->pos.getValue()) {
 			particle->pos.setValue(pos);
 		}
 	}
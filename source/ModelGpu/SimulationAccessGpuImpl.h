@@ -4,6 +4,7 @@
 #include "ModelBasic/ChangeDescriptions.h"
 
 #include "CudaConstants.h"
+#include "RegionDeltaBuilder.h"
 #include "SimulationAccessGpu.h"
 
 class SimulationAccessGpuImpl
@@ -23,12 +24,27 @@ public:
     virtual void applyAction(PhysicalAction const& action) override;
     virtual DataDescription const& retrieveData() override;
 
+    virtual int subscribeRegion(IntRect rect, ResolveDescription const& resolveDesc, int interval = 1) override;
+    virtual void unsubscribeRegion(int subscriptionId) override;
+    virtual DataChangeDescription const& retrieveRegionChanges(int subscriptionId) override;
+
+    virtual int queryEntities(EntityQuery const& query) override;
+    virtual int deleteEntities(EntityQuery const& query) override;
+    virtual EntityQueryResult retrieveQueryResult(int queryId) override;
+
 private:
     void scheduleJob(CudaJob const& job);
 	Q_SLOT void jobsFinished();
+	Q_SLOT void timestepCalculated();
+
+	void requireRegionChangesIfOutdated(int subscriptionId);
+	void createRegionChangesFromGpuModel(DataAccessTO dataTO, int subscriptionId);
+
+	int scheduleQuery(EntityQuery const& query, bool deletion);
+	void evaluateQuery(DataAccessTO dataTO, int queryId);
 
 	void updateDataToGpu(DataAccessTO dataToUpdateTO, IntRect const& rect, DataChangeDescription const& updateDesc);
-	void createDataFromGpuModel(DataAccessTO dataTO, IntRect const& rect);
+	void createDataFromGpuModel(DataAccessTO dataTO, IntRect const& rect, int projection);
 
 	void metricCorrection(DataChangeDescription& data) const;
 
@@ -53,6 +69,28 @@ private:
 	};
     using DataTOCache = boost::shared_ptr<_DataTOCache>;
 
+	//next changes are only required after the previous ones have been retrieved
+	struct Subscription
+	{
+		IntRect rect;
+		int projection;
+		int interval;
+		int timestepsSinceRequest = 0;
+		bool outdated = true;
+		bool changesRequired = false;
+		bool changesReadyToRetrieve = false;
+		RegionDeltaBuilder deltaBuilder;
+		DataChangeDescription changes;
+	};
+
+	struct Query
+	{
+		EntityQuery query;
+		bool deletion = false;
+		bool finished = false;
+		EntityQueryResult result;
+	};
+
 private:
 	list<QMetaObject::Connection> _connections;
 
@@ -67,5 +105,11 @@ private:
 	bool _updateInProgress = false;
 	vector<CudaJob> _waitingJobs;
 
+	map<int, Subscription> _subscriptionsById;
+	int _nextSubscriptionId = 0;
+
+	map<int, Query> _queriesById;
+	int _nextQueryId = 0;
+
 };
 
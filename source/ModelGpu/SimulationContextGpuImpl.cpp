@@ -86,6 +86,16 @@ void SimulationContextGpuImpl::setExecutionParameters(ExecutionParameters const&
     _cudaController->setExecutionParameters(parameters);
 }
 
+void SimulationContextGpuImpl::startRecording(RecordingParameters const& parameters)
+{
+    _cudaController->startRecording(parameters);
+}
+
+void SimulationContextGpuImpl::stopRecording()
+{
+    _cudaController->stopRecording();
+}
+
 CudaController * SimulationContextGpuImpl::getCudaController() const
 {
 	return _cudaController;
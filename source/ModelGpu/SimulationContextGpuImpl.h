@@ -32,6 +32,8 @@ public:
 
 	virtual void setSimulationParameters(SimulationParameters const& parameters) override;
     virtual void setExecutionParameters(ExecutionParameters const& parameters) override;
+    virtual void startRecording(RecordingParameters const& parameters) override;
+    virtual void stopRecording() override;
 
 	virtual CudaController* getCudaController() const;
 
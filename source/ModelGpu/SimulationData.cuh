@@ -4,6 +4,9 @@
 #include "Definitions.cuh"
 #include "Entities.cuh"
 #include "CellFunctionData.cuh"
+#include "ClusterWorkPartition.cuh"
+#include "ClusterBroadPhase.cuh"
+#include "ColdBlockMap.cuh"
 
 struct SimulationData
 {
@@ -13,6 +16,9 @@ struct SimulationData
     CellMap cellMap;
     ParticleMap particleMap;
     CellFunctionData cellFunctionData;
+    ClusterWorkPartition clusterWorkPartition;
+    ClusterBroadPhase clusterBroadPhase;
+    ColdBlockMap coldBlockMap;
 
     Entities entities;
     Entities entitiesForCleanup;
@@ -22,22 +28,38 @@ struct SimulationData
     CudaNumberGenerator numberGen;
     unsigned int* rawImageData;
     unsigned int* finalImageData;
+    int imageDataCapacity;  //in pixels, the image buffers grow with the requested image size
 
-    void init(int2 const& universeSize, CudaConstants const& cudaConstants, int timestep_)
+    void init(int2 const& universeSize, CudaConstants const& cudaConstants, int timestep_, uint64_t firstId = 1)
     {
         size = universeSize;
         timestep = timestep_;
 
         entities.init(cudaConstants);
         entitiesForCleanup.init(cudaConstants);
-        cellFunctionData.init(universeSize);
-        cellMap.init(size, cudaConstants.MAX_CELLPOINTERS, entities.cellPointers.getArrayForHost());
-        particleMap.init(size, cudaConstants.MAX_PARTICLEPOINTERS);
+        cellFunctionData.init(universeSize, cudaConstants.MAX_CLUSTERS);
+        clusterWorkPartition.init(cudaConstants.MAX_CLUSTERPOINTERS);
+        clusterBroadPhase.init(universeSize, cudaConstants.MAX_CLUSTERPOINTERS, cudaConstants.MAX_CLUSTERPOINTERS);
+        coldBlockMap.init(universeSize);
+        cellMap.init(size, cudaConstants.MAX_CELLPOINTERS, cudaConstants.MAX_MAPTILES, entities.cellPointers.getArrayForHost());
+        particleMap.init(size, cudaConstants.MAX_PARTICLEPOINTERS, cudaConstants.MAX_MAPTILES);
         dynamicMemory.init(cudaConstants.DYNAMIC_MEMORY_SIZE);
-        numberGen.init(40312357);
+        numberGen.init(40312357, firstId);
 
-        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(universeSize.x * universeSize.y, rawImageData);
-        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(universeSize.x * universeSize.y, finalImageData);
+        rawImageData = nullptr;
+        finalImageData = nullptr;
+        imageDataCapacity = 0;
+    }
+
+    void resizeImageData(int numPixels)
+    {
+        if (numPixels <= imageDataCapacity) {
+            return;
+        }
+        freeImageData();
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(MemorySubsystem::Images, numPixels, rawImageData);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(MemorySubsystem::Images, numPixels, finalImageData);
+        imageDataCapacity = numPixels;
     }
 
     void free()
@@ -45,13 +67,25 @@ struct SimulationData
         entities.free();
         entitiesForCleanup.free();
         cellFunctionData.free();
+        clusterWorkPartition.free();
+        clusterBroadPhase.free();
+        coldBlockMap.free();
         cellMap.free();
         particleMap.free();
         numberGen.free();
         dynamicMemory.free();
 
+        freeImageData();
+    }
+
+    void freeImageData()
+    {
+        if (0 == imageDataCapacity) {
+            return;
+        }
         CudaMemoryManager::getInstance().freeMemory(rawImageData);
         CudaMemoryManager::getInstance().freeMemory(finalImageData);
+        imageDataCapacity = 0;
     }
 };
 
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ModelBasic/Definitions.h"
+#include "ModelBasic/SimulationParameters.h"
+#include "ModelBasic/ExecutionParameters.h"
+#include "ModelBasic/MonitorData.h"
+#include "ModelBasic/MonitorStatistics.h"
+
+#include "CudaConstants.h"
+#include "Definitions.h"
+
+/**
+ * Many small independent universes in one engine instance, e.g. for parameter studies. Each universe has its own
+ * parameters, memory limits, timestep and monitor. The universes are calculated synchronously in the calling thread
+ * and share the device with no other simulation, i.e. no SimulationControllerGpu may exist at the same time.
+ */
+class SimulationEnsembleGpu
+{
+public:
+    virtual ~SimulationEnsembleGpu() = default;
+
+    struct UniverseConfig
+    {
+        IntVector2D universeSize;
+        SimulationParameters parameters;
+        ExecutionParameters executionParameters;
+        CudaConstants cudaConstants;
+        int timestep = 0;
+        uint64_t firstId = 1;   //ids of entities created by the engine start here, e.g. to keep several processes apart
+    };
+    //returns the index of the new universe
+    virtual int addUniverse(UniverseConfig const& config, DataDescription const& data) = 0;
+    virtual int getNumUniverses() const = 0;
+
+    virtual void calculateTimesteps(int numTimesteps) = 0;
+
+    virtual int getTimestep(int universe) = 0;
+    virtual DataDescription getData(int universe) = 0;
+    //replaces the whole content of the universe
+    virtual void setData(int universe, DataDescription const& data) = 0;
+    //the clusters act on the clusters of the universe but are neither moved nor changed themselves, e.g. copies of
+    //clusters simulated by another process; they are not returned by getData and are removed by the next setData
+    virtual void addGhosts(int universe, DataDescription const& ghosts) = 0;
+    virtual MonitorData getMonitorData(int universe) = 0;
+    virtual MonitorStatistics getMonitorStatistics(int universe) = 0;
+
+    virtual void setSimulationParameters(int universe, SimulationParameters const& parameters) = 0;
+    virtual void setExecutionParameters(int universe, ExecutionParameters const& parameters) = 0;
+};
@@ -0,0 +1,144 @@
+#include "Base/ServiceLocator.h"
+#include "Base/GlobalFactory.h"
+#include "Base/NumberGenerator.h"
+
+#include "ModelBasic/ChangeDescriptions.h"
+
+#include "SimulationEnsembleGpuImpl.h"
+#include "DataConverter.h"
+
+SimulationEnsembleGpuImpl::SimulationEnsembleGpuImpl()
+{
+	auto factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+	_numberGen = factory->buildRandomNumberGenerator();
+	_numberGen->init(1323781, 1);
+}
+
+SimulationEnsembleGpuImpl::~SimulationEnsembleGpuImpl()
+{
+	_ensemble.clear();
+	delete _numberGen;
+}
+
+int SimulationEnsembleGpuImpl::addUniverse(UniverseConfig const& config, DataDescription const& data)
+{
+	auto const index = _ensemble.add(new CudaSimulation(
+		{ config.universeSize.x, config.universeSize.y },
+		config.timestep,
+		config.parameters,
+		config.cudaConstants,
+		config.firstId));
+	_configs.emplace_back(config);
+
+	auto& simulation = _ensemble.getActivatedMember(index);
+	simulation.setExecutionParameters(config.executionParameters);
+
+	auto dataTO = createDataTO(config.cudaConstants);
+	DataConverter converter(dataTO, _numberGen, config.parameters, config.universeSize);
+	converter.updateData(DataChangeDescription(data));
+	simulation.setSimulationData({ 0, 0 }, { -1, -1 }, dataTO);   //empty rect: nothing to remove beforehand
+	deleteDataTO(dataTO);
+
+	return index;
+}
+
+int SimulationEnsembleGpuImpl::getNumUniverses() const
+{
+	return _ensemble.getNumMembers();
+}
+
+void SimulationEnsembleGpuImpl::calculateTimesteps(int numTimesteps)
+{
+	_ensemble.calcTimesteps(numTimesteps);
+}
+
+int SimulationEnsembleGpuImpl::getTimestep(int universe)
+{
+	return _ensemble.getActivatedMember(universe).getTimestep();
+}
+
+DataDescription SimulationEnsembleGpuImpl::getData(int universe)
+{
+	auto const& config = _configs.at(universe);
+	auto dataTO = createDataTO(config.cudaConstants);
+	_ensemble.getActivatedMember(universe).getSimulationData(
+		{ 0, 0 }, { config.universeSize.x, config.universeSize.y }, dataTO);
+
+	DataConverter converter(dataTO, _numberGen, config.parameters, config.universeSize);
+	auto result = converter.getDataDescription();
+	deleteDataTO(dataTO);
+	return result;
+}
+
+void SimulationEnsembleGpuImpl::setData(int universe, DataDescription const& data)
+{
+	auto const& config = _configs.at(universe);
+	auto dataTO = createDataTO(config.cudaConstants);
+	DataConverter converter(dataTO, _numberGen, config.parameters, config.universeSize);
+	converter.updateData(DataChangeDescription(data));
+	_ensemble.getActivatedMember(universe).setSimulationData(
+		{ 0, 0 }, { config.universeSize.x, config.universeSize.y }, dataTO);
+	deleteDataTO(dataTO);
+}
+
+void SimulationEnsembleGpuImpl::addGhosts(int universe, DataDescription const& ghosts)
+{
+	auto const& config = _configs.at(universe);
+	auto dataTO = createDataTO(config.cudaConstants);
+	DataConverter converter(dataTO, _numberGen, config.parameters, config.universeSize);
+	converter.updateData(DataChangeDescription(ghosts));
+	_ensemble.getActivatedMember(universe).addGhostData(dataTO);
+	deleteDataTO(dataTO);
+}
+
+MonitorData SimulationEnsembleGpuImpl::getMonitorData(int universe)
+{
+	return _ensemble.getActivatedMember(universe).getMonitorData();
+}
+
+MonitorStatistics SimulationEnsembleGpuImpl::getMonitorStatistics(int universe)
+{
+	return _ensemble.getActivatedMember(universe).getMonitorStatistics();
+}
+
+void SimulationEnsembleGpuImpl::setSimulationParameters(int universe, SimulationParameters const& parameters)
+{
+	_configs.at(universe).parameters = parameters;
+	_ensemble.getActivatedMember(universe).setSimulationParameters(parameters);
+}
+
+void SimulationEnsembleGpuImpl::setExecutionParameters(int universe, ExecutionParameters const& parameters)
+{
+	_configs.at(universe).executionParameters = parameters;
+	_ensemble.getActivatedMember(universe).setExecutionParameters(parameters);
+}
+
+DataAccessTO SimulationEnsembleGpuImpl::createDataTO(CudaConstants const& cudaConstants) const
+{
+	DataAccessTO result;
+	result.numClusters = new int(0);
+	result.numCells = new int(0);
+	result.numParticles = new int(0);
+	result.numTokens = new int(0);
+	result.numStringBytes = new int(0);
+	result.clusters = new ClusterAccessTO[cudaConstants.MAX_CLUSTERS];
+	result.cells = new CellAccessTO[cudaConstants.MAX_CELLS];
+	result.particles = new ParticleAccessTO[cudaConstants.MAX_PARTICLES];
+	result.tokens = new TokenAccessTO[cudaConstants.MAX_TOKENS];
+	result.stringBytes = new char[cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE];
+	return result;
+}
+
+void SimulationEnsembleGpuImpl::deleteDataTO(DataAccessTO const& dataTO) const
+{
+	delete dataTO.numClusters;
+	delete dataTO.numCells;
+	delete dataTO.numParticles;
+	delete dataTO.numTokens;
+	delete dataTO.numStringBytes;
+	delete[] dataTO.clusters;
+	delete[] dataTO.cells;
+	delete[] dataTO.particles;
+	delete[] dataTO.tokens;
+	delete[] dataTO.stringBytes;
+}
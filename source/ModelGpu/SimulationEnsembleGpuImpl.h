@@ -0,0 +1,38 @@
+#pragma once
+
+#include "SimulationEnsembleGpu.h"
+#include "DefinitionsImpl.h"
+#include "AccessTOs.cuh"
+#include "Ensemble.h"
+
+class SimulationEnsembleGpuImpl
+	: public SimulationEnsembleGpu
+{
+public:
+	SimulationEnsembleGpuImpl();
+	virtual ~SimulationEnsembleGpuImpl();
+
+	int addUniverse(UniverseConfig const& config, DataDescription const& data) override;
+	int getNumUniverses() const override;
+
+	void calculateTimesteps(int numTimesteps) override;
+
+	int getTimestep(int universe) override;
+	DataDescription getData(int universe) override;
+	void setData(int universe, DataDescription const& data) override;
+	void addGhosts(int universe, DataDescription const& ghosts) override;
+	MonitorData getMonitorData(int universe) override;
+	MonitorStatistics getMonitorStatistics(int universe) override;
+
+	void setSimulationParameters(int universe, SimulationParameters const& parameters) override;
+	void setExecutionParameters(int universe, ExecutionParameters const& parameters) override;
+
+private:
+	DataAccessTO createDataTO(CudaConstants const& cudaConstants) const;
+	void deleteDataTO(DataAccessTO const& dataTO) const;
+
+private:
+	Ensemble<CudaSimulation> _ensemble;
+	vector<UniverseConfig> _configs;
+	NumberGenerator* _numberGen = nullptr;
+};
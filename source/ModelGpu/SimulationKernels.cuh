@@ -17,9 +17,19 @@
 /* Helpers for clusters													*/
 /************************************************************************/
 
+__global__ void calcClusterWeights(SimulationData data)
+{
+    data.clusterWorkPartition.calcWeights_system(data.entities.clusterPointers);
+}
+
+__global__ void calcClusterWorkPartition(SimulationData data)
+{
+    data.clusterWorkPartition.calcOffsets_block();
+}
+
 __global__ void clusterProcessingStep1(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    PartitionData clusterBlock = data.clusterWorkPartition.getPartition(numClusters, blockIdx.x, gridDim.x);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         ClusterProcessor clusterProcessor;
         clusterProcessor.init_block(data, clusterIndex);
@@ -30,7 +40,7 @@ __global__ void clusterProcessingStep1(SimulationData data, int numClusters)
 
 __global__ void clusterProcessingStep2(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    PartitionData clusterBlock = data.clusterWorkPartition.getPartition(numClusters, blockIdx.x, gridDim.x);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         ClusterProcessor clusterProcessor;
         clusterProcessor.init_block(data, clusterIndex);
@@ -38,9 +48,37 @@ __global__ void clusterProcessingStep2(SimulationData data, int numClusters)
     }
 }
 
+__global__ void resetClusterBroadPhase(SimulationData data)
+{
+    data.clusterBroadPhase.reset_system();
+}
+
+__global__ void insertClustersIntoBroadPhase(SimulationData data, int numClusters)
+{
+    PartitionData clusterBlock = data.clusterWorkPartition.getPartition(numClusters, blockIdx.x, gridDim.x);
+    for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
+        data.clusterBroadPhase.insert_block(clusterIndex, data.entities.clusterPointers.at(clusterIndex), data.cellMap);
+    }
+}
+
+__global__ void calcClusterBroadPhaseOffsets(SimulationData data)
+{
+    data.clusterBroadPhase.calcSectionOffsets_block();
+}
+
+__global__ void scatterClusterBroadPhase(SimulationData data, int numClusters)
+{
+    data.clusterBroadPhase.scatter_system(numClusters);
+}
+
+__global__ void flagCollisionCandidates(SimulationData data, int numClusters)
+{
+    data.clusterBroadPhase.flagCandidates_system(numClusters);
+}
+
 __global__ void clusterProcessingStep3(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    PartitionData clusterBlock = data.clusterWorkPartition.getPartition(numClusters, blockIdx.x, gridDim.x);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         ClusterProcessor clusterProcessor;
         clusterProcessor.init_block(data, clusterIndex);
@@ -52,7 +90,7 @@ __global__ void clusterProcessingStep3(SimulationData data, int numClusters)
 
 __global__ void clusterProcessingStep4(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    PartitionData clusterBlock = data.clusterWorkPartition.getPartition(numClusters, blockIdx.x, gridDim.x);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         ClusterProcessor clusterProcessor;
         clusterProcessor.init_block(data, clusterIndex);
@@ -71,21 +109,34 @@ __global__ void resetCellFunctionData(SimulationData data)
     data.cellFunctionData.mapSectionCollector.reset_system();
 }
 
+__global__ void calcCellFunctionDataOffsets(SimulationData data)
+{
+    data.cellFunctionData.mapSectionCollector.calcSectionOffsets_block();
+}
+
+__global__ void scatterCellFunctionData(SimulationData data)
+{
+    data.cellFunctionData.mapSectionCollector.scatter_system();
+}
+
 __global__ void tokenProcessingStep1(SimulationData data, int numClusters)
 {
-    auto const clusterPartition = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterPartition = data.clusterWorkPartition.getPartition(numClusters, blockIdx.x, gridDim.x);
     for (int clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
         TokenProcessor tokenProcessor;
         tokenProcessor.init_block(data, clusterIndex);
         tokenProcessor.processingEnergyAveraging_block();
         tokenProcessor.processingSpreading_block();
+        if (cudaExecutionParameters.tokenBucketing) {
+            tokenProcessor.bucketTokens_block();
+        }
         tokenProcessor.processingLightWeigthedFeatures_block();
     }
 }
 
 __global__ void tokenProcessingStep2(SimulationData data, int numClusters)
 {
-    auto const clusterPartition = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    auto const clusterPartition = data.clusterWorkPartition.getPartition(numClusters, blockIdx.x, gridDim.x);
     for (int clusterIndex = clusterPartition.startIndex; clusterIndex <= clusterPartition.endIndex; ++clusterIndex) {
         TokenProcessor tokenProcessor;
         tokenProcessor.init_block(data, clusterIndex);
@@ -95,7 +146,7 @@ __global__ void tokenProcessingStep2(SimulationData data, int numClusters)
 
 __global__ void tokenProcessingStep3(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    PartitionData clusterBlock = data.clusterWorkPartition.getPartition(numClusters, blockIdx.x, gridDim.x);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         TokenProcessor tokenProcessor;
         tokenProcessor.init_block(data, clusterIndex);
@@ -105,7 +156,7 @@ __global__ void tokenProcessingStep3(SimulationData data, int numClusters)
 
 __global__ void tokenProcessingStep4(SimulationData data, int numClusters)
 {
-    PartitionData clusterBlock = calcPartition(numClusters, blockIdx.x, gridDim.x);
+    PartitionData clusterBlock = data.clusterWorkPartition.getPartition(numClusters, blockIdx.x, gridDim.x);
     for (int clusterIndex = clusterBlock.startIndex; clusterIndex <= clusterBlock.endIndex; ++clusterIndex) {
         TokenProcessor tokenProcessor;
         tokenProcessor.init_block(data, clusterIndex);
@@ -150,12 +201,21 @@ __global__ void calcSimulationTimestep(SimulationData data)
     data.particleMap.reset();
     data.dynamicMemory.reset();
     KERNEL_CALL(resetCellFunctionData, data);
+    KERNEL_CALL(calcClusterWeights, data);
+    KERNEL_CALL_1_BLOCK(calcClusterWorkPartition, data);
     KERNEL_CALL(clusterProcessingStep1, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(tokenProcessingStep1, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(tokenProcessingStep2, data, data.entities.clusterPointers.getNumEntries());
+    KERNEL_CALL_1_BLOCK(calcCellFunctionDataOffsets, data);
+    KERNEL_CALL(scatterCellFunctionData, data);
     KERNEL_CALL(tokenProcessingStep3, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(tokenProcessingStep4, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(clusterProcessingStep2, data, data.entities.clusterPointers.getNumEntries());
+    KERNEL_CALL(resetClusterBroadPhase, data);
+    KERNEL_CALL(insertClustersIntoBroadPhase, data, data.entities.clusterPointers.getNumEntries());
+    KERNEL_CALL_1_BLOCK(calcClusterBroadPhaseOffsets, data);
+    KERNEL_CALL(scatterClusterBroadPhase, data, data.entities.clusterPointers.getNumEntries());
+    KERNEL_CALL(flagCollisionCandidates, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(clusterProcessingStep3, data, data.entities.clusterPointers.getNumEntries());
     KERNEL_CALL(clusterProcessingStep4, data, data.entities.clusterPointers.getNumEntries());
 
@@ -49,6 +49,18 @@ MonitorData const & SimulationMonitorGpuImpl::retrieveData()
 	return _monitorData;
 }
 
+void SimulationMonitorGpuImpl::requireStatistics()
+{
+    auto const cudaWorker = _context->getCudaController()->getCudaWorker();
+    auto const job = boost::make_shared<_GetMonitorStatisticsJob>(getObjectId());
+    cudaWorker->addJob(job);
+}
+
+MonitorStatistics const& SimulationMonitorGpuImpl::retrieveStatistics()
+{
+    return _monitorStatistics;
+}
+
 void SimulationMonitorGpuImpl::jobsFinished()
 {
 	auto worker = _context->getCudaController()->getCudaWorker();
@@ -58,6 +70,10 @@ void SimulationMonitorGpuImpl::jobsFinished()
             _monitorData = getMonitorDataJob->getMonitorData();
 			Q_EMIT dataReadyToRetrieve();
 		}
+        if (auto const& getMonitorStatisticsJob = boost::dynamic_pointer_cast<_GetMonitorStatisticsJob>(job)) {
+            _monitorStatistics = getMonitorStatisticsJob->getMonitorStatistics();
+            Q_EMIT statisticsReadyToRetrieve();
+        }
 	}
 }
 
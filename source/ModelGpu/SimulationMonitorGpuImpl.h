@@ -17,6 +17,9 @@ public:
 	virtual void requireData() override;
 	virtual MonitorData const& retrieveData() override;
 
+	virtual void requireStatistics() override;
+	virtual MonitorStatistics const& retrieveStatistics() override;
+
 private:
 	Q_SLOT void jobsFinished();
 
@@ -27,5 +30,6 @@ private:
 
 	SimulationContextGpuImpl* _context = nullptr;
 	MonitorData _monitorData;
+	MonitorStatistics _monitorStatistics;
 };
 
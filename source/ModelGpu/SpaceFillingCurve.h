@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#ifdef __CUDACC__
+#define CURVE_FUNCTION __host__ __device__ __inline__
+#else
+#define CURVE_FUNCTION inline
+#endif
+
+/**
+ * Morton order (Z-order) of positions on a toroidal map. Entities which are sorted by their key are close in memory
+ * if they are close in space, hence neighbor accesses hit the same cache lines.
+ */
+class SpaceFillingCurve
+{
+public:
+    static int const MaxNumBitsPerAxis = 16;
+    static int const NumBitsPerAxisForReordering = 7;  //resolution of the bins of the reordering on the device
+
+    //interleaves the lower 16 bits of x and y
+    CURVE_FUNCTION static uint32_t calcMortonKey(uint32_t x, uint32_t y) { return spreadBits(x) | (spreadBits(y) << 1); }
+
+    //the map is divided into 2^numBitsPerAxis x 2^numBitsPerAxis cells, hence the key is below 4^numBitsPerAxis
+    CURVE_FUNCTION static uint32_t
+    calcKey(float posX, float posY, int universeSizeX, int universeSizeY, int numBitsPerAxis)
+    {
+        return calcMortonKey(
+            toGridCoordinate(posX, universeSizeX, numBitsPerAxis), toGridCoordinate(posY, universeSizeY, numBitsPerAxis));
+    }
+
+private:
+    CURVE_FUNCTION static uint32_t spreadBits(uint32_t value)
+    {
+        value &= 0xffff;
+        value = (value | (value << 8)) & 0x00ff00ff;
+        value = (value | (value << 4)) & 0x0f0f0f0f;
+        value = (value | (value << 2)) & 0x33333333;
+        value = (value | (value << 1)) & 0x55555555;
+        return value;
+    }
+
+    CURVE_FUNCTION static uint32_t toGridCoordinate(float pos, int universeSize, int numBitsPerAxis)
+    {
+        auto const numCells = 1 << numBitsPerAxis;
+        auto result = static_cast<int>(pos / universeSize * numCells);
+        result = result < 0 ? 0 : result;
+        return static_cast<uint32_t>(result < numCells ? result : numCells - 1);
+    }
+};
+
+/**
+ * Returns the indices of the entries in Morton order. The sort is stable, i.e. entries with the same key keep
+ * their order. getPosition(entry) returns the position as std::pair<float, float>.
+ */
+template <typename T, typename PositionFunc>
+std::vector<int> calcSpaceFillingCurveOrder(
+    std::vector<T> const& entries,
+    int universeSizeX,
+    int universeSizeY,
+    PositionFunc const& getPosition,
+    int numBitsPerAxis = SpaceFillingCurve::MaxNumBitsPerAxis)
+{
+    std::vector<uint32_t> keys;
+    keys.reserve(entries.size());
+    for (auto const& entry : entries) {
+        auto const pos = getPosition(entry);
+        keys.emplace_back(SpaceFillingCurve::calcKey(
+            pos.first, pos.second, universeSizeX, universeSizeY, numBitsPerAxis));
+    }
+    std::vector<int> result(entries.size());
+    std::iota(result.begin(), result.end(), 0);
+    std::stable_sort(result.begin(), result.end(), [&](int index1, int index2) { return keys[index1] < keys[index2]; });
+    return result;
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <vector>
+
+#ifdef __CUDACC__
+#define BINNING_FUNCTION __host__ __device__ __inline__
+#else
+#define BINNING_FUNCTION inline
+#endif
+
+/**
+ * Division of a toroidal map into square sections. Entries are binned by counting sort: the entries per section are
+ * counted, the section offsets are obtained by an exclusive prefix sum and the entries are scattered into one
+ * contiguous array. Hence the entries of a section can be read without pointer chasing.
+ * The layout is shared by the device binning in MapSectionCollector and the host implementation below.
+ */
+class SpatialBinningLayout
+{
+public:
+    BINNING_FUNCTION void init(int universeSizeX, int universeSizeY, int sectionSize)
+    {
+        _numSectionsX = universeSizeX / sectionSize;
+        _numSectionsY = universeSizeY / sectionSize;
+        _sectionSize = sectionSize;
+    }
+
+    BINNING_FUNCTION int getNumSections() const { return _numSectionsX * _numSectionsY; }
+    BINNING_FUNCTION int getNumSectionsX() const { return _numSectionsX; }
+    BINNING_FUNCTION int getNumSectionsY() const { return _numSectionsY; }
+
+    BINNING_FUNCTION void getSection(float posX, float posY, int& sectionX, int& sectionY) const
+    {
+        sectionX = static_cast<int>(posX) / _sectionSize;
+        sectionY = static_cast<int>(posY) / _sectionSize;
+    }
+
+    //section coordinates are taken modulo the number of sections
+    BINNING_FUNCTION int getSectionIndex(int sectionX, int sectionY) const
+    {
+        sectionX = ((sectionX % _numSectionsX) + _numSectionsX) % _numSectionsX;
+        sectionY = ((sectionY % _numSectionsY) + _numSectionsY) % _numSectionsY;
+        return sectionX + sectionY * _numSectionsX;
+    }
+
+    BINNING_FUNCTION int getSectionIndex(float posX, float posY) const
+    {
+        int sectionX, sectionY;
+        getSection(posX, posY, sectionX, sectionY);
+        return getSectionIndex(sectionX, sectionY);
+    }
+
+    //sections [start, end] around a position which cover a radius, each section is covered only once
+    BINNING_FUNCTION void getSectionRange(
+        float posX,
+        float posY,
+        float radius,
+        int& startSectionX,
+        int& startSectionY,
+        int& endSectionX,
+        int& endSectionY) const
+    {
+        int sectionX, sectionY;
+        getSection(posX, posY, sectionX, sectionY);
+        auto const sectionRadius = static_cast<int>(radius) / _sectionSize + 1;
+        auto const clampedRadiusX = 2 * sectionRadius + 1 < _numSectionsX ? sectionRadius : -1;
+        auto const clampedRadiusY = 2 * sectionRadius + 1 < _numSectionsY ? sectionRadius : -1;
+        startSectionX = clampedRadiusX >= 0 ? sectionX - clampedRadiusX : 0;
+        endSectionX = clampedRadiusX >= 0 ? sectionX + clampedRadiusX : _numSectionsX - 1;
+        startSectionY = clampedRadiusY >= 0 ? sectionY - clampedRadiusY : 0;
+        endSectionY = clampedRadiusY >= 0 ? sectionY + clampedRadiusY : _numSectionsY - 1;
+    }
+
+private:
+    int _numSectionsX = 0;
+    int _numSectionsY = 0;
+    int _sectionSize = 1;
+};
+
+/**
+ * Host implementation of the counting-sort binning. The scatter is stable, i.e. entries of a section keep their
+ * insertion order.
+ */
+template <typename T>
+class HostSpatialBinning
+{
+public:
+    HostSpatialBinning(int universeSizeX, int universeSizeY, int sectionSize)
+    {
+        _layout.init(universeSizeX, universeSizeY, sectionSize);
+    }
+
+    SpatialBinningLayout const& getLayout() const { return _layout; }
+
+    //getPosition(entry) returns the position as std::pair<float, float>
+    template <typename PositionFunc>
+    void build(std::vector<T> const& entries, PositionFunc const& getPosition)
+    {
+        auto const numEntries = static_cast<int>(entries.size());
+        std::vector<int> sectionIndices(numEntries);
+        _sectionOffsets.assign(_layout.getNumSections() + 1, 0);
+        for (int index = 0; index < numEntries; ++index) {
+            auto const pos = getPosition(entries[index]);
+            sectionIndices[index] = _layout.getSectionIndex(pos.first, pos.second);
+            ++_sectionOffsets[sectionIndices[index] + 1];
+        }
+        for (int section = 0; section < _layout.getNumSections(); ++section) {
+            _sectionOffsets[section + 1] += _sectionOffsets[section];
+        }
+
+        auto cursors = _sectionOffsets;
+        _sortedEntries.resize(numEntries);
+        for (int index = 0; index < numEntries; ++index) {
+            _sortedEntries[cursors[sectionIndices[index]]++] = entries[index];
+        }
+    }
+
+    int getNumEntries(int sectionIndex) const
+    {
+        return _sectionOffsets[sectionIndex + 1] - _sectionOffsets[sectionIndex];
+    }
+
+    T const* getEntries(int sectionIndex) const { return _sortedEntries.data() + _sectionOffsets[sectionIndex]; }
+
+    //visits all entries in the sections which cover the radius around the position
+    template <typename Func>
+    void forEachEntryAround(float posX, float posY, float radius, Func const& func) const
+    {
+        int startSectionX, startSectionY, endSectionX, endSectionY;
+        _layout.getSectionRange(posX, posY, radius, startSectionX, startSectionY, endSectionX, endSectionY);
+        for (int sectionY = startSectionY; sectionY <= endSectionY; ++sectionY) {
+            for (int sectionX = startSectionX; sectionX <= endSectionX; ++sectionX) {
+                auto const sectionIndex = _layout.getSectionIndex(sectionX, sectionY);
+                auto const entries = getEntries(sectionIndex);
+                for (int index = 0; index < getNumEntries(sectionIndex); ++index) {
+                    func(entries[index]);
+                }
+            }
+        }
+    }
+
+private:
+    SpatialBinningLayout _layout;
+    std::vector<int> _sectionOffsets;
+    std::vector<T> _sortedEntries;
+};
@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "Base/InterprocessChannel.h"
+#include "Base/ServiceLocator.h"
+#include "ModelBasic/Descriptions.h"
+#include "ModelBasic/ModelBasicBuilderFacade.h"
+#include "ModelBasic/ModelBasicSettings.h"
+#include "ModelBasic/Serializer.h"
+
+#include "ModelGpuBuilderFacade.h"
+#include "SimulationEnsembleGpu.h"
+#include "SubdomainProcess.h"
+
+namespace
+{
+    string getChannelName(string const& runName, int fromRank, int toRank)
+    {
+        std::stringstream stream;
+        stream << "alien_" << runName << "_" << fromRank << "_" << toRank;
+        return stream.str();
+    }
+
+    double getMilliseconds(std::chrono::steady_clock::time_point const& start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    optional<IntVector2D> parseSize(string const& value)
+    {
+        IntVector2D result;
+        char separator = 0;
+        std::istringstream stream(value);
+        stream >> result.x >> separator >> result.y;
+        if (stream.fail() || separator != 'x' || result.x <= 0 || result.y <= 0) {
+            return boost::none;
+        }
+        return result;
+    }
+
+    optional<int> parseInt(string const& value)
+    {
+        int result = 0;
+        std::istringstream stream(value);
+        stream >> result;
+        if (stream.fail()) {
+            return boost::none;
+        }
+        return result;
+    }
+
+    void printUsage()
+    {
+        std::cerr << "usage: alien --subdomain <rank> --grid <columns>x<rows> --size <width>x<height> --run <name>"
+                  << " --data <file> --timesteps <number> [--halo <width>] [--report <interval>] [--output <file>]"
+                  << std::endl;
+    }
+
+    void printLoads(int rank, vector<SubdomainLoad> const& loads)
+    {
+        auto maxCells = 0;
+        auto sumCells = 0;
+        for (auto const& load : loads) {
+            std::cout << "subdomain " << load.rank << " at timestep " << load.timestep << ": " << load.numClusters
+                      << " clusters, " << load.numCells << " cells, " << load.numParticles << " particles, "
+                      << load.calculationTime << " ms calculation, " << load.exchangeTime << " ms exchange"
+                      << std::endl;
+            maxCells = std::max(maxCells, load.numCells);
+            sumCells += load.numCells;
+        }
+        if (sumCells > 0) {
+            auto const meanCells = static_cast<double>(sumCells) / loads.size();
+            std::cout << "load imbalance seen by subdomain " << rank << ": " << maxCells / meanCells << std::endl;
+        }
+    }
+}
+
+SubdomainProcess::SubdomainProcess(
+    Config const& config,
+    SimulationParameters const& parameters,
+    CudaConstants const& cudaConstants)
+    : _config(config)
+    , _parameters(parameters)
+    , _cudaConstants(cudaConstants)
+    , _decomposition(config.universeSize, config.gridSize, config.haloWidth)
+    , _exchange(_decomposition, config.rank)
+    , _neighborRanks(_decomposition.getNeighborRanks(config.rank))
+{
+    auto const basicFacade = ServiceLocator::getInstance().getService<ModelBasicBuilderFacade>();
+    auto const gpuFacade = ServiceLocator::getInstance().getService<ModelGpuBuilderFacade>();
+    _serializer = basicFacade->buildSerializer();
+    _simulation = gpuFacade->buildSimulationEnsemble();
+
+    for (int neighborRank : _neighborRanks) {
+        _sendChannels[neighborRank] =
+            new InterprocessChannel(getChannelName(config.runName, config.rank, neighborRank));
+        _receiveChannels[neighborRank] =
+            new InterprocessChannel(getChannelName(config.runName, neighborRank, config.rank));
+    }
+}
+
+SubdomainProcess::~SubdomainProcess()
+{
+    for (auto const& rankAndChannel : _sendChannels) {
+        delete rankAndChannel.second;
+    }
+    for (auto const& rankAndChannel : _receiveChannels) {
+        delete rankAndChannel.second;
+        InterprocessChannel::remove(getChannelName(_config.runName, rankAndChannel.first, _config.rank));
+    }
+    delete _simulation;
+    delete _serializer;
+}
+
+bool SubdomainProcess::init(DataDescription const& globalData)
+{
+    SimulationEnsembleGpu::UniverseConfig universeConfig;
+    universeConfig.universeSize = _decomposition.getLocalUniverseSize(_config.rank);
+    universeConfig.parameters = _parameters;
+    universeConfig.executionParameters = ModelBasicSettings::getDefaultExecutionParameters();
+    universeConfig.cudaConstants = _cudaConstants;
+    //each process creates ids in its own range, above the ranges of the host number generators (thread id << 48)
+    universeConfig.firstId = static_cast<uint64_t>(0x8000 + _config.rank) << 48;
+    _simulation->addUniverse(universeConfig, _exchange.extractOwnedData(globalData));
+
+    //the halos are filled before the first timestep
+    return exchange(0.0);
+}
+
+bool SubdomainProcess::calculateTimesteps(int numTimesteps)
+{
+    for (int i = 0; i < numTimesteps; ++i) {
+        auto const start = std::chrono::steady_clock::now();
+        _simulation->calculateTimesteps(1);
+        ++_timestep;
+        if (!exchange(getMilliseconds(start))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int SubdomainProcess::getTimestep() const
+{
+    return _timestep;
+}
+
+DataDescription SubdomainProcess::getGlobalOwnedData() const
+{
+    return _exchange.getGlobalOwnedData(_simulation->getData(0));
+}
+
+vector<SubdomainLoad> SubdomainProcess::getLoads() const
+{
+    vector<SubdomainLoad> result{_load};
+    for (auto const& rankAndLoad : _neighborLoads) {
+        result.emplace_back(rankAndLoad.second);
+    }
+    return result;
+}
+
+bool SubdomainProcess::isRequested(int argc, char* argv[])
+{
+    for (int index = 1; index < argc; ++index) {
+        if (string(argv[index]) == "--subdomain") {
+            return true;
+        }
+    }
+    return false;
+}
+
+int SubdomainProcess::run(int argc, char* argv[])
+{
+    map<string, string> arguments;
+    for (int index = 1; index + 1 < argc; index += 2) {
+        arguments[argv[index]] = argv[index + 1];
+    }
+    auto const getArgument = [&arguments](string const& key) -> string {
+        auto const findResult = arguments.find(key);
+        return findResult != arguments.end() ? findResult->second : string();
+    };
+
+    auto const rank = parseInt(getArgument("--subdomain"));
+    auto const gridSize = parseSize(getArgument("--grid"));
+    auto const universeSize = parseSize(getArgument("--size"));
+    auto const timesteps = parseInt(getArgument("--timesteps"));
+    auto const haloWidth = arguments.count("--halo") ? parseInt(getArgument("--halo")) : optional<int>(20);
+    auto const reportInterval = arguments.count("--report") ? parseInt(getArgument("--report")) : optional<int>(100);
+    if (!rank || !gridSize || !universeSize || !timesteps || !haloWidth || !reportInterval || *reportInterval <= 0
+        || getArgument("--run").empty() || getArgument("--data").empty()) {
+        printUsage();
+        return 1;
+    }
+
+    std::ifstream dataFile(getArgument("--data"), std::ios::binary);
+    if (!dataFile) {
+        std::cerr << "could not open " << getArgument("--data") << std::endl;
+        return 1;
+    }
+    std::stringstream dataStream;
+    dataStream << dataFile.rdbuf();
+
+    Config config;
+    config.runName = getArgument("--run");
+    config.universeSize = *universeSize;
+    config.gridSize = *gridSize;
+    config.haloWidth = *haloWidth;
+    config.rank = *rank;
+
+    auto const gpuFacade = ServiceLocator::getInstance().getService<ModelGpuBuilderFacade>();
+    SubdomainProcess process(
+        config, ModelBasicSettings::getDefaultSimulationParameters(), gpuFacade->getDefaultCudaConstants());
+    if (!process.init(process._serializer->deserializeDataDescription(dataStream.str()))) {
+        return 2;
+    }
+
+    while (process.getTimestep() < *timesteps) {
+        if (!process.calculateTimesteps(std::min(*reportInterval, *timesteps - process.getTimestep()))) {
+            return 2;
+        }
+        printLoads(config.rank, process.getLoads());
+    }
+
+    auto const outputFileName = getArgument("--output");
+    if (!outputFileName.empty()) {
+        std::ofstream outputFile(outputFileName + "." + std::to_string(config.rank), std::ios::binary);
+        outputFile << process._serializer->serializeDataDescription(process.getGlobalOwnedData());
+    }
+    return 0;
+}
+
+bool SubdomainProcess::exchange(double calculationTime)
+{
+    auto const start = std::chrono::steady_clock::now();
+    auto data = _simulation->getData(0);
+    auto messages = _exchange.split(data, _timestep);
+
+    auto const exchangeTime = _load.exchangeTime;
+    _load = SubdomainExchange::calcLoad(data);
+    _load.rank = _config.rank;
+    _load.timestep = _timestep;
+    _load.calculationTime = calculationTime;
+    _load.exchangeTime = exchangeTime;     //of the previous timestep
+    map<int, string> encodedMessages;
+    for (auto& rankAndMessage : messages) {
+        rankAndMessage.second.load = _load;
+        encodedMessages[rankAndMessage.first] = SubdomainExchange::encodeMessage(rankAndMessage.second, _serializer);
+    }
+
+    //messages larger than the queues would block all processes if they were sent before receiving
+    vector<int> unreachableRanks;
+    std::thread sender([this, &encodedMessages, &unreachableRanks] {
+        auto const sendTimeout = _config.timeout * (_config.numRetries + 1);
+        for (auto const& rankAndMessage : encodedMessages) {
+            if (!_sendChannels.at(rankAndMessage.first)->send(rankAndMessage.second, sendTimeout)) {
+                unreachableRanks.emplace_back(rankAndMessage.first);
+            }
+        }
+    });
+    vector<optional<string>> receivedData;
+    for (int neighborRank : _neighborRanks) {
+        receivedData.emplace_back(receiveFromNeighbor(neighborRank));
+    }
+    sender.join();
+
+    auto success = true;
+    for (int index = 0; index < static_cast<int>(_neighborRanks.size()); ++index) {
+        if (!receivedData[index]) {
+            std::cerr << "subdomain " << _config.rank << ": subdomain " << _neighborRanks[index]
+                      << " has not sent its data of timestep " << _timestep << ", shutting down" << std::endl;
+            success = false;
+        }
+    }
+    for (int neighborRank : unreachableRanks) {
+        std::cerr << "subdomain " << _config.rank << ": subdomain " << neighborRank
+                  << " has not received the data of timestep " << _timestep << ", shutting down" << std::endl;
+        success = false;
+    }
+    if (!success) {
+        return false;
+    }
+
+    vector<SubdomainMessage> receivedMessages;
+    for (int index = 0; index < static_cast<int>(_neighborRanks.size()); ++index) {
+        receivedMessages.emplace_back(SubdomainExchange::decodeMessage(*receivedData[index], _serializer));
+        auto const& message = receivedMessages.back();
+        if (message.timestep != _timestep) {
+            std::cerr << "subdomain " << _config.rank << ": subdomain " << _neighborRanks[index]
+                      << " has sent its data of timestep " << message.timestep << " instead of " << _timestep
+                      << ", shutting down" << std::endl;
+            return false;
+        }
+        _neighborLoads[message.fromRank] = message.load;
+    }
+    _exchange.merge(data, receivedMessages);
+    _simulation->setData(0, data);
+    _simulation->addGhosts(0, _exchange.getGhosts());
+
+    _load.exchangeTime = getMilliseconds(start);
+    return true;
+}
+
+//a neighbor may be slower than the timeout, e.g. because of a large timestep
+optional<string> SubdomainProcess::receiveFromNeighbor(int neighborRank)
+{
+    auto const& channel = _receiveChannels.at(neighborRank);
+    for (int attempt = 0; attempt <= _config.numRetries; ++attempt) {
+        if (auto result = channel->receive(_config.timeout)) {
+            return result;
+        }
+        std::cerr << "subdomain " << _config.rank << ": waiting for subdomain " << neighborRank << " (timestep "
+                  << _timestep << ") for more than " << _config.timeout * (attempt + 1) << " ms" << std::endl;
+    }
+    return boost::none;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ModelBasic/Definitions.h"
+#include "ModelBasic/SimulationParameters.h"
+#include "ModelBasic/SubdomainExchange.h"
+
+#include "CudaConstants.h"
+#include "Definitions.h"
+
+class InterprocessChannel;
+
+/**
+ * Simulates one subdomain of a universe which is distributed over several processes on the same machine. Each
+ * process calculates its local universe (subdomain and halo) in an own engine instance and exchanges migrating and
+ * boundary entities with the processes of the neighbor subdomains after every timestep. The processes are
+ * synchronized by these messages, i.e. all of them have to run the same number of timesteps.
+ * A process is started via the command line of the application, e.g. for the upper left subdomain of a 2x2 grid:
+ *   alien --subdomain 0 --grid 2x2 --size 2000x1000 --halo 20 --run test --data universe.col --timesteps 1000
+ * where universe.col contains the serialized data description of the whole universe.
+ */
+class MODELGPU_EXPORT SubdomainProcess
+{
+public:
+    struct Config
+    {
+        string runName;     //prefix of the channel names, has to be unique among the runs on the machine
+        IntVector2D universeSize;
+        IntVector2D gridSize;
+        int haloWidth = 20;
+        int rank = 0;
+        int timeout = 60000;    //in ms for the messages of the neighbors
+        int numRetries = 4;     //number of further timeouts a slow neighbor is waited for
+    };
+    SubdomainProcess(
+        Config const& config,
+        SimulationParameters const& parameters,
+        CudaConstants const& cudaConstants);
+    ~SubdomainProcess();
+
+    //only the entities of the subdomain are taken from the global data
+    //both return false if a neighbor has not responded (see Config) or is out of step, the process has to be shut
+    //down then
+    bool init(DataDescription const& globalData);
+    bool calculateTimesteps(int numTimesteps);
+
+    int getTimestep() const;
+    DataDescription getGlobalOwnedData() const;
+
+    //loads of this subdomain and of its neighbors as reported in the last timestep
+    vector<SubdomainLoad> getLoads() const;
+
+    //returns false if the arguments do not request a subdomain process
+    static bool isRequested(int argc, char* argv[]);
+    //returns the exit code of the process
+    static int run(int argc, char* argv[]);
+
+private:
+    bool exchange(double calculationTime);
+    optional<string> receiveFromNeighbor(int neighborRank);
+
+    Config _config;
+    SimulationParameters _parameters;
+    CudaConstants _cudaConstants;
+    DomainDecomposition _decomposition;
+    SubdomainExchange _exchange;
+    vector<int> _neighborRanks;
+
+    SimulationEnsembleGpu* _simulation = nullptr;
+    Serializer* _serializer = nullptr;
+    map<int, InterprocessChannel*> _sendChannels;
+    map<int, InterprocessChannel*> _receiveChannels;
+
+    int _timestep = 0;
+    SubdomainLoad _load;
+    map<int, SubdomainLoad> _neighborLoads;
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <vector>
+
+#ifdef __CUDACC__
+#define TILEDMAP_FUNCTION __host__ __device__ __inline__
+#else
+#define TILEDMAP_FUNCTION inline
+#endif
+
+/**
+ * Sparse toroidal map which stores its entries in tiles of 32x32 positions. Tiles are taken from a fixed pool when
+ * the first entry is set and returned when the last one is cleared, hence memory only depends on the populated area.
+ * Setting (allocation) and clearing (release) must not run concurrently, i.e. they have to be done in different
+ * kernels.
+ */
+template <typename T>
+class TiledMap
+{
+public:
+    static int const TileSize = 32;
+    static int const NumEntriesPerTile = TileSize * TileSize;
+
+    TILEDMAP_FUNCTION static int getNumDirectoryEntries(int width, int height)
+    {
+        return divUp(width, TileSize) * divUp(height, TileSize);
+    }
+
+    //maxTiles = 0 allows to populate the whole map
+    TILEDMAP_FUNCTION static int getNumPoolTiles(int width, int height, int maxTiles)
+    {
+        auto const numDirectoryEntries = getNumDirectoryEntries(width, height);
+        return 0 < maxTiles && maxTiles < numDirectoryEntries ? maxTiles : numDirectoryEntries;
+    }
+
+    //each entry populates at most one tile (tiles lost in races included), hence this pool size cannot be exhausted
+    TILEDMAP_FUNCTION static int getNumRequiredPoolTiles(int width, int height, int maxEntries)
+    {
+        auto const numDirectoryEntries = getNumDirectoryEntries(width, height);
+        return maxEntries < numDirectoryEntries ? maxEntries : numDirectoryEntries;
+    }
+
+    /**
+     * Expected initial state: directory filled with -1, pool and entryCounts zero-initialized, freeTiles contains
+     * 0..numPoolTiles-1 and counters = {numPoolTiles, 0, 0}.
+     */
+    TILEDMAP_FUNCTION void init(
+        int width,
+        int* directory,
+        T* pool,
+        int* entryCounts,
+        int* freeTiles,
+        int* spareTiles,
+        int* counters)
+    {
+        _numTilesX = divUp(width, TileSize);
+        _directory = directory;
+        _pool = pool;
+        _entryCounts = entryCounts;
+        _freeTiles = freeTiles;
+        _spareTiles = spareTiles;
+        _counters = counters;
+    }
+
+    //returns nullptr and counts the lost entry if the tile pool is exhausted, otherwise each call has to be matched by a
+    //call of clear
+    TILEDMAP_FUNCTION T* getOrCreateEntry(int x, int y)
+    {
+        auto& tileRef = _directory[getDirectoryIndex(x, y)];
+        auto tile = tileRef;
+        if (tile < 0) {
+            auto const newTile = allocateTile();
+            if (newTile < 0) {
+                tile = readTile(tileRef);
+                if (tile < 0) {
+#ifdef __CUDA_ARCH__
+                    atomicAdd(&_counters[2], 1);
+#else
+                    ++_counters[2];
+#endif
+                    return nullptr;
+                }
+            } else {
+                auto const origTile = compareAndSwapTile(tileRef, newTile);
+                if (-1 == origTile) {
+                    tile = newTile;
+                } else {
+                    addSpareTile(newTile);
+                    tile = origTile;
+                }
+            }
+        }
+#ifdef __CUDA_ARCH__
+        atomicAdd(&_entryCounts[tile], 1);
+#else
+        ++_entryCounts[tile];
+#endif
+        return &_pool[tile * NumEntriesPerTile + getTileOffset(x, y)];
+    }
+
+    //returns a zero-initialized value for positions in unpopulated tiles
+    TILEDMAP_FUNCTION T get(int x, int y) const
+    {
+        auto const tile = _directory[getDirectoryIndex(x, y)];
+        if (tile < 0) {
+            return T();
+        }
+        return _pool[tile * NumEntriesPerTile + getTileOffset(x, y)];
+    }
+
+    //releases the tile with its last entry
+    TILEDMAP_FUNCTION void clear(int x, int y)
+    {
+        auto& tileRef = _directory[getDirectoryIndex(x, y)];
+        auto const tile = tileRef;
+        _pool[tile * NumEntriesPerTile + getTileOffset(x, y)] = T();
+#ifdef __CUDA_ARCH__
+        __threadfence();
+        auto const origEntryCount = atomicSub(&_entryCounts[tile], 1);
+#else
+        auto const origEntryCount = _entryCounts[tile]--;
+#endif
+        if (1 == origEntryCount) {
+            tileRef = -1;
+            pushTile(_freeTiles, _counters[0], tile);
+        }
+    }
+
+    //returns the tiles which lost the race for a directory entry to the pool, must not run concurrently to allocations
+    TILEDMAP_FUNCTION void reclaimSpareTiles()
+    {
+        for (int index = 0; index < _counters[1]; ++index) {
+            pushTile(_freeTiles, _counters[0], _spareTiles[index]);
+        }
+        _counters[1] = 0;
+    }
+
+    TILEDMAP_FUNCTION int getNumFreeTiles() const { return _counters[0]; }
+
+    //number of entries which could not be created since the initialization
+    TILEDMAP_FUNCTION int getNumLostEntries() const { return _counters[2]; }
+
+private:
+    TILEDMAP_FUNCTION static int divUp(int value, int divisor) { return (value + divisor - 1) / divisor; }
+
+    TILEDMAP_FUNCTION int getDirectoryIndex(int x, int y) const
+    {
+        return y / TileSize * _numTilesX + x / TileSize;
+    }
+
+    TILEDMAP_FUNCTION static int getTileOffset(int x, int y) { return (y % TileSize) * TileSize + x % TileSize; }
+
+    TILEDMAP_FUNCTION int allocateTile()
+    {
+#ifdef __CUDA_ARCH__
+        auto const index = atomicSub(&_counters[0], 1) - 1;
+        if (index < 0) {
+            atomicAdd(&_counters[0], 1);
+            return -1;
+        }
+        return _freeTiles[index];
+#else
+        if (0 == _counters[0]) {
+            return -1;
+        }
+        return _freeTiles[--_counters[0]];
+#endif
+    }
+
+    TILEDMAP_FUNCTION static int readTile(int& tileRef)
+    {
+#ifdef __CUDA_ARCH__
+        return atomicAdd(&tileRef, 0);
+#else
+        return tileRef;
+#endif
+    }
+
+    TILEDMAP_FUNCTION static int compareAndSwapTile(int& tileRef, int newTile)
+    {
+#ifdef __CUDA_ARCH__
+        return atomicCAS(&tileRef, -1, newTile);
+#else
+        auto const result = tileRef;
+        if (-1 == result) {
+            tileRef = newTile;
+        }
+        return result;
+#endif
+    }
+
+    TILEDMAP_FUNCTION void addSpareTile(int tile) { pushTile(_spareTiles, _counters[1], tile); }
+
+    TILEDMAP_FUNCTION static void pushTile(int* stack, int& numTiles, int tile)
+    {
+#ifdef __CUDA_ARCH__
+        stack[atomicAdd(&numTiles, 1)] = tile;
+#else
+        stack[numTiles++] = tile;
+#endif
+    }
+
+    int _numTilesX;
+    int* _directory;
+    T* _pool;
+    int* _entryCounts;
+    int* _freeTiles;
+    int* _spareTiles;
+    int* _counters;     //number of free tiles, number of spare tiles and number of lost entries
+};
+
+/**
+ * Host implementation which owns the memory of a tiled map.
+ */
+template <typename T>
+class HostTiledMap
+{
+public:
+    HostTiledMap(int width, int height, int maxTiles)
+    {
+        auto const numPoolTiles = TiledMap<T>::getNumPoolTiles(width, height, maxTiles);
+        _directory.resize(TiledMap<T>::getNumDirectoryEntries(width, height), -1);
+        _pool.resize(static_cast<size_t>(numPoolTiles) * TiledMap<T>::NumEntriesPerTile, T());
+        _entryCounts.resize(numPoolTiles, 0);
+        for (int tile = 0; tile < numPoolTiles; ++tile) {
+            _freeTiles.emplace_back(tile);
+        }
+        _spareTiles.resize(numPoolTiles);
+        _counters = {numPoolTiles, 0, 0};
+        _map.init(
+            width,
+            _directory.data(),
+            _pool.data(),
+            _entryCounts.data(),
+            _freeTiles.data(),
+            _spareTiles.data(),
+            _counters.data());
+    }
+
+    TiledMap<T>& getMap() { return _map; }
+
+    int getNumPoolTiles() const { return static_cast<int>(_entryCounts.size()); }
+
+    int getNumAllocatedTiles() const { return getNumPoolTiles() - _map.getNumFreeTiles(); }
+
+private:
+    std::vector<int> _directory;
+    std::vector<T> _pool;
+    std::vector<int> _entryCounts;
+    std::vector<int> _freeTiles;
+    std::vector<int> _spareTiles;
+    std::vector<int> _counters;
+    TiledMap<T> _map;
+};
@@ -0,0 +1,31 @@
+#include "Base/TaskScheduler.h"
+
+#include "TokenBucketSorter.h"
+
+void TokenBucketSorter::sortTokens(DataAccessTO const& dataTO)
+{
+    auto const numClusters = *dataTO.numClusters;
+    _bucketStarts.resize(numClusters * (NumTokenBuckets + 1));
+    TaskScheduler::getInstance().parallelFor(
+        0,
+        numClusters,
+        [&](int clusterIndex) {
+            auto const& cluster = dataTO.clusters[clusterIndex];
+            auto const tokens = dataTO.tokens + cluster.tokenStartIndex;
+            vector<TokenAccessTO> origTokens(tokens, tokens + cluster.numTokens);
+            sortTokensIntoBuckets(
+                origTokens.data(),
+                tokens,
+                cluster.numTokens,
+                [&](TokenAccessTO const& token) { return dataTO.cells[token.cellIndex].cellFunctionType; },
+                &_bucketStarts[clusterIndex * (NumTokenBuckets + 1)]);
+        },
+        0,
+        nullptr,
+        "TokenBucketSorter clusters");
+}
+
+int const* TokenBucketSorter::getBucketStarts(int clusterIndex) const
+{
+    return &_bucketStarts.at(clusterIndex * (NumTokenBuckets + 1));
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Definitions.h"
+#include "AccessTOs.cuh"
+#include "TokenBucketing.cuh"
+
+/**
+ * Host-side counterpart of the token bucketing in TokenProcessor: sorts the tokens of each cluster of a transfer
+ * object stably by the function of their cells, so that the tokens of one cell function are processed together.
+ * The tokens of a cell keep their relative order. The clusters are processed as tasks of the TaskScheduler.
+ */
+class MODELGPU_EXPORT TokenBucketSorter
+{
+public:
+    void sortTokens(DataAccessTO const& dataTO);
+
+    //token index ranges of the buckets of a cluster after sorting, NumTokenBuckets + 1 entries relative to the
+    //first token of the cluster
+    int const* getBucketStarts(int clusterIndex) const;
+
+private:
+    vector<int> _bucketStarts;
+};
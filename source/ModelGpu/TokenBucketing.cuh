@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cuda_runtime.h>
+
+#include "ModelBasic/ElementaryTypes.h"
+
+//functions shared by the token bucketing in the kernels and the host reference implementation
+
+//one bucket per cell function, the bucket index is the cell function type
+int const NumTokenBuckets = Enums::CellFunction::_COUNTER;
+
+__host__ __device__ __inline__ int calcTokenBucket(int cellFunctionType)
+{
+    return static_cast<int>(static_cast<unsigned int>(cellFunctionType) % Enums::CellFunction::_COUNTER);
+}
+
+//bucketStarts has NumTokenBuckets + 1 entries, the last one is the total number of tokens
+__host__ __device__ __inline__ void calcTokenBucketStarts(int const* bucketSizes, int* bucketStarts)
+{
+    bucketStarts[0] = 0;
+    for (int bucket = 0; bucket < NumTokenBuckets; ++bucket) {
+        bucketStarts[bucket + 1] = bucketStarts[bucket] + bucketSizes[bucket];
+    }
+}
+
+//stable counting sort of source into target
+template <typename T, typename GetCellFunctionType>
+__host__ __inline__ void sortTokensIntoBuckets(
+    T const* source,
+    T* target,
+    int numTokens,
+    GetCellFunctionType const& getCellFunctionType,
+    int* bucketStarts)
+{
+    int bucketSizes[NumTokenBuckets] = {};
+    for (int index = 0; index < numTokens; ++index) {
+        ++bucketSizes[calcTokenBucket(getCellFunctionType(source[index]))];
+    }
+    calcTokenBucketStarts(bucketSizes, bucketStarts);
+
+    int targetIndices[NumTokenBuckets];
+    for (int bucket = 0; bucket < NumTokenBuckets; ++bucket) {
+        targetIndices[bucket] = bucketStarts[bucket];
+    }
+    for (int index = 0; index < numTokens; ++index) {
+        target[targetIndices[calcTokenBucket(getCellFunctionType(source[index]))]++] = source[index];
+    }
+}
@@ -17,6 +17,7 @@
 #include "WeaponFunction.cuh"
 #include "SensorFunction.cuh"
 #include "CommunicatorFunction.cuh"
+#include "TokenBucketing.cuh"
 
 class TokenProcessor
 {
@@ -25,6 +26,7 @@ public:
 
     __inline__ __device__ void processingEnergyAveraging_block();
     __inline__ __device__ void processingSpreading_block();
+    __inline__ __device__ void bucketTokens_block();
     __inline__ __device__ void processingLightWeigthedFeatures_block();
 
     __inline__ __device__ void createCellFunctionData_block();
@@ -40,11 +42,17 @@ private:
 
     __inline__ __device__ void resetTags_block();
 
+    template <typename Func>
+    __inline__ __device__ void processingTokenBuckets_block(int firstBucket, int lastBucket, Func const& func);
+
 private:
     SimulationData* _data;
     Cluster* _cluster;
     PartitionData _cellPartition;
     PartitionData _tokenPartition;
+
+    bool _tokensBucketed;
+    int _tokenBucketStarts[NumTokenBuckets + 1];
 };
 
 /************************************************************************/
@@ -56,6 +64,7 @@ __inline__ __device__ void TokenProcessor::init_block(SimulationData& data, int
     _cluster = data.entities.clusterPointers.at(clusterIndex);
     _cellPartition = calcPartition(_cluster->numCellPointers, threadIdx.x, blockDim.x);
     _tokenPartition = calcPartition(_cluster->numTokenPointers, threadIdx.x, blockDim.x);
+    _tokensBucketed = false;
 }
 
 __inline__ __device__ void TokenProcessor::processingEnergyAveraging_block()
@@ -261,11 +270,90 @@ __inline__ __device__ void TokenProcessor::processingSpreading_block()
     _tokenPartition = calcPartition(_cluster->numTokenPointers, threadIdx.x, blockDim.x);
 }
 
+/**
+ * Sorts the token pointers of the cluster stably by the function of their cells (counting sort), so that the
+ * light-weighted features are processed in a specialized loop per cell function instead of branching per token.
+ * The tokens are scattered into dynamic memory and copied back, i.e. no further token pointers are allocated.
+ */
+__inline__ __device__ void TokenProcessor::bucketTokens_block()
+{
+    auto const numTokenPointers = _cluster->numTokenPointers;
+    if (0 == numTokenPointers) {
+        return;
+    }
+
+    __shared__ int bucketSizes[NumTokenBuckets];
+    __shared__ Token** sortedTokenPointers;
+    if (0 == threadIdx.x) {
+        for (int bucket = 0; bucket < NumTokenBuckets; ++bucket) {
+            bucketSizes[bucket] = 0;
+        }
+        sortedTokenPointers = _data->dynamicMemory.getArray<Token*>(numTokenPointers);
+    }
+    __syncthreads();
+
+    if (!sortedTokenPointers) {
+        return;
+    }
+
+    for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
+        auto const& token = _cluster->tokenPointers[tokenIndex];
+        atomicAdd_block(&bucketSizes[calcTokenBucket(token->cell->getCellFunctionType())], 1);
+    }
+    __syncthreads();
+
+    calcTokenBucketStarts(bucketSizes, _tokenBucketStarts);
+
+    //the tokens of a bucket are written by one thread in their original order
+    for (int bucket = threadIdx.x; bucket < NumTokenBuckets; bucket += blockDim.x) {
+        if (0 == bucketSizes[bucket]) {
+            continue;
+        }
+        auto sortedTokenIndex = _tokenBucketStarts[bucket];
+        for (int tokenIndex = 0; tokenIndex < numTokenPointers; ++tokenIndex) {
+            auto const& token = _cluster->tokenPointers[tokenIndex];
+            if (calcTokenBucket(token->cell->getCellFunctionType()) == bucket) {
+                sortedTokenPointers[sortedTokenIndex++] = token;
+            }
+        }
+    }
+    __syncthreads();
+
+    for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
+        _cluster->tokenPointers[tokenIndex] = sortedTokenPointers[tokenIndex];
+    }
+    __syncthreads();
+
+    _tokensBucketed = true;
+}
+
 __inline__ __device__ void TokenProcessor::processingLightWeigthedFeatures_block()
 {
     EntityFactory factory;
     factory.init(_data);
 
+    if (_tokensBucketed) {
+        processingTokenBuckets_block(Enums::CellFunction::COMPUTER, Enums::CellFunction::COMPUTER, [&](Token* token) {
+            CellComputerFunction::processing(token);
+        });
+        processingTokenBuckets_block(
+            Enums::CellFunction::PROPULSION, Enums::CellFunction::PROPULSION, [&](Token* token) {
+                PropulsionFunction::processing(token, factory);
+            });
+        processingTokenBuckets_block(Enums::CellFunction::SCANNER, Enums::CellFunction::SCANNER, [&](Token* token) {
+            ScannerFunction::processing(token);
+        });
+        processingTokenBuckets_block(Enums::CellFunction::WEAPON, Enums::CellFunction::WEAPON, [&](Token* token) {
+            WeaponFunction::processing(token, _data);
+        });
+
+        //the remaining functions are processed in later steps
+        processingTokenBuckets_block(
+            Enums::CellFunction::CONSTRUCTOR, Enums::CellFunction::_COUNTER - 1, [](Token*) {});
+        __syncthreads();
+        return;
+    }
+
     for (auto tokenIndex = _tokenPartition.startIndex; tokenIndex <= _tokenPartition.endIndex; ++tokenIndex) {
         auto& token = _cluster->tokenPointers[tokenIndex];
         auto cell = token->cell;
@@ -308,6 +396,9 @@ __inline__ __device__ void TokenProcessor::processingConstructors_block()
     for (int tokenIndex = 0; tokenIndex < numTokenPointers; ++tokenIndex) {
         auto const& token = _cluster->tokenPointers[tokenIndex];
         auto const type = token->cell->getCellFunctionType();
+        if (Enums::CellFunction::CONSTRUCTOR != type) {
+            continue;   //uniform for the block
+        }
         __syncthreads();
         switch (type) {
         case Enums::CellFunction::CONSTRUCTOR: {
@@ -338,6 +429,9 @@ __inline__ __device__ void TokenProcessor::processingCommunicatorsAnsSensors_blo
     for (int tokenIndex = 0; tokenIndex < numTokenPointers; ++tokenIndex) {
         auto const& token = _cluster->tokenPointers[tokenIndex];
         auto const type = token->cell->getCellFunctionType();
+        if (Enums::CellFunction::SENSOR != type && Enums::CellFunction::COMMUNICATOR != type) {
+            continue;   //uniform for the block
+        }
         __syncthreads();
         switch (type) {
         case Enums::CellFunction::SENSOR: {
@@ -372,7 +466,7 @@ __inline__ __device__ void TokenProcessor::createCellFunctionData_block()
 
     if (0 == threadIdx.x) {
         if (hasToken && hasCommunicator) {
-            _data->cellFunctionData.mapSectionCollector.insert(_cluster, &_data->dynamicMemory);
+            _data->cellFunctionData.mapSectionCollector.insert(_cluster);
         }
     }
 }
@@ -454,6 +548,23 @@ __inline__ __device__ void TokenProcessor::moveToken(Token* sourceToken, Token*&
     targetToken->cell = targetCell;
 }
 
+template <typename Func>
+__inline__ __device__ void
+TokenProcessor::processingTokenBuckets_block(int firstBucket, int lastBucket, Func const& func)
+{
+    auto const startIndex = _tokenBucketStarts[firstBucket];
+    auto const partition = calcPartition(_tokenBucketStarts[lastBucket + 1] - startIndex, threadIdx.x, blockDim.x);
+    for (auto tokenIndex = startIndex + partition.startIndex; tokenIndex <= startIndex + partition.endIndex;
+         ++tokenIndex) {
+        auto& token = _cluster->tokenPointers[tokenIndex];
+        auto cell = token->cell;
+        cell->getLock();
+        EnergyGuidance::processing(token);
+        func(token);
+        cell->releaseLock();
+    }
+}
+
 __inline__ __device__ void TokenProcessor::resetTags_block()
 {
     for (auto cellIndex = _cellPartition.startIndex; cellIndex <= _cellPartition.endIndex; ++cellIndex) {
@@ -35,7 +35,7 @@ __inline__ __device__ void WeaponFunction::processing(Token* token, SimulationDa
             if (!otherCell) {
                 continue;
             }
-            if (otherCell->cluster == cell->cluster) {
+            if (otherCell->cluster == cell->cluster || otherCell->cluster->isGhost()) {
                 continue;
             }
             if (otherCell->cluster->numCellPointers < minMass || otherCell->cluster->numCellPointers > maxMass) {
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#ifdef __CUDACC__
+#define PARTITIONING_FUNCTION __host__ __device__ __inline__
+#else
+#define PARTITIONING_FUNCTION inline
+#endif
+
+/**
+ * Division of entities with different weights (e.g. the number of cells of clusters) into ranges of similar total
+ * weight. Input is the exclusive prefix sum of the positive weights where weightOffsets[numEntities] holds the total
+ * weight.
+ * An entity belongs to the division in which its offset lies, hence each entity is assigned to exactly one division
+ * and the load of a division exceeds the average by at most the largest single weight.
+ */
+class WeightedPartitioning
+{
+public:
+    //range [startIndex, endIndex] of a division, the range is empty if endIndex < startIndex
+    PARTITIONING_FUNCTION static void calcPartition(
+        int const* weightOffsets,
+        int numEntities,
+        int division,
+        int numDivisions,
+        int& startIndex,
+        int& endIndex)
+    {
+        startIndex = findFirstEntity(weightOffsets, numEntities, calcBound(weightOffsets, numEntities, division, numDivisions));
+        endIndex = findFirstEntity(weightOffsets, numEntities, calcBound(weightOffsets, numEntities, division + 1, numDivisions)) - 1;
+    }
+
+private:
+    PARTITIONING_FUNCTION static int64_t calcBound(int const* weightOffsets, int numEntities, int division, int numDivisions)
+    {
+        return static_cast<int64_t>(weightOffsets[numEntities]) * division / numDivisions;
+    }
+
+    //first entity whose offset is not below the bound
+    PARTITIONING_FUNCTION static int findFirstEntity(int const* weightOffsets, int numEntities, int64_t bound)
+    {
+        int lower = 0;
+        int upper = numEntities;
+        while (lower < upper) {
+            auto const middle = (lower + upper) / 2;
+            if (weightOffsets[middle] < bound) {
+                lower = middle + 1;
+            }
+            else {
+                upper = middle;
+            }
+        }
+        return lower;
+    }
+};
+
+/**
+ * Host implementation which calculates the prefix sum of given weights.
+ */
+class HostWeightedPartitioning
+{
+public:
+    void init(std::vector<int> const& weights)
+    {
+        _weightOffsets.assign(weights.size() + 1, 0);
+        for (int index = 0; index < static_cast<int>(weights.size()); ++index) {
+            _weightOffsets[index + 1] = _weightOffsets[index] + weights[index];
+        }
+    }
+
+    void calcPartition(int division, int numDivisions, int& startIndex, int& endIndex) const
+    {
+        WeightedPartitioning::calcPartition(
+            _weightOffsets.data(),
+            static_cast<int>(_weightOffsets.size()) - 1,
+            division,
+            numDivisions,
+            startIndex,
+            endIndex);
+    }
+
+    int getWeight(int startIndex, int endIndex) const
+    {
+        return endIndex < startIndex ? 0 : _weightOffsets[endIndex + 1] - _weightOffsets[startIndex];
+    }
+
+private:
+    std::vector<int> _weightOffsets;
+};
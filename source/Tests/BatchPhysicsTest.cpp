@@ -0,0 +1,116 @@
+#include <random>
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "ModelBasic/BatchPhysics.h"
+#include "ModelBasic/Physics.h"
+
+class BatchPhysicsTest : public ::testing::Test
+{
+public:
+    BatchPhysicsTest() = default;
+    virtual ~BatchPhysicsTest() = default;
+
+protected:
+    //the number of positions is not a multiple of the SIMD width in order to test the remainders
+    Vector2DArrays<float> createPositions(int numPositions, QVector2D const& offset);
+    vector<QVector2D> toVector(Vector2DArrays<float> const& positions) const;
+
+    std::mt19937 _randomEngine;
+};
+
+Vector2DArrays<float> BatchPhysicsTest::createPositions(int numPositions, QVector2D const& offset)
+{
+    std::uniform_real_distribution<float> distribution(-20.0f, 20.0f);
+    Vector2DArrays<float> result;
+    for (int index = 0; index < numPositions; ++index) {
+        result.add(offset + QVector2D(distribution(_randomEngine), distribution(_randomEngine)));
+    }
+    return result;
+}
+
+vector<QVector2D> BatchPhysicsTest::toVector(Vector2DArrays<float> const& positions) const
+{
+    vector<QVector2D> result;
+    for (int index = 0; index < positions.size(); ++index) {
+        result.emplace_back(positions.get(index));
+    }
+    return result;
+}
+
+TEST_F(BatchPhysicsTest, testCenterAndAngularMass)
+{
+    auto const positions = createPositions(103, {500, 300});
+    auto const positionVector = toVector(positions);
+
+    QVector2D expectedCenter;
+    for (auto const& pos : positionVector) {
+        expectedCenter += pos;
+    }
+    expectedCenter = expectedCenter / positionVector.size();
+    vector<QVector2D> relPositionVector;
+    for (auto const& pos : positionVector) {
+        relPositionVector.emplace_back(pos - expectedCenter);
+    }
+    auto const expectedAngularMass = Physics::angularMass(relPositionVector);
+
+    for (bool useSimd : {false, true}) {
+        BatchPhysics batchPhysics(useSimd);
+        auto const center = batchPhysics.calcCenter(positions.getSpan());
+        auto relPositions = positions;
+        batchPhysics.translate(relPositions.getSpan(), -expectedCenter);
+        auto const angularMass = batchPhysics.calcAngularMass(relPositions.getSpan());
+        if (useSimd) {
+            EXPECT_NEAR(expectedCenter.x(), center.x(), FLOATINGPOINT_MEDIUM_PRECISION);
+            EXPECT_NEAR(expectedCenter.y(), center.y(), FLOATINGPOINT_MEDIUM_PRECISION);
+            EXPECT_NEAR(expectedAngularMass, angularMass, expectedAngularMass * FLOATINGPOINT_MEDIUM_PRECISION);
+        }
+        else {
+            EXPECT_EQ(expectedCenter, center);
+            EXPECT_EQ(expectedAngularMass, angularMass);
+        }
+    }
+}
+
+TEST_F(BatchPhysicsTest, testVelocitiesOfCenter)
+{
+    Physics::Velocities const velocities{QVector2D(0.3f, -0.1f), 2.0};
+    for (int numPositions : {1, 2, 7, 50}) {
+        auto const relPositions = createPositions(numPositions, {0, 0});
+        auto const expected = Physics::velocitiesOfCenter(velocities, toVector(relPositions));
+        for (bool useSimd : {false, true}) {
+            auto const actual = BatchPhysics(useSimd).calcVelocitiesOfCenter(velocities, relPositions.getSpan());
+            EXPECT_EQ(expected.linear, actual.linear);
+            EXPECT_EQ(expected.angular, actual.angular);
+        }
+    }
+}
+
+TEST_F(BatchPhysicsTest, testTranslate)
+{
+    QVector2D const delta(13.25f, -7.5f);
+    auto const positions = createPositions(21, {0, 0});
+    for (bool useSimd : {false, true}) {
+        auto translatedPositions = positions;
+        BatchPhysics(useSimd).translate(translatedPositions.getSpan(), delta);
+        for (int index = 0; index < positions.size(); ++index) {
+            ASSERT_EQ(positions.get(index) + delta, translatedPositions.get(index));
+        }
+    }
+}
+
+TEST_F(BatchPhysicsTest, testRotateClockwise)
+{
+    QVector2D const center(100, 50);
+    double const angle = 37.5;
+    auto const positions = createPositions(31, center);
+
+    for (bool useSimd : {false, true}) {
+        auto rotatedPositions = positions;
+        BatchPhysics(useSimd).rotateClockwise(rotatedPositions.getSpan(), center, angle);
+        for (int index = 0; index < positions.size(); ++index) {
+            auto const expectedPos = center + Physics::rotateClockwise(positions.get(index) - center, angle);
+            ASSERT_EQ(expectedPos, rotatedPositions.get(index));
+        }
+    }
+}
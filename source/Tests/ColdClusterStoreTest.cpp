@@ -0,0 +1,386 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+#include "ModelGpu/ColdClusterStore.h"
+
+#include "TransferData.h"
+
+class ColdClusterStoreTest : public ::testing::Test
+{
+public:
+    ColdClusterStoreTest();
+    virtual ~ColdClusterStoreTest() = default;
+
+protected:
+    TransferData createTransferData() const;
+
+    //adds a chain of cells at random position with tokens and metadata
+    void addRandomCluster(TransferData& data, uint64_t id, int numCells, int numTokens);
+    int addString(TransferData& data, string const& value);
+
+    //checks that each expected cluster is contained in actual independent of the position in the arrays
+    void checkEquality(TransferData const& expected, TransferData const& actual) const;
+
+    bool hasCellInRect(
+        TransferData const& data,
+        ClusterAccessTO const& clusterTO,
+        IntVector2D const& rectUpperLeft,
+        IntVector2D const& rectLowerRight) const;
+
+    IntVector2D const _universeSize = {1000, 500};
+    ColdClusterStore::Capacity const _capacity = {1000, 20000, 5000, 100000};
+    RandomStream _random;
+};
+
+ColdClusterStoreTest::ColdClusterStoreTest()
+    : _random(1, 0)
+{}
+
+TransferData ColdClusterStoreTest::createTransferData() const
+{
+    return TransferData(_capacity.numClusters, _capacity.numCells, 1, _capacity.numTokens, _capacity.numStringBytes);
+}
+
+void ColdClusterStoreTest::addRandomCluster(TransferData& data, uint64_t id, int numCells, int numTokens)
+{
+    auto const posX = _random.getFloat() * _universeSize.x;
+    auto const posY = _random.getFloat() * _universeSize.y;
+
+    ClusterAccessTO clusterTO = {};
+    clusterTO.id = id;
+    clusterTO.pos = {posX, posY};
+    clusterTO.vel = {_random.getFloat(), _random.getFloat()};
+    clusterTO.numCells = numCells;
+    clusterTO.cellStartIndex = data.numCells;
+    clusterTO.numTokens = numTokens;
+    clusterTO.tokenStartIndex = data.numTokens;
+    clusterTO.metadata.nameLen = static_cast<int>(std::to_string(id).size());
+    clusterTO.metadata.nameStringIndex = addString(data, std::to_string(id));
+
+    //one cell name shared by all cells of the cluster
+    string const cellName = "cell of " + std::to_string(id);
+    auto const cellNameStringIndex = addString(data, cellName);
+
+    for (int index = 0; index < numCells; ++index) {
+        CellAccessTO cellTO = {};
+        cellTO.id = id * 1000 + index;
+        cellTO.pos = {posX + index, posY};     //may cross the map border
+        cellTO.energy = _random.getFloat() * 100;
+        cellTO.maxConnections = 2;
+        if (index > 0) {
+            cellTO.connectionIndices[cellTO.numConnections++] = data.numCells + index - 1;
+        }
+        if (index < numCells - 1) {
+            cellTO.connectionIndices[cellTO.numConnections++] = data.numCells + index + 1;
+        }
+        cellTO.cellFunctionType = _random.getUInt(10);
+        cellTO.staticData[0] = static_cast<char>(index);
+        cellTO.metadata.nameLen = static_cast<int>(cellName.size());
+        cellTO.metadata.nameStringIndex = cellNameStringIndex;
+        if (0 == index % 3) {
+            string const code = "mov [1], " + std::to_string(index);
+            cellTO.metadata.sourceCodeLen = static_cast<int>(code.size());
+            cellTO.metadata.sourceCodeStringIndex = addString(data, code);
+        }
+        data.cells[data.numCells + index] = cellTO;
+    }
+    for (int index = 0; index < numTokens; ++index) {
+        TokenAccessTO tokenTO = {};
+        tokenTO.energy = _random.getFloat() * 10;
+        tokenTO.memory[index % MAX_TOKEN_MEM_SIZE] = 7;
+        tokenTO.cellIndex = data.numCells + _random.getUInt(numCells - 1);
+        data.tokens[data.numTokens + index] = tokenTO;
+    }
+    data.clusters[data.numClusters++] = clusterTO;
+    data.numCells += numCells;
+    data.numTokens += numTokens;
+}
+
+int ColdClusterStoreTest::addString(TransferData& data, string const& value)
+{
+    auto const result = data.numStringBytes + STRING_HEADER_SIZE;
+    std::copy(value.begin(), value.end(), data.stringBytes.begin() + result);
+    data.numStringBytes += getStringBlockSize(static_cast<int>(value.size()));
+    return result;
+}
+
+void ColdClusterStoreTest::checkEquality(TransferData const& expected, TransferData const& actual) const
+{
+    auto getString = [](TransferData const& data, int len, int index) {
+        return string(data.stringBytes.begin() + index, data.stringBytes.begin() + index + len);
+    };
+
+    unordered_map<uint64_t, ClusterAccessTO> actualClusterById;
+    for (int index = 0; index < actual.numClusters; ++index) {
+        actualClusterById.emplace(actual.clusters[index].id, actual.clusters[index]);
+    }
+    for (int clusterIndex = 0; clusterIndex < expected.numClusters; ++clusterIndex) {
+        auto const& expectedCluster = expected.clusters[clusterIndex];
+        auto const& actualCluster = actualClusterById.at(expectedCluster.id);
+        EXPECT_EQ(expectedCluster.pos.x, actualCluster.pos.x);
+        EXPECT_EQ(expectedCluster.vel.y, actualCluster.vel.y);
+        ASSERT_EQ(expectedCluster.numCells, actualCluster.numCells);
+        ASSERT_EQ(expectedCluster.numTokens, actualCluster.numTokens);
+        EXPECT_EQ(
+            getString(expected, expectedCluster.metadata.nameLen, expectedCluster.metadata.nameStringIndex),
+            getString(actual, actualCluster.metadata.nameLen, actualCluster.metadata.nameStringIndex));
+
+        for (int index = 0; index < expectedCluster.numCells; ++index) {
+            auto const& expectedCell = expected.cells[expectedCluster.cellStartIndex + index];
+            auto const& actualCell = actual.cells[actualCluster.cellStartIndex + index];
+            EXPECT_EQ(expectedCell.id, actualCell.id);
+            EXPECT_EQ(expectedCell.energy, actualCell.energy);
+            EXPECT_EQ(expectedCell.cellFunctionType, actualCell.cellFunctionType);
+            EXPECT_EQ(expectedCell.staticData[0], actualCell.staticData[0]);
+            ASSERT_EQ(expectedCell.numConnections, actualCell.numConnections);
+            for (int i = 0; i < expectedCell.numConnections; ++i) {
+                EXPECT_EQ(
+                    expected.cells[expectedCell.connectionIndices[i]].id,
+                    actual.cells[actualCell.connectionIndices[i]].id);
+            }
+            EXPECT_EQ(
+                getString(expected, expectedCell.metadata.nameLen, expectedCell.metadata.nameStringIndex),
+                getString(actual, actualCell.metadata.nameLen, actualCell.metadata.nameStringIndex));
+            EXPECT_EQ(
+                getString(expected, expectedCell.metadata.sourceCodeLen, expectedCell.metadata.sourceCodeStringIndex),
+                getString(actual, actualCell.metadata.sourceCodeLen, actualCell.metadata.sourceCodeStringIndex));
+        }
+        for (int index = 0; index < expectedCluster.numTokens; ++index) {
+            auto const& expectedToken = expected.tokens[expectedCluster.tokenStartIndex + index];
+            auto const& actualToken = actual.tokens[actualCluster.tokenStartIndex + index];
+            EXPECT_EQ(expectedToken.energy, actualToken.energy);
+            EXPECT_EQ(0, memcmp(expectedToken.memory, actualToken.memory, MAX_TOKEN_MEM_SIZE));
+            EXPECT_EQ(expected.cells[expectedToken.cellIndex].id, actual.cells[actualToken.cellIndex].id);
+        }
+    }
+}
+
+bool ColdClusterStoreTest::hasCellInRect(
+    TransferData const& data,
+    ClusterAccessTO const& clusterTO,
+    IntVector2D const& rectUpperLeft,
+    IntVector2D const& rectLowerRight) const
+{
+    for (int index = 0; index < clusterTO.numCells; ++index) {
+        auto const& pos = data.cells[clusterTO.cellStartIndex + index].pos;
+        auto const x = std::fmod(pos.x, static_cast<float>(_universeSize.x));
+        auto const y = std::fmod(pos.y, static_cast<float>(_universeSize.y));
+        if (x >= rectUpperLeft.x && x <= rectLowerRight.x && y >= rectUpperLeft.y && y <= rectLowerRight.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_F(ColdClusterStoreTest, testEvictAndRestoreRoundTrip)
+{
+    for (bool compress : {false, true}) {
+        auto data = createTransferData();
+        for (int i = 0; i < 100; ++i) {
+            addRandomCluster(data, i + 1, 1 + _random.getUInt(50), _random.getUInt(5));
+        }
+
+        ColdClusterStore store(_universeSize, compress);
+        store.evict(data.getDataTO());
+        EXPECT_EQ(100, store.getMemoryUsage().numClusters);
+
+        //restored clusters are appended to existing content
+        auto restoredData = createTransferData();
+        addRandomCluster(restoredData, 1000, 5, 1);
+        EXPECT_EQ(100, store.restoreAll(restoredData.getDataTO(), _capacity));
+
+        EXPECT_EQ(1 + data.numClusters, restoredData.numClusters);
+        EXPECT_EQ(5 + data.numCells, restoredData.numCells);
+        EXPECT_EQ(1 + data.numTokens, restoredData.numTokens);
+        checkEquality(data, restoredData);
+        EXPECT_EQ(0, store.getMemoryUsage().numClusters);
+        EXPECT_EQ(0, store.getMemoryUsage().numBytes);
+    }
+}
+
+TEST_F(ColdClusterStoreTest, testRestoreByBlocks)
+{
+    auto data = createTransferData();
+    for (int i = 0; i < 200; ++i) {
+        addRandomCluster(data, i + 1, 1 + _random.getUInt(10), 0);
+    }
+    ColdClusterStore store(_universeSize);
+    store.evict(data.getDataTO());
+
+    auto const coldBlocks = store.getColdBlocks();
+    ASSERT_EQ(16 * 8, coldBlocks.size());
+
+    auto restoredData = createTransferData();
+    EXPECT_LT(0, store.restore({0, 0}, {255, 127}, restoredData.getDataTO(), _capacity));
+    for (int i = 0; i < restoredData.numClusters; ++i) {
+        auto const& clusterTO = restoredData.clusters[i];
+        bool inBlock = false;
+        for (int j = 0; j < clusterTO.numCells; ++j) {
+            auto const& pos = restoredData.cells[clusterTO.cellStartIndex + j].pos;
+            auto const x = static_cast<int>(pos.x) % _universeSize.x;
+            auto const y = static_cast<int>(pos.y) % _universeSize.y;
+            inBlock |= x < 256 && y < 128;
+        }
+        EXPECT_TRUE(inBlock);
+    }
+    auto const coldBlocksAfterRestore = store.getColdBlocks();
+    for (int blockIndex : {0, 1, 2, 3, 16, 17, 18, 19}) {
+        EXPECT_EQ(0, coldBlocksAfterRestore[blockIndex]);
+    }
+
+    auto const numRemainingClusters = store.getMemoryUsage().numClusters;
+    EXPECT_EQ(200, numRemainingClusters + restoredData.numClusters);
+    EXPECT_EQ(numRemainingClusters, store.restoreAll(restoredData.getDataTO(), _capacity));
+    EXPECT_EQ(200, restoredData.numClusters);
+    for (int coldBlock : store.getColdBlocks()) {
+        EXPECT_EQ(0, coldBlock);
+    }
+}
+
+TEST_F(ColdClusterStoreTest, testMemoryAccounting)
+{
+    auto data = createTransferData();
+    for (int i = 0; i < 50; ++i) {
+        addRandomCluster(data, i + 1, 20, 2);
+    }
+    ColdClusterStore store(_universeSize);
+    store.evict(data.getDataTO());
+    store.evict(data.getDataTO());  //evicting a cluster twice replaces the record
+
+    auto const usage = store.getMemoryUsage();
+    EXPECT_EQ(50, usage.numClusters);
+    EXPECT_EQ(50 * 20, usage.numCells);
+    EXPECT_EQ(50 * 2, usage.numTokens);
+    EXPECT_EQ(data.numStringBytes, usage.numStringBytes);
+    EXPECT_EQ(
+        50 * sizeof(ClusterAccessTO) + 50 * 20 * sizeof(CellAccessTO) + 50 * 2 * sizeof(TokenAccessTO)
+            + data.numStringBytes,
+        usage.numUncompressedBytes);
+    EXPECT_LT(usage.numBytes * 3, usage.numUncompressedBytes);
+
+    store.clear();
+    EXPECT_EQ(0, store.getMemoryUsage().numClusters);
+    EXPECT_EQ(0, store.getMemoryUsage().numUncompressedBytes);
+}
+
+TEST_F(ColdClusterStoreTest, testRestoreRespectsCapacity)
+{
+    auto data = createTransferData();
+    for (int i = 0; i < 10; ++i) {
+        addRandomCluster(data, i + 1, 100, 0);
+    }
+    ColdClusterStore store(_universeSize);
+    store.evict(data.getDataTO());
+
+    //the capacity limits the number fields including the existing content
+    auto capacity = _capacity;
+    capacity.numCells = 355;
+    auto restoredData = createTransferData();
+    addRandomCluster(restoredData, 1000, 5, 0);
+    EXPECT_EQ(3, store.restoreAll(restoredData.getDataTO(), capacity));
+    EXPECT_EQ(305, restoredData.numCells);
+    EXPECT_EQ(7, store.getMemoryUsage().numClusters);
+}
+
+TEST_F(ColdClusterStoreTest, testCopyByRect)
+{
+    auto data = createTransferData();
+    for (int i = 0; i < 200; ++i) {
+        addRandomCluster(data, i + 1, 1 + _random.getUInt(10), _random.getUInt(3));
+    }
+    ColdClusterStore store(_universeSize);
+    store.evict(data.getDataTO());
+
+    IntVector2D const rectUpperLeft{100, 50};
+    IntVector2D const rectLowerRight{399, 249};
+    set<uint64_t> expectedClusterIds;
+    for (int i = 0; i < data.numClusters; ++i) {
+        if (hasCellInRect(data, data.clusters[i], rectUpperLeft, rectLowerRight)) {
+            expectedClusterIds.insert(data.clusters[i].id);
+        }
+    }
+    ASSERT_LT(0, expectedClusterIds.size());
+
+    //copies in portions of at most 7 clusters
+    auto capacity = _capacity;
+    capacity.numClusters = 7;
+    set<uint64_t> clusterIds;
+    int position = 0;
+    bool complete = false;
+    while (!complete) {
+        auto copiedData = createTransferData();
+        complete = store.copy(
+            rectUpperLeft, rectLowerRight, copiedData.getDataTO(), capacity, Enums::DataProjection::ALL, position);
+        EXPECT_LT(0, copiedData.numClusters);
+        EXPECT_GE(7, copiedData.numClusters);
+        for (int i = 0; i < copiedData.numClusters; ++i) {
+            EXPECT_TRUE(clusterIds.insert(copiedData.clusters[i].id).second);
+        }
+    }
+    EXPECT_EQ(expectedClusterIds, clusterIds);
+    EXPECT_EQ(200, store.getMemoryUsage().numClusters);
+
+    auto copiedData = createTransferData();
+    position = 0;
+    EXPECT_TRUE(store.copy(
+        rectUpperLeft, rectLowerRight, copiedData.getDataTO(), _capacity, Enums::DataProjection::ALL, position));
+    checkEquality(copiedData, data);
+}
+
+TEST_F(ColdClusterStoreTest, testCopyWithProjection)
+{
+    auto data = createTransferData();
+    for (int i = 0; i < 20; ++i) {
+        addRandomCluster(data, i + 1, 5, 2);
+    }
+    ColdClusterStore store(_universeSize);
+    store.evict(data.getDataTO());
+
+    auto copiedData = createTransferData();
+    int position = 0;
+    EXPECT_TRUE(store.copy(
+        {0, 0},
+        {_universeSize.x - 1, _universeSize.y - 1},
+        copiedData.getDataTO(),
+        _capacity,
+        Enums::DataProjection::ENERGIES,
+        position));
+    EXPECT_EQ(20, copiedData.numClusters);
+    EXPECT_EQ(20 * 5, copiedData.numCells);
+    EXPECT_EQ(0, copiedData.numTokens);
+    EXPECT_EQ(0, copiedData.numStringBytes);
+    for (int i = 0; i < copiedData.numClusters; ++i) {
+        EXPECT_EQ(0, copiedData.clusters[i].numTokens);
+        EXPECT_EQ(0, copiedData.clusters[i].metadata.nameLen);
+    }
+    for (int i = 0; i < copiedData.numCells; ++i) {
+        EXPECT_EQ(0, copiedData.cells[i].numConnections);
+        EXPECT_EQ(0, copiedData.cells[i].metadata.nameLen);
+    }
+}
+
+TEST_F(ColdClusterStoreTest, testRemoveByRect)
+{
+    auto data = createTransferData();
+    for (int i = 0; i < 200; ++i) {
+        addRandomCluster(data, i + 1, 1 + _random.getUInt(10), 0);
+    }
+    ColdClusterStore store(_universeSize);
+    store.evict(data.getDataTO());
+
+    IntVector2D const rectUpperLeft{100, 50};
+    IntVector2D const rectLowerRight{399, 249};
+    auto const numRemovedClusters = store.remove(rectUpperLeft, rectLowerRight);
+    EXPECT_LT(0, numRemovedClusters);
+    EXPECT_EQ(200, numRemovedClusters + store.getMemoryUsage().numClusters);
+
+    auto restoredData = createTransferData();
+    store.restoreAll(restoredData.getDataTO(), _capacity);
+    EXPECT_EQ(200, numRemovedClusters + restoredData.numClusters);
+    for (int i = 0; i < restoredData.numClusters; ++i) {
+        EXPECT_FALSE(hasCellInRect(restoredData, restoredData.clusters[i], rectUpperLeft, rectLowerRight));
+    }
+}
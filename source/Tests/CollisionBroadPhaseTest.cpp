@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+#include "ModelGpu/CollisionBroadPhase.h"
+
+class CollisionBroadPhaseTest : public ::testing::Test
+{
+public:
+    CollisionBroadPhaseTest();
+    virtual ~CollisionBroadPhaseTest() = default;
+
+protected:
+    struct Cluster
+    {
+        float posX;
+        float posY;
+        vector<std::pair<float, float>> cellPositions;
+    };
+    vector<Cluster> createRandomClusters(int numClusters, float maxRadius);
+    BoundingCircle calcBoundingCircle(Cluster const& cluster) const;
+    float calcMapDelta(float delta, int universeSize) const;
+
+    //reproduces the cell map lookups of the collision handling: a cluster is involved in a collision check if one of
+    //its cells finds a cell of another cluster at one of the four map positions around it
+    vector<bool> calcClustersWithContactByCellMap(vector<Cluster> const& clusters) const;
+
+    vector<bool> calcCandidatesByBruteForce(vector<BoundingCircle> const& circles) const;
+
+    //universe size is no multiple of the section size
+    int const _universeSizeX = 600;
+    int const _universeSizeY = 410;
+    int const _sectionSize = 16;
+    float const _margin = 3.0f;
+    HostCollisionBroadPhase _broadPhase;
+    RandomStream _random;
+};
+
+CollisionBroadPhaseTest::CollisionBroadPhaseTest()
+    : _broadPhase(_universeSizeX, _universeSizeY, _sectionSize, _margin)
+    , _random(1, 0)
+{}
+
+auto CollisionBroadPhaseTest::createRandomClusters(int numClusters, float maxRadius) -> vector<Cluster>
+{
+    vector<Cluster> result;
+    for (int i = 0; i < numClusters; ++i) {
+        Cluster cluster;
+        cluster.posX = _random.getFloat() * _universeSizeX;
+        cluster.posY = _random.getFloat() * _universeSizeY;
+        auto const radius = _random.getFloat() * maxRadius;
+        auto const numCells = 1 + static_cast<int>(_random.getUInt(20));
+        for (int j = 0; j < numCells; ++j) {
+            auto const x = cluster.posX + (_random.getFloat() * 2 - 1) * radius;
+            auto const y = cluster.posY + (_random.getFloat() * 2 - 1) * radius;
+            cluster.cellPositions.emplace_back(
+                x - std::floor(x / _universeSizeX) * _universeSizeX, y - std::floor(y / _universeSizeY) * _universeSizeY);
+        }
+        result.emplace_back(cluster);
+    }
+    return result;
+}
+
+BoundingCircle CollisionBroadPhaseTest::calcBoundingCircle(Cluster const& cluster) const
+{
+    float radius = 0;
+    for (auto const& cellPos : cluster.cellPositions) {
+        auto const deltaX = calcMapDelta(cellPos.first - cluster.posX, _universeSizeX);
+        auto const deltaY = calcMapDelta(cellPos.second - cluster.posY, _universeSizeY);
+        radius = std::max(radius, std::sqrt(deltaX * deltaX + deltaY * deltaY));
+    }
+    return {cluster.posX, cluster.posY, radius};
+}
+
+float CollisionBroadPhaseTest::calcMapDelta(float delta, int universeSize) const
+{
+    delta = std::abs(delta);
+    return std::min(delta, universeSize - delta);
+}
+
+vector<bool> CollisionBroadPhaseTest::calcClustersWithContactByCellMap(vector<Cluster> const& clusters) const
+{
+    vector<int> map(_universeSizeX * _universeSizeY, -1);
+    for (int index = 0; index < static_cast<int>(clusters.size()); ++index) {
+        for (auto const& cellPos : clusters[index].cellPositions) {
+            map[static_cast<int>(cellPos.first) + static_cast<int>(cellPos.second) * _universeSizeX] = index;
+        }
+    }
+
+    vector<bool> result(clusters.size(), false);
+    for (int index = 0; index < static_cast<int>(clusters.size()); ++index) {
+        for (auto const& cellPos : clusters[index].cellPositions) {
+            for (float dx = -0.5f; dx < 0.51f; dx += 1.0f) {
+                for (float dy = -0.5f; dy < 0.51f; dy += 1.0f) {
+                    auto const x = static_cast<int>(std::floor(cellPos.first + dx) + _universeSizeX) % _universeSizeX;
+                    auto const y = static_cast<int>(std::floor(cellPos.second + dy) + _universeSizeY) % _universeSizeY;
+                    auto const otherIndex = map[x + y * _universeSizeX];
+                    if (-1 != otherIndex && otherIndex != index) {
+                        result[index] = true;
+                        result[otherIndex] = true;
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+vector<bool> CollisionBroadPhaseTest::calcCandidatesByBruteForce(vector<BoundingCircle> const& circles) const
+{
+    vector<bool> result(circles.size(), false);
+    for (int i = 0; i < static_cast<int>(circles.size()); ++i) {
+        for (int j = 0; j < static_cast<int>(circles.size()); ++j) {
+            if (i != j && _broadPhase.getLayout().overlaps(circles[i], circles[j])) {
+                result[i] = true;
+            }
+        }
+    }
+    return result;
+}
+
+TEST_F(CollisionBroadPhaseTest, testEqualsBruteForce)
+{
+    for (float maxRadius : {0.0f, 5.0f, 30.0f, 100.0f}) {
+        vector<BoundingCircle> circles;
+        for (auto const& cluster : createRandomClusters(1000, maxRadius)) {
+            circles.emplace_back(calcBoundingCircle(cluster));
+        }
+        ASSERT_EQ(calcCandidatesByBruteForce(circles), _broadPhase.calcCandidates(circles));
+    }
+}
+
+TEST_F(CollisionBroadPhaseTest, testOverlapAcrossMapBorders)
+{
+    vector<BoundingCircle> circles{
+        {1.0f, 1.0f, 2.0f}, {_universeSizeX - 1.0f, _universeSizeY - 1.0f, 2.0f}, {300.0f, 200.0f, 2.0f}};
+    EXPECT_EQ(vector<bool>({true, true, false}), _broadPhase.calcCandidates(circles));
+}
+
+TEST_F(CollisionBroadPhaseTest, testCandidatesContainAllClustersWithContact)
+{
+    for (float maxRadius : {2.0f, 10.0f, 40.0f}) {
+        auto const clusters = createRandomClusters(500, maxRadius);
+        vector<BoundingCircle> circles;
+        for (auto const& cluster : clusters) {
+            circles.emplace_back(calcBoundingCircle(cluster));
+        }
+        auto const withContact = calcClustersWithContactByCellMap(clusters);
+        auto const candidates = _broadPhase.calcCandidates(circles);
+        for (int index = 0; index < static_cast<int>(clusters.size()); ++index) {
+            if (withContact[index]) {
+                ASSERT_TRUE(candidates[index]);
+            }
+        }
+    }
+}
+
+TEST_F(CollisionBroadPhaseTest, testSparseWorldHasNoCandidates)
+{
+    vector<BoundingCircle> circles;
+    for (int x = 0; x < 10; ++x) {
+        for (int y = 0; y < 10; ++y) {
+            circles.push_back({x * 60.0f + 30.0f, y * 41.0f + 20.0f, 10.0f});
+        }
+    }
+    for (bool candidate : _broadPhase.calcCandidates(circles)) {
+        EXPECT_FALSE(candidate);
+    }
+}
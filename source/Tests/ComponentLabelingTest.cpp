@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <deque>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+#include "ModelGpu/ComponentLabeling.h"
+
+class ComponentLabelingTest : public ::testing::Test
+{
+public:
+    ComponentLabelingTest();
+    virtual ~ComponentLabelingTest() = default;
+
+protected:
+    using Edges = vector<std::pair<int, int>>;
+
+    //reference labels by breadth-first search, label is the smallest node index of the component
+    vector<int> calcLabelsByBfs(int numNodes, Edges const& edges) const;
+    void shuffle(Edges& edges);
+
+    HostComponentLabeling _labeling;
+    RandomStream _random;
+};
+
+ComponentLabelingTest::ComponentLabelingTest()
+    : _random(1, 0)
+{}
+
+vector<int> ComponentLabelingTest::calcLabelsByBfs(int numNodes, Edges const& edges) const
+{
+    vector<vector<int>> adjacentNodes(numNodes);
+    for (auto const& edge : edges) {
+        adjacentNodes[edge.first].emplace_back(edge.second);
+        adjacentNodes[edge.second].emplace_back(edge.first);
+    }
+    vector<int> result(numNodes, -1);
+    for (int startNode = 0; startNode < numNodes; ++startNode) {
+        if (-1 != result[startNode]) {
+            continue;
+        }
+        result[startNode] = startNode;
+        std::deque<int> nodesToEvaluate{startNode};
+        while (!nodesToEvaluate.empty()) {
+            auto const node = nodesToEvaluate.front();
+            nodesToEvaluate.pop_front();
+            for (auto const& adjacentNode : adjacentNodes[node]) {
+                if (-1 == result[adjacentNode]) {
+                    result[adjacentNode] = startNode;
+                    nodesToEvaluate.emplace_back(adjacentNode);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+void ComponentLabelingTest::shuffle(Edges& edges)
+{
+    for (int index = static_cast<int>(edges.size()) - 1; index > 0; --index) {
+        std::swap(edges[index], edges[_random.getUInt(index + 1)]);
+    }
+}
+
+TEST_F(ComponentLabelingTest, testLongChain)
+{
+    int const numNodes = 100000;
+    Edges edges;
+    for (int index = numNodes - 1; index > 0; --index) {
+        edges.emplace_back(index, index - 1);
+    }
+    auto const labels = _labeling.calcLabels(numNodes, edges);
+    for (int index = 0; index < numNodes; ++index) {
+        ASSERT_EQ(0, labels[index]);
+    }
+}
+
+TEST_F(ComponentLabelingTest, testGridCutIntoHalves)
+{
+    int const size = 200;
+    Edges edges;
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            if (x + 1 < size && x + 1 != size / 2) {
+                edges.emplace_back(x + y * size, x + 1 + y * size);
+            }
+            if (y + 1 < size) {
+                edges.emplace_back(x + y * size, x + (y + 1) * size);
+            }
+        }
+    }
+    shuffle(edges);
+    auto const labels = _labeling.calcLabels(size * size, edges);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            ASSERT_EQ(x < size / 2 ? 0 : size / 2, labels[x + y * size]);
+        }
+    }
+}
+
+TEST_F(ComponentLabelingTest, testManyFragments)
+{
+    int const numNodes = 30000;
+    Edges edges;
+    for (int index = 0; index + 2 < numNodes; index += 3) {
+        edges.emplace_back(index + 2, index);
+        edges.emplace_back(index + 1, index + 2);
+    }
+    shuffle(edges);
+    auto const labels = _labeling.calcLabels(numNodes, edges);
+    for (int index = 0; index < numNodes; ++index) {
+        ASSERT_EQ(index / 3 * 3, labels[index]);
+    }
+}
+
+TEST_F(ComponentLabelingTest, testRandomGraphsEqualBfs)
+{
+    for (int i = 0; i < 20; ++i) {
+        auto const numNodes = 1 + static_cast<int>(_random.getUInt(2000));
+        auto const numEdges = static_cast<int>(_random.getUInt(numNodes * 2));
+        Edges edges;
+        for (int j = 0; j < numEdges; ++j) {
+            edges.emplace_back(_random.getUInt(numNodes), _random.getUInt(numNodes));
+        }
+        ASSERT_EQ(calcLabelsByBfs(numNodes, edges), _labeling.calcLabels(numNodes, edges));
+    }
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/ServiceLocator.h"
+#include "Base/GlobalFactory.h"
+#include "Base/NumberGenerator.h"
+#include "ModelBasic/ChangeDescriptions.h"
+#include "ModelBasic/Descriptions.h"
+#include "ModelBasic/ModelBasicSettings.h"
+#include "ModelGpu/DataConverter.h"
+
+#include "TransferData.h"
+
+class DataProjectionTest : public ::testing::Test
+{
+public:
+    DataProjectionTest();
+    virtual ~DataProjectionTest();
+
+protected:
+
+    //chain of connected computer cells with a token on the first cell
+    ClusterDescription createCluster(int numCells) const;
+
+    NumberGenerator* _numberGen = nullptr;
+    SimulationParameters _parameters;
+};
+
+DataProjectionTest::DataProjectionTest()
+    : _parameters(ModelBasicSettings::getDefaultSimulationParameters())
+{
+    auto factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+    _numberGen = factory->buildRandomNumberGenerator();
+    _numberGen->init();
+}
+
+DataProjectionTest::~DataProjectionTest()
+{
+    delete _numberGen;
+}
+
+ClusterDescription DataProjectionTest::createCluster(int numCells) const
+{
+    auto result = ClusterDescription()
+                      .setId(_numberGen->getId())
+                      .setPos({100, 100})
+                      .setVel({0.5f, 0})
+                      .setAngle(0)
+                      .setAngularVel(0)
+                      .setMetadata(ClusterMetadata().setName("chain"));
+    vector<uint64_t> cellIds;
+    for (int index = 0; index < numCells; ++index) {
+        cellIds.emplace_back(_numberGen->getId());
+    }
+    for (int index = 0; index < numCells; ++index) {
+        list<uint64_t> connectingCellIds;
+        if (index > 0) {
+            connectingCellIds.emplace_back(cellIds[index - 1]);
+        }
+        if (index < numCells - 1) {
+            connectingCellIds.emplace_back(cellIds[index + 1]);
+        }
+        auto cell = CellDescription()
+                        .setId(cellIds[index])
+                        .setPos({100, 100.0f + index})
+                        .setEnergy(100)
+                        .setMaxConnections(2)
+                        .setConnectingCells(connectingCellIds)
+                        .setTokenBranchNumber(index)
+                        .setFlagTokenBlocked(false)
+                        .setTokenUsages(0)
+                        .setCellFeature(CellFeatureDescription().setType(Enums::CellFunction::COMPUTER))
+                        .setMetadata(CellMetadata().setName("cell").setColor(1));
+        if (0 == index) {
+            cell.addToken(TokenDescription().setEnergy(30).setData(QByteArray(_parameters.tokenMemorySize, 0)));
+        }
+        result.addCell(cell);
+    }
+    return result;
+}
+
+TEST_F(DataProjectionTest, testPrefixSizes)
+{
+    EXPECT_EQ(sizeof(CellAccessTO), getCellAccessTOPrefixSize(Enums::DataProjection::ALL));
+
+    //position-only reads transfer a fraction of the cell data
+    auto const positionsSize = getCellAccessTOPrefixSize(Enums::DataProjection::POSITIONS);
+    EXPECT_EQ(sizeof(uint64_t) + sizeof(float2), positionsSize);
+    EXPECT_LT(positionsSize * 4, sizeof(CellAccessTO));
+
+    auto previousSize = positionsSize;
+    for (auto const projection : {Enums::DataProjection::ENERGIES,
+                                  Enums::DataProjection::CELL_CONNECTIONS,
+                                  Enums::DataProjection::METADATA,
+                                  Enums::DataProjection::CELL_FUNCTION_DATA}) {
+        auto const size = getCellAccessTOPrefixSize(projection);
+        EXPECT_LT(previousSize, size);
+        previousSize = size;
+    }
+}
+
+TEST_F(DataProjectionTest, testPositionsOnly)
+{
+    DataDescription data;
+    data.addCluster(createCluster(5));
+    data.addParticle(ParticleDescription().setId(_numberGen->getId()).setPos({10, 10}).setVel({1, 0}).setEnergy(50));
+
+    TransferData transferData(10, 100, 10, 10, 10000);
+    auto dataTO = transferData.getDataTO();
+    DataConverter(dataTO, _numberGen, _parameters, {1000, 1000}).updateData(DataChangeDescription(data));
+
+    auto const convertedData = DataConverter(dataTO, _numberGen, _parameters, {1000, 1000})
+                                   .getDataDescription(Enums::DataProjection::POSITIONS);
+
+    ASSERT_EQ(1, convertedData.clusters->size());
+    auto const& cluster = convertedData.clusters->front();
+    EXPECT_EQ(data.clusters->front().id, cluster.id);
+    EXPECT_FALSE(cluster.vel);
+    EXPECT_FALSE(cluster.metadata);
+    ASSERT_EQ(5, cluster.cells->size());
+    for (int index = 0; index < 5; ++index) {
+        auto const& cell = cluster.cells->at(index);
+        EXPECT_EQ(data.clusters->front().cells->at(index).id, cell.id);
+        EXPECT_EQ(QVector2D(100, 100.0f + index), *cell.pos);
+        EXPECT_FALSE(cell.energy);
+        EXPECT_FALSE(cell.connectingCells);
+        EXPECT_FALSE(cell.metadata);
+        EXPECT_FALSE(cell.cellFeature);
+        EXPECT_FALSE(cell.tokens);
+    }
+
+    ASSERT_EQ(1, convertedData.particles->size());
+    auto const& particle = convertedData.particles->front();
+    EXPECT_EQ(QVector2D(10, 10), *particle.pos);
+    EXPECT_FALSE(particle.vel);
+    EXPECT_FALSE(particle.energy);
+}
+
+TEST_F(DataProjectionTest, testConnectionsAndMetadata)
+{
+    DataDescription data;
+    data.addCluster(createCluster(5));
+
+    TransferData transferData(10, 100, 10, 10, 10000);
+    auto dataTO = transferData.getDataTO();
+    DataConverter(dataTO, _numberGen, _parameters, {1000, 1000}).updateData(DataChangeDescription(data));
+
+    auto const projection = Enums::DataProjection::CELL_CONNECTIONS | Enums::DataProjection::METADATA;
+    auto const convertedData =
+        DataConverter(dataTO, _numberGen, _parameters, {1000, 1000}).getDataDescription(projection);
+
+    auto const& cluster = convertedData.clusters->front();
+    EXPECT_EQ(QString("chain"), cluster.metadata->name);
+    for (int index = 0; index < 5; ++index) {
+        auto const& expectedCell = data.clusters->front().cells->at(index);
+        auto const& cell = cluster.cells->at(index);
+        EXPECT_EQ(*expectedCell.connectingCells, *cell.connectingCells);
+        EXPECT_EQ(index, *cell.tokenBranchNumber);
+        EXPECT_EQ(*expectedCell.metadata, *cell.metadata);
+        EXPECT_FALSE(cell.energy);
+        EXPECT_FALSE(cell.cellFeature);
+        EXPECT_FALSE(cell.tokens);
+    }
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include "Base/ServiceLocator.h"
+#include "Base/GlobalFactory.h"
+#include "Base/NumberGenerator.h"
+#include "ModelBasic/DescriptionReplicator.h"
+
+class DescriptionReplicatorTest : public ::testing::Test
+{
+public:
+    DescriptionReplicatorTest();
+    ~DescriptionReplicatorTest();
+
+protected:
+    DataDescription createTemplate() const;
+
+    NumberGenerator* _numberGen = nullptr;
+};
+
+DescriptionReplicatorTest::DescriptionReplicatorTest()
+{
+    GlobalFactory* factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+    _numberGen = factory->buildRandomNumberGenerator();
+    _numberGen->init(123, 0);
+}
+
+DescriptionReplicatorTest::~DescriptionReplicatorTest()
+{
+    delete _numberGen;
+}
+
+//cluster with a chain of three cells and one particle, ids are arbitrary
+DataDescription DescriptionReplicatorTest::createTemplate() const
+{
+    ClusterDescription cluster;
+    cluster.setId(1000).setPos({1, 0}).setVel({0.5, 0}).setAngle(0).setAngularVel(0);
+    cluster.addCell(CellDescription().setId(11).setPos({0, 0}).setConnectingCells({12}));
+    cluster.addCell(CellDescription().setId(12).setPos({1, 0}).setConnectingCells({11, 13}));
+    cluster.addCell(CellDescription().setId(13).setPos({2, 0}).setConnectingCells({12}));
+
+    DataDescription result;
+    result.addCluster(cluster);
+    result.addParticle(ParticleDescription().setId(2000).setPos({1, 0}).setVel({0, 0}).setEnergy(10));
+    return result;
+}
+
+TEST_F(DescriptionReplicatorTest, testIdsAndConnections)
+{
+    auto const templateData = createTemplate();
+    vector<DescriptionReplicator::Transform> transforms(1000);
+    for (int i = 0; i < transforms.size(); ++i) {
+        transforms.at(i).posDelta = QVector2D(i * 10, 0);
+    }
+
+    DescriptionReplicator replicator(_numberGen, 4);
+    auto const replicas = replicator.replicate(templateData, transforms);
+    ASSERT_EQ(1000, replicas.clusters->size());
+    ASSERT_EQ(1000, replicas.particles->size());
+
+    unordered_set<uint64_t> ids;
+    for (int i = 0; i < transforms.size(); ++i) {
+        auto const& cluster = replicas.clusters->at(i);
+        ids.insert(cluster.id);
+        unordered_map<uint64_t, int> cellIndexById;
+        for (int cellIndex = 0; cellIndex < 3; ++cellIndex) {
+            auto const& cell = cluster.cells->at(cellIndex);
+            ids.insert(cell.id);
+            cellIndexById.insert_or_assign(cell.id, cellIndex);
+            EXPECT_EQ(QVector2D(i * 10 + cellIndex, 0), *cell.pos);
+        }
+
+        //connections must point to the cells of the same copy
+        EXPECT_EQ(list<uint64_t>({cluster.cells->at(1).id}), *cluster.cells->at(0).connectingCells);
+        EXPECT_EQ(
+            list<uint64_t>({cluster.cells->at(0).id, cluster.cells->at(2).id}), *cluster.cells->at(1).connectingCells);
+        EXPECT_EQ(list<uint64_t>({cluster.cells->at(1).id}), *cluster.cells->at(2).connectingCells);
+
+        auto const& particle = replicas.particles->at(i);
+        ids.insert(particle.id);
+        EXPECT_EQ(QVector2D(i * 10 + 1, 0), *particle.pos);
+        EXPECT_EQ(10.0, *particle.energy);
+    }
+    EXPECT_EQ(5000, ids.size());
+
+    //reserved ids must not be handed out again
+    EXPECT_EQ(0, ids.count(_numberGen->getId()));
+}
+
+TEST_F(DescriptionReplicatorTest, testTransform)
+{
+    auto const templateData = createTemplate();
+    DescriptionReplicator::Transform transform;
+    transform.posDelta = QVector2D(100, 50);
+    transform.velDelta = QVector2D(0, 1);
+    transform.angularVelDelta = 2.0;
+    transform.angle = 90.0;
+
+    DescriptionReplicator replicator(_numberGen);
+    auto const replicas = replicator.replicate(templateData, {transform});
+
+    //rotation around the center (1, 0) of the template moved by posDelta
+    auto const& cluster = replicas.clusters->front();
+    EXPECT_NEAR(101.0, cluster.pos->x(), FLOATINGPOINT_MEDIUM_PRECISION);
+    EXPECT_NEAR(50.0, cluster.pos->y(), FLOATINGPOINT_MEDIUM_PRECISION);
+    EXPECT_NEAR(101.0, cluster.cells->at(0).pos->x(), FLOATINGPOINT_MEDIUM_PRECISION);
+    EXPECT_NEAR(49.0, cluster.cells->at(0).pos->y(), FLOATINGPOINT_MEDIUM_PRECISION);
+    EXPECT_NEAR(101.0, cluster.cells->at(2).pos->x(), FLOATINGPOINT_MEDIUM_PRECISION);
+    EXPECT_NEAR(51.0, cluster.cells->at(2).pos->y(), FLOATINGPOINT_MEDIUM_PRECISION);
+    EXPECT_EQ(QVector2D(0.5, 1), *cluster.vel);
+    EXPECT_EQ(90.0, *cluster.angle);
+    EXPECT_EQ(2.0, *cluster.angularVel);
+
+    auto const& particle = replicas.particles->front();
+    EXPECT_EQ(QVector2D(0, 1), *particle.vel);
+}
+
+TEST_F(DescriptionReplicatorTest, testParallelEqualsSequential)
+{
+    auto const templateData = createTemplate();
+    vector<DescriptionReplicator::Transform> transforms(777);
+    for (int i = 0; i < transforms.size(); ++i) {
+        transforms.at(i).posDelta = QVector2D(_numberGen->getRandomReal(0, 1000), _numberGen->getRandomReal(0, 1000));
+        transforms.at(i).angle = _numberGen->getRandomReal(0, 360);
+    }
+
+    _numberGen->init(1, 0);
+    auto const sequentialReplicas = DescriptionReplicator(_numberGen, 1).replicate(templateData, transforms);
+    _numberGen->init(1, 0);
+    auto const parallelReplicas = DescriptionReplicator(_numberGen, 8).replicate(templateData, transforms);
+
+    ASSERT_EQ(sequentialReplicas.clusters->size(), parallelReplicas.clusters->size());
+    for (int i = 0; i < sequentialReplicas.clusters->size(); ++i) {
+        auto const& expected = sequentialReplicas.clusters->at(i);
+        auto const& actual = parallelReplicas.clusters->at(i);
+        EXPECT_EQ(expected.id, actual.id);
+        EXPECT_EQ(*expected.pos, *actual.pos);
+        for (int cellIndex = 0; cellIndex < 3; ++cellIndex) {
+            EXPECT_EQ(expected.cells->at(cellIndex).id, actual.cells->at(cellIndex).id);
+            EXPECT_EQ(*expected.cells->at(cellIndex).pos, *actual.cells->at(cellIndex).pos);
+            EXPECT_EQ(*expected.cells->at(cellIndex).connectingCells, *actual.cells->at(cellIndex).connectingCells);
+        }
+    }
+}
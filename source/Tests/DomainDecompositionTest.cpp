@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/ServiceLocator.h"
+#include "ModelBasic/Descriptions.h"
+#include "ModelBasic/DomainDecomposition.h"
+#include "ModelBasic/ModelBasicBuilderFacade.h"
+#include "ModelBasic/Serializer.h"
+#include "ModelBasic/SubdomainExchange.h"
+
+class DomainDecompositionTest : public ::testing::Test
+{
+public:
+    DomainDecompositionTest() = default;
+    virtual ~DomainDecompositionTest() = default;
+
+protected:
+    ClusterDescription createCluster(uint64_t id, QVector2D const& pos, int numCells) const;
+    optional<QVector2D> findParticlePos(DataDescription const& data, uint64_t id) const;
+    bool containsCluster(DataDescription const& data, uint64_t id) const;
+    void exchange(vector<SubdomainExchange>& exchanges, vector<DataDescription>& localData, int timestep) const;
+};
+
+ClusterDescription DomainDecompositionTest::createCluster(uint64_t id, QVector2D const& pos, int numCells) const
+{
+    auto result = ClusterDescription().setId(id).setPos(pos).setVel({0, 0}).setAngle(0).setAngularVel(0);
+    for (int index = 0; index < numCells; ++index) {
+        result.addCell(CellDescription().setId(id * 100 + index).setPos(pos + QVector2D(index, 0)).setEnergy(100));
+    }
+    return result;
+}
+
+optional<QVector2D> DomainDecompositionTest::findParticlePos(DataDescription const& data, uint64_t id) const
+{
+    if (data.particles) {
+        for (auto const& particle : *data.particles) {
+            if (particle.id == id) {
+                return *particle.pos;
+            }
+        }
+    }
+    return boost::none;
+}
+
+bool DomainDecompositionTest::containsCluster(DataDescription const& data, uint64_t id) const
+{
+    if (data.clusters) {
+        for (auto const& cluster : *data.clusters) {
+            if (cluster.id == id) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void DomainDecompositionTest::exchange(
+    vector<SubdomainExchange>& exchanges,
+    vector<DataDescription>& localData,
+    int timestep) const
+{
+    vector<vector<SubdomainMessage>> receivedMessages(exchanges.size());
+    for (int rank = 0; rank < exchanges.size(); ++rank) {
+        for (auto const& rankAndMessage : exchanges.at(rank).split(localData.at(rank), timestep)) {
+            receivedMessages.at(rankAndMessage.first).emplace_back(rankAndMessage.second);
+        }
+    }
+    for (int rank = 0; rank < exchanges.size(); ++rank) {
+        exchanges.at(rank).merge(localData.at(rank), receivedMessages.at(rank));
+    }
+}
+
+TEST_F(DomainDecompositionTest, testSubdomainsCoverUniverse)
+{
+    DomainDecomposition decomposition({100, 60}, {3, 2}, 5);
+    EXPECT_EQ(6, decomposition.getNumSubdomains());
+
+    vector<int> numPositionsByRank(decomposition.getNumSubdomains(), 0);
+    for (int x = 0; x < 100; ++x) {
+        for (int y = 0; y < 60; ++y) {
+            auto const rank = decomposition.getRankOfPosition(QVector2D(x + 0.5f, y + 0.5f));
+            ASSERT_TRUE(decomposition.getSubdomainRect(rank).isContained({x, y}));
+            ++numPositionsByRank.at(rank);
+        }
+    }
+    for (int rank = 0; rank < decomposition.getNumSubdomains(); ++rank) {
+        auto const rect = decomposition.getSubdomainRect(rank);
+        EXPECT_EQ((rect.p2.x - rect.p1.x + 1) * (rect.p2.y - rect.p1.y + 1), numPositionsByRank.at(rank));
+    }
+    EXPECT_EQ(decomposition.getRankOfPosition(QVector2D(0.5f, 0.5f)), decomposition.getRankOfPosition(QVector2D(100.5f, -59.5f)));
+}
+
+TEST_F(DomainDecompositionTest, testNeighborsOnTorus)
+{
+    EXPECT_EQ(8, DomainDecomposition({300, 300}, {3, 3}, 10).getNeighborRanks(4).size());
+    EXPECT_EQ(8, DomainDecomposition({300, 300}, {3, 3}, 10).getNeighborRanks(0).size());
+    EXPECT_EQ(3, DomainDecomposition({200, 200}, {2, 2}, 10).getNeighborRanks(0).size());
+    EXPECT_EQ(vector<int>{1}, DomainDecomposition({200, 100}, {2, 1}, 10).getNeighborRanks(0));
+    EXPECT_TRUE(DomainDecomposition({200, 100}, {1, 1}, 10).getNeighborRanks(0).empty());
+}
+
+TEST_F(DomainDecompositionTest, testLocalCoordinates)
+{
+    DomainDecomposition decomposition({100, 100}, {2, 2}, 10);
+    EXPECT_EQ(70, decomposition.getLocalUniverseSize(0).x);
+
+    EXPECT_EQ(QVector2D(15, 15), decomposition.toLocalPosition(0, QVector2D(5, 5)));
+    EXPECT_EQ(QVector2D(5, 15), decomposition.toLocalPosition(0, QVector2D(95, 5)));
+    EXPECT_EQ(QVector2D(95, 5), decomposition.toGlobalPosition(0, QVector2D(5, 15)));
+    EXPECT_EQ(QVector2D(60.5f, 70.25f), decomposition.toGlobalPosition(3, decomposition.toLocalPosition(3, QVector2D(60.5f, 70.25f))));
+
+    EXPECT_TRUE(decomposition.isInHalo(0, QVector2D(95, 5)));
+    EXPECT_TRUE(decomposition.isInHalo(0, QVector2D(55, 55)));
+    EXPECT_FALSE(decomposition.isInHalo(0, QVector2D(5, 5)));
+    EXPECT_FALSE(decomposition.isInHalo(0, QVector2D(75, 5)));
+}
+
+TEST_F(DomainDecompositionTest, testGhostsAndMigration)
+{
+    DomainDecomposition decomposition({100, 50}, {2, 1}, 10);
+    DataDescription globalData;
+    globalData.addParticle(ParticleDescription().setId(1).setPos({45, 10}).setVel({0, 0}).setEnergy(10));
+    globalData.addParticle(ParticleDescription().setId(2).setPos({20, 10}).setVel({0, 0}).setEnergy(10));
+    globalData.addCluster(createCluster(3, {98, 20}, 2));
+    globalData.addCluster(createCluster(4, {55, 30}, 2));
+
+    vector<SubdomainExchange> exchanges{{decomposition, 0}, {decomposition, 1}};
+    vector<DataDescription> localData{exchanges[0].extractOwnedData(globalData), exchanges[1].extractOwnedData(globalData)};
+    EXPECT_EQ(2, localData[0].particles->size());
+    EXPECT_FALSE(localData[0].clusters);
+    EXPECT_TRUE(containsCluster(localData[1], 3));
+
+    exchange(exchanges, localData, 0);
+    EXPECT_TRUE(containsCluster(exchanges[0].getGhosts(), 3));      //ghost across the wrap-around
+    EXPECT_TRUE(containsCluster(exchanges[0].getGhosts(), 4));
+    EXPECT_FALSE(containsCluster(localData[0], 3));
+    EXPECT_FALSE(exchanges[1].getGhosts().clusters);
+    EXPECT_FALSE(findParticlePos(localData[1], 1));     //particles are not sent as ghosts
+    EXPECT_EQ(2, SubdomainExchange::calcLoad(exchanges[1].getGlobalOwnedData(localData[1])).numClusters);
+
+    //particle 1 crosses the boundary to subdomain 1 and cluster 4 to subdomain 0
+    for (auto& particle : *localData[0].particles) {
+        if (particle.id == 1) {
+            particle.pos = *particle.pos + QVector2D(7, 0);
+        }
+    }
+    for (auto& cluster : *localData[1].clusters) {
+        if (cluster.id == 4) {
+            cluster.pos = *cluster.pos - QVector2D(7, 0);
+            for (auto& cell : *cluster.cells) {
+                cell.pos = *cell.pos - QVector2D(7, 0);
+            }
+        }
+    }
+    exchange(exchanges, localData, 1);
+    EXPECT_FALSE(findParticlePos(localData[0], 1));
+    EXPECT_EQ(QVector2D(52, 10), *findParticlePos(exchanges[1].getGlobalOwnedData(localData[1]), 1));
+    EXPECT_TRUE(containsCluster(localData[0], 4));
+    EXPECT_FALSE(containsCluster(exchanges[0].getGhosts(), 4));
+    EXPECT_FALSE(containsCluster(localData[1], 4));
+    EXPECT_TRUE(containsCluster(exchanges[1].getGhosts(), 4));      //emigrated but still in the halo
+    EXPECT_TRUE(containsCluster(exchanges[0].getGhosts(), 3));
+
+    auto const cellPositions = *exchanges[1].getGlobalOwnedData(localData[1]).clusters->front().cells;
+    EXPECT_EQ(QVector2D(98, 20), *cellPositions.at(0).pos);
+    EXPECT_EQ(QVector2D(99, 20), *cellPositions.at(1).pos);
+}
+
+TEST_F(DomainDecompositionTest, testMessageEncoding)
+{
+    auto const facade = ServiceLocator::getInstance().getService<ModelBasicBuilderFacade>();
+    auto const serializer = facade->buildSerializer();
+
+    SubdomainMessage message;
+    message.fromRank = 2;
+    message.timestep = 17;
+    message.load.rank = 2;
+    message.load.numCells = 123;
+    message.load.calculationTime = 1.5;
+    message.migrants.addCluster(createCluster(1, {10, 10}, 3));
+    message.ghosts.addCluster(createCluster(2, {20, 10}, 1));
+
+    auto const decodedMessage =
+        SubdomainExchange::decodeMessage(SubdomainExchange::encodeMessage(message, serializer), serializer);
+    EXPECT_EQ(2, decodedMessage.fromRank);
+    EXPECT_EQ(17, decodedMessage.timestep);
+    EXPECT_EQ(123, decodedMessage.load.numCells);
+    EXPECT_EQ(1.5, decodedMessage.load.calculationTime);
+    EXPECT_EQ(3, decodedMessage.migrants.clusters->front().cells->size());
+    EXPECT_FALSE(decodedMessage.migrants.particles);
+    EXPECT_EQ(QVector2D(20, 10), *decodedMessage.ghosts.clusters->front().pos);
+    delete serializer;
+}
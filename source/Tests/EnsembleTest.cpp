@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+#include "ModelGpu/Ensemble.h"
+
+namespace
+{
+    /**
+     * Emulates the constant memory and the default stream of the device: kernels read the constant memory when they
+     * are executed, i.e. at the next synchronization. A blocking upload (cudaMemcpyToSymbol) waits for all pending
+     * operations, an asynchronous upload is enqueued as the kernel launches.
+     */
+    struct Device
+    {
+        static double constantMemory;
+        static vector<std::function<void()>> pendingOperations;
+        static int numHostWaits;
+
+        static void synchronize()
+        {
+            if (!pendingOperations.empty()) {
+                ++numHostWaits;
+            }
+            for (auto const& operation : pendingOperations) {
+                operation();
+            }
+            pendingOperations.clear();
+        }
+
+        static void uploadBlocking(double value)
+        {
+            synchronize();
+            constantMemory = value;
+        }
+
+        static void uploadAsync(double value)
+        {
+            pendingOperations.emplace_back([value]() { constantMemory = value; });
+        }
+
+        static double readConstantMemory()
+        {
+            synchronize();
+            return constantMemory;
+        }
+    };
+    double Device::constantMemory = 0;
+    vector<std::function<void()>> Device::pendingOperations;
+    int Device::numHostWaits = 0;
+
+    class TestUniverse
+    {
+    public:
+        TestUniverse(int numParticles, double parameter, uint32_t seed, int timestep)
+            : _parameter(parameter), _random(seed, 0), _timestep(timestep)
+        {
+            for (int i = 0; i < numParticles; ++i) {
+                _particles.emplace_back(_random.getUInt(1000));
+            }
+            Device::uploadBlocking(_parameter);     //as the constructor of CudaSimulation
+        }
+
+        void activate() { Device::uploadAsync(_parameter); }
+
+        void launchTimestep()
+        {
+            auto const timestep = _timestep++;
+            Device::pendingOperations.emplace_back([this, timestep]() {
+                auto const parameter = Device::constantMemory;
+                for (auto& particle : _particles) {
+                    particle = particle * parameter + _random.getUInt(100) + timestep;
+                    particle -= static_cast<double>(static_cast<int64_t>(particle / 1000)) * 1000;
+                }
+            });
+        }
+
+        static void synchronize() { Device::synchronize(); }
+
+        void setParameter(double parameter)
+        {
+            _parameter = parameter;
+            Device::uploadBlocking(_parameter);     //as CudaSimulation::setSimulationParameters
+        }
+
+        int getTimestep() const { return _timestep; }
+        vector<double> const& getParticles() const
+        {
+            Device::synchronize();
+            return _particles;
+        }
+
+    private:
+        double _parameter;
+        RandomStream _random;
+        int _timestep;
+        vector<double> _particles;
+    };
+}
+
+class EnsembleTest : public ::testing::Test
+{
+public:
+    EnsembleTest();
+    virtual ~EnsembleTest() = default;
+
+protected:
+    struct Config
+    {
+        int numParticles;
+        double parameter;
+        uint32_t seed;
+        int timestep;
+    };
+    vector<Config> createRandomConfigs(int numConfigs);
+    TestUniverse* createUniverse(Config const& config) const;
+
+    vector<double> runAlone(Config const& config, int numTimesteps) const;
+
+    RandomStream _random;
+};
+
+EnsembleTest::EnsembleTest()
+    : _random(1, 0)
+{
+    Device::pendingOperations.clear();
+    Device::numHostWaits = 0;
+}
+
+vector<EnsembleTest::Config> EnsembleTest::createRandomConfigs(int numConfigs)
+{
+    vector<Config> result;
+    for (int i = 0; i < numConfigs; ++i) {
+        result.push_back({1 + static_cast<int>(_random.getUInt(49)),
+                          1.0 + _random.getDouble(),
+                          _random.getUInt(),
+                          static_cast<int>(_random.getUInt(10000))});
+    }
+    return result;
+}
+
+TestUniverse* EnsembleTest::createUniverse(Config const& config) const
+{
+    return new TestUniverse(config.numParticles, config.parameter, config.seed, config.timestep);
+}
+
+vector<double> EnsembleTest::runAlone(Config const& config, int numTimesteps) const
+{
+    Ensemble<TestUniverse> ensemble;
+    ensemble.add(createUniverse(config));
+    ensemble.calcTimesteps(numTimesteps);
+    return ensemble.getActivatedMember(0).getParticles();
+}
+
+TEST_F(EnsembleTest, testEnsembleEqualsSingleRuns)
+{
+    int const numTimesteps = 50;
+    auto const configs = createRandomConfigs(100);
+
+    Ensemble<TestUniverse> ensemble;
+    for (auto const& config : configs) {
+        ensemble.add(createUniverse(config));
+    }
+    ensemble.calcTimesteps(numTimesteps);
+
+    ASSERT_EQ(configs.size(), ensemble.getNumMembers());
+    for (int index = 0; index < configs.size(); ++index) {
+        auto const& member = ensemble.getActivatedMember(index);
+        EXPECT_EQ(configs[index].timestep + numTimesteps, member.getTimestep());
+        EXPECT_EQ(runAlone(configs[index], numTimesteps), member.getParticles());
+    }
+}
+
+TEST_F(EnsembleTest, testChangedParametersOnlyAffectOneMember)
+{
+    auto const configs = createRandomConfigs(10);
+
+    Ensemble<TestUniverse> ensemble;
+    for (auto const& config : configs) {
+        ensemble.add(createUniverse(config));
+    }
+    ensemble.calcTimesteps(10);
+    ensemble.getActivatedMember(3).setParameter(1.5);
+    ensemble.calcTimesteps(10);
+
+    for (int index = 0; index < configs.size(); ++index) {
+        if (3 == index) {
+            EXPECT_NE(runAlone(configs[index], 20), ensemble.getActivatedMember(index).getParticles());
+        }
+        else {
+            EXPECT_EQ(runAlone(configs[index], 20), ensemble.getActivatedMember(index).getParticles());
+        }
+    }
+}
+
+TEST_F(EnsembleTest, testMemberIsActivatedForAccess)
+{
+    Ensemble<TestUniverse> ensemble;
+    ensemble.add(new TestUniverse(1, 1.25, 1, 0));
+    ensemble.add(new TestUniverse(1, 1.75, 2, 0));
+    EXPECT_EQ(1.75, Device::readConstantMemory());
+
+    ensemble.getActivatedMember(0);
+    EXPECT_EQ(1.25, Device::readConstantMemory());
+
+    ensemble.calcTimesteps(1);
+    EXPECT_EQ(1.75, Device::readConstantMemory());
+
+    ensemble.add(new TestUniverse(1, 1.5, 3, 0));
+    ensemble.getActivatedMember(1);
+    EXPECT_EQ(1.75, Device::readConstantMemory());
+}
+
+//activating the members in between must not wait for the device
+TEST_F(EnsembleTest, testOneHostWaitPerTimestep)
+{
+    Ensemble<TestUniverse> ensemble;
+    for (auto const& config : createRandomConfigs(20)) {
+        ensemble.add(createUniverse(config));
+    }
+    Device::numHostWaits = 0;
+    ensemble.calcTimesteps(30);
+    EXPECT_EQ(30, Device::numHostWaits);
+}
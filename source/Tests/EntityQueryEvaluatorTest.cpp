@@ -0,0 +1,250 @@
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+#include "ModelGpu/EntityQueryEvaluator.h"
+
+class EntityQueryEvaluatorTest : public ::testing::Test
+{
+public:
+    EntityQueryEvaluatorTest();
+    virtual ~EntityQueryEvaluatorTest() = default;
+
+protected:
+    struct CellData
+    {
+        int cellFunction;
+        float energy;
+    };
+    //cells are connected as a chain and placed horizontally from pos, tokens are placed on the first cell
+    void addCluster(
+        uint64_t id,
+        float2 const& pos,
+        vector<CellData> const& cells,
+        int numTokens = 0,
+        string const& name = string());
+    void addParticle(uint64_t id, float2 const& pos, float energy);
+    DataAccessTO getDataTO();
+
+    void checkConsistency() const;
+
+    int _numClusters = 0;
+    int _numCells = 0;
+    int _numParticles = 0;
+    int _numTokens = 0;
+    int _numStringBytes = 0;
+    vector<ClusterAccessTO> _clusters;
+    vector<CellAccessTO> _cells;
+    vector<ParticleAccessTO> _particles;
+    vector<TokenAccessTO> _tokens;
+    vector<char> _stringBytes;
+};
+
+EntityQueryEvaluatorTest::EntityQueryEvaluatorTest()
+{
+    _clusters.reserve(1000);
+    _cells.reserve(10000);
+    _particles.reserve(1000);
+    _tokens.reserve(1000);
+}
+
+void EntityQueryEvaluatorTest::addCluster(
+    uint64_t id,
+    float2 const& pos,
+    vector<CellData> const& cells,
+    int numTokens,
+    string const& name)
+{
+    ClusterAccessTO clusterTO = {};
+    clusterTO.id = id;
+    clusterTO.pos = pos;
+    clusterTO.numCells = static_cast<int>(cells.size());
+    clusterTO.cellStartIndex = static_cast<int>(_cells.size());
+    clusterTO.numTokens = numTokens;
+    clusterTO.tokenStartIndex = static_cast<int>(_tokens.size());
+    clusterTO.metadata.nameLen = static_cast<int>(name.size());
+    clusterTO.metadata.nameStringIndex = static_cast<int>(_stringBytes.size());
+    _stringBytes.insert(_stringBytes.end(), name.begin(), name.end());
+
+    for (int index = 0; index < clusterTO.numCells; ++index) {
+        CellAccessTO cellTO = {};
+        cellTO.id = id * 1000 + index;
+        cellTO.pos = {pos.x + index, pos.y};
+        cellTO.energy = cells.at(index).energy;
+        cellTO.cellFunctionType = cells.at(index).cellFunction;
+        if (index > 0) {
+            cellTO.connectionIndices[cellTO.numConnections++] = clusterTO.cellStartIndex + index - 1;
+        }
+        if (index < clusterTO.numCells - 1) {
+            cellTO.connectionIndices[cellTO.numConnections++] = clusterTO.cellStartIndex + index + 1;
+        }
+        _cells.emplace_back(cellTO);
+    }
+    for (int index = 0; index < numTokens; ++index) {
+        TokenAccessTO tokenTO = {};
+        tokenTO.cellIndex = clusterTO.cellStartIndex;
+        _tokens.emplace_back(tokenTO);
+    }
+    _clusters.emplace_back(clusterTO);
+}
+
+void EntityQueryEvaluatorTest::addParticle(uint64_t id, float2 const& pos, float energy)
+{
+    ParticleAccessTO particleTO = {};
+    particleTO.id = id;
+    particleTO.pos = pos;
+    particleTO.energy = energy;
+    _particles.emplace_back(particleTO);
+}
+
+DataAccessTO EntityQueryEvaluatorTest::getDataTO()
+{
+    _numClusters = static_cast<int>(_clusters.size());
+    _numCells = static_cast<int>(_cells.size());
+    _numParticles = static_cast<int>(_particles.size());
+    _numTokens = static_cast<int>(_tokens.size());
+    _numStringBytes = static_cast<int>(_stringBytes.size());
+
+    DataAccessTO result;
+    result.numClusters = &_numClusters;
+    result.clusters = _clusters.data();
+    result.numCells = &_numCells;
+    result.cells = _cells.data();
+    result.numParticles = &_numParticles;
+    result.particles = _particles.data();
+    result.numTokens = &_numTokens;
+    result.tokens = _tokens.data();
+    result.numStringBytes = &_numStringBytes;
+    result.stringBytes = _stringBytes.data();
+    return result;
+}
+
+//the ids of the cells refer to their clusters and chain positions, see addCluster
+void EntityQueryEvaluatorTest::checkConsistency() const
+{
+    int cellIndex = 0;
+    int tokenIndex = 0;
+    for (int clusterIndex = 0; clusterIndex < _numClusters; ++clusterIndex) {
+        auto const& cluster = _clusters[clusterIndex];
+        ASSERT_EQ(cellIndex, cluster.cellStartIndex);
+        ASSERT_EQ(tokenIndex, cluster.tokenStartIndex);
+        for (int index = 0; index < cluster.numCells; ++index) {
+            auto const& cell = _cells[cluster.cellStartIndex + index];
+            ASSERT_EQ(cluster.id * 1000 + index, cell.id);
+            for (int connectionIndex = 0; connectionIndex < cell.numConnections; ++connectionIndex) {
+                auto const& connectedCell = _cells[cell.connectionIndices[connectionIndex]];
+                ASSERT_EQ(cluster.id, connectedCell.id / 1000);
+                ASSERT_EQ(1, std::abs(static_cast<int>(connectedCell.id % 1000) - index));
+            }
+        }
+        for (int index = 0; index < cluster.numTokens; ++index) {
+            ASSERT_EQ(cluster.id * 1000, _cells[_tokens[cluster.tokenStartIndex + index].cellIndex].id);
+        }
+        cellIndex += cluster.numCells;
+        tokenIndex += cluster.numTokens;
+    }
+    ASSERT_EQ(cellIndex, _numCells);
+    ASSERT_EQ(tokenIndex, _numTokens);
+}
+
+TEST_F(EntityQueryEvaluatorTest, testConditions)
+{
+    addCluster(1, {10, 10}, {{Enums::CellFunction::WEAPON, 50}, {Enums::CellFunction::COMPUTER, 200}}, 2, "hunter");
+    addCluster(2, {100, 10}, {{Enums::CellFunction::COMPUTER, 20}}, 0, "j\xe4ger");
+    addCluster(3, {10, 100}, {{Enums::CellFunction::SCANNER, 100}, {Enums::CellFunction::WEAPON, 150}, {Enums::CellFunction::PROPULSION, 5}}, 0, "hunter2");
+    addParticle(11, {12, 12}, 5);
+    addParticle(12, {100, 100}, 30);
+    auto const dataTO = getDataTO();
+
+    auto const query = [&](EntityQuery const& entityQuery) { return EntityQueryEvaluator(entityQuery).evaluate(dataTO); };
+    using Ids = vector<uint64_t>;
+    EXPECT_EQ(Ids({1, 2, 3}), query(EntityQuery()).clusterIds);
+    EXPECT_EQ(Ids(), query(EntityQuery()).particleIds);
+    EXPECT_EQ(Ids({2, 3}), query(EntityQuery().setHasTokens(false)).clusterIds);
+    EXPECT_EQ(Ids({1, 3}), query(EntityQuery().setCellFunction(Enums::CellFunction::WEAPON)).clusterIds);
+    EXPECT_EQ(Ids({3}), query(EntityQuery().setCellFunction(Enums::CellFunction::WEAPON).setMinEnergy(100)).clusterIds);
+    EXPECT_EQ(Ids({2, 3}), query(EntityQuery().setMaxEnergy(21)).clusterIds);
+    EXPECT_EQ(Ids({1, 3}), query(EntityQuery().setMinNumCells(2)).clusterIds);
+    EXPECT_EQ(Ids({1, 2}), query(EntityQuery().setMaxNumCells(2)).clusterIds);
+    EXPECT_EQ(Ids({1}), query(EntityQuery().setClusterName("hunter")).clusterIds);
+    EXPECT_EQ(Ids({2}), query(EntityQuery().setClusterName(QString::fromLatin1("j\xe4ger", 5))).clusterIds);
+    EXPECT_EQ(Ids(), query(EntityQuery().setClusterName("")).clusterIds);
+
+    auto const rect = IntRect{{0, 0}, {20, 20}};
+    auto result = query(EntityQuery().setRect(rect).setIncludeParticles(true));
+    EXPECT_EQ(Ids({1}), result.clusterIds);
+    EXPECT_EQ(Ids({11}), result.particleIds);
+
+    result = query(EntityQuery().setIncludeClusters(false).setIncludeParticles(true).setMaxEnergy(10));
+    EXPECT_EQ(Ids(), result.clusterIds);
+    EXPECT_EQ(Ids({11}), result.particleIds);
+
+    //particles have no cell functions
+    result = query(EntityQuery().setIncludeParticles(true).setCellFunction(Enums::CellFunction::COMPUTER));
+    EXPECT_EQ(Ids({1, 2}), result.clusterIds);
+    EXPECT_EQ(Ids(), result.particleIds);
+}
+
+TEST_F(EntityQueryEvaluatorTest, testDeleteMatching)
+{
+    for (int index = 0; index < 100; ++index) {
+        vector<CellData> cells;
+        for (int cellIndex = 0; cellIndex < 1 + index % 6; ++cellIndex) {
+            cells.push_back({(index + cellIndex) % Enums::CellFunction::_COUNTER, 10.0f * (cellIndex + 1)});
+        }
+        addCluster(index + 1, {10.0f * index, 10}, cells, index % 3);
+        addParticle(1000 + index, {10.0f * index, 50}, static_cast<float>(index % 10));
+    }
+    auto const dataTO = getDataTO();
+
+    auto const result = EntityQueryEvaluator(EntityQuery().setHasTokens(false).setIncludeParticles(true).setMaxEnergy(15))
+                            .deleteMatching(dataTO);
+
+    EXPECT_EQ(34, result.clusterIds.size());
+    EXPECT_EQ(0, result.particleIds.size());
+    EXPECT_EQ(66, _numClusters);
+    EXPECT_EQ(100, _numParticles);
+    checkConsistency();
+    for (int clusterIndex = 0; clusterIndex < _numClusters; ++clusterIndex) {
+        EXPECT_LT(0, _clusters[clusterIndex].numTokens);
+    }
+
+    EntityQueryEvaluator(EntityQuery().setIncludeClusters(false).setIncludeParticles(true).setMaxEnergy(5))
+        .deleteMatching(dataTO);
+    EXPECT_EQ(66, _numClusters);
+    EXPECT_EQ(50, _numParticles);
+    for (int particleIndex = 0; particleIndex < _numParticles; ++particleIndex) {
+        EXPECT_LE(5, _particles[particleIndex].energy);
+    }
+    checkConsistency();
+}
+
+TEST_F(EntityQueryEvaluatorTest, testBulkDeletion)
+{
+    auto const numClusters = 20000;
+    _clusters.reserve(numClusters);
+    _cells.reserve(numClusters * 25);
+    _tokens.reserve(numClusters);
+    _particles.reserve(500000);
+    vector<CellData> cells(25, {Enums::CellFunction::COMPUTER, 100});
+    for (int index = 0; index < numClusters; ++index) {
+        cells[0].energy = static_cast<float>(index % 100);
+        addCluster(index + 1, {static_cast<float>(index % 1000), static_cast<float>(index / 1000)}, cells, index % 2);
+    }
+    for (int index = 0; index < 500000; ++index) {
+        addParticle(numClusters + index + 1, {static_cast<float>(index % 1000), 100}, static_cast<float>(index % 10));
+    }
+    auto const dataTO = getDataTO();
+
+    QElapsedTimer timer;
+    timer.start();
+    auto const result =
+        EntityQueryEvaluator(EntityQuery().setMaxEnergy(10).setIncludeParticles(true)).deleteMatching(dataTO);
+    std::cerr << "Time elapsed during deletion: " << timer.elapsed() << " ms" << std::endl;
+
+    EXPECT_EQ(numClusters / 10, result.clusterIds.size());
+    EXPECT_EQ(500000, result.particleIds.size());
+    EXPECT_EQ(numClusters - numClusters / 10, _numClusters);
+    EXPECT_EQ(0, _numParticles);
+    checkConsistency();
+}
@@ -0,0 +1,142 @@
+#include <condition_variable>
+#include <mutex>
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "ModelGpu/FrameRecorder.h"
+
+class FrameRecorderTest : public ::testing::Test
+{
+public:
+    FrameRecorderTest() = default;
+    virtual ~FrameRecorderTest() = default;
+
+protected:
+    //encoder which blocks until it is released and collects the encoded frames
+    struct BlockingEncoder
+    {
+        void encode(FrameRecorder::Frame const& frame);
+        void release();
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool released = false;
+        vector<pair<int, IntVector2D>> encodedFrames;   //timesteps and sizes
+    };
+
+    RecordingParameters createParameters(int queueCapacity) const;
+};
+
+void FrameRecorderTest::BlockingEncoder::encode(FrameRecorder::Frame const& frame)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return released; });
+    encodedFrames.emplace_back(frame.timestep, frame.size);
+}
+
+void FrameRecorderTest::BlockingEncoder::release()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+    }
+    condition.notify_all();
+}
+
+RecordingParameters FrameRecorderTest::createParameters(int queueCapacity) const
+{
+    RecordingParameters result;
+    result.timesteps = 5;
+    result.scale = 0.5;
+    result.queueCapacity = queueCapacity;
+    result.numEncodingThreads = 2;
+    return result;
+}
+
+TEST_F(FrameRecorderTest, testFramesAreDue)
+{
+    BlockingEncoder encoder;
+    encoder.release();
+    FrameRecorder recorder(createParameters(4), {100, 50}, [&](auto const& frame) { encoder.encode(frame); });
+
+    EXPECT_TRUE(recorder.isFrameDue(0));
+    EXPECT_FALSE(recorder.isFrameDue(3));
+    EXPECT_TRUE(recorder.isFrameDue(10));
+}
+
+TEST_F(FrameRecorderTest, testAllSubmittedFramesAreEncoded)
+{
+    BlockingEncoder encoder;
+    encoder.release();
+    {
+        FrameRecorder recorder(createParameters(4), {100, 50}, [&](auto const& frame) { encoder.encode(frame); });
+        for (int timestep = 0; timestep < 20; timestep += 5) {
+            auto const frame = recorder.acquireFrame(timestep);
+            ASSERT_NE(nullptr, frame);
+            recorder.submitFrame(frame);
+        }
+    }
+    ASSERT_EQ(4, encoder.encodedFrames.size());
+    for (auto const& encodedFrame : encoder.encodedFrames) {
+        EXPECT_EQ(0, encodedFrame.first % 5);
+    }
+}
+
+TEST_F(FrameRecorderTest, testBackPressure)
+{
+    BlockingEncoder encoder;
+    {
+        FrameRecorder recorder(createParameters(4), {100, 50}, [&](auto const& frame) { encoder.encode(frame); });
+
+        //the encoders are blocked: the first half of the frames has full size, the second half is down-sampled
+        vector<IntVector2D> frameSizes;
+        for (int timestep = 0; timestep < 4; ++timestep) {
+            auto const frame = recorder.acquireFrame(timestep);
+            ASSERT_NE(nullptr, frame);
+            frameSizes.emplace_back(frame->size);
+            recorder.submitFrame(frame);
+        }
+        EXPECT_EQ(nullptr, recorder.acquireFrame(4));
+
+        EXPECT_EQ(50, frameSizes[0].x);
+        EXPECT_EQ(25, frameSizes[1].y);
+        EXPECT_EQ(25, frameSizes[2].x);
+        EXPECT_EQ(12, frameSizes[3].y);
+
+        encoder.release();
+    }
+    ASSERT_EQ(4, encoder.encodedFrames.size());
+}
+
+TEST_F(FrameRecorderTest, testStatistics)
+{
+    BlockingEncoder encoder;
+    FrameRecorder recorder(createParameters(2), {100, 50}, [&](auto const& frame) { encoder.encode(frame); });
+    for (int timestep = 0; timestep < 5; ++timestep) {
+        if (auto const frame = recorder.acquireFrame(timestep)) {
+            recorder.submitFrame(frame);
+        }
+    }
+    auto const statistics = recorder.getStatistics();
+    EXPECT_EQ(0, statistics.numEncodedFrames);
+    EXPECT_EQ(1, statistics.numDownsampledFrames);
+    EXPECT_EQ(3, statistics.numDroppedFrames);
+    encoder.release();
+}
+
+TEST_F(FrameRecorderTest, testFrameSizeIsCapped)
+{
+    BlockingEncoder encoder;
+    encoder.release();
+    auto parameters = createParameters(4);
+    parameters.scale = 1.0;
+    parameters.maxFramePixels = 200 * 100;
+    FrameRecorder recorder(parameters, {4000, 2000}, [&](auto const& frame) { encoder.encode(frame); });
+
+    auto const frame = recorder.acquireFrame(0);
+    ASSERT_NE(nullptr, frame);
+    EXPECT_EQ(200, frame->size.x);
+    EXPECT_EQ(100, frame->size.y);
+    EXPECT_EQ(200 * 100, frame->pixels.size());
+    recorder.submitFrame(frame);
+}
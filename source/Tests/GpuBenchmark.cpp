@@ -1,5 +1,7 @@
 #include <QElapsedTimer>
 
+#include "ModelBasic/ModelBasicSettings.h"
+
 #include "IntegrationGpuTestFramework.h"
 
 class GpuBenchmark
@@ -62,6 +64,55 @@ TEST_F(GpuBenchmark, testOnlyClusterMovement)
     std::cerr << "Time elapsed during simulation: " << timer.elapsed() << " ms" << std::endl;
 }
 
+TEST_F(GpuBenchmark, testTokensOnMixedCellFunctions)
+{
+    _parameters.radiationProb = 0;
+    _context->setSimulationParameters(_parameters);
+
+    vector<Enums::CellFunction::Type> const cellFunctions = {Enums::CellFunction::COMPUTER,
+                                                             Enums::CellFunction::PROPULSION,
+                                                             Enums::CellFunction::SCANNER,
+                                                             Enums::CellFunction::WEAPON,
+                                                             Enums::CellFunction::CONSTRUCTOR,
+                                                             Enums::CellFunction::SENSOR,
+                                                             Enums::CellFunction::COMMUNICATOR};
+    DataDescription origData;
+    for (int i = 0; i < 250; ++i) {
+        auto cluster = createRectangularCluster({ 7, 40 },
+            QVector2D{
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.x)),
+            static_cast<float>(_numberGen->getRandomReal(0, _universeSize.y)) },
+            QVector2D{});
+        for (int j = 0; j < cluster.cells->size(); ++j) {
+            auto& cell = cluster.cells->at(j);
+            cell.tokenBranchNumber = (j / 7) % _parameters.cellMaxTokenBranchNumber;
+            cell.cellFeature = CellFeatureDescription().setType(cellFunctions.at(j % cellFunctions.size()));
+            if (j < 7) {
+                cell.addToken(createSimpleToken());
+            }
+        }
+        origData.addCluster(cluster);
+    }
+
+    for (auto const tokenBucketing : {false, true}) {
+        auto executionParameters = ModelBasicSettings::getDefaultExecutionParameters();
+        executionParameters.tokenBucketing = tokenBucketing;
+        _context->setExecutionParameters(executionParameters);
+
+        IntegrationTestHelper::updateData(_access, origData);
+        IntegrationTestHelper::runSimulation(20, _controller);
+
+        QElapsedTimer timer;
+        timer.start();
+        IntegrationTestHelper::runSimulation(200, _controller);
+        std::cerr << "Time elapsed during simulation " << (tokenBucketing ? "with" : "without")
+                  << " token bucketing: " << timer.elapsed() << " ms" << std::endl;
+
+        auto const data = IntegrationTestHelper::getContent(_access, { { 0, 0 },{ _universeSize.x, _universeSize.y } });
+        IntegrationTestHelper::updateData(_access, DataChangeDescription(data, DataDescription()));
+    }
+}
+
 namespace
 {
     ModelGpuData getModelGpuDataWithOneBlock()
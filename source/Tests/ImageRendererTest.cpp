@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "ModelBasic/ModelBasicSettings.h"
+#include "ModelGpu/ImageRenderer.h"
+#include "ModelGpu/RenderingFunctions.cuh"
+
+#include "TransferData.h"
+
+class ImageRendererTest : public ::testing::Test
+{
+public:
+    ImageRendererTest();
+    virtual ~ImageRendererTest() = default;
+
+protected:
+    TransferData createTransferData() const;
+    void addCell(TransferData& data, float2 const& pos, float energy) const;
+    void addParticle(TransferData& data, float2 const& pos, float energy) const;
+
+    unsigned int getPixel(vector<unsigned int> const& image, IntVector2D const& imageSize, int x, int y) const;
+
+    ExecutionParameters _parameters;
+};
+
+ImageRendererTest::ImageRendererTest()
+    : _parameters(ModelBasicSettings::getDefaultExecutionParameters())
+{
+    _parameters.imageGlow = false;
+}
+
+TransferData ImageRendererTest::createTransferData() const
+{
+    return TransferData(1, 100, 100, 1, 1);
+}
+
+void ImageRendererTest::addCell(TransferData& data, float2 const& pos, float energy) const
+{
+    auto& cell = data.cells[data.numCells++];
+    cell.id = data.numCells;
+    cell.pos = pos;
+    cell.energy = energy;
+    cell.metadata.color = 0;
+}
+
+void ImageRendererTest::addParticle(TransferData& data, float2 const& pos, float energy) const
+{
+    auto& particle = data.particles[data.numParticles++];
+    particle.id = 1000 + data.numParticles;
+    particle.pos = pos;
+    particle.energy = energy;
+}
+
+unsigned int
+ImageRendererTest::getPixel(vector<unsigned int> const& image, IntVector2D const& imageSize, int x, int y) const
+{
+    return image[x + y * imageSize.x];
+}
+
+TEST_F(ImageRendererTest, testFullResolution)
+{
+    auto data = createTransferData();
+    addCell(data, {10.5f, 20.5f}, 100);
+    addParticle(data, {50, 50}, 10);
+
+    IntVector2D const imageSize{100, 100};
+    auto const image = ImageRenderer(_parameters).render(data.getDataTO(), {{0, 0}, {99, 99}}, imageSize);
+
+    ASSERT_EQ(100 * 100, image.size());
+    EXPECT_NE(ImageBackgroundColor, getPixel(image, imageSize, 10, 20));
+    EXPECT_NE(ImageBackgroundColor, getPixel(image, imageSize, 11, 20));
+    EXPECT_NE(ImageBackgroundColor, getPixel(image, imageSize, 50, 50));
+    EXPECT_EQ(ImageBackgroundColor, getPixel(image, imageSize, 30, 30));
+    EXPECT_EQ(ImageBackgroundColor, getPixel(image, imageSize, 12, 20));
+}
+
+TEST_F(ImageRendererTest, testZoomedOut)
+{
+    auto data = createTransferData();
+    addCell(data, {40, 80}, 100);
+    addCell(data, {300, 300}, 100);
+    addParticle(data, {900, 900}, 10);   //outside of the rect
+
+    //the image has the size of the output and not of the rendered rect
+    IntVector2D const imageSize{100, 100};
+    auto const image = ImageRenderer(_parameters).render(data.getDataTO(), {{0, 0}, {399, 399}}, imageSize);
+
+    ASSERT_EQ(100 * 100, image.size());
+    EXPECT_NE(ImageBackgroundColor, getPixel(image, imageSize, 10, 20));
+    EXPECT_NE(ImageBackgroundColor, getPixel(image, imageSize, 75, 75));
+    auto numDrawnPixels = 0;
+    for (auto const& pixel : image) {
+        numDrawnPixels += ImageBackgroundColor != pixel ? 1 : 0;
+    }
+    EXPECT_EQ(10, numDrawnPixels);
+}
+
+TEST_F(ImageRendererTest, testDensityAggregation)
+{
+    auto data = createTransferData();
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            addCell(data, {40.0f + x, 40.0f + y}, 100);
+        }
+    }
+    addCell(data, {80, 40}, 100);
+
+    _parameters.imageAggregation = ExecutionParameters::ImageAggregation::Density;
+    IntVector2D const imageSize{25, 25};
+    auto const image = ImageRenderer(_parameters).render(data.getDataTO(), {{0, 0}, {99, 99}}, imageSize);
+
+    //a pixel covers 16 units
+    auto const densePixel = getPixel(image, imageSize, 10, 10);
+    auto const sparsePixel = getPixel(image, imageSize, 20, 10);
+    EXPECT_EQ(ImageBackgroundColor, getPixel(image, imageSize, 11, 10));
+    EXPECT_EQ(calcAggregatedColor(16, {0.25f, 0.25f}, ExecutionParameters::ImageAggregation::Density), densePixel);
+    EXPECT_EQ(0xffu, densePixel & 0xff);
+    EXPECT_GT(densePixel & 0xff, sparsePixel & 0xff);
+    EXPECT_NE(ImageBackgroundColor, sparsePixel);
+}
+
+TEST_F(ImageRendererTest, testGlow)
+{
+    auto data = createTransferData();
+    addCell(data, {50, 50}, 200);
+
+    IntVector2D const imageSize{100, 100};
+    auto const rect = IntRect{{0, 0}, {99, 99}};
+    auto const imageWithoutGlow = ImageRenderer(_parameters).render(data.getDataTO(), rect, imageSize);
+    _parameters.imageGlow = true;
+    auto const imageWithGlow = ImageRenderer(_parameters).render(data.getDataTO(), rect, imageSize);
+
+    ASSERT_EQ(imageWithoutGlow.size(), imageWithGlow.size());
+    EXPECT_EQ(ImageBackgroundColor, getPixel(imageWithoutGlow, imageSize, 53, 50));
+    EXPECT_NE(getPixel(imageWithoutGlow, imageSize, 53, 50), getPixel(imageWithGlow, imageSize, 53, 50));
+    EXPECT_EQ(getPixel(imageWithGlow, imageSize, 10, 90), getPixel(imageWithGlow, imageSize, 90, 90));
+}
+
+TEST_F(ImageRendererTest, testRenderOver)
+{
+    auto data = createTransferData();
+    addCell(data, {10, 10}, 100);
+    auto otherData = createTransferData();
+    addCell(otherData, {60, 60}, 100);
+    addParticle(otherData, {30, 70}, 10);
+    auto jointData = createTransferData();
+    addCell(jointData, {10, 10}, 100);
+    addCell(jointData, {60, 60}, 100);
+    addParticle(jointData, {30, 70}, 10);
+
+    IntVector2D const imageSize{100, 100};
+    auto const rect = IntRect{{0, 0}, {99, 99}};
+    ImageRenderer const renderer(_parameters);
+    auto image = renderer.render(data.getDataTO(), rect, imageSize);
+    renderer.renderOver(otherData.getDataTO(), rect, imageSize, image.data());
+
+    EXPECT_EQ(renderer.render(jointData.getDataTO(), rect, imageSize), image);
+}
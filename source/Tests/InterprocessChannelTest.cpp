@@ -0,0 +1,97 @@
+#include <thread>
+#include <gtest/gtest.h>
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "Base/Definitions.h"
+#include "Base/InterprocessChannel.h"
+
+class InterprocessChannelTest : public ::testing::Test
+{
+public:
+    InterprocessChannelTest();
+    virtual ~InterprocessChannelTest();
+
+protected:
+    string const _channelName = "alien_InterprocessChannelTest";
+};
+
+InterprocessChannelTest::InterprocessChannelTest()
+{
+    InterprocessChannel::remove(_channelName);
+}
+
+InterprocessChannelTest::~InterprocessChannelTest()
+{
+    InterprocessChannel::remove(_channelName);
+}
+
+TEST_F(InterprocessChannelTest, testMessagesArriveInOrder)
+{
+    string largeMessage(1000 * 1000, 'a');
+    for (int index = 0; index < largeMessage.size(); index += 7) {
+        largeMessage[index] = static_cast<char>(index % 256);
+    }
+    vector<string> const messages{"hello", largeMessage, "", string(100 - sizeof(uint64_t), 'b')};
+
+    //queue is smaller than the large message
+    std::thread sender([&] {
+        InterprocessChannel channel(_channelName, 100, 4);
+        for (auto const& message : messages) {
+            channel.send(message);
+        }
+    });
+    InterprocessChannel channel(_channelName, 100, 4);
+    for (auto const& message : messages) {
+        auto const receivedMessage = channel.receive(10000);
+        ASSERT_TRUE(receivedMessage);
+        EXPECT_EQ(message, *receivedMessage);
+    }
+    sender.join();
+}
+
+TEST_F(InterprocessChannelTest, testTimeout)
+{
+    InterprocessChannel channel(_channelName);
+    EXPECT_FALSE(channel.receive(10));
+}
+
+TEST_F(InterprocessChannelTest, testSendTimeout)
+{
+    InterprocessChannel channel(_channelName, 100, 4);
+    EXPECT_TRUE(channel.send("hello", 10));
+    EXPECT_FALSE(channel.send(string(1000, 'a'), 10));     //nobody receives
+}
+
+TEST_F(InterprocessChannelTest, testIncompleteMessage)
+{
+    InterprocessChannel channel(_channelName, 100, 4);
+    EXPECT_TRUE(channel.send("hello", 10));
+    EXPECT_FALSE(channel.send(string(1000, 'a'), 10));     //only the first chunks fit into the queue
+
+    EXPECT_EQ(string("hello"), *channel.receive(10));
+    EXPECT_FALSE(channel.receive(10));
+}
+
+#ifndef _WIN32
+TEST_F(InterprocessChannelTest, testBetweenProcesses)
+{
+    string const message(200 * 1000, 'c');
+    auto const childId = fork();
+    ASSERT_NE(-1, childId);
+    if (0 == childId) {
+        InterprocessChannel channel(_channelName);
+        channel.send(message);
+        _exit(0);
+    }
+
+    InterprocessChannel channel(_channelName);
+    auto const receivedMessage = channel.receive(10000);
+    int status = 0;
+    waitpid(childId, &status, 0);
+    ASSERT_TRUE(receivedMessage);
+    EXPECT_EQ(message, *receivedMessage);
+}
+#endif
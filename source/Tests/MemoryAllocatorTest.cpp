@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "ModelGpu/MemoryAllocator.h"
+#include "ModelGpu/Array.cuh"
+#include "ModelGpu/DynamicMemory.cuh"
+
+class MemoryAllocatorTest : public ::testing::Test
+{
+public:
+    virtual ~MemoryAllocatorTest() = default;
+};
+
+TEST_F(MemoryAllocatorTest, testAccountingBySubsystem)
+{
+    HostArenaAllocator allocator(1024 * 1024);
+
+    int* entities1;
+    int* entities2;
+    double* map;
+    allocator.acquireMemory(MemorySubsystem::Entities, 100, entities1);
+    allocator.acquireMemory(MemorySubsystem::Entities, 50, entities2);
+    allocator.acquireMemory(MemorySubsystem::Maps, 10, map);
+
+    EXPECT_EQ(150 * sizeof(int), allocator.getUsage(MemorySubsystem::Entities).bytes);
+    EXPECT_EQ(2, allocator.getUsage(MemorySubsystem::Entities).numAllocations);
+    EXPECT_EQ(10 * sizeof(double), allocator.getUsage(MemorySubsystem::Maps).bytes);
+    EXPECT_EQ(0, allocator.getUsage(MemorySubsystem::Images).bytes);
+    EXPECT_EQ(150 * sizeof(int) + 10 * sizeof(double), allocator.getTotalUsage().bytes);
+
+    allocator.freeMemory(entities1);
+    EXPECT_EQ(50 * sizeof(int), allocator.getUsage(MemorySubsystem::Entities).bytes);
+    EXPECT_EQ(150 * sizeof(int), allocator.getUsage(MemorySubsystem::Entities).highWaterMark);
+    EXPECT_EQ(150 * sizeof(int) + 10 * sizeof(double), allocator.getTotalUsage().highWaterMark);
+
+    allocator.resetHighWaterMarks();
+    EXPECT_EQ(50 * sizeof(int), allocator.getUsage(MemorySubsystem::Entities).highWaterMark);
+
+    allocator.freeMemory(entities2);
+    allocator.freeMemory(map);
+    EXPECT_EQ(0, allocator.getTotalUsage().bytes);
+    EXPECT_EQ(0, allocator.getTotalUsage().numAllocations);
+}
+
+TEST_F(MemoryAllocatorTest, testHostArena)
+{
+    HostArenaAllocator allocator(4096);
+
+    unsigned char* memory1;
+    unsigned char* memory2;
+    allocator.acquireMemory(MemorySubsystem::Other, 1, memory1);
+    allocator.acquireMemory(MemorySubsystem::Other, 300, memory2);
+    EXPECT_EQ(256, memory2 - memory1);
+    EXPECT_EQ(256 + 512, allocator.getOccupiedBytes());
+
+    int values[] = {1, 2, 3};
+    int* target;
+    allocator.acquireMemory(MemorySubsystem::Other, 3, target);
+    allocator.copy(target, values, sizeof(values));
+    EXPECT_EQ(2, target[1]);
+    allocator.set(target, 0, sizeof(values));
+    EXPECT_EQ(0, target[2]);
+
+    EXPECT_THROW(allocator.acquireMemory(MemorySubsystem::Other, 4096, memory1), std::bad_alloc);
+
+    //arena is rewound when all allocations are freed
+    allocator.freeMemory(memory1);
+    allocator.freeMemory(memory2);
+    allocator.freeMemory(target);
+    EXPECT_EQ(0, allocator.getOccupiedBytes());
+}
+
+TEST_F(MemoryAllocatorTest, testArrayOnHostArena)
+{
+    HostArenaAllocator allocator(1024 * 1024);
+
+    Array<float> array;
+    array.init(1000, MemorySubsystem::Entities, &allocator);
+    EXPECT_EQ(1000 * sizeof(float) + sizeof(float*) + sizeof(int), allocator.getUsage(MemorySubsystem::Entities).bytes);
+    EXPECT_EQ(0, array.retrieveNumEntries());
+    EXPECT_EQ(0, CudaMemoryManager::getInstance().getSizeOfAcquiredMemory());
+
+    auto data = array.getArrayForHost();
+    data[999] = 1.5f;
+    EXPECT_EQ(1.5f, array.getArrayForHost()[999]);
+
+    array.free();
+    EXPECT_EQ(0, allocator.getTotalUsage().bytes);
+    EXPECT_EQ(0, allocator.getOccupiedBytes());
+}
+
+TEST_F(MemoryAllocatorTest, testDynamicMemoryOnHostArena)
+{
+    HostArenaAllocator allocator1(1024 * 1024);
+    HostArenaAllocator allocator2(1024 * 1024);
+
+    DynamicMemory memory1;
+    DynamicMemory memory2;
+    memory1.init(10000, MemorySubsystem::DynamicMemory, &allocator1);
+    memory2.init(20000, MemorySubsystem::Other, &allocator2);
+    EXPECT_EQ(
+        10000 + sizeof(unsigned char*) + sizeof(int), allocator1.getUsage(MemorySubsystem::DynamicMemory).bytes);
+    EXPECT_EQ(0, allocator1.getUsage(MemorySubsystem::Other).bytes);
+    EXPECT_EQ(20000 + sizeof(unsigned char*) + sizeof(int), allocator2.getUsage(MemorySubsystem::Other).bytes);
+    EXPECT_EQ(0, memory1.retrieveNumBytes());
+    EXPECT_EQ(0, memory2.retrieveNumBytes());
+
+    memory1.free();
+    EXPECT_EQ(0, allocator1.getOccupiedBytes());
+    EXPECT_LT(0, allocator2.getOccupiedBytes());
+
+    memory2.free();
+    EXPECT_EQ(0, allocator2.getOccupiedBytes());
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/ServiceLocator.h"
+#include "Base/GlobalFactory.h"
+#include "Base/NumberGenerator.h"
+#include "ModelBasic/ChangeDescriptions.h"
+#include "ModelBasic/Descriptions.h"
+#include "ModelBasic/MetadataStringTable.h"
+#include "ModelBasic/ModelBasicBuilderFacade.h"
+#include "ModelBasic/ModelBasicSettings.h"
+#include "ModelBasic/Serializer.h"
+#include "ModelGpu/DataConverter.h"
+
+#include "TransferData.h"
+
+class MetadataStringTableTest : public ::testing::Test
+{
+public:
+    MetadataStringTableTest();
+    virtual ~MetadataStringTableTest();
+
+protected:
+
+    //all cells share the same source code and name as in replicator worlds
+    DataDescription createReplicators(int numClusters, int numCellsPerCluster) const;
+
+    //checks the metadata of each expected cluster independent of its position in actual
+    void checkMetadata(DataDescription const& expected, DataDescription const& actual) const;
+
+    QString const _sourceCode = QString("mov [1], [2]\nadd [1], 3\n").repeated(20);
+    NumberGenerator* _numberGen = nullptr;
+    SimulationParameters _parameters;
+};
+
+MetadataStringTableTest::MetadataStringTableTest()
+    : _parameters(ModelBasicSettings::getDefaultSimulationParameters())
+{
+    auto factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+    _numberGen = factory->buildRandomNumberGenerator();
+    _numberGen->init();
+}
+
+MetadataStringTableTest::~MetadataStringTableTest()
+{
+    delete _numberGen;
+}
+
+DataDescription MetadataStringTableTest::createReplicators(int numClusters, int numCellsPerCluster) const
+{
+    DataDescription result;
+    for (int clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex) {
+        auto cluster = ClusterDescription()
+                           .setId(_numberGen->getId())
+                           .setPos({100.0f + clusterIndex * 10, 100})
+                           .setVel({0, 0})
+                           .setAngle(0)
+                           .setAngularVel(0)
+                           .setMetadata(ClusterMetadata().setName("replicator"));
+        for (int cellIndex = 0; cellIndex < numCellsPerCluster; ++cellIndex) {
+            auto metadata = CellMetadata().setName("cell").setSourceCode(_sourceCode).setColor(cellIndex % 7);
+            if (0 == cellIndex) {
+                metadata.setDescription("origin of " + QString::number(clusterIndex));
+            }
+            cluster.addCell(CellDescription()
+                                .setId(_numberGen->getId())
+                                .setPos({100.0f + clusterIndex * 10, 100.0f + cellIndex})
+                                .setEnergy(100)
+                                .setMaxConnections(2)
+                                .setCellFeature(CellFeatureDescription().setType(Enums::CellFunction::COMPUTER))
+                                .setMetadata(metadata));
+        }
+        result.addCluster(cluster);
+    }
+    return result;
+}
+
+void MetadataStringTableTest::checkMetadata(DataDescription const& expected, DataDescription const& actual) const
+{
+    unordered_map<uint64_t, ClusterDescription const*> actualClusterById;
+    for (auto const& cluster : *actual.clusters) {
+        actualClusterById.emplace(cluster.id, &cluster);
+    }
+    ASSERT_EQ(expected.clusters->size(), actualClusterById.size());
+    for (auto const& expectedCluster : *expected.clusters) {
+        auto const& actualCluster = *actualClusterById.at(expectedCluster.id);
+        EXPECT_EQ(*expectedCluster.metadata, *actualCluster.metadata);
+        ASSERT_EQ(expectedCluster.cells->size(), actualCluster.cells->size());
+        for (int index = 0; index < expectedCluster.cells->size(); ++index) {
+            EXPECT_EQ(*expectedCluster.cells->at(index).metadata, *actualCluster.cells->at(index).metadata);
+        }
+    }
+}
+
+TEST_F(MetadataStringTableTest, testInternAndRelease)
+{
+    MetadataStringTable table;
+    auto const id1 = table.intern("mov [1], 2");
+    auto const id2 = table.intern("cell");
+    EXPECT_EQ(id1, table.intern("mov [1], 2"));
+    EXPECT_NE(id1, id2);
+    EXPECT_EQ(2, table.getRefCount(id1));
+    EXPECT_EQ(2, table.getNumStrings());
+    EXPECT_EQ(14, table.getNumBytes());
+    EXPECT_EQ(id2, *table.getId("cell"));
+    EXPECT_FALSE(table.getId("unknown"));
+
+    table.release(id1);
+    EXPECT_EQ(QString("mov [1], 2"), table.getString(id1));
+    table.release(id1);
+    EXPECT_FALSE(table.getId("mov [1], 2"));
+    EXPECT_EQ(1, table.getNumStrings());
+    EXPECT_EQ(4, table.getNumBytes());
+
+    //ids of dropped strings are reused
+    EXPECT_EQ(id1, table.intern("description"));
+    EXPECT_EQ(2, table.getIdBound());
+}
+
+TEST_F(MetadataStringTableTest, testDataConverterRoundTrip)
+{
+    auto const data = createReplicators(20, 30);
+
+    TransferData transferData(100, 1000, 1, 1, 100000);
+    auto dataTO = transferData.getDataTO();
+    DataConverter(dataTO, _numberGen, _parameters, {1000, 1000}).updateData(DataChangeDescription(data));
+
+    //"replicator", "cell", source code and one description per cluster
+    auto expectedNumStringBytes = getStringBlockSize(10) + getStringBlockSize(4) + getStringBlockSize(_sourceCode.size());
+    for (int clusterIndex = 0; clusterIndex < 20; ++clusterIndex) {
+        expectedNumStringBytes += getStringBlockSize(("origin of " + QString::number(clusterIndex)).size());
+    }
+    EXPECT_EQ(expectedNumStringBytes, transferData.numStringBytes);
+    for (int index = 1; index < transferData.numCells; ++index) {
+        EXPECT_EQ(
+            transferData.cells[0].metadata.sourceCodeStringIndex,
+            transferData.cells[index].metadata.sourceCodeStringIndex);
+    }
+
+    auto const convertedData = DataConverter(dataTO, _numberGen, _parameters, {1000, 1000}).getDataDescription();
+    checkMetadata(data, convertedData);
+}
+
+TEST_F(MetadataStringTableTest, testSerializerRoundTrip)
+{
+    auto const data = createReplicators(20, 30);
+
+    auto facade = ServiceLocator::getInstance().getService<ModelBasicBuilderFacade>();
+    auto serializer = facade->buildSerializer();
+    auto const serializedData = serializer->serializeDataDescription(data);
+    EXPECT_LT(serializedData.size(), 20 * 30 * _sourceCode.size());   //less than the source code of all cells
+
+    auto const deserializedData = serializer->deserializeDataDescription(serializedData);
+    checkMetadata(data, deserializedData);
+    delete serializer;
+}
@@ -0,0 +1,152 @@
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#include "ModelBasic/MonitorHistory.h"
+
+class MonitorHistoryTest : public ::testing::Test
+{
+public:
+    virtual ~MonitorHistoryTest() = default;
+
+protected:
+    MonitorData createMonitorData(int value) const;
+    void checkEquality(MonitorData const& expected, MonitorData const& actual) const;
+};
+
+MonitorData MonitorHistoryTest::createMonitorData(int value) const
+{
+    MonitorData result;
+    result.numClusters = value;
+    result.numClustersWithTokens = value;
+    result.numCells = value * 10;
+    result.numParticles = value * 2;
+    result.numTokens = value;
+    result.totalInternalEnergy = value * 100.0;
+    result.totalLinearKineticEnergy = value;
+    result.totalRotationalKineticEnergy = value;
+    return result;
+}
+
+void MonitorHistoryTest::checkEquality(MonitorData const& expected, MonitorData const& actual) const
+{
+    EXPECT_EQ(expected.numClusters, actual.numClusters);
+    EXPECT_EQ(expected.numClustersWithTokens, actual.numClustersWithTokens);
+    EXPECT_EQ(expected.numCells, actual.numCells);
+    EXPECT_EQ(expected.numParticles, actual.numParticles);
+    EXPECT_EQ(expected.numTokens, actual.numTokens);
+    EXPECT_DOUBLE_EQ(expected.totalInternalEnergy, actual.totalInternalEnergy);
+    EXPECT_DOUBLE_EQ(expected.totalLinearKineticEnergy, actual.totalLinearKineticEnergy);
+    EXPECT_DOUBLE_EQ(expected.totalRotationalKineticEnergy, actual.totalRotationalKineticEnergy);
+}
+
+TEST_F(MonitorHistoryTest, testRingBufferOverflow)
+{
+    MonitorHistory history(5);
+    for (int i = 1; i <= 8; ++i) {
+        history.add(i, createMonitorData(i));
+    }
+    EXPECT_EQ(5, history.getNumSamples(MonitorHistory::Resolution::Raw));
+
+    auto const samples = history.getSamples(0, 100);
+    ASSERT_EQ(5, samples.size());
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(i + 4, samples.at(i).timestep);
+        EXPECT_EQ(i + 4, samples.at(i).data.numClusters);
+    }
+    EXPECT_EQ(8, history.getLastSample()->timestep);
+}
+
+TEST_F(MonitorHistoryTest, testDownsampling)
+{
+    MonitorHistory history;
+    for (int i = 1; i <= 200; ++i) {
+        history.add(i, createMonitorData(i));
+    }
+    EXPECT_EQ(200, history.getNumSamples(MonitorHistory::Resolution::Raw));
+    EXPECT_EQ(20, history.getNumSamples(MonitorHistory::Resolution::Tenth));
+    EXPECT_EQ(2, history.getNumSamples(MonitorHistory::Resolution::Hundredth));
+
+    auto const tenth = history.getSamples(0, 10, MonitorHistory::Resolution::Tenth);
+    ASSERT_EQ(1, tenth.size());
+    EXPECT_EQ(10, tenth.front().timestep);
+    EXPECT_EQ(55, tenth.front().data.numCells);   //mean of 10, 20, ..., 100
+    EXPECT_DOUBLE_EQ(550.0, tenth.front().data.totalInternalEnergy);
+
+    auto const hundredth = history.getSamples(0, 200, MonitorHistory::Resolution::Hundredth);
+    ASSERT_EQ(2, hundredth.size());
+    EXPECT_EQ(100, hundredth.at(0).timestep);
+    EXPECT_EQ(200, hundredth.at(1).timestep);
+    EXPECT_DOUBLE_EQ(15050.0, hundredth.at(1).data.totalInternalEnergy);
+}
+
+TEST_F(MonitorHistoryTest, testRangeQueryAndAggregate)
+{
+    MonitorHistory history;
+    for (int i = 1; i <= 50; ++i) {
+        history.add(i * 100, createMonitorData(i));
+    }
+
+    auto const samples = history.getSamples(1050, 1500);
+    ASSERT_EQ(5, samples.size());
+    EXPECT_EQ(1100, samples.front().timestep);
+    EXPECT_EQ(1500, samples.back().timestep);
+
+    auto const aggregate = history.getAggregate(1000, 2000);
+    EXPECT_EQ(11, aggregate.numSamples);
+    EXPECT_EQ(10, aggregate.min.numClusters);
+    EXPECT_EQ(20, aggregate.max.numClusters);
+    EXPECT_EQ(15, aggregate.mean.numClusters);
+    EXPECT_DOUBLE_EQ(1500.0, aggregate.mean.totalInternalEnergy);
+
+    EXPECT_EQ(0, history.getAggregate(6000, 7000).numSamples);
+}
+
+TEST_F(MonitorHistoryTest, testResetOnDecreasingTimestep)
+{
+    MonitorHistory history;
+    for (int i = 1; i <= 30; ++i) {
+        history.add(i, createMonitorData(i));
+    }
+    history.add(5, createMonitorData(1));
+    EXPECT_EQ(1, history.getNumSamples(MonitorHistory::Resolution::Raw));
+    EXPECT_EQ(0, history.getNumSamples(MonitorHistory::Resolution::Tenth));
+    EXPECT_EQ(5, history.getLastSample()->timestep);
+}
+
+TEST_F(MonitorHistoryTest, testSaveAndLoad)
+{
+    MonitorHistory history(30);
+    for (int i = 1; i <= 123; ++i) {
+        history.add(i, createMonitorData(i));
+    }
+
+    string const filename = "MonitorHistoryTest.monitor";
+    ASSERT_TRUE(history.saveToFile(filename));
+
+    MonitorHistory loadedHistory;
+    ASSERT_TRUE(loadedHistory.loadFromFile(filename));
+    std::remove(filename.c_str());
+
+    for (auto resolution :
+         {MonitorHistory::Resolution::Raw, MonitorHistory::Resolution::Tenth, MonitorHistory::Resolution::Hundredth}) {
+        auto const expected = history.getSamples(0, 1000, resolution);
+        auto const actual = loadedHistory.getSamples(0, 1000, resolution);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (int i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected.at(i).timestep, actual.at(i).timestep);
+            checkEquality(expected.at(i).data, actual.at(i).data);
+        }
+    }
+
+    //pending accumulators must be restored such that downsampling continues seamlessly
+    for (int i = 124; i <= 130; ++i) {
+        history.add(i, createMonitorData(i));
+        loadedHistory.add(i, createMonitorData(i));
+    }
+    EXPECT_EQ(13, loadedHistory.getNumSamples(MonitorHistory::Resolution::Tenth));
+    checkEquality(
+        history.getSamples(0, 1000, MonitorHistory::Resolution::Tenth).back().data,
+        loadedHistory.getSamples(0, 1000, MonitorHistory::Resolution::Tenth).back().data);
+    EXPECT_FALSE(loadedHistory.loadFromFile("nonexistent.monitor"));
+}
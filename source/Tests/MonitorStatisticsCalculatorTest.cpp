@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include "ModelGpu/MonitorStatisticsCalculator.h"
+
+class MonitorStatisticsCalculatorTest : public ::testing::Test
+{
+public:
+    MonitorStatisticsCalculatorTest();
+    virtual ~MonitorStatisticsCalculatorTest() = default;
+
+protected:
+    void addCluster(vector<int> const& cellFunctions, vector<std::pair<int, float>> const& tokenCellIndicesAndEnergies);
+    void addParticle(float energy);
+    DataAccessTO getDataTO();
+
+    void checkEquality(MonitorStatistics const& expected, MonitorStatistics const& actual) const;
+
+    int _numClusters = 0;
+    int _numCells = 0;
+    int _numParticles = 0;
+    int _numTokens = 0;
+    int _numStringBytes = 0;
+    vector<ClusterAccessTO> _clusters;
+    vector<CellAccessTO> _cells;
+    vector<ParticleAccessTO> _particles;
+    vector<TokenAccessTO> _tokens;
+};
+
+MonitorStatisticsCalculatorTest::MonitorStatisticsCalculatorTest()
+{
+    _clusters.reserve(1000);
+    _cells.reserve(100000);
+    _particles.reserve(1000);
+    _tokens.reserve(10000);
+}
+
+void MonitorStatisticsCalculatorTest::addCluster(
+    vector<int> const& cellFunctions,
+    vector<std::pair<int, float>> const& tokenCellIndicesAndEnergies)
+{
+    ClusterAccessTO clusterTO = {};
+    clusterTO.numCells = static_cast<int>(cellFunctions.size());
+    clusterTO.cellStartIndex = static_cast<int>(_cells.size());
+    clusterTO.numTokens = static_cast<int>(tokenCellIndicesAndEnergies.size());
+    clusterTO.tokenStartIndex = static_cast<int>(_tokens.size());
+    for (auto const& cellFunction : cellFunctions) {
+        CellAccessTO cellTO = {};
+        cellTO.cellFunctionType = cellFunction;
+        _cells.emplace_back(cellTO);
+    }
+    for (auto const& tokenCellIndexAndEnergy : tokenCellIndicesAndEnergies) {
+        TokenAccessTO tokenTO = {};
+        tokenTO.cellIndex = clusterTO.cellStartIndex + tokenCellIndexAndEnergy.first;
+        tokenTO.energy = tokenCellIndexAndEnergy.second;
+        _tokens.emplace_back(tokenTO);
+    }
+    _clusters.emplace_back(clusterTO);
+}
+
+void MonitorStatisticsCalculatorTest::addParticle(float energy)
+{
+    ParticleAccessTO particleTO = {};
+    particleTO.energy = energy;
+    _particles.emplace_back(particleTO);
+}
+
+DataAccessTO MonitorStatisticsCalculatorTest::getDataTO()
+{
+    _numClusters = static_cast<int>(_clusters.size());
+    _numCells = static_cast<int>(_cells.size());
+    _numParticles = static_cast<int>(_particles.size());
+    _numTokens = static_cast<int>(_tokens.size());
+
+    DataAccessTO result;
+    result.numClusters = &_numClusters;
+    result.clusters = _clusters.data();
+    result.numCells = &_numCells;
+    result.cells = _cells.data();
+    result.numParticles = &_numParticles;
+    result.particles = _particles.data();
+    result.numTokens = &_numTokens;
+    result.tokens = _tokens.data();
+    result.numStringBytes = &_numStringBytes;
+    return result;
+}
+
+void MonitorStatisticsCalculatorTest::checkEquality(
+    MonitorStatistics const& expected,
+    MonitorStatistics const& actual) const
+{
+    for (int i = 0; i < Enums::CellFunction::_COUNTER; ++i) {
+        EXPECT_EQ(expected.numCellsByFunction[i], actual.numCellsByFunction[i]);
+    }
+    for (int i = 0; i < MonitorStatistics::NumClusterSizeBins; ++i) {
+        EXPECT_EQ(expected.clusterSizeHistogram[i], actual.clusterSizeHistogram[i]);
+    }
+    for (int i = 0; i < MonitorStatistics::NumTokenEnergyBins; ++i) {
+        EXPECT_EQ(expected.tokenEnergyHistogram[i], actual.tokenEnergyHistogram[i]);
+    }
+    EXPECT_EQ(expected.numConstructorActivities, actual.numConstructorActivities);
+    EXPECT_EQ(expected.numWeaponActivities, actual.numWeaponActivities);
+    EXPECT_EQ(expected.numParticles, actual.numParticles);
+    EXPECT_NEAR(expected.totalParticleEnergy, actual.totalParticleEnergy, 0.01);
+}
+
+TEST_F(MonitorStatisticsCalculatorTest, testBinning)
+{
+    EXPECT_EQ(0, MonitorStatistics::getClusterSizeBin(1));
+    EXPECT_EQ(1, MonitorStatistics::getClusterSizeBin(2));
+    EXPECT_EQ(1, MonitorStatistics::getClusterSizeBin(3));
+    EXPECT_EQ(2, MonitorStatistics::getClusterSizeBin(4));
+    EXPECT_EQ(MonitorStatistics::NumClusterSizeBins - 1, MonitorStatistics::getClusterSizeBin(1 << 30));
+
+    EXPECT_EQ(0, MonitorStatistics::getTokenEnergyBin(-1.0));
+    EXPECT_EQ(0, MonitorStatistics::getTokenEnergyBin(9.9));
+    EXPECT_EQ(1, MonitorStatistics::getTokenEnergyBin(10.0));
+    EXPECT_EQ(MonitorStatistics::NumTokenEnergyBins - 1, MonitorStatistics::getTokenEnergyBin(1e6));
+}
+
+TEST_F(MonitorStatisticsCalculatorTest, testSmallData)
+{
+    addCluster({Enums::CellFunction::COMPUTER}, {});
+    addCluster(
+        {Enums::CellFunction::CONSTRUCTOR, Enums::CellFunction::WEAPON, Enums::CellFunction::COMPUTER},
+        {{0, 5.0f}, {0, 25.0f}, {1, 15.0f}, {2, 15.0f}});
+    addCluster(
+        vector<int>(5, Enums::CellFunction::SCANNER + Enums::CellFunction::_COUNTER),  //invalid types are wrapped
+        {{4, 1000.0f}});
+    addParticle(1.5f);
+    addParticle(2.5f);
+
+    MonitorStatistics expected;
+    expected.numCellsByFunction[Enums::CellFunction::COMPUTER] = 2;
+    expected.numCellsByFunction[Enums::CellFunction::CONSTRUCTOR] = 1;
+    expected.numCellsByFunction[Enums::CellFunction::WEAPON] = 1;
+    expected.numCellsByFunction[Enums::CellFunction::SCANNER] = 5;
+    expected.clusterSizeHistogram[0] = 1;
+    expected.clusterSizeHistogram[1] = 1;
+    expected.clusterSizeHistogram[2] = 1;
+    expected.tokenEnergyHistogram[0] = 1;
+    expected.tokenEnergyHistogram[1] = 2;
+    expected.tokenEnergyHistogram[2] = 1;
+    expected.tokenEnergyHistogram[MonitorStatistics::NumTokenEnergyBins - 1] = 1;
+    expected.numConstructorActivities = 2;
+    expected.numWeaponActivities = 1;
+    expected.numParticles = 2;
+    expected.totalParticleEnergy = 4.0;
+
+    auto const dataTO = getDataTO();
+    checkEquality(expected, MonitorStatisticsCalculator(1).calcStatistics(dataTO));
+    checkEquality(expected, MonitorStatisticsCalculator(8).calcStatistics(dataTO));
+}
+
+TEST_F(MonitorStatisticsCalculatorTest, testParallelReductionEqualsSequential)
+{
+    for (int clusterIndex = 0; clusterIndex < 997; ++clusterIndex) {
+        vector<int> cellFunctions;
+        for (int cellIndex = 0; cellIndex < 1 + (clusterIndex * 7) % 60; ++cellIndex) {
+            cellFunctions.emplace_back((clusterIndex + cellIndex) % Enums::CellFunction::_COUNTER);
+        }
+        vector<std::pair<int, float>> tokens;
+        for (int tokenIndex = 0; tokenIndex < clusterIndex % 5; ++tokenIndex) {
+            tokens.emplace_back(tokenIndex % cellFunctions.size(), static_cast<float>((clusterIndex * 13) % 200));
+        }
+        addCluster(cellFunctions, tokens);
+    }
+    for (int particleIndex = 0; particleIndex < 555; ++particleIndex) {
+        addParticle(static_cast<float>(particleIndex % 10));
+    }
+
+    auto const dataTO = getDataTO();
+    auto const expected = MonitorStatisticsCalculator(1).calcStatistics(dataTO);
+    for (int numThreads : {2, 3, 7, 16}) {
+        checkEquality(expected, MonitorStatisticsCalculator(numThreads).calcStatistics(dataTO));
+    }
+    checkEquality(expected, MonitorStatisticsCalculator().calcStatistics(dataTO));
+}
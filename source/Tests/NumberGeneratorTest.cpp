@@ -48,3 +48,26 @@ TEST_F(NumberGeneratorTest, testTags)
 	EXPECT_EQ(2, tag & 0xffffffffffff);
 }
 
+TEST_F(NumberGeneratorTest, testReproducibleStreams)
+{
+	GlobalFactory* factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+	auto otherNumberGen = factory->buildRandomNumberGenerator();
+
+	_numberGen->init(123, 1);
+	otherNumberGen->init(123, 1);
+	for (int i = 0; i < 5000; ++i) {
+		EXPECT_EQ(_numberGen->getRandomInt(), otherNumberGen->getRandomInt());
+	}
+
+	_numberGen->init(123, 1);
+	otherNumberGen->init(123, 2);
+	int numEqual = 0;
+	for (int i = 0; i < 5000; ++i) {
+		if (_numberGen->getRandomInt() == otherNumberGen->getRandomInt()) {
+			++numEqual;
+		}
+	}
+	EXPECT_GT(5, numEqual);
+
+	delete otherNumberGen;
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+#include "ModelGpu/OccupancyPyramid.h"
+
+class OccupancyPyramidTest : public ::testing::Test
+{
+public:
+    OccupancyPyramidTest();
+    virtual ~OccupancyPyramidTest() = default;
+
+protected:
+    void occupyRandomPositions(int numPositions);
+    bool isOccupiedBruteForce(int x, int y) const;
+
+    //width and height are no multiples of the block size to check partial tiles and blocks
+    int const _width = 301;
+    int const _height = 203;
+    vector<unsigned long long> _tileWords;
+    vector<unsigned long long> _blockWords;
+    vector<bool> _occupied;
+    OccupancyPyramid _pyramid;
+    RandomStream _random;
+};
+
+OccupancyPyramidTest::OccupancyPyramidTest()
+    : _tileWords(OccupancyPyramid::getNumTileWords(_width, _height), 0)
+    , _blockWords(OccupancyPyramid::getNumBlockWords(_width, _height), 0)
+    , _occupied(_width * _height, false)
+    , _random(2019, 0)
+{
+    _pyramid.init(_width, _height, _tileWords.data(), _blockWords.data());
+}
+
+void OccupancyPyramidTest::occupyRandomPositions(int numPositions)
+{
+    for (int i = 0; i < numPositions; ++i) {
+        auto const x = static_cast<int>(_random.getUInt(_width));
+        auto const y = static_cast<int>(_random.getUInt(_height));
+        _occupied.at(x + y * _width) = true;
+        _pyramid.set(x, y);
+    }
+}
+
+bool OccupancyPyramidTest::isOccupiedBruteForce(int x, int y) const
+{
+    x = ((x % _width) + _width) % _width;
+    y = ((y % _height) + _height) % _height;
+    return _occupied.at(x + y * _width);
+}
+
+TEST_F(OccupancyPyramidTest, testRectQueriesEqualBruteForce)
+{
+    occupyRandomPositions(150);
+    for (int i = 0; i < 2000; ++i) {
+        auto const x0 = static_cast<int>(_random.getUInt(3 * _width)) - _width;
+        auto const y0 = static_cast<int>(_random.getUInt(3 * _height)) - _height;
+        auto const x1 = x0 + static_cast<int>(_random.getUInt(i % 2 == 0 ? 10 : 150));
+        auto const y1 = y0 + static_cast<int>(_random.getUInt(i % 2 == 0 ? 10 : 150));
+
+        set<std::pair<int, int>> expected;
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                if (isOccupiedBruteForce(x, y)) {
+                    expected.insert({x, y});
+                }
+            }
+        }
+        set<std::pair<int, int>> actual;
+        _pyramid.forEachOccupied(x0, y0, x1, y1, [&](int x, int y) {
+            EXPECT_TRUE(actual.insert({x, y}).second);
+        });
+        ASSERT_EQ(expected, actual);
+        ASSERT_EQ(expected.empty(), _pyramid.isRectEmpty(x0, y0, x1, y1));
+    }
+}
+
+TEST_F(OccupancyPyramidTest, testPointQueries)
+{
+    occupyRandomPositions(1000);
+    for (int y = -_height; y < 2 * _height; y += 3) {
+        for (int x = -_width; x < 2 * _width; x += 3) {
+            ASSERT_EQ(isOccupiedBruteForce(x, y), _pyramid.isOccupied(x, y));
+        }
+    }
+}
+
+//same scan pattern as the sensor vicinity search: grid points with given step size within a radius
+TEST_F(OccupancyPyramidTest, testVicinityScanEqualsBruteForce)
+{
+    occupyRandomPositions(300);
+    for (int i = 0; i < 200; ++i) {
+        auto const centerX = static_cast<int>(_random.getUInt(_width));
+        auto const centerY = static_cast<int>(_random.getUInt(_height));
+        auto const range = 5 + static_cast<int>(_random.getUInt(50));
+        auto const step = 1 + static_cast<int>(_random.getUInt(6));
+        auto const numScanPointsPerAxis = (range * 2 + 1) / step;
+
+        set<std::pair<int, int>> expected;
+        for (int index = 0; index < numScanPointsPerAxis * numScanPointsPerAxis; ++index) {
+            auto const deltaX = index % numScanPointsPerAxis * step - range;
+            auto const deltaY = index / numScanPointsPerAxis * step - range;
+            if (deltaX * deltaX + deltaY * deltaY > range * range) {
+                continue;
+            }
+            if (isOccupiedBruteForce(centerX + deltaX, centerY + deltaY)) {
+                expected.insert({deltaX, deltaY});
+            }
+        }
+
+        set<std::pair<int, int>> actual;
+        for (int row = 0; row < numScanPointsPerAxis; ++row) {
+            auto const deltaY = row * step - range;
+            _pyramid.forEachOccupied(
+                centerX - range,
+                centerY + deltaY,
+                centerX - range + (numScanPointsPerAxis - 1) * step,
+                centerY + deltaY,
+                [&](int x, int y) {
+                    auto const deltaX = x - centerX;
+                    if ((deltaX + range) % step != 0 || deltaX * deltaX + deltaY * deltaY > range * range) {
+                        return;
+                    }
+                    actual.insert({deltaX, y - centerY});
+                });
+        }
+        ASSERT_EQ(expected, actual);
+    }
+}
+
+TEST_F(OccupancyPyramidTest, testClear)
+{
+    occupyRandomPositions(500);
+    for (int y = 0; y < _height; ++y) {
+        for (int x = 0; x < _width; ++x) {
+            if (_occupied.at(x + y * _width)) {
+                _pyramid.clear(x, y);
+            }
+        }
+    }
+    EXPECT_TRUE(_pyramid.isRectEmpty(0, 0, _width - 1, _height - 1));
+    for (auto const& word : _tileWords) {
+        EXPECT_EQ(0, word);
+    }
+    for (auto const& word : _blockWords) {
+        EXPECT_EQ(0, word);
+    }
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+
+class RandomStreamTest : public ::testing::Test
+{
+public:
+    virtual ~RandomStreamTest() = default;
+};
+
+//known answers from the Random123 reference implementation
+TEST_F(RandomStreamTest, testPhiloxKnownAnswers)
+{
+    uint32_t result[4];
+    {
+        uint32_t const counter[4] = {0, 0, 0, 0};
+        uint32_t const key[2] = {0, 0};
+        RandomStream::philox4x32_10(counter, key, result);
+        EXPECT_EQ(0x6627e8d5, result[0]);
+        EXPECT_EQ(0xe169c58d, result[1]);
+        EXPECT_EQ(0xbc57ac4c, result[2]);
+        EXPECT_EQ(0x9b00dbd8, result[3]);
+    }
+    {
+        uint32_t const counter[4] = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+        uint32_t const key[2] = {0xffffffff, 0xffffffff};
+        RandomStream::philox4x32_10(counter, key, result);
+        EXPECT_EQ(0x408f276d, result[0]);
+        EXPECT_EQ(0x41c83b0e, result[1]);
+        EXPECT_EQ(0xa20bc7c6, result[2]);
+        EXPECT_EQ(0x6d5451fd, result[3]);
+    }
+    {
+        uint32_t const counter[4] = {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+        uint32_t const key[2] = {0xa4093822, 0x299f31d0};
+        RandomStream::philox4x32_10(counter, key, result);
+        EXPECT_EQ(0xd16cfe09, result[0]);
+        EXPECT_EQ(0x94fdcceb, result[1]);
+        EXPECT_EQ(0x5001e420, result[2]);
+        EXPECT_EQ(0x24126ea1, result[3]);
+    }
+}
+
+TEST_F(RandomStreamTest, testStreamIsPositionAddressable)
+{
+    RandomStream stream(42, 7);
+    vector<uint32_t> sequence;
+    for (int i = 0; i < 100; ++i) {
+        sequence.emplace_back(stream.getUInt());
+    }
+    EXPECT_EQ(100, stream.getPosition());
+
+    for (int position : {0, 1, 3, 4, 5, 63, 99}) {
+        EXPECT_EQ(sequence.at(position), RandomStream::generateNumber(42, 7, position));
+
+        RandomStream streamAtPosition(42, 7, position);
+        EXPECT_EQ(sequence.at(position), streamAtPosition.getUInt());
+    }
+}
+
+TEST_F(RandomStreamTest, testBulkFillEqualsSequentialGeneration)
+{
+    for (int startPosition : {0, 1, 2, 3, 4, 17}) {
+        for (int count : {0, 1, 3, 4, 5, 8, 1001}) {
+            vector<uint32_t> values(count);
+            RandomStream::fill(123, 5, startPosition, values.data(), values.size());
+
+            RandomStream stream(123, 5, startPosition);
+            for (int i = 0; i < count; ++i) {
+                EXPECT_EQ(stream.getUInt(), values.at(i));
+            }
+        }
+    }
+}
+
+TEST_F(RandomStreamTest, testStreamsAreIndependent)
+{
+    RandomStream stream1(1, 0);
+    RandomStream stream2(1, 1);
+    RandomStream stream3(2, 0);
+    int numEqual12 = 0;
+    int numEqual13 = 0;
+    for (int i = 0; i < 1000; ++i) {
+        auto const value1 = stream1.getUInt();
+        if (value1 == stream2.getUInt()) {
+            ++numEqual12;
+        }
+        if (value1 == stream3.getUInt()) {
+            ++numEqual13;
+        }
+    }
+    EXPECT_EQ(0, numEqual12);
+    EXPECT_EQ(0, numEqual13);
+}
+
+TEST_F(RandomStreamTest, testDistribution)
+{
+    int const NumBins = 10;
+    int const NumSamples = 100000;
+    int bins[NumBins] = {};
+    double sum = 0.0;
+    RandomStream stream(2019, 3);
+    for (int i = 0; i < NumSamples; ++i) {
+        auto const value = stream.getFloat();
+        ASSERT_GE(value, 0.0f);
+        ASSERT_LT(value, 1.0f);
+        sum += value;
+        ++bins[stream.getUInt(NumBins)];
+    }
+    EXPECT_NEAR(0.5, sum / NumSamples, 0.01);
+    for (auto const& bin : bins) {
+        EXPECT_NEAR(NumSamples / NumBins, bin, NumSamples / NumBins / 10);
+    }
+}
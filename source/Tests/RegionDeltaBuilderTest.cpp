@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/ServiceLocator.h"
+#include "Base/GlobalFactory.h"
+#include "Base/NumberGenerator.h"
+#include "ModelBasic/ChangeDescriptions.h"
+#include "ModelBasic/Descriptions.h"
+#include "ModelBasic/ModelBasicSettings.h"
+#include "ModelGpu/DataConverter.h"
+#include "ModelGpu/RegionDeltaBuilder.h"
+
+#include "TransferData.h"
+
+class RegionDeltaBuilderTest : public ::testing::Test
+{
+public:
+    RegionDeltaBuilderTest();
+    virtual ~RegionDeltaBuilderTest();
+
+protected:
+    struct DeltaCounts
+    {
+        int numNewClusters = 0;
+        int numModifiedClusters = 0;
+        int numDeletedClusters = 0;
+        int numNewParticles = 0;
+        int numModifiedParticles = 0;
+        int numDeletedParticles = 0;
+    };
+
+    ClusterDescription createCluster(uint64_t id, QVector2D const& pos, int numCells) const;
+
+    DataChangeDescription calcDelta(RegionDeltaBuilder& builder, DataDescription const& data) const;
+    DeltaCounts countChanges(DataChangeDescription const& delta) const;
+
+    NumberGenerator* _numberGen = nullptr;
+    SimulationParameters _parameters;
+};
+
+RegionDeltaBuilderTest::RegionDeltaBuilderTest()
+    : _parameters(ModelBasicSettings::getDefaultSimulationParameters())
+{
+    auto factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+    _numberGen = factory->buildRandomNumberGenerator();
+    _numberGen->init();
+}
+
+RegionDeltaBuilderTest::~RegionDeltaBuilderTest()
+{
+    delete _numberGen;
+}
+
+ClusterDescription RegionDeltaBuilderTest::createCluster(uint64_t id, QVector2D const& pos, int numCells) const
+{
+    auto result = ClusterDescription().setId(id).setPos(pos).setVel({0, 0}).setAngle(0).setAngularVel(0);
+    for (int index = 0; index < numCells; ++index) {
+        result.addCell(CellDescription()
+                           .setId(id * 100 + index)
+                           .setPos(pos + QVector2D(0, index))
+                           .setEnergy(100)
+                           .setMaxConnections(0)
+                           .setCellFeature(CellFeatureDescription()));
+    }
+    return result;
+}
+
+DataChangeDescription RegionDeltaBuilderTest::calcDelta(RegionDeltaBuilder& builder, DataDescription const& data) const
+{
+    TransferData transferData(100, 1000, 100, 1, 1000);
+    auto dataTO = transferData.getDataTO();
+    DataConverter converter(dataTO, _numberGen, _parameters, {1000, 1000});
+    converter.updateData(DataChangeDescription(data));
+    return builder.calcDelta(dataTO, converter, Enums::DataProjection::ALL);
+}
+
+auto RegionDeltaBuilderTest::countChanges(DataChangeDescription const& delta) const -> DeltaCounts
+{
+    DeltaCounts result;
+    for (auto const& cluster : delta.clusters) {
+        result.numNewClusters += cluster.isAdded() ? 1 : 0;
+        result.numModifiedClusters += cluster.isModified() ? 1 : 0;
+        result.numDeletedClusters += cluster.isDeleted() ? 1 : 0;
+    }
+    for (auto const& particle : delta.particles) {
+        result.numNewParticles += particle.isAdded() ? 1 : 0;
+        result.numModifiedParticles += particle.isModified() ? 1 : 0;
+        result.numDeletedParticles += particle.isDeleted() ? 1 : 0;
+    }
+    return result;
+}
+
+TEST_F(RegionDeltaBuilderTest, testCreatedMovedAndDestroyed)
+{
+    DataDescription data;
+    data.addCluster(createCluster(1, {10, 10}, 3));
+    data.addCluster(createCluster(2, {20, 10}, 3));
+    data.addCluster(createCluster(3, {30, 10}, 3));
+    data.addParticle(ParticleDescription().setId(11).setPos({50, 50}).setVel({0, 0}).setEnergy(10));
+    data.addParticle(ParticleDescription().setId(12).setPos({60, 50}).setVel({0, 0}).setEnergy(10));
+
+    RegionDeltaBuilder builder(4);
+    auto counts = countChanges(calcDelta(builder, data));
+    EXPECT_EQ(3, counts.numNewClusters);
+    EXPECT_EQ(2, counts.numNewParticles);
+    EXPECT_EQ(0, counts.numModifiedClusters + counts.numDeletedClusters);
+
+    EXPECT_TRUE(calcDelta(builder, data).empty());
+
+    DataDescription movedData;
+    movedData.addCluster(createCluster(1, {11, 10}, 3));  //moved
+    movedData.addCluster(createCluster(3, {30, 10}, 4));  //cell added
+    movedData.addCluster(createCluster(4, {40, 10}, 2));  //created
+    movedData.addParticle(ParticleDescription().setId(11).setPos({50, 51}).setVel({0, 1}).setEnergy(10));
+    auto const delta = calcDelta(builder, movedData);
+    counts = countChanges(delta);
+    EXPECT_EQ(2, counts.numNewClusters);
+    EXPECT_EQ(1, counts.numModifiedClusters);
+    EXPECT_EQ(2, counts.numDeletedClusters);
+    EXPECT_EQ(0, counts.numNewParticles);
+    EXPECT_EQ(1, counts.numModifiedParticles);
+    EXPECT_EQ(1, counts.numDeletedParticles);
+
+    for (auto const& cluster : delta.clusters) {
+        if (!cluster.isModified()) {
+            continue;
+        }
+        auto const& movedCluster = cluster.getValue();
+        EXPECT_EQ(1, movedCluster.id);
+        EXPECT_EQ(QVector2D(10, 10), movedCluster.pos.getOldValue());
+        EXPECT_EQ(QVector2D(11, 10), movedCluster.pos.getValue());
+        EXPECT_FALSE(movedCluster.vel);
+        ASSERT_EQ(3, movedCluster.cells.size());
+        for (auto const& cell : movedCluster.cells) {
+            EXPECT_TRUE(cell.isModified());
+            EXPECT_EQ(1.0f, cell.getValue().pos.getValue().x() - cell.getValue().pos.getOldValue().x());
+        }
+    }
+}
+
+TEST_F(RegionDeltaBuilderTest, testNumThreadsDoNotChangeResult)
+{
+    DataDescription data;
+    for (int index = 0; index < 50; ++index) {
+        data.addCluster(createCluster(index + 1, {10.0f * index, 10}, 1 + index % 5));
+        data.addParticle(ParticleDescription().setId(1000 + index).setPos({10.0f * index, 50}).setVel({0, 0}).setEnergy(10));
+    }
+    DataDescription changedData;
+    for (int index = 0; index < 50; ++index) {
+        if (index % 3 != 0) {
+            auto const pos = QVector2D(10.0f * index, index % 2 == 0 ? 10 : 12);
+            changedData.addCluster(createCluster(index + 1, pos, 1 + index % 5));
+        }
+        changedData.addParticle(ParticleDescription().setId(1000 + index).setPos({10.0f * index, 50.0f + index % 4}).setVel({0, 0}).setEnergy(10));
+    }
+
+    RegionDeltaBuilder singleThreadedBuilder(1);
+    RegionDeltaBuilder multiThreadedBuilder(7);
+    calcDelta(singleThreadedBuilder, data);
+    calcDelta(multiThreadedBuilder, data);
+    auto const expected = countChanges(calcDelta(singleThreadedBuilder, changedData));
+    auto const actual = countChanges(calcDelta(multiThreadedBuilder, changedData));
+
+    EXPECT_EQ(17, expected.numDeletedClusters);
+    EXPECT_EQ(17, expected.numModifiedClusters);
+    EXPECT_EQ(37, expected.numModifiedParticles);
+    EXPECT_EQ(expected.numNewClusters, actual.numNewClusters);
+    EXPECT_EQ(expected.numModifiedClusters, actual.numModifiedClusters);
+    EXPECT_EQ(expected.numDeletedClusters, actual.numDeletedClusters);
+    EXPECT_EQ(expected.numModifiedParticles, actual.numModifiedParticles);
+}
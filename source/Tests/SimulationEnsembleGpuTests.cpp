@@ -0,0 +1,182 @@
+#include "Base/ServiceLocator.h"
+#include "Base/GlobalFactory.h"
+#include "Base/NumberGenerator.h"
+
+#include "ModelBasic/ChangeDescriptions.h"
+#include "ModelBasic/SimulationController.h"
+
+#include "ModelGpu/SimulationControllerGpu.h"
+#include "ModelGpu/SimulationAccessGpu.h"
+#include "ModelGpu/SimulationEnsembleGpu.h"
+#include "ModelGpu/ModelGpuData.h"
+#include "ModelGpu/ModelGpuBuilderFacade.h"
+
+#include "IntegrationTestHelper.h"
+#include "IntegrationTestFramework.h"
+
+/**
+ * The universes of an ensemble share the device and its constant memory, hence each universe has to yield the same
+ * result as if it were calculated alone by a simulation controller.
+ * No controller may exist while the ensemble exists (see SimulationEnsembleGpu), therefore the fixture does not derive
+ * from IntegrationGpuTestFramework.
+ */
+class SimulationEnsembleGpuTests
+    : public IntegrationTestFramework
+{
+public:
+    SimulationEnsembleGpuTests();
+    virtual ~SimulationEnsembleGpuTests();
+
+protected:
+    SimulationEnsembleGpu::UniverseConfig createConfig(int index) const;
+
+    //two single cells on collision course (whether they fuse depends on the parameters), a rotating cluster and a
+    //particle
+    DataDescription createData(IntVector2D const& universeSize) const;
+
+    DataDescription
+    runAlone(SimulationEnsembleGpu::UniverseConfig const& config, DataDescription const& data, int numTimesteps) const;
+
+    void checkEquality(DataDescription const& expected, DataDescription const& actual) const;
+};
+
+SimulationEnsembleGpuTests::SimulationEnsembleGpuTests()
+    : IntegrationTestFramework({ 900, 600 })
+{
+    auto factory = ServiceLocator::getInstance().getService<GlobalFactory>();
+    _numberGen = factory->buildRandomNumberGenerator();
+    _numberGen->init();
+}
+
+SimulationEnsembleGpuTests::~SimulationEnsembleGpuTests()
+{
+    delete _numberGen;
+}
+
+SimulationEnsembleGpu::UniverseConfig SimulationEnsembleGpuTests::createConfig(int index) const
+{
+    SimulationEnsembleGpu::UniverseConfig result;
+    result.universeSize = 0 == index % 2 ? IntVector2D{ 900, 600 } : IntVector2D{ 600, 400 };
+    result.parameters = _parameters;
+    result.parameters.radiationProb = 0;
+    result.parameters.cellFusionVelocity = 0 == index % 2 ? 0.1f : 1.0f;
+    result.timestep = 100 * index;
+
+    auto& cudaConstants = result.cudaConstants;
+    cudaConstants.NUM_THREADS_PER_BLOCK = 64;
+    cudaConstants.NUM_BLOCKS = 64;
+    cudaConstants.MAX_CLUSTERS = 1000;
+    cudaConstants.MAX_CELLS = 10000;
+    cudaConstants.MAX_PARTICLES = 10000;
+    cudaConstants.MAX_TOKENS = 1000;
+    cudaConstants.MAX_CELLPOINTERS = 10000 * 10;
+    cudaConstants.MAX_CLUSTERPOINTERS = 1000 * 10;
+    cudaConstants.MAX_PARTICLEPOINTERS = 10000 * 10;
+    cudaConstants.MAX_TOKENPOINTERS = 1000 * 10;
+    cudaConstants.DYNAMIC_MEMORY_SIZE = 10000000;
+    cudaConstants.METADATA_DYNAMIC_MEMORY_SIZE = 1000;
+    return result;
+}
+
+DataDescription SimulationEnsembleGpuTests::createData(IntVector2D const& universeSize) const
+{
+    DataDescription result;
+    auto const cellEnergy = _parameters.cellFunctionConstructorOffspringCellEnergy;
+    for (auto const& posAndVel : vector<pair<QVector2D, QVector2D>>{ { { 100, 100 }, { 0.1f, 0 } },
+                                                                     { { 110.2f, 100 }, { -0.1f, 0 } } }) {
+        auto cell = CellDescription()
+                        .setId(_numberGen->getId())
+                        .setPos(posAndVel.first)
+                        .setMaxConnections(2)
+                        .setEnergy(cellEnergy);
+        auto cluster = ClusterDescription()
+                           .setId(_numberGen->getId())
+                           .setVel(posAndVel.second)
+                           .setAngle(0)
+                           .setAngularVel(0)
+                           .addCell(cell);
+        cluster.setPos(cluster.getClusterPosFromCells());
+        result.addCluster(cluster);
+    }
+    result.addCluster(createHorizontalCluster(
+        5, QVector2D(universeSize.x / 2, universeSize.y / 2), QVector2D(0.2f, -0.1f), 0.5));
+    result.addParticle(createParticle(QVector2D(50, universeSize.y - 50), QVector2D(0.5f, 0)));
+    return result;
+}
+
+DataDescription SimulationEnsembleGpuTests::runAlone(
+    SimulationEnsembleGpu::UniverseConfig const& config,
+    DataDescription const& data,
+    int numTimesteps) const
+{
+    auto const controller = _gpuFacade->buildSimulationController(
+        { config.universeSize, _symbols, config.parameters }, ModelGpuData(config.cudaConstants), config.timestep);
+    auto const access = _gpuFacade->buildSimulationAccess();
+    access->init(controller);
+
+    IntegrationTestHelper::updateData(access, data);
+    IntegrationTestHelper::runSimulation(numTimesteps, controller);
+    auto const result = IntegrationTestHelper::getContent(access, { { 0, 0 }, config.universeSize });
+
+    delete access;
+    delete controller;
+    return result;
+}
+
+void SimulationEnsembleGpuTests::checkEquality(DataDescription const& expected, DataDescription const& actual) const
+{
+    ASSERT_EQ(expected.clusters.is_initialized(), actual.clusters.is_initialized());
+    if (expected.clusters) {
+        EXPECT_EQ(expected.clusters->size(), actual.clusters->size());
+    }
+    auto const expectedCellById = IntegrationTestHelper::getCellByCellId(expected);
+    auto const actualCellById = IntegrationTestHelper::getCellByCellId(actual);
+    ASSERT_EQ(expectedCellById.size(), actualCellById.size());
+    for (auto const& cellAndId : expectedCellById) {
+        auto const& expectedCell = cellAndId.second;
+        auto const& actualCell = actualCellById.at(cellAndId.first);
+        checkCompatibility(*expectedCell.pos, *actualCell.pos);
+        checkCompatibility(*expectedCell.energy, *actualCell.energy);
+        EXPECT_EQ(expectedCell.connectingCells->size(), actualCell.connectingCells->size());
+    }
+
+    auto const expectedParticleById = IntegrationTestHelper::getParticleByParticleId(expected);
+    auto const actualParticleById = IntegrationTestHelper::getParticleByParticleId(actual);
+    ASSERT_EQ(expectedParticleById.size(), actualParticleById.size());
+    for (auto const& particleAndId : expectedParticleById) {
+        auto const& expectedParticle = particleAndId.second;
+        auto const& actualParticle = actualParticleById.at(particleAndId.first);
+        checkCompatibility(*expectedParticle.pos, *actualParticle.pos);
+        checkCompatibility(*expectedParticle.vel, *actualParticle.vel);
+    }
+}
+
+TEST_F(SimulationEnsembleGpuTests, testUniversesEqualSingleRuns)
+{
+    int const numUniverses = 4;
+    int const numTimesteps = 150;
+
+    vector<SimulationEnsembleGpu::UniverseConfig> configs;
+    vector<DataDescription> origData;
+    for (int index = 0; index < numUniverses; ++index) {
+        configs.emplace_back(createConfig(index));
+        origData.emplace_back(createData(configs.back().universeSize));
+    }
+
+    //the ensemble has to be deleted before the single runs
+    auto const ensemble = _gpuFacade->buildSimulationEnsemble();
+    for (int index = 0; index < numUniverses; ++index) {
+        EXPECT_EQ(index, ensemble->addUniverse(configs[index], origData[index]));
+    }
+    ensemble->calculateTimesteps(numTimesteps);
+    vector<DataDescription> ensembleData;
+    for (int index = 0; index < numUniverses; ++index) {
+        EXPECT_EQ(configs[index].timestep + numTimesteps, ensemble->getTimestep(index));
+        ensembleData.emplace_back(ensemble->getData(index));
+    }
+    delete ensemble;
+
+    for (int index = 0; index < numUniverses; ++index) {
+        checkEquality(runAlone(configs[index], origData[index], numTimesteps), ensembleData[index]);
+    }
+}
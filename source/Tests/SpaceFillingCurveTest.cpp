@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+#include "ModelGpu/SpaceFillingCurve.h"
+
+class SpaceFillingCurveTest : public ::testing::Test
+{
+public:
+    SpaceFillingCurveTest();
+    virtual ~SpaceFillingCurveTest() = default;
+
+protected:
+    //size similar to the device cells
+    struct Entity
+    {
+        float posX;
+        float posY;
+        float energy;
+        float padding[29];
+    };
+    vector<Entity> createRandomEntities(int numEntities);
+    vector<Entity> reorder(vector<Entity> const& entities) const;
+
+    //index of the entity at each position of the universe or -1
+    vector<int> createMap(vector<Entity> const& entities) const;
+
+    //sums the energies of all entities in the neighborhood of each entity via the map
+    float sumNeighborEnergies(vector<Entity> const& entities, vector<int> const& map) const;
+
+    float calcMeanIndexDistanceOfNeighbors(vector<Entity> const& entities, vector<int> const& map) const;
+
+    int const _universeSizeX = 1024;
+    int const _universeSizeY = 1024;
+    RandomStream _random;
+};
+
+SpaceFillingCurveTest::SpaceFillingCurveTest()
+    : _random(1, 0)
+{}
+
+auto SpaceFillingCurveTest::createRandomEntities(int numEntities) -> vector<Entity>
+{
+    vector<Entity> result;
+    for (int i = 0; i < numEntities; ++i) {
+        Entity entity;
+        entity.posX = _random.getFloat() * _universeSizeX;
+        entity.posY = _random.getFloat() * _universeSizeY;
+        entity.energy = _random.getFloat();
+        result.emplace_back(entity);
+    }
+    return result;
+}
+
+auto SpaceFillingCurveTest::reorder(vector<Entity> const& entities) const -> vector<Entity>
+{
+    auto const order = calcSpaceFillingCurveOrder(entities, _universeSizeX, _universeSizeY, [](Entity const& entity) {
+        return std::make_pair(entity.posX, entity.posY);
+    });
+    vector<Entity> result;
+    for (int index : order) {
+        result.emplace_back(entities[index]);
+    }
+    return result;
+}
+
+vector<int> SpaceFillingCurveTest::createMap(vector<Entity> const& entities) const
+{
+    vector<int> result(_universeSizeX * _universeSizeY, -1);
+    for (int index = 0; index < entities.size(); ++index) {
+        auto const& entity = entities[index];
+        result[static_cast<int>(entity.posX) + static_cast<int>(entity.posY) * _universeSizeX] = index;
+    }
+    return result;
+}
+
+namespace
+{
+    int const NeighborhoodRadius = 2;
+}
+
+float SpaceFillingCurveTest::sumNeighborEnergies(vector<Entity> const& entities, vector<int> const& map) const
+{
+    float result = 0;
+    for (auto const& entity : entities) {
+        auto const x = static_cast<int>(entity.posX);
+        auto const y = static_cast<int>(entity.posY);
+        for (int dy = -NeighborhoodRadius; dy <= NeighborhoodRadius; ++dy) {
+            for (int dx = -NeighborhoodRadius; dx <= NeighborhoodRadius; ++dx) {
+                auto const mapX = (x + dx + _universeSizeX) % _universeSizeX;
+                auto const mapY = (y + dy + _universeSizeY) % _universeSizeY;
+                auto const neighborIndex = map[mapX + mapY * _universeSizeX];
+                if (-1 != neighborIndex) {
+                    result += entities[neighborIndex].energy;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+float SpaceFillingCurveTest::calcMeanIndexDistanceOfNeighbors(vector<Entity> const& entities, vector<int> const& map)
+    const
+{
+    double sum = 0;
+    int num = 0;
+    for (int index = 0; index < entities.size(); ++index) {
+        auto const x = static_cast<int>(entities[index].posX);
+        auto const y = static_cast<int>(entities[index].posY);
+        for (int dx = 1; dx <= NeighborhoodRadius; ++dx) {
+            auto const neighborIndex = map[(x + dx) % _universeSizeX + y * _universeSizeX];
+            if (-1 != neighborIndex) {
+                sum += std::abs(neighborIndex - index);
+                ++num;
+            }
+        }
+    }
+    return num > 0 ? static_cast<float>(sum / num) : 0.0f;
+}
+
+TEST_F(SpaceFillingCurveTest, testMortonKey)
+{
+    EXPECT_EQ(0, SpaceFillingCurve::calcMortonKey(0, 0));
+    EXPECT_EQ(1, SpaceFillingCurve::calcMortonKey(1, 0));
+    EXPECT_EQ(2, SpaceFillingCurve::calcMortonKey(0, 1));
+    EXPECT_EQ(3, SpaceFillingCurve::calcMortonKey(1, 1));
+    EXPECT_EQ(4, SpaceFillingCurve::calcMortonKey(2, 0));
+    EXPECT_EQ(0x55555555u, SpaceFillingCurve::calcMortonKey(0xffff, 0));
+    EXPECT_EQ(0xffffffffu, SpaceFillingCurve::calcMortonKey(0xffff, 0xffff));
+}
+
+TEST_F(SpaceFillingCurveTest, testKeyIsClampedToUniverse)
+{
+    EXPECT_EQ(0, SpaceFillingCurve::calcKey(-1.0f, -1.0f, _universeSizeX, _universeSizeY, 7));
+    EXPECT_EQ((1u << 14) - 1, SpaceFillingCurve::calcKey(
+        static_cast<float>(_universeSizeX), static_cast<float>(_universeSizeY), _universeSizeX, _universeSizeY, 7));
+}
+
+TEST_F(SpaceFillingCurveTest, testOrderIsSortedAndStable)
+{
+    auto entities = createRandomEntities(10000);
+    for (int i = 0; i < 1000; ++i) {
+        entities.emplace_back(entities[i]);
+    }
+    auto const order = calcSpaceFillingCurveOrder(entities, _universeSizeX, _universeSizeY, [](Entity const& entity) {
+        return std::make_pair(entity.posX, entity.posY);
+    });
+    ASSERT_EQ(entities.size(), order.size());
+    ASSERT_EQ(set<int>(order.begin(), order.end()).size(), order.size());
+
+    auto getKey = [&](int index) {
+        return SpaceFillingCurve::calcKey(
+            entities[index].posX,
+            entities[index].posY,
+            _universeSizeX,
+            _universeSizeY,
+            SpaceFillingCurve::MaxNumBitsPerAxis);
+    };
+    for (int i = 1; i < order.size(); ++i) {
+        ASSERT_LE(getKey(order[i - 1]), getKey(order[i]));
+        if (getKey(order[i - 1]) == getKey(order[i])) {
+            ASSERT_LT(order[i - 1], order[i]);
+        }
+    }
+}
+
+TEST_F(SpaceFillingCurveTest, testNeighborsAreCloseInMemory)
+{
+    auto const entities = createRandomEntities(100000);
+    auto const reorderedEntities = reorder(entities);
+
+    auto const distance = calcMeanIndexDistanceOfNeighbors(entities, createMap(entities));
+    auto const reorderedDistance = calcMeanIndexDistanceOfNeighbors(reorderedEntities, createMap(reorderedEntities));
+    EXPECT_LT(reorderedDistance * 10, distance);
+}
+
+TEST_F(SpaceFillingCurveTest, benchmarkNeighborAccess)
+{
+    auto const entities = createRandomEntities(300000);
+    auto const reorderedEntities = reorder(entities);
+    auto const map = createMap(entities);
+    auto const reorderedMap = createMap(reorderedEntities);
+
+    auto measure = [&](vector<Entity> const& entities, vector<int> const& map, float& energy) {
+        auto const start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 5; ++i) {
+            energy = sumNeighborEnergies(entities, map);
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+    float energy, reorderedEnergy;
+    auto const time = measure(entities, map, energy);
+    auto const reorderedTime = measure(reorderedEntities, reorderedMap, reorderedEnergy);
+    std::cerr << "Time elapsed for neighbor access in insertion order: " << time << " ms" << std::endl;
+    std::cerr << "Time elapsed for neighbor access in Morton order: " << reorderedTime << " ms" << std::endl;
+
+    EXPECT_NEAR(energy, reorderedEnergy, energy * 1e-3f);
+}
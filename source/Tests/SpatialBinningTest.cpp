@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+#include "ModelGpu/SpatialBinning.h"
+
+class SpatialBinningTest : public ::testing::Test
+{
+public:
+    SpatialBinningTest();
+    virtual ~SpatialBinningTest() = default;
+
+protected:
+    struct Entry
+    {
+        int id;
+        float posX;
+        float posY;
+    };
+    vector<Entry> createRandomEntries(int numEntries);
+    float calcDistance(Entry const& entry, float posX, float posY) const;
+
+    //universe size is no multiple of the section size
+    int const _universeSizeX = 1010;
+    int const _universeSizeY = 620;
+    int const _sectionSize = 50;
+    HostSpatialBinning<Entry> _binning;
+    RandomStream _random;
+};
+
+SpatialBinningTest::SpatialBinningTest()
+    : _binning(_universeSizeX, _universeSizeY, _sectionSize)
+    , _random(1, 0)
+{}
+
+auto SpatialBinningTest::createRandomEntries(int numEntries) -> vector<Entry>
+{
+    vector<Entry> result;
+    for (int i = 0; i < numEntries; ++i) {
+        result.emplace_back(Entry{i, _random.getFloat() * _universeSizeX, _random.getFloat() * _universeSizeY});
+    }
+    return result;
+}
+
+float SpatialBinningTest::calcDistance(Entry const& entry, float posX, float posY) const
+{
+    auto deltaX = std::abs(entry.posX - posX);
+    auto deltaY = std::abs(entry.posY - posY);
+    deltaX = std::min(deltaX, _universeSizeX - deltaX);
+    deltaY = std::min(deltaY, _universeSizeY - deltaY);
+    return std::sqrt(deltaX * deltaX + deltaY * deltaY);
+}
+
+TEST_F(SpatialBinningTest, testEntriesAreBinnedStably)
+{
+    auto const entries = createRandomEntries(5000);
+    _binning.build(entries, [](Entry const& entry) { return std::make_pair(entry.posX, entry.posY); });
+
+    auto const& layout = _binning.getLayout();
+    int numEntries = 0;
+    for (int section = 0; section < layout.getNumSections(); ++section) {
+        auto const sectionEntries = _binning.getEntries(section);
+        for (int index = 0; index < _binning.getNumEntries(section); ++index) {
+            auto const& entry = sectionEntries[index];
+            EXPECT_EQ(section, layout.getSectionIndex(entry.posX, entry.posY));
+            if (index > 0) {
+                EXPECT_LT(sectionEntries[index - 1].id, entry.id);
+            }
+        }
+        numEntries += _binning.getNumEntries(section);
+    }
+    EXPECT_EQ(5000, numEntries);
+}
+
+TEST_F(SpatialBinningTest, testRadiusQueryEqualsBruteForce)
+{
+    auto const entries = createRandomEntries(2000);
+    _binning.build(entries, [](Entry const& entry) { return std::make_pair(entry.posX, entry.posY); });
+
+    for (int i = 0; i < 500; ++i) {
+        auto const posX = _random.getFloat() * _universeSizeX;
+        auto const posY = _random.getFloat() * _universeSizeY;
+        auto const radius = i % 10 == 0 ? _random.getFloat() * 400 : _random.getFloat() * 120;
+
+        set<int> expected;
+        for (auto const& entry : entries) {
+            if (calcDistance(entry, posX, posY) < radius) {
+                expected.insert(entry.id);
+            }
+        }
+
+        set<int> actual;
+        _binning.forEachEntryAround(posX, posY, radius, [&](Entry const& entry) {
+            if (calcDistance(entry, posX, posY) < radius) {
+                EXPECT_TRUE(actual.insert(entry.id).second);
+            }
+        });
+        ASSERT_EQ(expected, actual);
+    }
+}
+
+TEST_F(SpatialBinningTest, testEmpty)
+{
+    _binning.build({}, [](Entry const& entry) { return std::make_pair(entry.posX, entry.posY); });
+    for (int section = 0; section < _binning.getLayout().getNumSections(); ++section) {
+        EXPECT_EQ(0, _binning.getNumEntries(section));
+    }
+}
@@ -0,0 +1,68 @@
+#include <cmath>
+
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/TaskScheduler.h"
+
+class TaskSchedulerBenchmark : public ::testing::Test
+{
+public:
+    TaskSchedulerBenchmark() = default;
+    virtual ~TaskSchedulerBenchmark() = default;
+
+protected:
+    static double calcWork(int index);
+};
+
+double TaskSchedulerBenchmark::calcWork(int index)
+{
+    double result = 0;
+    for (int i = 0; i < 200; ++i) {
+        result += std::sin(index * 0.001 + i);
+    }
+    return result;
+}
+
+TEST_F(TaskSchedulerBenchmark, testParallelReduce)
+{
+    auto const numIndices = 200000;
+    auto const sum = [&](TaskScheduler& scheduler) {
+        return scheduler.parallelReduce(
+            0,
+            numIndices,
+            0.0,
+            [](double& partialSum, int index) { partialSum += calcWork(index); },
+            [](double value1, double value2) { return value1 + value2; },
+            1000);
+    };
+
+    TaskScheduler singleThreadedScheduler(1);
+    QElapsedTimer timer;
+    timer.start();
+    auto const expected = sum(singleThreadedScheduler);
+    std::cerr << "Time elapsed with 1 thread: " << timer.elapsed() << " ms" << std::endl;
+
+    auto& scheduler = TaskScheduler::getInstance();
+    timer.start();
+    auto const actual = sum(scheduler);
+    std::cerr << "Time elapsed with " << scheduler.getNumThreads() << " threads: " << timer.elapsed() << " ms"
+              << std::endl;
+    EXPECT_EQ(expected, actual);
+}
+
+TEST_F(TaskSchedulerBenchmark, testFineGrainedTasks)
+{
+    auto& scheduler = TaskScheduler::getInstance();
+    vector<double> results(100000);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int run = 0; run < 20; ++run) {
+        scheduler.parallelFor(0, static_cast<int>(results.size()), [&](int index) { results[index] = index * 0.5; }, 16);
+    }
+    std::cerr << "Time elapsed for 20 x " << results.size() / 16 << " tasks: " << timer.elapsed() << " ms"
+              << std::endl;
+}
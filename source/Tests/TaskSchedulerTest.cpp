@@ -0,0 +1,143 @@
+#include <atomic>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/TaskScheduler.h"
+#include "Base/TraceRecorder.h"
+
+class TaskSchedulerTest : public ::testing::Test
+{
+public:
+    TaskSchedulerTest();
+    virtual ~TaskSchedulerTest() = default;
+
+protected:
+    TaskScheduler _scheduler;
+};
+
+TaskSchedulerTest::TaskSchedulerTest()
+    : _scheduler(4)
+{
+}
+
+TEST_F(TaskSchedulerTest, testParallelForVisitsEachIndexOnce)
+{
+    vector<std::atomic<int>> visits(10000);
+    _scheduler.parallelFor(0, 10000, [&](int index) { ++visits[index]; });
+    _scheduler.parallelFor(0, 10000, [&](int index) { ++visits[index]; }, 7);
+    _scheduler.parallelFor(5, 5, [&](int index) { ++visits[index]; });
+
+    for (auto const& visit : visits) {
+        ASSERT_EQ(2, visit.load());
+    }
+}
+
+TEST_F(TaskSchedulerTest, testParallelReduceIndependentOfNumThreads)
+{
+    auto const sum = [](TaskScheduler& scheduler, int grainSize) {
+        return scheduler.parallelReduce(
+            0,
+            100000,
+            0.0f,
+            [](float& partialSum, int index) { partialSum += 1.0f / (1 + index); },
+            [](float value1, float value2) { return value1 + value2; },
+            grainSize);
+    };
+
+    TaskScheduler singleThreadedScheduler(1);
+    for (int grainSize : {100, 0}) {
+        auto const expected = sum(singleThreadedScheduler, grainSize);
+        for (int run = 0; run < 10; ++run) {
+            EXPECT_EQ(expected, sum(_scheduler, grainSize));
+        }
+    }
+    EXPECT_EQ(0.0f, _scheduler.parallelReduce(3, 3, 0.0f, [](float&, int) {}, std::plus<float>()));
+}
+
+TEST_F(TaskSchedulerTest, testNestedParallelFor)
+{
+    vector<std::atomic<int>> visits(100 * 100);
+    _scheduler.parallelFor(0, 100, [&](int outerIndex) {
+        _scheduler.parallelFor(0, 100, [&](int innerIndex) { ++visits[outerIndex * 100 + innerIndex]; });
+    }, 1);
+
+    for (auto const& visit : visits) {
+        ASSERT_EQ(1, visit.load());
+    }
+}
+
+TEST_F(TaskSchedulerTest, testTaskGraphOrder)
+{
+    std::atomic<int> counter{0};
+    vector<int> order(5, -1);
+    auto const record = [&](int taskIndex) { return [&, taskIndex] { order[taskIndex] = counter++; }; };
+
+    TaskGraph graph;
+    auto const load = graph.addTask(record(0));
+    auto const convert1 = graph.addTask(record(1), {load});
+    auto const convert2 = graph.addTask(record(2), {load});
+    auto const merge = graph.addTask(record(3), {convert1, convert2});
+    graph.addTask(record(4), {merge, load});
+    graph.run(_scheduler);
+
+    EXPECT_EQ(0, order[0]);
+    EXPECT_LT(order[0], order[1]);
+    EXPECT_LT(order[0], order[2]);
+    EXPECT_LT(order[1], order[3]);
+    EXPECT_LT(order[2], order[3]);
+    EXPECT_EQ(4, order[4]);
+}
+
+TEST_F(TaskSchedulerTest, testCancellation)
+{
+    CancellationToken cancellation;
+    std::atomic<int> numVisits{0};
+    _scheduler.parallelFor(0, 1000, [&](int index) {
+        ++numVisits;
+        if (10 == index) {
+            cancellation.cancel();
+        }
+    }, 1, &cancellation);
+
+    EXPECT_TRUE(cancellation.isCancelled());
+    EXPECT_GE(numVisits.load(), 11);
+    EXPECT_LT(numVisits.load(), 1000);
+}
+
+TEST_F(TaskSchedulerTest, testExceptionPropagation)
+{
+    EXPECT_THROW(
+        _scheduler.parallelFor(0, 100, [](int index) {
+            if (50 == index) {
+                throw std::runtime_error("task failed");
+            }
+        }, 1),
+        std::runtime_error);
+
+    bool successorExecuted = false;
+    TaskGraph graph;
+    auto const failing = graph.addTask([] { throw std::runtime_error("task failed"); });
+    graph.addTask([&] { successorExecuted = true; }, {failing});
+    EXPECT_THROW(graph.run(_scheduler), std::runtime_error);
+    EXPECT_FALSE(successorExecuted);
+
+    //the scheduler remains usable
+    std::atomic<int> numVisits{0};
+    _scheduler.parallelFor(0, 100, [&](int) { ++numVisits; });
+    EXPECT_EQ(100, numVisits.load());
+}
+
+TEST_F(TaskSchedulerTest, testNamedTasksAreTraced)
+{
+    auto& recorder = TraceRecorder::getInstance();
+    recorder.clear();
+    recorder.setEnabled(true);
+    _scheduler.parallelFor(0, 8, [](int) {}, 1, nullptr, "traced chunk");
+    recorder.setEnabled(false);
+
+    auto const json = recorder.exportToJson();
+    recorder.clear();
+    EXPECT_NE(string::npos, json.find("traced chunk"));
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+#include "ModelGpu/TiledMap.h"
+
+class TiledMapTest : public ::testing::Test
+{
+public:
+    TiledMapTest();
+    virtual ~TiledMapTest() = default;
+
+protected:
+    vector<std::pair<int, int>> createRandomPositions(int numPositions, int width, int height);
+
+    RandomStream _random;
+};
+
+TiledMapTest::TiledMapTest()
+    : _random(1, 0)
+{}
+
+vector<std::pair<int, int>> TiledMapTest::createRandomPositions(int numPositions, int width, int height)
+{
+    vector<std::pair<int, int>> result;
+    for (int i = 0; i < numPositions; ++i) {
+        result.emplace_back(_random.getUInt(width - 1), _random.getUInt(height - 1));
+    }
+    return result;
+}
+
+TEST_F(TiledMapTest, testSetGetClearEqualsDenseMap)
+{
+    int const width = 500;
+    int const height = 333;     //no multiple of the tile size
+    HostTiledMap<int> tiledMap(width, height, 0);
+    auto& map = tiledMap.getMap();
+    vector<int> denseMap(width * height, 0);
+
+    auto const positions = createRandomPositions(20000, width, height);
+    for (int index = 0; index < positions.size(); ++index) {
+        auto const& pos = positions[index];
+        *map.getOrCreateEntry(pos.first, pos.second) = index + 1;
+        denseMap[pos.first + pos.second * width] = index + 1;
+    }
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) {
+            ASSERT_EQ(denseMap[x + y * width], map.get(x, y));
+        }
+    }
+
+    for (auto const& pos : positions) {
+        map.clear(pos.first, pos.second);
+    }
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) {
+            ASSERT_EQ(0, map.get(x, y));
+        }
+    }
+    EXPECT_EQ(0, tiledMap.getNumAllocatedTiles());
+}
+
+TEST_F(TiledMapTest, testTilesAreReleasedWithLastEntry)
+{
+    HostTiledMap<int> tiledMap(100, 100, 0);
+    auto& map = tiledMap.getMap();
+
+    *map.getOrCreateEntry(3, 4) = 1;
+    *map.getOrCreateEntry(5, 6) = 2;
+    *map.getOrCreateEntry(5, 6) = 3;       //second entry at the same position as in the cell map
+    *map.getOrCreateEntry(99, 99) = 4;
+    EXPECT_EQ(2, tiledMap.getNumAllocatedTiles());
+
+    map.clear(5, 6);
+    map.clear(3, 4);
+    EXPECT_EQ(2, tiledMap.getNumAllocatedTiles());
+    map.clear(5, 6);
+    EXPECT_EQ(1, tiledMap.getNumAllocatedTiles());
+    EXPECT_EQ(4, map.get(99, 99));
+    map.clear(99, 99);
+    EXPECT_EQ(0, tiledMap.getNumAllocatedTiles());
+}
+
+TEST_F(TiledMapTest, testExhaustedPool)
+{
+    HostTiledMap<int> tiledMap(320, 320, 2);
+    auto& map = tiledMap.getMap();
+
+    EXPECT_NE(nullptr, map.getOrCreateEntry(0, 0));
+    EXPECT_NE(nullptr, map.getOrCreateEntry(40, 0));
+    EXPECT_EQ(nullptr, map.getOrCreateEntry(80, 0));
+    EXPECT_NE(nullptr, map.getOrCreateEntry(41, 1));    //allocated tile can still be populated
+    EXPECT_EQ(0, map.get(80, 0));
+    EXPECT_EQ(1, map.getNumLostEntries());
+
+    map.clear(0, 0);
+    EXPECT_NE(nullptr, map.getOrCreateEntry(80, 0));
+    EXPECT_EQ(1, map.getNumLostEntries());
+}
+
+TEST_F(TiledMapTest, testRequiredPoolIsNeverExhausted)
+{
+    int const maxEntries = 50;
+    auto const numRequiredTiles = TiledMap<int>::getNumRequiredPoolTiles(3200, 3200, maxEntries);
+    EXPECT_EQ(maxEntries, numRequiredTiles);
+    EXPECT_EQ(4, TiledMap<int>::getNumRequiredPoolTiles(64, 64, maxEntries));
+
+    //entries in distinct tiles
+    HostTiledMap<int> tiledMap(3200, 3200, numRequiredTiles);
+    auto& map = tiledMap.getMap();
+    for (int i = 0; i < maxEntries; ++i) {
+        EXPECT_NE(nullptr, map.getOrCreateEntry(i * 64, i * 32));
+    }
+    EXPECT_EQ(0, map.getNumLostEntries());
+}
+
+TEST_F(TiledMapTest, testSparseHugeUniverse)
+{
+    int const size = 20000;
+    int const maxTiles = 1000;
+    HostTiledMap<unsigned long long> tiledMap(size, size, maxTiles);
+    auto& map = tiledMap.getMap();
+    EXPECT_EQ(maxTiles, tiledMap.getNumPoolTiles());
+
+    //a few dense colonies in an empty universe
+    vector<std::pair<int, int>> positions;
+    for (int colony = 0; colony < 20; ++colony) {
+        auto const centerX = static_cast<int>(_random.getUInt(size - 1));
+        auto const centerY = static_cast<int>(_random.getUInt(size - 1));
+        for (auto const& delta : createRandomPositions(2000, 100, 100)) {
+            positions.emplace_back((centerX + delta.first) % size, (centerY + delta.second) % size);
+        }
+    }
+    for (int timestep = 0; timestep < 3; ++timestep) {
+        for (auto const& pos : positions) {
+            auto const entry = map.getOrCreateEntry(pos.first, pos.second);
+            ASSERT_NE(nullptr, entry);
+            *entry = 1;
+        }
+        EXPECT_GE(20 * 25, tiledMap.getNumAllocatedTiles());
+        for (auto const& pos : positions) {
+            map.clear(pos.first, pos.second);
+        }
+        EXPECT_EQ(0, tiledMap.getNumAllocatedTiles());
+    }
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include "ModelGpu/TokenBucketSorter.h"
+
+class TokenBucketSorterTest : public ::testing::Test
+{
+public:
+    TokenBucketSorterTest();
+    virtual ~TokenBucketSorterTest() = default;
+
+protected:
+    //each token gets a sequence number in its memory
+    void addCluster(vector<int> const& cellFunctions, vector<int> const& tokenCellIndices);
+    DataAccessTO getDataTO();
+
+    //token memories by cell index in the order of the tokens
+    map<int, vector<string>> getTokenMemoriesByCell() const;
+
+    int _numClusters = 0;
+    int _numCells = 0;
+    int _numParticles = 0;
+    int _numTokens = 0;
+    int _numStringBytes = 0;
+    vector<ClusterAccessTO> _clusters;
+    vector<CellAccessTO> _cells;
+    vector<TokenAccessTO> _tokens;
+};
+
+TokenBucketSorterTest::TokenBucketSorterTest()
+{
+    _clusters.reserve(1000);
+    _cells.reserve(10000);
+    _tokens.reserve(10000);
+}
+
+void TokenBucketSorterTest::addCluster(vector<int> const& cellFunctions, vector<int> const& tokenCellIndices)
+{
+    ClusterAccessTO clusterTO = {};
+    clusterTO.numCells = static_cast<int>(cellFunctions.size());
+    clusterTO.cellStartIndex = static_cast<int>(_cells.size());
+    clusterTO.numTokens = static_cast<int>(tokenCellIndices.size());
+    clusterTO.tokenStartIndex = static_cast<int>(_tokens.size());
+    for (auto const& cellFunction : cellFunctions) {
+        CellAccessTO cellTO = {};
+        cellTO.cellFunctionType = cellFunction;
+        _cells.emplace_back(cellTO);
+    }
+    for (auto const& tokenCellIndex : tokenCellIndices) {
+        TokenAccessTO tokenTO = {};
+        tokenTO.cellIndex = clusterTO.cellStartIndex + tokenCellIndex;
+        tokenTO.memory[1] = static_cast<char>(_tokens.size() % 128);
+        tokenTO.memory[2] = static_cast<char>(_tokens.size() / 128);
+        _tokens.emplace_back(tokenTO);
+    }
+    _clusters.emplace_back(clusterTO);
+}
+
+DataAccessTO TokenBucketSorterTest::getDataTO()
+{
+    _numClusters = static_cast<int>(_clusters.size());
+    _numCells = static_cast<int>(_cells.size());
+    _numTokens = static_cast<int>(_tokens.size());
+
+    DataAccessTO result;
+    result.numClusters = &_numClusters;
+    result.clusters = _clusters.data();
+    result.numCells = &_numCells;
+    result.cells = _cells.data();
+    result.numParticles = &_numParticles;
+    result.numTokens = &_numTokens;
+    result.tokens = _tokens.data();
+    result.numStringBytes = &_numStringBytes;
+    return result;
+}
+
+map<int, vector<string>> TokenBucketSorterTest::getTokenMemoriesByCell() const
+{
+    map<int, vector<string>> result;
+    for (auto const& token : _tokens) {
+        result[token.cellIndex].emplace_back(string(token.memory, MAX_TOKEN_MEM_SIZE));
+    }
+    return result;
+}
+
+TEST_F(TokenBucketSorterTest, testBucketsAreSortedAndStable)
+{
+    addCluster({Enums::CellFunction::WEAPON, Enums::CellFunction::COMPUTER, Enums::CellFunction::SCANNER}, {0, 1, 2, 1, 0});
+    addCluster({Enums::CellFunction::COMPUTER}, {});
+    addCluster(
+        {Enums::CellFunction::COMMUNICATOR, Enums::CellFunction::COMPUTER, Enums::CellFunction::_COUNTER + 1},
+        {2, 0, 1, 2, 0, 1});
+    auto const dataTO = getDataTO();
+
+    TokenBucketSorter sorter;
+    sorter.sortTokens(dataTO);
+
+    auto const expectTokens = [&](int tokenIndex, int cellIndex, int sequenceNumber) {
+        EXPECT_EQ(cellIndex, _tokens[tokenIndex].cellIndex);
+        EXPECT_EQ(sequenceNumber, _tokens[tokenIndex].memory[1]);
+    };
+    expectTokens(0, 1, 1);  //computer
+    expectTokens(1, 1, 3);
+    expectTokens(2, 2, 2);  //scanner
+    expectTokens(3, 0, 0);  //weapon
+    expectTokens(4, 0, 4);
+    expectTokens(5, 5, 7);  //computer
+    expectTokens(6, 5, 10);
+    expectTokens(7, 6, 5);  //propulsion (function type is taken modulo the number of functions)
+    expectTokens(8, 6, 8);
+    expectTokens(9, 4, 6);  //communicator
+    expectTokens(10, 4, 9);
+
+    auto const bucketStarts = sorter.getBucketStarts(0);
+    EXPECT_EQ(0, bucketStarts[Enums::CellFunction::COMPUTER]);
+    EXPECT_EQ(2, bucketStarts[Enums::CellFunction::SCANNER]);
+    EXPECT_EQ(3, bucketStarts[Enums::CellFunction::WEAPON]);
+    EXPECT_EQ(5, bucketStarts[NumTokenBuckets]);
+    EXPECT_EQ(0, sorter.getBucketStarts(1)[NumTokenBuckets]);
+    EXPECT_EQ(4, sorter.getBucketStarts(2)[Enums::CellFunction::SCANNER]);
+}
+
+TEST_F(TokenBucketSorterTest, testTokenMemoriesOfCellsUnchanged)
+{
+    for (int clusterIndex = 0; clusterIndex < 200; ++clusterIndex) {
+        vector<int> cellFunctions;
+        vector<int> tokenCellIndices;
+        auto const numCells = 1 + clusterIndex % 13;
+        for (int cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+            cellFunctions.emplace_back((clusterIndex * 7 + cellIndex * 3) % Enums::CellFunction::_COUNTER);
+        }
+        for (int tokenIndex = 0; tokenIndex < clusterIndex % 17; ++tokenIndex) {
+            tokenCellIndices.emplace_back((tokenIndex * 5 + clusterIndex) % numCells);
+        }
+        addCluster(cellFunctions, tokenCellIndices);
+    }
+    auto const dataTO = getDataTO();
+    auto const origTokenMemoriesByCell = getTokenMemoriesByCell();
+
+    TokenBucketSorter sorter;
+    sorter.sortTokens(dataTO);
+
+    EXPECT_EQ(origTokenMemoriesByCell, getTokenMemoriesByCell());
+    for (int clusterIndex = 0; clusterIndex < _numClusters; ++clusterIndex) {
+        auto const& cluster = _clusters[clusterIndex];
+        auto const bucketStarts = sorter.getBucketStarts(clusterIndex);
+        ASSERT_EQ(cluster.numTokens, bucketStarts[NumTokenBuckets]);
+        for (int bucket = 0; bucket < NumTokenBuckets; ++bucket) {
+            for (int index = bucketStarts[bucket]; index < bucketStarts[bucket + 1]; ++index) {
+                auto const& token = _tokens[cluster.tokenStartIndex + index];
+                ASSERT_LE(cluster.cellStartIndex, token.cellIndex);
+                ASSERT_GT(cluster.cellStartIndex + cluster.numCells, token.cellIndex);
+                EXPECT_EQ(bucket, _cells[token.cellIndex].cellFunctionType);
+            }
+        }
+    }
+}
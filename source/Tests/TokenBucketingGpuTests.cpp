@@ -0,0 +1,109 @@
+#include "Base/ServiceLocator.h"
+#include "ModelBasic/CellComputerCompiler.h"
+#include "ModelBasic/ModelBasicSettings.h"
+
+#include "IntegrationGpuTestFramework.h"
+
+class TokenBucketingGpuTests
+    : public IntegrationGpuTestFramework
+{
+public:
+    TokenBucketingGpuTests() : IntegrationGpuTestFramework({ 600, 300 })
+    {}
+
+    virtual ~TokenBucketingGpuTests() = default;
+
+protected:
+    virtual void SetUp();
+
+    //clusters with cells of alternating functions, tokens are moving along the cells
+    DataDescription createMixedFunctionData() const;
+
+    //token memories by cell id after running the simulation
+    map<uint64_t, vector<QByteArray>> runSimulation(DataDescription const& data, bool tokenBucketing);
+};
+
+void TokenBucketingGpuTests::SetUp()
+{
+    _parameters.radiationProb = 0;    //exclude radiation
+    _context->setSimulationParameters(_parameters);
+}
+
+DataDescription TokenBucketingGpuTests::createMixedFunctionData() const
+{
+    auto basicFacade = ServiceLocator::getInstance().getService<ModelBasicBuilderFacade>();
+    auto compiler =
+        basicFacade->buildCellComputerCompiler(_context->getSymbolTable(), _context->getSimulationParameters());
+    auto const program = compiler->compileSourceCode("add [10], 1\nmov [11], [10]").compilation;
+    delete compiler;
+
+    vector<Enums::CellFunction::Type> const cellFunctions = {Enums::CellFunction::COMPUTER,
+                                                             Enums::CellFunction::SCANNER,
+                                                             Enums::CellFunction::COMPUTER,
+                                                             Enums::CellFunction::PROPULSION,
+                                                             Enums::CellFunction::CONSTRUCTOR,
+                                                             Enums::CellFunction::SENSOR,
+                                                             Enums::CellFunction::COMMUNICATOR};
+    DataDescription result;
+    for (int clusterIndex = 0; clusterIndex < 100; ++clusterIndex) {
+        QVector2D const pos(30.0f + 60.0f * (clusterIndex % 10), 15.0f + 30.0f * (clusterIndex / 10));
+        auto cluster = createHorizontalCluster(20, pos, QVector2D{}, 0);
+        for (int cellIndex = 0; cellIndex < 20; ++cellIndex) {
+            auto& cell = cluster.cells->at(cellIndex);
+            cell.tokenBranchNumber = cellIndex % _parameters.cellMaxTokenBranchNumber;
+            auto const cellFunction = cellFunctions.at((clusterIndex + cellIndex) % cellFunctions.size());
+            cell.cellFeature = CellFeatureDescription().setType(cellFunction);
+            if (Enums::CellFunction::COMPUTER == cellFunction) {
+                cell.cellFeature->setConstData(program);
+            }
+        }
+        cluster.cells->at(0).addToken(createSimpleToken());
+        cluster.cells->at(7).addToken(createSimpleToken());
+        result.addCluster(cluster);
+    }
+    return result;
+}
+
+map<uint64_t, vector<QByteArray>> TokenBucketingGpuTests::runSimulation(DataDescription const& data, bool tokenBucketing)
+{
+    auto executionParameters = ModelBasicSettings::getDefaultExecutionParameters();
+    executionParameters.tokenBucketing = tokenBucketing;
+    _context->setExecutionParameters(executionParameters);
+
+    IntegrationTestHelper::updateData(_access, data);
+    IntegrationTestHelper::runSimulation(15, _controller);
+    auto const newData = IntegrationTestHelper::getContent(_access, {{0, 0}, {_universeSize.x, _universeSize.y}});
+    IntegrationTestHelper::updateData(_access, DataChangeDescription(newData, DataDescription()));
+
+    map<uint64_t, vector<QByteArray>> result;
+    for (auto const& cluster : *newData.clusters) {
+        for (auto const& cell : *cluster.cells) {
+            auto& tokenMemories = result[cell.id];
+            if (cell.tokens) {
+                for (auto const& token : *cell.tokens) {
+                    tokenMemories.emplace_back(*token.data);
+                }
+            }
+
+            //the order of the tokens on a cell depends on the scheduling on the device
+            std::sort(tokenMemories.begin(), tokenMemories.end());
+        }
+    }
+    return result;
+}
+
+TEST_F(TokenBucketingGpuTests, testIdenticalTokenMemories)
+{
+    auto const data = createMixedFunctionData();
+    auto const expected = runSimulation(data, false);
+    auto const actual = runSimulation(data, true);
+
+    ASSERT_EQ(expected.size(), actual.size());
+    EXPECT_TRUE(expected == actual);
+
+    auto numTokens = 0;
+    for (auto const& cellIdAndTokenMemories : actual) {
+        numTokens += static_cast<int>(cellIdAndTokenMemories.second.size());
+    }
+    EXPECT_LT(0, numTokens);
+}
@@ -0,0 +1,111 @@
+#include <random>
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "ModelBasic/SpaceProperties.h"
+#include "ModelBasic/TorusGeometry.h"
+
+class TorusGeometryTest : public ::testing::Test
+{
+public:
+    TorusGeometryTest();
+    virtual ~TorusGeometryTest() = default;
+
+protected:
+    //the number of positions is not a multiple of the SIMD width in order to test the remainders
+    Vector2DArrays<float> createPositions(int numPositions);
+
+    IntVector2D const _size{1000, 600};
+    SpaceProperties _space;
+    std::mt19937 _randomEngine;
+};
+
+TorusGeometryTest::TorusGeometryTest()
+{
+    _space.init(_size);
+}
+
+Vector2DArrays<float> TorusGeometryTest::createPositions(int numPositions)
+{
+    std::uniform_real_distribution<float> distributionX(-2.0f * _size.x, 3.0f * _size.x);
+    std::uniform_real_distribution<float> distributionY(-2.0f * _size.y, 3.0f * _size.y);
+    Vector2DArrays<float> result;
+    for (int index = 0; index < numPositions; ++index) {
+        result.add(QVector2D(distributionX(_randomEngine), distributionY(_randomEngine)));
+    }
+    result.add(QVector2D(0, 0));
+    result.add(QVector2D(-1.0f, _size.y));
+    result.add(QVector2D(_size.x - 0.25f, -0.25f));
+    return result;
+}
+
+TEST_F(TorusGeometryTest, testCorrectPositions)
+{
+    auto const origPositions = createPositions(1000);
+    for (bool useSimd : {false, true}) {
+        auto positions = origPositions;
+        TorusGeometry(_size, useSimd).correctPositions(positions.getSpan());
+        for (int index = 0; index < positions.size(); ++index) {
+            auto expectedPos = origPositions.get(index);
+            _space.correctPosition(expectedPos);
+            ASSERT_EQ(expectedPos, positions.get(index)) << "index: " << index << ", SIMD: " << useSimd;
+        }
+    }
+}
+
+TEST_F(TorusGeometryTest, testCorrectPositionsWithDoublePrecision)
+{
+    auto const origPositions = createPositions(1000);
+    Vector2DArrays<double> expectedPositions;
+    for (int index = 0; index < origPositions.size(); ++index) {
+        expectedPositions.add(origPositions.get(index));
+    }
+    auto positions = expectedPositions;
+    TorusGeometry(_size, false).correctPositions(expectedPositions.getSpan());
+    TorusGeometry(_size, true).correctPositions(positions.getSpan());
+
+    auto const expectedSpan = expectedPositions.getSpan();
+    auto const span = positions.getSpan();
+    for (int index = 0; index < span.size; ++index) {
+        ASSERT_EQ(expectedSpan.x[index], span.x[index]);
+        ASSERT_EQ(expectedSpan.y[index], span.y[index]);
+        ASSERT_TRUE(span.x[index] >= 0 && span.x[index] < _size.x);
+        ASSERT_TRUE(span.y[index] >= 0 && span.y[index] < _size.y);
+    }
+}
+
+TEST_F(TorusGeometryTest, testDisplacementsAndDistances)
+{
+    auto const fromPoints = createPositions(500);
+    auto const toPoints = createPositions(500);
+    for (bool useSimd : {false, true}) {
+        TorusGeometry geometry(_size, useSimd);
+        Vector2DArrays<float> displacements(fromPoints.size());
+        vector<float> distances(fromPoints.size());
+        geometry.calcDisplacements(fromPoints.getSpan(), toPoints.getSpan(), displacements.getSpan());
+        geometry.calcDistances(fromPoints.getSpan(), toPoints.getSpan(), distances.data());
+        for (int index = 0; index < fromPoints.size(); ++index) {
+            auto const from = fromPoints.get(index);
+            auto const to = toPoints.get(index);
+            ASSERT_EQ(_space.displacement(from, to), displacements.get(index))
+                << "index: " << index << ", SIMD: " << useSimd;
+            ASSERT_EQ(static_cast<float>(_space.distance(from, to)), distances.at(index))
+                << "index: " << index << ", SIMD: " << useSimd;
+        }
+    }
+}
+
+TEST_F(TorusGeometryTest, testDisplacementsInPlace)
+{
+    auto const fromPoints = createPositions(100);
+    auto const toPoints = createPositions(100);
+    Vector2DArrays<float> expectedDisplacements(fromPoints.size());
+    TorusGeometry geometry(_size);
+    geometry.calcDisplacements(fromPoints.getSpan(), toPoints.getSpan(), expectedDisplacements.getSpan());
+
+    auto displacements = toPoints;
+    geometry.calcDisplacements(fromPoints.getSpan(), displacements.getSpan(), displacements.getSpan());
+    for (int index = 0; index < displacements.size(); ++index) {
+        ASSERT_EQ(expectedDisplacements.get(index), displacements.get(index));
+    }
+}
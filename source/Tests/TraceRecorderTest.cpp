@@ -0,0 +1,115 @@
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "Base/Definitions.h"
+#include "Base/TraceRecorder.h"
+
+class TraceRecorderTest : public ::testing::Test
+{
+public:
+    TraceRecorderTest();
+    virtual ~TraceRecorderTest();
+
+protected:
+    int countOccurrences(string const& text, string const& pattern) const;
+};
+
+TraceRecorderTest::TraceRecorderTest()
+{
+    TraceRecorder::getInstance().clear();
+    TraceRecorder::getInstance().setEnabled(true);
+}
+
+TraceRecorderTest::~TraceRecorderTest()
+{
+    TraceRecorder::getInstance().setEnabled(false);
+    TraceRecorder::getInstance().clear();
+}
+
+int TraceRecorderTest::countOccurrences(string const& text, string const& pattern) const
+{
+    int result = 0;
+    for (auto pos = text.find(pattern); pos != string::npos; pos = text.find(pattern, pos + pattern.size())) {
+        ++result;
+    }
+    return result;
+}
+
+TEST_F(TraceRecorderTest, testNestedScopesAndCounters)
+{
+    {
+        TRACE_SCOPE("outer");
+        TRACE_COUNTER("jobs", 3);
+        {
+            TRACE_SCOPE("inner");
+        }
+    }
+    auto const json = TraceRecorder::getInstance().exportToJson();
+
+    EXPECT_EQ(0, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_EQ(1, countOccurrences(json, "\"ph\":\"B\",\"name\":\"outer\""));
+    EXPECT_EQ(1, countOccurrences(json, "\"ph\":\"B\",\"name\":\"inner\""));
+    EXPECT_EQ(2, countOccurrences(json, "\"ph\":\"E\""));
+    EXPECT_EQ(1, countOccurrences(json, "\"ph\":\"C\",\"name\":\"jobs\",\"args\":{\"value\":3}"));
+    EXPECT_LT(json.find("\"outer\""), json.find("\"inner\""));
+}
+
+TEST_F(TraceRecorderTest, testDisabledRecorderRecordsNothing)
+{
+    TraceRecorder::getInstance().setEnabled(false);
+    {
+        TRACE_SCOPE("ignored");
+        TRACE_COUNTER("ignored", 1);
+    }
+    EXPECT_EQ(string::npos, TraceRecorder::getInstance().exportToJson().find("ignored"));
+}
+
+TEST_F(TraceRecorderTest, testScopeStartedWhileDisabledIsNotClosed)
+{
+    TraceRecorder::getInstance().setEnabled(false);
+    {
+        TRACE_SCOPE("before");
+        TraceRecorder::getInstance().setEnabled(true);
+    }
+    auto const json = TraceRecorder::getInstance().exportToJson();
+    EXPECT_EQ(0, countOccurrences(json, "\"ph\":\"B\""));
+    EXPECT_EQ(0, countOccurrences(json, "\"ph\":\"E\""));
+}
+
+TEST_F(TraceRecorderTest, testRingBufferOverflow)
+{
+    {
+        TRACE_SCOPE("overwritten");
+        for (int i = 0; i < TraceRecorder::EventsPerThread; ++i) {
+            TRACE_SCOPE("recent");
+        }
+    }
+    auto const json = TraceRecorder::getInstance().exportToJson();
+
+    //the end event of the overwritten scope is omitted since its begin event is lost
+    EXPECT_EQ(0, countOccurrences(json, "\"overwritten\""));
+    EXPECT_EQ(TraceRecorder::EventsPerThread / 2 - 1, countOccurrences(json, "\"ph\":\"B\",\"name\":\"recent\""));
+    EXPECT_EQ(TraceRecorder::EventsPerThread / 2 - 1, countOccurrences(json, "\"ph\":\"E\""));
+}
+
+TEST_F(TraceRecorderTest, testThreads)
+{
+    auto threadFunction = [] {
+        TRACE_THREAD_NAME("worker");
+        TRACE_SCOPE("work");
+    };
+    std::thread thread1(threadFunction);
+    std::thread thread2(threadFunction);
+    thread1.join();
+    thread2.join();
+    {
+        TRACE_SCOPE("main");
+    }
+
+    auto const json = TraceRecorder::getInstance().exportToJson();
+    EXPECT_EQ(2, countOccurrences(json, "\"name\":\"thread_name\""));
+    EXPECT_EQ(2, countOccurrences(json, "\"args\":{\"name\":\"worker\"}"));
+    EXPECT_EQ(2, countOccurrences(json, "\"ph\":\"B\",\"name\":\"work\""));
+    EXPECT_EQ(1, countOccurrences(json, "\"ph\":\"B\",\"name\":\"main\""));
+}
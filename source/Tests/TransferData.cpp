@@ -0,0 +1,25 @@
+#include "TransferData.h"
+
+TransferData::TransferData(int maxClusters, int maxCells, int maxParticles, int maxTokens, int maxStringBytes)
+    : clusters(maxClusters)
+    , cells(maxCells)
+    , particles(maxParticles)
+    , tokens(maxTokens)
+    , stringBytes(maxStringBytes)
+{}
+
+DataAccessTO TransferData::getDataTO()
+{
+    DataAccessTO result;
+    result.numClusters = &numClusters;
+    result.clusters = clusters.data();
+    result.numCells = &numCells;
+    result.cells = cells.data();
+    result.numParticles = &numParticles;
+    result.particles = particles.data();
+    result.numTokens = &numTokens;
+    result.tokens = tokens.data();
+    result.numStringBytes = &numStringBytes;
+    result.stringBytes = stringBytes.data();
+    return result;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Base/Definitions.h"
+#include "ModelGpu/AccessTOs.cuh"
+
+//transfer object with own memory for testing host code which works on DataAccessTO
+struct TransferData
+{
+    TransferData(int maxClusters, int maxCells, int maxParticles, int maxTokens, int maxStringBytes);
+    DataAccessTO getDataTO();
+
+    int numClusters = 0;
+    int numCells = 0;
+    int numParticles = 0;
+    int numTokens = 0;
+    int numStringBytes = 0;
+    vector<ClusterAccessTO> clusters;
+    vector<CellAccessTO> cells;
+    vector<ParticleAccessTO> particles;
+    vector<TokenAccessTO> tokens;
+    vector<char> stringBytes;
+};
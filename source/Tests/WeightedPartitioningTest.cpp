@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "Base/Definitions.h"
+#include "Base/RandomStream.h"
+#include "ModelGpu/WeightedPartitioning.h"
+
+class WeightedPartitioningTest : public ::testing::Test
+{
+public:
+    WeightedPartitioningTest();
+    virtual ~WeightedPartitioningTest() = default;
+
+protected:
+    //checks that the ranges cover all entities in order and returns the maximum weight of a division
+    int checkPartitionAndCalcMaxLoad(vector<int> const& weights, int numDivisions);
+
+    //maximum weight of a division if the entities are divided by count
+    int calcMaxLoadOfEvenPartition(vector<int> const& weights, int numDivisions) const;
+
+    //sizes of clusters in mature worlds: many small ones and a few giants
+    vector<int> createSkewedWeights(int numEntities);
+
+    HostWeightedPartitioning _partitioning;
+    RandomStream _random;
+};
+
+WeightedPartitioningTest::WeightedPartitioningTest()
+    : _random(1, 0)
+{}
+
+int WeightedPartitioningTest::checkPartitionAndCalcMaxLoad(vector<int> const& weights, int numDivisions)
+{
+    _partitioning.init(weights);
+    int result = 0;
+    int nextIndex = 0;
+    for (int division = 0; division < numDivisions; ++division) {
+        int startIndex, endIndex;
+        _partitioning.calcPartition(division, numDivisions, startIndex, endIndex);
+        if (endIndex >= startIndex) {
+            EXPECT_EQ(nextIndex, startIndex);
+            nextIndex = endIndex + 1;
+        }
+        result = std::max(result, _partitioning.getWeight(startIndex, endIndex));
+    }
+    EXPECT_EQ(static_cast<int>(weights.size()), nextIndex);
+    return result;
+}
+
+int WeightedPartitioningTest::calcMaxLoadOfEvenPartition(vector<int> const& weights, int numDivisions) const
+{
+    auto const numEntities = static_cast<int>(weights.size());
+    int result = 0;
+    for (int division = 0; division < numDivisions; ++division) {
+        auto const startIndex = static_cast<int64_t>(numEntities) * division / numDivisions;
+        auto const endIndex = static_cast<int64_t>(numEntities) * (division + 1) / numDivisions;
+        int load = 0;
+        for (auto index = startIndex; index < endIndex; ++index) {
+            load += weights[index];
+        }
+        result = std::max(result, load);
+    }
+    return result;
+}
+
+vector<int> WeightedPartitioningTest::createSkewedWeights(int numEntities)
+{
+    vector<int> result;
+    for (int i = 0; i < numEntities; ++i) {
+        auto const random = _random.getFloat();
+        result.emplace_back(random < 0.002f ? 10000 + _random.getUInt(20000) : 1 + _random.getUInt(20));
+    }
+    return result;
+}
+
+TEST_F(WeightedPartitioningTest, testUniformWeights)
+{
+    vector<int> weights(1000, 3);
+    EXPECT_EQ(3 * 16, checkPartitionAndCalcMaxLoad(weights, 64));
+}
+
+TEST_F(WeightedPartitioningTest, testFewerEntitiesThanDivisions)
+{
+    vector<int> weights{5, 1, 7};
+    EXPECT_EQ(7, checkPartitionAndCalcMaxLoad(weights, 64));
+
+    EXPECT_EQ(0, checkPartitionAndCalcMaxLoad({}, 64));
+}
+
+TEST_F(WeightedPartitioningTest, testLoadIsBoundedByAverageAndLargestWeight)
+{
+    for (int numDivisions : {1, 7, 64, 1000}) {
+        auto const weights = createSkewedWeights(20000);
+        auto const totalWeight = std::accumulate(weights.begin(), weights.end(), 0);
+        auto const maxWeight = *std::max_element(weights.begin(), weights.end());
+        EXPECT_LE(checkPartitionAndCalcMaxLoad(weights, numDivisions), totalWeight / numDivisions + maxWeight + 1);
+    }
+}
+
+TEST_F(WeightedPartitioningTest, testGiantsAtTheBeginning)
+{
+    vector<int> weights(10, 50000);
+    weights.resize(100000, 1);
+    auto const maxLoad = checkPartitionAndCalcMaxLoad(weights, 64);
+    EXPECT_EQ(50000, maxLoad);
+    EXPECT_LT(maxLoad * 5, calcMaxLoadOfEvenPartition(weights, 64));
+}
+
+TEST_F(WeightedPartitioningTest, testSkewedWeightsAreBetterBalancedThanByCount)
+{
+    auto const weights = createSkewedWeights(5000);
+    auto const maxLoad = checkPartitionAndCalcMaxLoad(weights, 64);
+    EXPECT_LT(maxLoad, calcMaxLoadOfEvenPartition(weights, 64));
+}